@@ -564,6 +564,51 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devi
  */
 extern SDL_DECLSPEC int * SDLCALL SDL_GetAudioDeviceChannelMap(SDL_AudioDeviceID devid, int *count);
 
+/**
+ * Get the properties associated with an audio device.
+ *
+ * The following read-only properties are provided by SDL, and are updated
+ * each time this function is called. They count from the last time the
+ * physical device was opened, and are all zero while it's closed:
+ *
+ * - `SDL_PROP_AUDIODEVICE_STATS_PERIODS_NUMBER`: the number of buffers the
+ *   device has processed.
+ * - `SDL_PROP_AUDIODEVICE_STATS_LATE_WAKEUPS_NUMBER`: the number of times
+ *   SDL got around to processing a buffer more than half a buffer's worth of
+ *   time later than expected. Each of these is eating into the audio already
+ *   queued in the hardware, and a steady stream of them is likely to end in
+ *   dropouts.
+ * - `SDL_PROP_AUDIODEVICE_STATS_MAX_INTERVAL_NS_NUMBER`: the longest time, in
+ *   nanoseconds, between processing two buffers.
+ * - `SDL_PROP_AUDIODEVICE_STATS_PROCESS_NS_NUMBER`: the total time, in
+ *   nanoseconds, spent processing buffers. For a playback device, this
+ *   includes getting data from all the bound audio streams and mixing it.
+ * - `SDL_PROP_AUDIODEVICE_STATS_MAX_PROCESS_NS_NUMBER`: the longest time, in
+ *   nanoseconds, spent processing a single buffer. If this gets close to the
+ *   length of a buffer (see SDL_GetAudioDeviceFormat), the device is at risk
+ *   of running dry.
+ *
+ * Logical devices share the properties of the physical device they were
+ * opened on.
+ *
+ * \param devid the instance ID of the device to query.
+ * \returns a valid property ID on success or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ */
+extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetAudioDeviceProperties(SDL_AudioDeviceID devid);
+
+#define SDL_PROP_AUDIODEVICE_STATS_PERIODS_NUMBER          "SDL.audiodevice.stats.periods"
+#define SDL_PROP_AUDIODEVICE_STATS_LATE_WAKEUPS_NUMBER     "SDL.audiodevice.stats.late_wakeups"
+#define SDL_PROP_AUDIODEVICE_STATS_MAX_INTERVAL_NS_NUMBER  "SDL.audiodevice.stats.max_interval_ns"
+#define SDL_PROP_AUDIODEVICE_STATS_PROCESS_NS_NUMBER       "SDL.audiodevice.stats.process_ns"
+#define SDL_PROP_AUDIODEVICE_STATS_MAX_PROCESS_NS_NUMBER   "SDL.audiodevice.stats.max_process_ns"
+
 /**
  * Open a specific audio device.
  *
@@ -936,17 +981,109 @@ extern SDL_DECLSPEC SDL_AudioDeviceID SDLCALL SDL_GetAudioStreamDevice(SDL_Audio
  */
 extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec);
 
+/**
+ * Create a new audio stream with the specified properties.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BOOLEAN`: true if exactly one
+ *   thread puts data into the stream and one thread gets data from it. Data
+ *   put into the stream goes through a lock-free ring buffer, so
+ *   SDL_PutAudioStreamData() doesn't need to wait for the stream's lock while
+ *   another thread is getting data from the stream, defaults to false.
+ * - `SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BUFFER_SIZE_NUMBER`: the size, in
+ *   bytes, of the lock-free ring buffer, defaults to 65536. Data that doesn't
+ *   fit, and data put while a put callback is set, goes through the stream's
+ *   lock as usual.
+ * - `SDL_PROP_AUDIOSTREAM_CREATE_PREALLOCATE_NUMBER`: the number of bytes of
+ *   input to allocate queue memory for up front, defaults to 0. This memory
+ *   is kept for the life of the stream, so as long as no more than this much
+ *   data is queued at once, putting and getting data won't allocate memory.
+ *   This also stops SDL_PutAudioStreamData() from copying large amounts of
+ *   data into a new allocation before taking the stream's lock.
+ * - `SDL_PROP_AUDIOSTREAM_CREATE_MAX_IDLE_NUMBER`: the number of bytes of
+ *   queue memory that isn't holding any data to keep around for reuse,
+ *   defaults to 32768. Anything over this is freed as soon as the data in it
+ *   is consumed. Memory beyond the preallocation that goes unused for a full
+ *   second is freed the next time data is put into the stream or the stream
+ *   is cleared, so it's given back a second or two after a burst of data.
+ *
+ * A lock-free stream behaves like any other audio stream, including format
+ * changes part way through the queued data, but with more than one thread
+ * calling SDL_PutAudioStreamData() at the same time the order of the data is
+ * undefined.
+ *
+ * \param src_spec the format details of the input audio.
+ * \param dst_spec the format details of the output audio.
+ * \param props the properties to use.
+ * \returns a new audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateAudioStream
+ * \sa SDL_PutAudioStreamData
+ * \sa SDL_GetAudioStreamData
+ * \sa SDL_DestroyAudioStream
+ */
+extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStreamWithProperties(const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec, SDL_PropertiesID props);
+
+#define SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BOOLEAN             "SDL.audiostream.create.lockfree"
+#define SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BUFFER_SIZE_NUMBER  "SDL.audiostream.create.lockfree.buffer_size"
+#define SDL_PROP_AUDIOSTREAM_CREATE_PREALLOCATE_NUMBER           "SDL.audiostream.create.preallocate"
+#define SDL_PROP_AUDIOSTREAM_CREATE_MAX_IDLE_NUMBER              "SDL.audiostream.create.max_idle"
+
 /**
  * Get the properties associated with an audio stream.
  *
+ * The following read-only properties are provided by SDL, and are updated
+ * each time this function is called:
+ *
+ * - `SDL_PROP_AUDIOSTREAM_STATS_CONVERT_NS_NUMBER`: the total time, in
+ *   nanoseconds, spent converting and resampling data while getting it from
+ *   the stream. This does not include time spent in the get callback.
+ * - `SDL_PROP_AUDIOSTREAM_STATS_FRAMES_CONVERTED_NUMBER`: the total number of
+ *   sample frames, in the output format, gotten from the stream.
+ * - `SDL_PROP_AUDIOSTREAM_STATS_QUEUED_NUMBER`: the number of bytes of input
+ *   currently queued, the same as SDL_GetAudioStreamQueued() reports.
+ * - `SDL_PROP_AUDIOSTREAM_STATS_QUEUED_HIGH_WATER_NUMBER`: the most bytes of
+ *   input that have been queued at once, as seen each time data was gotten
+ *   from the stream.
+ * - `SDL_PROP_AUDIOSTREAM_STATS_WORK_BUFFER_REALLOCS_NUMBER`: the number of
+ *   times the stream had to allocate a bigger scratch buffer for conversion.
+ * - `SDL_PROP_AUDIOSTREAM_STATS_QUEUE_MEMORY_NUMBER`: the number of bytes of
+ *   memory the stream is holding to queue input, whether it's in use or not.
+ * - `SDL_PROP_AUDIOSTREAM_STATS_QUEUE_IDLE_MEMORY_NUMBER`: the part of that
+ *   memory which isn't holding any data right now.
+ * - `SDL_PROP_AUDIOSTREAM_STATS_QUEUE_ALLOCATIONS_NUMBER`: the number of
+ *   times the stream had to allocate more memory to queue input, not
+ *   counting what was preallocated with
+ *   `SDL_PROP_AUDIOSTREAM_CREATE_PREALLOCATE_NUMBER`.
+ *
+ * These are kept for every stream, and only cost a little bookkeeping each
+ * time data is gotten from it, so they can be left on in shipping code.
+ *
  * \param stream the SDL_AudioStream to query.
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
  *
+ * \threadsafety It is safe to call this function from any thread.
+ *
  * \since This function is available since SDL 3.0.0.
  */
 extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetAudioStreamProperties(SDL_AudioStream *stream);
 
+#define SDL_PROP_AUDIOSTREAM_STATS_CONVERT_NS_NUMBER            "SDL.audiostream.stats.convert_ns"
+#define SDL_PROP_AUDIOSTREAM_STATS_FRAMES_CONVERTED_NUMBER      "SDL.audiostream.stats.frames_converted"
+#define SDL_PROP_AUDIOSTREAM_STATS_QUEUED_NUMBER                "SDL.audiostream.stats.queued"
+#define SDL_PROP_AUDIOSTREAM_STATS_QUEUED_HIGH_WATER_NUMBER     "SDL.audiostream.stats.queued_high_water"
+#define SDL_PROP_AUDIOSTREAM_STATS_WORK_BUFFER_REALLOCS_NUMBER  "SDL.audiostream.stats.work_buffer_reallocs"
+#define SDL_PROP_AUDIOSTREAM_STATS_QUEUE_MEMORY_NUMBER          "SDL.audiostream.stats.queue_memory"
+#define SDL_PROP_AUDIOSTREAM_STATS_QUEUE_IDLE_MEMORY_NUMBER     "SDL.audiostream.stats.queue_idle_memory"
+#define SDL_PROP_AUDIOSTREAM_STATS_QUEUE_ALLOCATIONS_NUMBER     "SDL.audiostream.stats.queue_allocations"
+
 /**
  * Query the current format of an audio stream.
  *
@@ -1262,6 +1399,70 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioStreamOutputChannelMap(SDL_AudioStr
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len);
 
+/**
+ * A callback that fires when data passed to SDL_PutAudioStreamDataNoCopy()
+ * is no longer needed.
+ *
+ * This is called once the stream has consumed all of the buffer, when the
+ * stream is cleared, or when it is destroyed, whichever comes first. After
+ * this, the app can free or reuse the buffer.
+ *
+ * This callback is called with the stream locked, from whichever thread
+ * caused the buffer to be released, which might be an audio device thread.
+ * It should not block or call back into the stream.
+ *
+ * \param userdata an opaque pointer provided by the app for their personal
+ *                 use.
+ * \param buf the pointer provided to SDL_PutAudioStreamDataNoCopy().
+ * \param buflen the size of buffer, in bytes, provided to
+ *               SDL_PutAudioStreamDataNoCopy().
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_PutAudioStreamDataNoCopy
+ */
+typedef void (SDLCALL *SDL_AudioStreamDataCompleteCallback)(void *userdata, const void *buf, int buflen);
+
+/**
+ * Add external data to an audio stream without copying it.
+ *
+ * Unlike SDL_PutAudioStreamData(), this call does not make a copy of the
+ * provided data. The stream reads from the app's buffer directly, so the
+ * buffer must stay valid and unchanged until `callback` fires to say the
+ * stream is done with it.
+ *
+ * Like SDL_PutAudioStreamData(), the data must match the format/channels/
+ * samplerate of the stream's input at the time of this call. Changing the
+ * stream's format afterwards does not affect data that was already put
+ * into it, even if the stream has only consumed part of the buffer.
+ *
+ * If this function fails, `callback` is not called, and the app still owns
+ * the buffer.
+ *
+ * \param stream the stream the audio data is being added to.
+ * \param buf a pointer to the audio data to add.
+ * \param len the number of bytes to add to the stream.
+ * \param callback the callback function to call when the data is no longer
+ *                 needed by the stream. May be NULL.
+ * \param userdata an opaque pointer provided to the callback for its own
+ *                 personal use.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but if the
+ *               stream has a callback set, the caller might need to manage
+ *               extra locking.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ClearAudioStream
+ * \sa SDL_FlushAudioStream
+ * \sa SDL_GetAudioStreamData
+ * \sa SDL_GetAudioStreamQueued
+ * \sa SDL_PutAudioStreamData
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_PutAudioStreamDataNoCopy(SDL_AudioStream *stream, const void *buf, int len, SDL_AudioStreamDataCompleteCallback callback, void *userdata);
+
 /**
  * Get converted/resampled data from the stream.
  *
@@ -1914,6 +2115,101 @@ extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV_IO(SDL_IOStream *src, bool closeio,
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len);
 
+/**
+ * Open a WAVE file from a data source for streaming playback.
+ *
+ * Unlike SDL_LoadWAV_IO(), this doesn't read and decode the whole file up
+ * front. The chunks are parsed right away, but the audio data is read from
+ * `src` and decoded a block at a time, as the returned audio stream needs
+ * more of it. This keeps memory usage small and constant, no matter how long
+ * the file is.
+ *
+ * All the formats SDL_LoadWAV_IO() supports can be streamed, and the same
+ * hints apply.
+ *
+ * The returned stream's input and output formats are both set to the format
+ * of the WAVE data (which is also what `spec` is set to). Change the output
+ * format with SDL_SetAudioStreamFormat(), or bind the stream to an audio
+ * device, and get data from it as usual. The stream is flushed once the end
+ * of the data is reached. The stream uses its get-callback to decode, so the
+ * app must not replace it with SDL_SetAudioStreamGetCallback().
+ *
+ * `src` is used by the stream until it is destroyed with
+ * SDL_DestroyAudioStream(), and must not be used by anything else in the
+ * meantime.
+ *
+ * \param src the data source for the WAVE data. It must be seekable.
+ * \param closeio if true, calls SDL_CloseIO() on `src` when the stream is
+ *                destroyed, or before returning in the case of an error.
+ * \param spec a pointer to an SDL_AudioSpec that will be set to the WAVE
+ *             data's format details on successful return, may be NULL.
+ * \param frames a pointer filled with the number of sample frames in the
+ *               WAVE data, may be NULL.
+ * \returns an audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyAudioStream
+ * \sa SDL_LoadWAV_IO
+ * \sa SDL_OpenWAVStream
+ * \sa SDL_SeekWAVStream
+ */
+extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_OpenWAVStream_IO(SDL_IOStream *src, bool closeio, SDL_AudioSpec *spec, Sint64 *frames);
+
+/**
+ * Open a WAVE file from a file path for streaming playback.
+ *
+ * This is a convenience function that is effectively the same as:
+ *
+ * ```c
+ * SDL_OpenWAVStream_IO(SDL_IOFromFile(path, "rb"), true, spec, frames);
+ * ```
+ *
+ * \param path the file path of the WAV file to open.
+ * \param spec a pointer to an SDL_AudioSpec that will be set to the WAVE
+ *             data's format details on successful return, may be NULL.
+ * \param frames a pointer filled with the number of sample frames in the
+ *               WAVE data, may be NULL.
+ * \returns an audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DestroyAudioStream
+ * \sa SDL_OpenWAVStream_IO
+ * \sa SDL_SeekWAVStream
+ */
+extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_OpenWAVStream(const char *path, SDL_AudioSpec *spec, Sint64 *frames);
+
+/**
+ * Seek to a sample frame in a stream opened with SDL_OpenWAVStream_IO().
+ *
+ * This clears any data already queued in the stream, as if by
+ * SDL_ClearAudioStream(), and continues decoding at `frame`. Seeking to the
+ * end of the data is allowed, and makes the stream flush.
+ *
+ * Only the block containing `frame` is read from the data source, so this
+ * is cheap even for compressed formats.
+ *
+ * \param stream an audio stream returned by SDL_OpenWAVStream_IO().
+ * \param frame the sample frame to continue decoding at, between 0 and the
+ *              number of frames in the WAVE data.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWAVStream_IO
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SeekWAVStream(SDL_AudioStream *stream, Sint64 frame);
+
 /**
  * Mix audio data in a specified format.
  *
@@ -1928,6 +2224,7 @@ extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec *sp
  * sample data. The output from repeated application of this function may be
  * distorted by clipping, because there is no accumulator with greater range
  * than the input (not to mention this being an inefficient way of doing it).
+ * Use SDL_MixAudioBatch() for that instead.
  *
  * It is a common misconception that this function is required to write audio
  * data to an output stream in an audio callback. While you can do that,
@@ -1947,9 +2244,44 @@ extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec *sp
  * \threadsafety It is safe to call this function from any thread.
  *
  * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_MixAudioBatch
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, float volume);
 
+/**
+ * Mix several audio buffers into one in a single pass.
+ *
+ * This adds each buffer in `srcs`, adjusted by the matching entry in
+ * `volumes`, to `dst`. Unlike calling SDL_MixAudio() once per source, the
+ * sum is accumulated in floating point and clipped only once at the end, so
+ * many sources can be mixed together without distortion from intermediate
+ * clipping, and `dst` is only read and written once.
+ *
+ * For integer formats, the data goes through 32-bit floats, so 32-bit
+ * integer data keeps about 24 bits of precision.
+ *
+ * \param dst the destination for the mixed audio, `len` bytes of `format`
+ *            data.
+ * \param srcs an array of `num_srcs` source audio buffers, each `len` bytes
+ *             of `format` data.
+ * \param volumes an array of `num_srcs` volumes, one for each source, where
+ *                1.0 is full volume. May be NULL to mix all sources at full
+ *                volume.
+ * \param num_srcs the number of source buffers.
+ * \param format the SDL_AudioFormat of all the buffers.
+ * \param len the length of each audio buffer in bytes.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_MixAudio
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_MixAudioBatch(Uint8 *dst, const Uint8 * const *srcs, const float *volumes, int num_srcs, SDL_AudioFormat format, Uint32 len);
+
 /**
  * Convert some audio data of one format to another format.
  *
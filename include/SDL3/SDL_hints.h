@@ -265,6 +265,36 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DEVICE_APP_ICON_NAME "SDL_AUDIO_DEVICE_APP_ICON_NAME"
 
+/**
+ * A variable controlling the number of helper threads used to mix streams
+ * bound to a playback device.
+ *
+ * This hint is an integer >= 0. By default (or if set to 0), each physical
+ * playback device converts, resamples and mixes all of its bound audio
+ * streams serially on its own audio thread.
+ *
+ * If set to a value > 0, SDL will spin up that many extra threads per opened
+ * playback device, and the per-stream work (which is usually dominated by
+ * format conversion and resampling) is spread across them and the device
+ * thread before the results are summed into the final mix. This can help
+ * apps that bind dozens or hundreds of streams to a single device, but it
+ * adds a little overhead and is not worth it for a handful of streams.
+ *
+ * When this is enabled, SDL_AudioStream get callbacks for bound streams
+ * might be called from one of these helper threads instead of the device
+ * thread, and multiple streams' callbacks may run at the same time. The
+ * device thread still holds the device's lock while the helpers run, so a
+ * get callback must not call anything that locks the same device (binding
+ * or unbinding streams, pausing, setting gain or a postmix callback, etc),
+ * or wait on a thread that does, as that will deadlock. Without this hint,
+ * callbacks run on the device thread, which already owns that lock.
+ *
+ * This hint should be set before an audio device is opened.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_AUDIO_DEVICE_MIXING_THREADS "SDL_AUDIO_DEVICE_MIXING_THREADS"
+
 /**
  * A variable controlling device buffer size.
  *
@@ -2979,6 +3009,54 @@ extern "C" {
  */
 #define SDL_HINT_STORAGE_USER_DRIVER "SDL_STORAGE_USER_DRIVER"
 
+/**
+ * A variable controlling the number of helper threads used for large
+ * software blits.
+ *
+ * This hint is an integer >= 0. By default (or if set to 0), SDL_BlitSurface()
+ * and SDL_BlitSurfaceScaled() do all of their work on the calling thread.
+ *
+ * If set to a value > 0, SDL keeps that many extra threads around, and large
+ * blits are split into bands of rows that are processed by them and the
+ * calling thread at the same time. The results are identical to blitting on
+ * one thread. Small blits, RLE accelerated blits, blits to palettized
+ * surfaces, blits from a surface to itself and nearest-neighbor scaling that
+ * also converts, blends or modulates are always done on the calling thread.
+ * The RLE encoding of large surfaces, done by their first blit or by
+ * SDL_EncodeSurfaceRLE(), is split up the same way.
+ *
+ * Only one blit at a time uses the helper threads; blits started on other
+ * threads while they are busy run on their calling thread as usual.
+ *
+ * This hint can be changed at any time, and takes effect on the next blit.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_SURFACE_BLIT_THREADS "SDL_SURFACE_BLIT_THREADS"
+
+/**
+ * A variable controlling whether duplicated surfaces share their pixels.
+ *
+ * When this is enabled, SDL_DuplicateSurface() and SDL_ConvertSurface() to
+ * the same format don't copy the pixels, the new surface refers to the same
+ * pixels as the original until one of them is changed. Blits, fills, pixel
+ * writes and SDL_LockSurface() give the surface being changed its own copy
+ * of the pixels first, so the surface pixels pointer can change when a
+ * surface is locked. Applications that write to the surface pixels without
+ * locking the surface should leave this disabled.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Duplicated surfaces have their own copy of the pixels. (default)
+ * - "1": Duplicated surfaces share the pixels until one of them is changed.
+ *
+ * This hint can be changed at any time, and takes effect on the next
+ * duplicate or conversion.
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_SURFACE_COPY_ON_WRITE "SDL_SURFACE_COPY_ON_WRITE"
+
 /**
  * Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as
  * realtime.
@@ -3784,6 +3862,26 @@ extern "C" {
  */
 #define SDL_HINT_WINDOW_FRAME_USABLE_WHILE_CURSOR_HIDDEN "SDL_WINDOW_FRAME_USABLE_WHILE_CURSOR_HIDDEN"
 
+/**
+ * A variable controlling whether window surfaces keep track of the areas that
+ * have changed.
+ *
+ * When this is enabled, SDL_UpdateWindowSurface() only copies the areas that
+ * were changed by blits, fills, pixel writes and locks since the last
+ * update. Applications that write to the surface pixels without locking the
+ * surface should use SDL_UpdateWindowSurfaceRects() for those changes.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": SDL_UpdateWindowSurface() copies the whole surface. (default)
+ * - "1": SDL_UpdateWindowSurface() copies the areas that have changed.
+ *
+ * This hint should be set before calling SDL_GetWindowSurface().
+ *
+ * \since This hint is available since SDL 3.0.0.
+ */
+#define SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING "SDL_WINDOW_SURFACE_DAMAGE_TRACKING"
+
 /**
  * A variable controlling whether SDL generates window-close events for Alt+F4
  * on Windows.
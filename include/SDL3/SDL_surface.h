@@ -66,12 +66,17 @@ typedef Uint32 SDL_SurfaceFlags;
 /**
  * The scaling mode.
  *
+ * SDL_SCALEMODE_AREA and SDL_SCALEMODE_LANCZOS are only supported when
+ * scaling surfaces, textures can't use them.
+ *
  * \since This enum is available since SDL 3.0.0.
  */
 typedef enum SDL_ScaleMode
 {
     SDL_SCALEMODE_NEAREST, /**< nearest pixel sampling */
-    SDL_SCALEMODE_LINEAR   /**< linear filtering */
+    SDL_SCALEMODE_LINEAR,  /**< linear filtering */
+    SDL_SCALEMODE_AREA,    /**< area averaging, for downscaling without aliasing. Upscaling is linear filtering. */
+    SDL_SCALEMODE_LANCZOS  /**< Lanczos-3 filtering, sharper than area averaging when downscaling and than linear filtering when upscaling. */
 } SDL_ScaleMode;
 
 /**
@@ -121,6 +126,71 @@ typedef struct SDL_Surface
 
 } SDL_Surface;
 
+/**
+ * A precomputed blit between a source and destination pixel format.
+ *
+ * A blit plan captures a source surface's format, palette, blend mode, color
+ * and alpha modulation and color key, along with the destination format, and
+ * picks the blit routine for that combination once. It can then copy any
+ * number of surfaces with that format in one call, without SDL having to
+ * look up the blit routine again whenever the blit state changes between
+ * them.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateBlitPlan
+ * \sa SDL_BlitSurfaceBatch
+ * \sa SDL_DestroyBlitPlan
+ */
+typedef struct SDL_BlitPlan SDL_BlitPlan;
+
+/**
+ * A single blit in a batch executed with SDL_BlitSurfaceBatch().
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_BlitSurfaceBatch
+ */
+typedef struct SDL_BlitBatchItem
+{
+    SDL_Surface *src;   /**< the surface to copy from, with the same format and palette the plan was created with */
+    SDL_Rect srcrect;   /**< the rectangle of `src` to copy */
+    SDL_Rect dstrect;   /**< the position in the destination surface; the width and height are ignored, as for SDL_BlitSurface() */
+} SDL_BlitBatchItem;
+
+
+/**
+ * A pool of surface pixel buffers that are recycled instead of freed.
+ *
+ * Creating and destroying lots of surfaces with the same size and format,
+ * such as decoded video frames, spends a lot of time in the allocator and in
+ * page faults on newly allocated memory. Surfaces created from a pool give
+ * their pixel buffer back to it when they're destroyed, and the next surface
+ * with the same width, height and format reuses it.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSurfacePool
+ * \sa SDL_CreatePooledSurface
+ * \sa SDL_GetSurfacePoolStats
+ * \sa SDL_DestroySurfacePool
+ */
+typedef struct SDL_SurfacePool SDL_SurfacePool;
+
+/**
+ * Counters describing the memory use of a surface pool.
+ *
+ * \since This struct is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetSurfacePoolStats
+ */
+typedef struct SDL_SurfacePoolStats
+{
+    Uint64 hits;            /**< the number of surfaces created with a recycled pixel buffer */
+    Uint64 misses;          /**< the number of surfaces that needed a new pixel buffer */
+    size_t resident_bytes;  /**< the pixel memory allocated by the pool, both in use and free */
+    size_t free_bytes;      /**< the pixel memory waiting in the pool to be reused */
+} SDL_SurfacePoolStats;
 
 /**
  * Allocate a new surface with a specific pixel format.
@@ -177,12 +247,99 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurfaceFrom(int width, int h
  *
  * \since This function is available since SDL 3.0.0.
  *
+ * \sa SDL_CreatePooledSurface
  * \sa SDL_CreateStackSurface
  * \sa SDL_CreateSurface
  * \sa SDL_CreateSurfaceFrom
  */
 extern SDL_DECLSPEC void SDLCALL SDL_DestroySurface(SDL_Surface *surface);
 
+/**
+ * Create a pool of reusable surface pixel buffers.
+ *
+ * Pixel buffers are kept for reuse until they add up to `max_free_bytes`;
+ * buffers released beyond that are freed.
+ *
+ * If `huge_pages` is true, buffers of 4 MB or more are rounded up to a
+ * multiple of 2 MB and allocated so that the operating system can back them
+ * with huge pages, which saves page faults and TLB misses on very large
+ * surfaces. This is currently only done on Linux, and is ignored elsewhere.
+ *
+ * \param max_free_bytes the most memory that the pool keeps in free pixel
+ *                       buffers.
+ * \param huge_pages true to back very large buffers with huge pages.
+ * \returns the new surface pool or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreatePooledSurface
+ * \sa SDL_DestroySurfacePool
+ */
+extern SDL_DECLSPEC SDL_SurfacePool * SDLCALL SDL_CreateSurfacePool(size_t max_free_bytes, bool huge_pages);
+
+/**
+ * Allocate a new surface with its pixels from a surface pool.
+ *
+ * If the pool has a free buffer for the same width, height and format it's
+ * reused, otherwise a new one is allocated. The buffer goes back to the pool
+ * when the surface is destroyed with SDL_DestroySurface().
+ *
+ * Unlike SDL_CreateSurface(), the pixels of a reused buffer are not cleared,
+ * and hold whatever the previous surface left in them.
+ *
+ * \param pool the surface pool to allocate the pixels from.
+ * \param width the width of the surface.
+ * \param height the height of the surface.
+ * \param format the SDL_PixelFormat for the new surface's pixel format.
+ * \returns the new SDL_Surface structure that is created or NULL on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSurface
+ * \sa SDL_CreateSurfacePool
+ * \sa SDL_DestroySurface
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreatePooledSurface(SDL_SurfacePool *pool, int width, int height, SDL_PixelFormat format);
+
+/**
+ * Get the reuse and memory counters of a surface pool.
+ *
+ * \param pool the surface pool to query.
+ * \param stats filled in with the current counters.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSurfacePool
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetSurfacePoolStats(SDL_SurfacePool *pool, SDL_SurfacePoolStats *stats);
+
+/**
+ * Destroy a surface pool.
+ *
+ * The free buffers in the pool are released right away. Surfaces that were
+ * created from the pool stay valid, and free their pixels when they are
+ * destroyed.
+ *
+ * \param pool the surface pool to destroy, or NULL.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateSurfacePool
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroySurfacePool(SDL_SurfacePool *pool);
+
 /**
  * Get the properties associated with a surface.
  *
@@ -537,6 +694,38 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetSurfaceRLE(SDL_Surface *surface, bool en
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SurfaceHasRLE(SDL_Surface *surface);
 
+/**
+ * Encode an RLE enabled surface for blitting onto a given pixel format.
+ *
+ * RLE enabled surfaces are normally encoded by the first blit, which can take
+ * a noticeable amount of time for large sprite sheets. This does the encoding
+ * ahead of time, for example while loading, so that blits onto surfaces of
+ * `format` can start using the encoded data right away. Only the destination
+ * pixel format matters for the encoding.
+ *
+ * Large surfaces are encoded using the threads set up with
+ * SDL_HINT_SURFACE_BLIT_THREADS, if any.
+ *
+ * As with the encoding done by a blit, the original pixels are released
+ * afterwards, and the surface must be locked before directly accessing them.
+ *
+ * \param surface the SDL_Surface structure to encode, with RLE enabled.
+ * \param format the pixel format of the surfaces it will be blitted onto.
+ * \returns true on success or false on failure, for example if the surface
+ *          doesn't have a color key or alpha blending that can be RLE
+ *          encoded for `format`; call SDL_GetError() for more information.
+ *
+ * \threadsafety The surface should not be used from other threads while it
+ *               is being encoded. Different surfaces can be encoded from
+ *               different threads at once.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetSurfaceRLE
+ * \sa SDL_SurfaceHasRLE
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_EncodeSurfaceRLE(SDL_Surface *surface, SDL_PixelFormat format);
+
 /**
  * Set the color key (transparent pixel) in a surface.
  *
@@ -756,12 +945,41 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetSurfaceClipRect(SDL_Surface *surface, SD
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_FlipSurface(SDL_Surface *surface, SDL_FlipMode flip);
 
+/**
+ * Creates a new surface with the contents of an existing surface rotated by a
+ * multiple of 90 degrees.
+ *
+ * The new surface has the format, palette, colorspace and blit settings of
+ * the original. When the number of quarter turns is odd, its width is the
+ * height of the original and its height is the width of the original.
+ *
+ * The returned surface should be freed with SDL_DestroySurface().
+ *
+ * \param surface the surface to rotate.
+ * \param turns the number of quarter turns to rotate clockwise, negative
+ *              values rotate counter-clockwise.
+ * \returns the rotated surface or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               the surface isn't being changed at the same time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_FlipSurface
+ * \sa SDL_DestroySurface
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_RotateSurface90(SDL_Surface *surface, int turns);
+
 /**
  * Creates a new surface identical to the existing surface.
  *
  * If the original surface has alternate images, the new surface will have a
  * reference to them as well.
  *
+ * If SDL_HINT_SURFACE_COPY_ON_WRITE is enabled, the new surface shares the
+ * pixels of the original until one of them is changed.
+ *
  * The returned surface should be freed with SDL_DestroySurface().
  *
  * \param surface the surface to duplicate.
@@ -932,6 +1150,48 @@ extern SDL_DECLSPEC bool SDLCALL SDL_PremultiplyAlpha(int width, int height, SDL
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PremultiplySurfaceAlpha(SDL_Surface *surface, bool linear);
 
+/**
+ * Undo alpha premultiplication on a block of pixels.
+ *
+ * The color channels are divided by alpha and rounded. Pixels with an alpha
+ * of 0 come out black, since their color can't be recovered.
+ *
+ * This is safe to use with src == dst, but not for other overlapping areas.
+ *
+ * \param width the width of the block to convert, in pixels.
+ * \param height the height of the block to convert, in pixels.
+ * \param src_format an SDL_PixelFormat value of the `src` pixels format.
+ * \param src a pointer to the premultiplied source pixels.
+ * \param src_pitch the pitch of the source pixels, in bytes.
+ * \param dst_format an SDL_PixelFormat value of the `dst` pixels format.
+ * \param dst a pointer to be filled in with straight alpha pixel data.
+ * \param dst_pitch the pitch of the destination pixels, in bytes.
+ * \param linear true if the alpha was multiplied in linear space, false if
+ *               it was multiplied in sRGB space.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PremultiplyAlpha
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_UnpremultiplyAlpha(int width, int height, SDL_PixelFormat src_format, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch, bool linear);
+
+/**
+ * Undo alpha premultiplication in a surface.
+ *
+ * \param surface the surface to modify.
+ * \param linear true if the alpha was multiplied in linear space, false if
+ *               it was multiplied in sRGB space.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PremultiplySurfaceAlpha
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_UnpremultiplySurfaceAlpha(SDL_Surface *surface, bool linear);
+
 /**
  * Clear a surface with a specific color, with floating point precision.
  *
@@ -1246,6 +1506,73 @@ extern SDL_DECLSPEC bool SDLCALL SDL_BlitSurfaceTiledWithScale(SDL_Surface *src,
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_BlitSurface9Grid(SDL_Surface *src, const SDL_Rect *srcrect, int left_width, int right_width, int top_height, int bottom_height, float scale, SDL_ScaleMode scaleMode, SDL_Surface *dst, const SDL_Rect *dstrect);
 
+/**
+ * Create a blit plan for blitting surfaces like `src` onto surfaces like
+ * `dst`.
+ *
+ * The plan takes a snapshot of the current pixel format, palette,
+ * colorspace, blend mode, color and alpha modulation and color key of `src`,
+ * its SDR white point, HDR headroom and tone mapping properties, and the
+ * pixel format of `dst`. Changing them on `src` afterwards doesn't affect the
+ * plan. A palette is shared rather than copied, so changes to the
+ * colors in it are picked up by the plan.
+ *
+ * \param src a surface with the format and blit state that the plan should
+ *            use.
+ * \param dst a surface with the destination format.
+ * \returns the new blit plan or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BlitSurfaceBatch
+ * \sa SDL_DestroyBlitPlan
+ */
+extern SDL_DECLSPEC SDL_BlitPlan * SDLCALL SDL_CreateBlitPlan(SDL_Surface *src, SDL_Surface *dst);
+
+/**
+ * Perform a batch of unscaled blits with a blit plan.
+ *
+ * Each item is clipped and copied like SDL_BlitSurface() would, except that
+ * the colorspace, blend mode, modulation and color key captured in `plan` are
+ * used instead of the ones set on the item's source surface.
+ *
+ * Each source surface must have the pixel format that `plan` was created
+ * with, and the same palette if the format is indexed. `dst` must have the
+ * destination pixel format that `plan` was created with.
+ *
+ * \param plan the blit plan to use.
+ * \param items an array of `num_items` blits to perform, in order.
+ * \param num_items the number of blits in `items`.
+ * \param dst the SDL_Surface structure that is the blit target.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information. Blits before the one that failed have been done.
+ *
+ * \threadsafety A blit plan and the destination surface should not be used
+ *               from two threads at once.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_BlitSurface
+ * \sa SDL_CreateBlitPlan
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_BlitSurfaceBatch(SDL_BlitPlan *plan, const SDL_BlitBatchItem *items, int num_items, SDL_Surface *dst);
+
+/**
+ * Destroy a blit plan.
+ *
+ * \param plan the blit plan to destroy, or NULL.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateBlitPlan
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyBlitPlan(SDL_BlitPlan *plan);
+
 /**
  * Map an RGB triple to an opaque pixel value for a surface.
  *
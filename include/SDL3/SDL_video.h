@@ -2013,6 +2013,10 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetWindowSurfaceVSync(SDL_Window *window, i
  *
  * This function is equivalent to the SDL 1.2 API SDL_Flip().
  *
+ * If SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING is enabled, only the areas of
+ * the surface that SDL has changed since the last update are copied, and
+ * nothing is presented if nothing changed.
+ *
  * \param window the window to update.
  * \returns true on success or false on failure; call SDL_GetError() for more
  *          information.
@@ -2020,6 +2024,7 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetWindowSurfaceVSync(SDL_Window *window, i
  * \since This function is available since SDL 3.0.0.
  *
  * \sa SDL_GetWindowSurface
+ * \sa SDL_GetWindowSurfaceDamage
  * \sa SDL_UpdateWindowSurfaceRects
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_UpdateWindowSurface(SDL_Window *window);
@@ -2051,6 +2056,30 @@ extern SDL_DECLSPEC bool SDLCALL SDL_UpdateWindowSurface(SDL_Window *window);
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_UpdateWindowSurfaceRects(SDL_Window *window, const SDL_Rect *rects, int numrects);
 
+/**
+ * Get the areas of the window surface that SDL_UpdateWindowSurface() will
+ * copy to the screen.
+ *
+ * If SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING was enabled when the surface was
+ * created, these are the areas changed by blits, fills, pixel writes and
+ * locks since the last call to SDL_UpdateWindowSurface(), merged into a few
+ * rectangles. Changes made through the surface pixels without locking the
+ * surface aren't tracked. Otherwise this is the whole surface.
+ *
+ * \param window the window to query.
+ * \param count a pointer filled in with the number of rectangles returned,
+ *              may be NULL.
+ * \returns an array of rectangles, which may be empty, or NULL on failure;
+ *          call SDL_GetError() for more information. This should be freed
+ *          with SDL_free() when it is no longer needed.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetWindowSurface
+ * \sa SDL_UpdateWindowSurface
+ */
+extern SDL_DECLSPEC SDL_Rect * SDLCALL SDL_GetWindowSurfaceDamage(SDL_Window *window, int *count);
+
 /**
  * Destroy the surface associated with the window.
  *
@@ -610,6 +610,7 @@ void SDL_Quit(void)
     SDL_AssertionsQuit();
 
     SDL_QuitPixelFormatDetails();
+    SDL_QuitBlitThreads();
 
     SDL_QuitCPUInfo();
 
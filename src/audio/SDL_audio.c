@@ -544,6 +544,7 @@ static void DestroyPhysicalAudioDevice(SDL_AudioDevice *device)
 
     SDL_UnlockMutex(device->lock);  // don't use ReleaseAudioDevice because we don't want to change refcounts while destroying.
 
+    SDL_DestroyProperties(device->props);
     SDL_DestroyMutex(device->lock);
     SDL_DestroyCondition(device->close_cond);
     SDL_free(device->work_buffer);
@@ -1079,6 +1080,275 @@ static void MixFloat32Audio(float *dst, const float *src, const int buffer_size)
     }
 }
 
+// Optional pool of helper threads that split up the per-stream work of a playback device. See SDL_HINT_AUDIO_DEVICE_MIXING_THREADS.
+
+#define SDL_MAX_AUDIO_MIXING_THREADS 64
+
+typedef struct SDL_AudioMixWorker
+{
+    struct SDL_AudioMixPool *pool;
+    SDL_Thread *thread;
+    Uint8 *work_buffer;  // scratch space for SDL_GetAudioStreamData.
+    float *mix_buffer;   // this worker's partial mix, summed into the final mix by the device thread.
+    bool mixed;          // true if mix_buffer holds data for the current job.
+} SDL_AudioMixWorker;
+
+typedef struct SDL_AudioMixPool
+{
+    SDL_AudioMixWorker *workers;
+    int num_workers;
+    int buffer_size;  // size of each worker's work_buffer and mix_buffer, in bytes.
+    SDL_Semaphore *start_sem;
+    SDL_Semaphore *done_sem;
+    SDL_AtomicInt shutdown;
+
+    // The current job. Only changed by the device thread while the workers are idle.
+    SDL_AudioStream **streams;
+    int num_streams;
+    int streams_allocation;
+    int job_size;
+    float gain;
+    SDL_AtomicInt next_stream;
+    SDL_AtomicInt failed;
+} SDL_AudioMixPool;
+
+// Pull streams off the current job until there are none left, mixing them into `mix_buffer`.
+static void MixPoolStreams(SDL_AudioMixPool *pool, Uint8 *work_buffer, float *mix_buffer, bool *mixed)
+{
+    int i;
+    while ((i = SDL_AddAtomicInt(&pool->next_stream, 1)) < pool->num_streams) {
+        const int br = SDL_GetAudioStreamDataAdjustGain(pool->streams[i], work_buffer, pool->job_size, pool->gain);
+        if (br < 0) {  // Probably OOM. The device thread will notice and kill the device.
+            SDL_SetAtomicInt(&pool->failed, 1);
+        } else if (br > 0) {
+            if (*mixed) {
+                MixFloat32Audio(mix_buffer, (float *) work_buffer, br);
+            } else {  // first data this job, just copy it over instead of mixing into silence.
+                SDL_memcpy(mix_buffer, work_buffer, br);
+                if (br < pool->job_size) {
+                    SDL_memset(((Uint8 *) mix_buffer) + br, '\0', pool->job_size - br);
+                }
+                *mixed = true;
+            }
+        }
+    }
+}
+
+static int SDLCALL AudioMixWorkerThread(void *data)  // thread entry point
+{
+    SDL_AudioMixWorker *worker = (SDL_AudioMixWorker *) data;
+    SDL_AudioMixPool *pool = worker->pool;
+
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_TIME_CRITICAL);
+
+    while (true) {
+        SDL_WaitSemaphore(pool->start_sem);
+        if (SDL_GetAtomicInt(&pool->shutdown)) {
+            break;
+        }
+        MixPoolStreams(pool, worker->work_buffer, worker->mix_buffer, &worker->mixed);
+        SDL_SignalSemaphore(pool->done_sem);
+    }
+
+    return 0;
+}
+
+static void DestroyAudioMixPool(SDL_AudioMixPool *pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    SDL_SetAtomicInt(&pool->shutdown, 1);
+    for (int i = 0; i < pool->num_workers; i++) {
+        if (pool->workers[i].thread) {
+            SDL_SignalSemaphore(pool->start_sem);
+        }
+    }
+
+    for (int i = 0; i < pool->num_workers; i++) {
+        SDL_AudioMixWorker *worker = &pool->workers[i];
+        if (worker->thread) {
+            SDL_WaitThread(worker->thread, NULL);
+        }
+        SDL_aligned_free(worker->work_buffer);
+        SDL_aligned_free(worker->mix_buffer);
+    }
+
+    SDL_DestroySemaphore(pool->start_sem);
+    SDL_DestroySemaphore(pool->done_sem);
+    SDL_free(pool->workers);
+    SDL_free(pool->streams);
+    SDL_free(pool);
+}
+
+static bool ResizeAudioMixPoolBuffers(SDL_AudioMixPool *pool, int buffer_size)
+{
+    for (int i = 0; i < pool->num_workers; i++) {
+        SDL_AudioMixWorker *worker = &pool->workers[i];
+        SDL_aligned_free(worker->work_buffer);
+        SDL_aligned_free(worker->mix_buffer);
+        worker->work_buffer = (Uint8 *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), buffer_size);
+        worker->mix_buffer = (float *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), buffer_size);
+        if (!worker->work_buffer || !worker->mix_buffer) {
+            pool->buffer_size = 0;
+            return false;
+        }
+    }
+    pool->buffer_size = buffer_size;
+    return true;
+}
+
+static SDL_AudioMixPool *CreateAudioMixPool(SDL_AudioDevice *device, int num_workers)
+{
+    SDL_AudioMixPool *pool = (SDL_AudioMixPool *)SDL_calloc(1, sizeof (*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->workers = (SDL_AudioMixWorker *)SDL_calloc(num_workers, sizeof (*pool->workers));
+    pool->start_sem = SDL_CreateSemaphore(0);
+    pool->done_sem = SDL_CreateSemaphore(0);
+    if (!pool->workers || !pool->start_sem || !pool->done_sem) {
+        DestroyAudioMixPool(pool);
+        return NULL;
+    }
+
+    pool->num_workers = num_workers;
+    if (!ResizeAudioMixPoolBuffers(pool, device->work_buffer_size)) {
+        DestroyAudioMixPool(pool);
+        return NULL;
+    }
+
+    char threadname[64];
+    SDL_GetAudioThreadName(device, threadname, sizeof (threadname));
+    const size_t namelen = SDL_strlen(threadname);
+    for (int i = 0; i < num_workers; i++) {
+        SDL_AudioMixWorker *worker = &pool->workers[i];
+        worker->pool = pool;
+        SDL_snprintf(threadname + namelen, sizeof (threadname) - namelen, "-mix%d", i);
+        worker->thread = SDL_CreateThread(AudioMixWorkerThread, threadname, worker);
+        if (!worker->thread) {
+            DestroyAudioMixPool(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+// Convert and mix all of `logdev`'s bound streams into `mix_buffer`, spread across the pool and the calling thread. Returns false on failure.
+static bool MixLogicalAudioDeviceParallel(SDL_AudioDevice *device, SDL_AudioMixPool *pool, SDL_LogicalAudioDevice *logdev, float *mix_buffer, int work_buffer_size)
+{
+    if (pool->buffer_size < work_buffer_size) {  // device format changed since we last ran? Workers are idle, so this is safe.
+        if (!ResizeAudioMixPoolBuffers(pool, work_buffer_size)) {
+            return false;
+        }
+    }
+
+    SDL_AudioSpec outspec;
+    SDL_copyp(&outspec, &device->spec);
+    outspec.format = SDL_AUDIO_F32;
+
+    int num_streams = 0;
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+        // We should have updated this elsewhere if the format changed!
+        SDL_assert(SDL_AudioSpecsEqual(&stream->dst_spec, &outspec, stream->dst_chmap, device->chmap));
+
+        if (num_streams >= pool->streams_allocation) {
+            const int newalloc = SDL_max(32, pool->streams_allocation * 2);
+            SDL_AudioStream **ptr = (SDL_AudioStream **)SDL_realloc(pool->streams, newalloc * sizeof (*ptr));
+            if (!ptr) {
+                return false;
+            }
+            pool->streams = ptr;
+            pool->streams_allocation = newalloc;
+        }
+        pool->streams[num_streams++] = stream;
+    }
+
+    pool->num_streams = num_streams;
+    pool->job_size = work_buffer_size;
+    pool->gain = logdev->gain;
+    SDL_SetAtomicInt(&pool->failed, 0);
+    SDL_SetAtomicInt(&pool->next_stream, 0);
+
+    // don't wake more workers than there is work for; the device thread takes a share, too.
+    const int num_workers = SDL_min(pool->num_workers, num_streams - 1);
+    for (int i = 0; i < num_workers; i++) {
+        pool->workers[i].mixed = false;
+        SDL_SignalSemaphore(pool->start_sem);
+    }
+
+    bool mixed = true;  // the device thread mixes straight into the destination.
+    MixPoolStreams(pool, device->work_buffer, mix_buffer, &mixed);
+
+    for (int i = 0; i < num_workers; i++) {
+        SDL_WaitSemaphore(pool->done_sem);
+    }
+
+    // final reduction of everyone's partial mixes.
+    for (int i = 0; i < num_workers; i++) {
+        SDL_AudioMixWorker *worker = &pool->workers[i];
+        if (worker->mixed) {
+            MixFloat32Audio(mix_buffer, worker->mix_buffer, work_buffer_size);
+        }
+    }
+
+    return !SDL_GetAtomicInt(&pool->failed);
+}
+
+static int GetAudioMixingThreadCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DEVICE_MIXING_THREADS);
+    if (hint) {
+        const int val = SDL_atoi(hint);
+        if (val > 0) {
+            return SDL_min(val, SDL_MAX_AUDIO_MIXING_THREADS);
+        }
+    }
+    return 0;
+}
+
+
+// this expects the device lock to be held.
+static void ResetAudioDeviceStats(SDL_AudioDevice *device)
+{
+    device->last_iterate_ns = 0;
+    device->stats_periods = 0;
+    device->stats_late_wakeups = 0;
+    device->stats_max_interval_ns = 0;
+    device->stats_process_ns = 0;
+    device->stats_max_process_ns = 0;
+}
+
+// Keep the counters for SDL_GetAudioDeviceProperties. Call with the device lock held, at the start of an iteration.
+static Uint64 BeginAudioDeviceIterationStats(SDL_AudioDevice *device)
+{
+    const Uint64 now = SDL_GetTicksNS();
+
+    if (device->last_iterate_ns && (device->spec.freq > 0)) {
+        // the device wants a buffer every period; noticeably longer than that between iterations means we're eating into what's queued in the hardware.
+        const Uint64 period_ns = ((Uint64) device->sample_frames * SDL_NS_PER_SECOND) / device->spec.freq;
+        const Uint64 interval_ns = now - device->last_iterate_ns;
+        if (interval_ns > (period_ns + (period_ns / 2))) {
+            device->stats_late_wakeups++;
+        }
+        device->stats_max_interval_ns = SDL_max(device->stats_max_interval_ns, interval_ns);
+    }
+
+    device->last_iterate_ns = now;
+    device->stats_periods++;
+    return now;
+}
+
+static void EndAudioDeviceIterationStats(SDL_AudioDevice *device, Uint64 start)
+{
+    const Uint64 elapsed = SDL_GetTicksNS() - start;
+    device->stats_process_ns += elapsed;
+    device->stats_max_process_ns = SDL_max(device->stats_max_process_ns, elapsed);
+}
+
 
 // Playback device thread. This is split into chunks, so backends that need to control this directly can use the pieces they need without duplicating effort.
 
@@ -1099,6 +1369,7 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         return false;  // we're done, shut it down.
     }
 
+    const Uint64 start = BeginAudioDeviceIterationStats(device);
     bool failed = false;
     int buffer_size = device->buffer_size;
     Uint8 *device_buffer = device->GetDeviceBuf(device, &buffer_size);
@@ -1150,20 +1421,26 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
                     SDL_memset(mix_buffer, '\0', work_buffer_size);  // start with silence.
                 }
 
-                for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
-                    // We should have updated this elsewhere if the format changed!
-                    SDL_assert(SDL_AudioSpecsEqual(&stream->dst_spec, &outspec, stream->dst_chmap, device->chmap));
-
-                    /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
-                       for iterating here because the binding linked list can only change while the device lock is held.
-                       (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
-                       the same stream to different devices at the same time, though.) */
-                    const int br = SDL_GetAudioStreamDataAdjustGain(stream, device->work_buffer, work_buffer_size, logdev->gain);
-                    if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
-                        failed = true;
-                        break;
-                    } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
-                        MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
+                if (device->mix_pool && logdev->bound_streams && logdev->bound_streams->next_binding) {
+                    if (!MixLogicalAudioDeviceParallel(device, device->mix_pool, logdev, mix_buffer, work_buffer_size)) {
+                        failed = true;  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
+                    }
+                } else {
+                    for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+                        // We should have updated this elsewhere if the format changed!
+                        SDL_assert(SDL_AudioSpecsEqual(&stream->dst_spec, &outspec, stream->dst_chmap, device->chmap));
+
+                        /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
+                           for iterating here because the binding linked list can only change while the device lock is held.
+                           (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
+                           the same stream to different devices at the same time, though.) */
+                        const int br = SDL_GetAudioStreamDataAdjustGain(stream, device->work_buffer, work_buffer_size, logdev->gain);
+                        if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
+                            failed = true;
+                            break;
+                        } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
+                            MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
+                        }
                     }
                 }
 
@@ -1188,6 +1465,8 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         }
     }
 
+    EndAudioDeviceIterationStats(device, start);
+
     SDL_UnlockMutex(device->lock);
 
     if (failed) {
@@ -1247,6 +1526,7 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
         return false;  // we're done, shut it down.
     }
 
+    const Uint64 start = BeginAudioDeviceIterationStats(device);
     bool failed = false;
 
     if (!device->logical_devices) {
@@ -1299,6 +1579,8 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
         }
     }
 
+    EndAudioDeviceIterationStats(device, start);
+
     SDL_UnlockMutex(device->lock);
 
     if (failed) {
@@ -1463,6 +1745,29 @@ bool SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devid, SDL_AudioSpec *spec, int
     return result;
 }
 
+SDL_PropertiesID SDL_GetAudioDeviceProperties(SDL_AudioDeviceID devid)
+{
+    SDL_PropertiesID result = 0;
+    SDL_AudioDevice *device = ObtainPhysicalAudioDeviceDefaultAllowed(devid);
+    if (device) {
+        if (device->props == 0) {
+            device->props = SDL_CreateProperties();
+        }
+        result = device->props;
+        if (result) {
+            // the device thread only touches these while holding the lock we have now, so this is a consistent snapshot.
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_STATS_PERIODS_NUMBER, (Sint64) device->stats_periods);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_STATS_LATE_WAKEUPS_NUMBER, (Sint64) device->stats_late_wakeups);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_STATS_MAX_INTERVAL_NS_NUMBER, (Sint64) device->stats_max_interval_ns);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_STATS_PROCESS_NS_NUMBER, (Sint64) device->stats_process_ns);
+            SDL_SetNumberProperty(result, SDL_PROP_AUDIODEVICE_STATS_MAX_PROCESS_NS_NUMBER, (Sint64) device->stats_max_process_ns);
+        }
+    }
+    ReleaseAudioDevice(device);
+
+    return result;
+}
+
 int *SDL_GetAudioDeviceChannelMap(SDL_AudioDeviceID devid, int *count)
 {
     int *result = NULL;
@@ -1516,6 +1821,9 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
         device->hidden = NULL;  // just in case.
     }
 
+    DestroyAudioMixPool(device->mix_pool);  // nothing is iterating the device now, so the helper threads are idle.
+    device->mix_pool = NULL;
+
     SDL_LockMutex(device->lock);
     SDL_SetAtomicInt(&device->shutdown, 0);  // ready to go again.
     SDL_BroadcastCondition(device->close_cond);  // release anyone waiting in SerializePhysicalDeviceClose; they'll still block until we release device->lock, though.
@@ -1529,6 +1837,8 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
     SDL_aligned_free(device->postmix_buffer);
     device->postmix_buffer = NULL;
 
+    ResetAudioDeviceStats(device);
+
     SDL_copyp(&device->spec, &device->default_spec);
     device->sample_frames = 0;
     device->silence_value = SDL_GetSilenceValueForFormat(device->spec.format);
@@ -1656,6 +1966,8 @@ static bool OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
     device->sample_frames = GetDefaultSampleFramesFromFreq(device->spec.freq);
     SDL_UpdatedAudioDeviceFormat(device);  // start this off sane.
 
+    ResetAudioDeviceStats(device);  // SDL_GetAudioDeviceProperties reports on the current opening only.
+
     device->currently_opened = true;  // mark this true even if impl.OpenDevice fails, so we know to clean up.
     if (!current_audio.impl.OpenDevice(device)) {
         ClosePhysicalAudioDevice(device);  // clean up anything the backend left half-initialized.
@@ -1679,6 +1991,14 @@ static bool OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
         }
     }
 
+    // Spin up helper threads for mixing, if requested. If this fails, we just mix everything on the device thread like usual.
+    if (!device->recording) {
+        const int num_mix_threads = GetAudioMixingThreadCount();
+        if (num_mix_threads > 0) {
+            device->mix_pool = CreateAudioMixPool(device, num_mix_threads);
+        }
+    }
+
     // Start the audio thread if necessary
     if (!current_audio.impl.ProvidesOwnCallbackThread) {
         char threadname[64];
@@ -1816,6 +2136,7 @@ bool SDL_SetAudioDeviceGain(SDL_AudioDeviceID devid, float gain)
                 // SDL_SetAudioStreamFormat does a ton of validation just to memcpy an audiospec.
                 SDL_LockMutex(stream->lock);
                 stream->src_spec.format = need_float32 ? SDL_AUDIO_F32 : device->spec.format;
+                UpdateAudioStreamRingFormat(stream);
                 SDL_UnlockMutex(stream->lock);
             }
         }
@@ -1851,6 +2172,7 @@ bool SDL_SetAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallba
                     // SDL_SetAudioStreamFormat does a ton of validation just to memcpy an audiospec.
                     SDL_LockMutex(stream->lock);
                     stream->src_spec.format = need_float32 ? SDL_AUDIO_F32 : device->spec.format;
+                    UpdateAudioStreamRingFormat(stream);
                     SDL_UnlockMutex(stream->lock);
                 }
             }
@@ -1940,6 +2262,7 @@ bool SDL_BindAudioStreams(SDL_AudioDeviceID devid, SDL_AudioStream **streams, in
                     if (logdev->postmix) {
                         stream->src_spec.format = SDL_AUDIO_F32;
                     }
+                    UpdateAudioStreamRingFormat(stream);
                     SDL_SetAudioStreamInputChannelMap(stream, device->chmap, device->spec.channels);  // this should be fast for normal cases, though!
                 }
 
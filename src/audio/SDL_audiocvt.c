@@ -29,6 +29,9 @@
 #define SDL_INT_MAX ((int)(~0u>>1))
 #endif
 
+// Resampled data that still needs converting is processed this many sample frames at a time, so it stays in the cache.
+#define AUDIOSTREAM_BLOCK_FRAMES 256
+
 #ifdef SDL_SSE3_INTRINSICS
 // Convert from stereo to mono. Average left and right.
 static void SDL_TARGETING("sse3") SDL_ConvertStereoToMono_SSE3(float *dst, const float *src, int num_frames)
@@ -289,7 +292,7 @@ void ConvertAudio(int num_frames,
 
     // Gain adjustment
     if (gain != 1.0f) {
-        float *buf = (float *)(dstconvert ? scratch : dst);
+        float *buf = (float *)((dstconvert || channelconvert) ? scratch : dst);  // dst might not fit src_channels worth of floats.
         const int total_samples = num_frames * src_channels;
         if (src == buf) {
             for (int i = 0; i < total_samples; i++) {
@@ -400,8 +403,204 @@ static bool UpdateAudioStreamInputSpec(SDL_AudioStream *stream, const SDL_AudioS
     return true;
 }
 
+// Lock-free streams put data into a ring buffer instead of the audio queue, so a producer thread
+// never has to wait on stream->lock while the consumer holds it. Whoever holds stream->lock next moves
+// the data from the ring into the queue (see DrainAudioStreamRing), so everything after that works
+// like any other stream.
+//
+// `state` counts the producers currently writing to the ring. AUDIOSTREAM_RING_DISABLED is set in it
+// while the ring's format is changing, which sends producers down the locked path until it's done.
+#define AUDIOSTREAM_RING_DISABLED 0x40000000
+#define AUDIOSTREAM_RING_DEFAULT_SIZE (64 * 1024)
+
+typedef struct SDL_AudioStreamRing
+{
+    Uint8 *data;
+    int capacity;  // one byte is always left unused, so a full ring doesn't look like an empty one.
+    SDL_AtomicInt head;  // where the producer writes next.
+    SDL_AtomicInt tail;  // where the next drain reads from.
+    SDL_AtomicInt state;
+    SDL_AudioSpec spec;  // the format of everything in the ring.
+    int *chmap;
+    int chmap_storage[SDL_MAX_CHANNELMAP_CHANNELS];
+} SDL_AudioStreamRing;
+
+// This doesn't touch stream->lock, and is the only thing that ever moves ring->head.
+// Returns false if the data has to go through the locked path instead.
+static bool PutAudioStreamRing(SDL_AudioStream *stream, const void *buf, int len)
+{
+    SDL_AudioStreamRing *ring = stream->ring;
+    bool result = false;
+
+    if ((SDL_AddAtomicInt(&ring->state, 1) & AUDIOSTREAM_RING_DISABLED) == 0) {
+        // partial frames and missing formats go through the locked path, which reports the error.
+        if ((ring->spec.format != 0) && ((len % SDL_AUDIO_FRAMESIZE(ring->spec)) == 0)) {
+            const int head = SDL_GetAtomicInt(&ring->head);
+            const int tail = SDL_GetAtomicInt(&ring->tail);
+            const int used = (head >= tail) ? (head - tail) : ((ring->capacity - tail) + head);
+
+            if (len < (ring->capacity - used)) {
+                const int cpy = SDL_min(len, ring->capacity - head);
+                SDL_memcpy(ring->data + head, buf, cpy);
+                SDL_memcpy(ring->data, ((const Uint8 *)buf) + cpy, len - cpy);
+                SDL_MemoryBarrierRelease();
+                SDL_SetAtomicInt(&ring->head, (head + len) % ring->capacity);
+                result = true;
+            }
+        }
+    }
+
+    SDL_AddAtomicInt(&ring->state, -1);
+    return result;
+}
+
+// You must hold stream->lock before calling this!
+static bool DrainAudioStreamRing(SDL_AudioStream *stream)
+{
+    SDL_AudioStreamRing *ring = stream->ring;
+    if (!ring) {
+        return true;
+    }
+
+    const int head = SDL_GetAtomicInt(&ring->head);
+    SDL_MemoryBarrierAcquire();
+    int tail = SDL_GetAtomicInt(&ring->tail);
+
+    if (head < tail) {  // wrapped around the end of the ring.
+        if (!SDL_WriteToAudioQueue(stream->queue, &ring->spec, ring->chmap, ring->data + tail, ring->capacity - tail)) {
+            return false;
+        }
+        tail = 0;
+        SDL_MemoryBarrierRelease();
+        SDL_SetAtomicInt(&ring->tail, tail);
+    }
+
+    if (head > tail) {
+        if (!SDL_WriteToAudioQueue(stream->queue, &ring->spec, ring->chmap, ring->data + tail, head - tail)) {
+            return false;
+        }
+        SDL_MemoryBarrierRelease();
+        SDL_SetAtomicInt(&ring->tail, head);
+    }
+
+    return true;
+}
+
+// The number of bytes producers have put in the ring that haven't been drained into the queue yet.
+static size_t GetAudioStreamRingQueued(SDL_AudioStream *stream)
+{
+    SDL_AudioStreamRing *ring = stream->ring;
+    if (!ring) {
+        return 0;
+    }
+
+    const int head = SDL_GetAtomicInt(&ring->head);
+    const int tail = SDL_GetAtomicInt(&ring->tail);
+    return (size_t) ((head >= tail) ? (head - tail) : ((ring->capacity - tail) + head));
+}
+
+void UpdateAudioStreamRingFormat(SDL_AudioStream *stream)
+{
+    SDL_AudioStreamRing *ring = stream->ring;
+    if (!ring) {
+        return;
+    }
+
+    // Keep new producers out, and wait for any that are part way through a write to finish.
+    int state;
+    do {
+        state = SDL_GetAtomicInt(&ring->state);
+    } while (!SDL_CompareAndSwapAtomicInt(&ring->state, state, state | AUDIOSTREAM_RING_DISABLED));
+
+    while (SDL_GetAtomicInt(&ring->state) != AUDIOSTREAM_RING_DISABLED) {
+        SDL_CPUPauseInstruction();
+    }
+
+    // Everything already in the ring gets queued with the old format. If that fails, the data is
+    // dropped instead of being played back as the new format.
+    if (!DrainAudioStreamRing(stream)) {
+        SDL_SetAtomicInt(&ring->tail, SDL_GetAtomicInt(&ring->head));
+    }
+
+    SDL_copyp(&ring->spec, &stream->src_spec);
+    if (!stream->src_chmap) {
+        ring->chmap = NULL;
+    } else {
+        ring->chmap = ring->chmap_storage;
+        SDL_memcpy(ring->chmap, stream->src_chmap, sizeof (*ring->chmap) * stream->src_spec.channels);
+    }
+
+    SDL_AddAtomicInt(&ring->state, -AUDIOSTREAM_RING_DISABLED);
+}
+
+static SDL_AudioStreamRing *CreateAudioStreamRing(int capacity)
+{
+    SDL_AudioStreamRing *ring = (SDL_AudioStreamRing *)SDL_calloc(1, sizeof(SDL_AudioStreamRing));
+    if (!ring) {
+        return NULL;
+    }
+
+    ring->data = (Uint8 *)SDL_malloc(capacity);
+    if (!ring->data) {
+        SDL_free(ring);
+        return NULL;
+    }
+    ring->capacity = capacity;
+
+    return ring;
+}
+
+static void DestroyAudioStreamRing(SDL_AudioStreamRing *ring)
+{
+    if (ring) {
+        SDL_free(ring->data);
+        SDL_free(ring);
+    }
+}
+
+// The queue allocates memory in chunks of this size. By default, a stream keeps a few unused ones around.
+#define AUDIOSTREAM_QUEUE_CHUNK_SIZE 8192
+#define AUDIOSTREAM_QUEUE_DEFAULT_MAX_IDLE (4 * AUDIOSTREAM_QUEUE_CHUNK_SIZE)
+
+// Queue memory beyond what was preallocated is freed once it has gone unused for this long.
+#define AUDIOSTREAM_QUEUE_TRIM_INTERVAL_NS SDL_NS_PER_SECOND
+
+// Call with the stream lock held.
+static void TrimAudioStreamQueue(SDL_AudioStream *stream)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    if ((now - stream->last_trim_ns) >= AUDIOSTREAM_QUEUE_TRIM_INTERVAL_NS) {
+        SDL_TrimAudioQueue(stream->queue);
+        stream->last_trim_ns = now;
+    }
+}
+
 SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec)
 {
+    return SDL_CreateAudioStreamWithProperties(src_spec, dst_spec, 0);
+}
+
+SDL_AudioStream *SDL_CreateAudioStreamWithProperties(const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec, SDL_PropertiesID props)
+{
+    const bool lockfree = SDL_GetBooleanProperty(props, SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BOOLEAN, false);
+    const Sint64 ring_size = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BUFFER_SIZE_NUMBER, AUDIOSTREAM_RING_DEFAULT_SIZE);
+
+    if (lockfree && ((ring_size <= 0) || (ring_size > SDL_INT_MAX))) {
+        SDL_InvalidParamError(SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BUFFER_SIZE_NUMBER);
+        return NULL;
+    }
+
+    const Sint64 prealloc = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_CREATE_PREALLOCATE_NUMBER, 0);
+    const Sint64 max_idle = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_CREATE_MAX_IDLE_NUMBER, AUDIOSTREAM_QUEUE_DEFAULT_MAX_IDLE);
+
+    if ((prealloc < 0) || ((Uint64) prealloc > SDL_SIZE_MAX)) {
+        SDL_InvalidParamError(SDL_PROP_AUDIOSTREAM_CREATE_PREALLOCATE_NUMBER);
+        return NULL;
+    } else if ((max_idle < 0) || ((Uint64) max_idle > SDL_SIZE_MAX)) {
+        SDL_InvalidParamError(SDL_PROP_AUDIOSTREAM_CREATE_MAX_IDLE_NUMBER);
+        return NULL;
+    }
+
     SDL_ChooseAudioConverters();
     SDL_SetupAudioResampler();
 
@@ -412,13 +611,21 @@ SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_
 
     result->freq_ratio = 1.0f;
     result->gain = 1.0f;
-    result->queue = SDL_CreateAudioQueue(8192);
+    result->queue = SDL_CreateAudioQueue(AUDIOSTREAM_QUEUE_CHUNK_SIZE);
 
     if (!result->queue) {
         SDL_free(result);
         return NULL;
     }
 
+    if (!SDL_SetAudioQueueMemoryBudget(result->queue, (size_t) prealloc, (size_t) max_idle)) {
+        SDL_DestroyAudioQueue(result->queue);
+        SDL_free(result);
+        return NULL;
+    }
+    result->queue_preallocated = (prealloc > 0);
+    result->last_trim_ns = SDL_GetTicksNS();
+
     result->lock = SDL_CreateMutex();
     if (!result->lock) {
         SDL_free(result->queue);
@@ -426,6 +633,16 @@ SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_
         return NULL;
     }
 
+    if (lockfree) {
+        result->ring = CreateAudioStreamRing((int)ring_size);
+        if (!result->ring) {
+            SDL_DestroyMutex(result->lock);
+            SDL_DestroyAudioQueue(result->queue);
+            SDL_free(result);
+            return NULL;
+        }
+    }
+
     OnAudioStreamCreated(result);
 
     if (!SDL_SetAudioStreamFormat(result, src_spec, dst_spec)) {
@@ -442,10 +659,35 @@ SDL_PropertiesID SDL_GetAudioStreamProperties(SDL_AudioStream *stream)
         SDL_InvalidParamError("stream");
         return 0;
     }
+
+    SDL_LockMutex(stream->lock);
+
     if (stream->props == 0) {
         stream->props = SDL_CreateProperties();
     }
-    return stream->props;
+
+    const SDL_PropertiesID props = stream->props;
+    if (props) {
+        // just a snapshot; anything a lock-free stream has in its ring buffer stays there until the next put or get.
+        const Uint64 queued = (Uint64) SDL_GetAudioQueueQueued(stream->queue) + GetAudioStreamRingQueued(stream);
+        const Uint64 high_water = SDL_max(stream->stats_queued_high_water, queued);
+
+        SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_CONVERT_NS_NUMBER, (Sint64) stream->stats_convert_ns);
+        SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_FRAMES_CONVERTED_NUMBER, (Sint64) stream->stats_frames_converted);
+        SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUED_NUMBER, (Sint64) SDL_min(queued, SDL_MAX_SINT64));
+        SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUED_HIGH_WATER_NUMBER, (Sint64) SDL_min(high_water, SDL_MAX_SINT64));
+        SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_WORK_BUFFER_REALLOCS_NUMBER, (Sint64) stream->stats_work_buffer_reallocs);
+
+        size_t resident = 0, idle = 0, allocations = 0;
+        SDL_GetAudioQueueMemoryStats(stream->queue, &resident, &idle, &allocations);
+        SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_MEMORY_NUMBER, (Sint64) resident);
+        SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_IDLE_MEMORY_NUMBER, (Sint64) idle);
+        SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_ALLOCATIONS_NUMBER, (Sint64) allocations);
+    }
+
+    SDL_UnlockMutex(stream->lock);
+
+    return props;
 }
 
 bool SDL_SetAudioStreamGetCallback(SDL_AudioStream *stream, SDL_AudioStreamCallback callback, void *userdata)
@@ -569,6 +811,7 @@ bool SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_
             stream->src_chmap = NULL;
         }
         SDL_copyp(&stream->src_spec, src_spec);
+        UpdateAudioStreamRingFormat(stream);
     }
 
     if (dst_spec) {
@@ -620,6 +863,10 @@ bool SetAudioStreamChannelMap(SDL_AudioStream *stream, const SDL_AudioSpec *spec
             SDL_free(*stream_chmap);
             *stream_chmap = NULL;
         }
+
+        if (stream_chmap == &stream->src_chmap) {
+            UpdateAudioStreamRingFormat(stream);
+        }
     }
 
     SDL_UnlockMutex(stream->lock);
@@ -749,7 +996,7 @@ static bool CheckAudioStreamIsFullySetup(SDL_AudioStream *stream)
     return true;
 }
 
-static bool PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int len, SDL_ReleaseAudioBufferCallback callback, void* userdata)
+static bool PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int len, SDL_AudioStreamDataCompleteCallback callback, void* userdata)
 {
 #if DEBUG_AUDIOSTREAM
     SDL_Log("AUDIOSTREAM: wants to put %d bytes", len);
@@ -767,6 +1014,12 @@ static bool PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int l
         return SDL_SetError("Can't add partial sample frames");
     }
 
+    // anything a lock-free stream already has in its ring buffer goes first.
+    if (!DrainAudioStreamRing(stream)) {
+        SDL_UnlockMutex(stream->lock);
+        return false;
+    }
+
     SDL_AudioTrack* track = NULL;
 
     if (callback) {
@@ -793,6 +1046,7 @@ static bool PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int l
             const int newavail = SDL_GetAudioStreamAvailable(stream) - prev_available;
             stream->put_callback(stream->put_callback_userdata, stream, newavail, newavail);
         }
+        TrimAudioStreamQueue(stream);  // the producer can afford to free memory; the device thread shouldn't have to.
     }
 
     SDL_UnlockMutex(stream->lock);
@@ -817,11 +1071,18 @@ bool SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
         return true; // nothing to do.
     }
 
+    // Lock-free streams skip the lock entirely when the data fits in the ring buffer. Put callbacks
+    // need to know how much data is available, which needs the lock anyhow.
+    if (stream->ring && !stream->put_callback && PutAudioStreamRing(stream, buf, len)) {
+        return true;
+    }
+
     // When copying in large amounts of data, try and do as much work as possible
     // outside of the stream lock, otherwise the output device is likely to be starved.
     const int large_input_thresh = 64 * 1024;
 
-    if (len >= large_input_thresh) {
+    // Streams with preallocated queue memory want to use it instead of going to the allocator, though.
+    if ((len >= large_input_thresh) && !stream->queue_preallocated) {
         void *data = SDL_malloc(len);
 
         if (!data) {
@@ -841,6 +1102,29 @@ bool SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
     return PutAudioStreamBuffer(stream, buf, len, NULL, NULL);
 }
 
+static void SDLCALL DontFreeThisAudioBuffer(void *userdata, const void *buf, int len)
+{
+    // We don't own the buffer, but know it will outlive the stream
+}
+
+bool SDL_PutAudioStreamDataNoCopy(SDL_AudioStream *stream, const void *buf, int len, SDL_AudioStreamDataCompleteCallback callback, void *userdata)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    } else if (len == 0) {
+        if (callback) {
+            callback(userdata, buf, len);  // nothing to do, so we're already done with it.
+        }
+        return true;
+    }
+
+    return PutAudioStreamBuffer(stream, buf, len, callback ? callback : DontFreeThisAudioBuffer, userdata);
+}
+
 bool SDL_FlushAudioStream(SDL_AudioStream *stream)
 {
     if (!stream) {
@@ -848,10 +1132,11 @@ bool SDL_FlushAudioStream(SDL_AudioStream *stream)
     }
 
     SDL_LockMutex(stream->lock);
+    const bool result = DrainAudioStreamRing(stream);
     SDL_FlushAudioQueue(stream->queue);
     SDL_UnlockMutex(stream->lock);
 
-    return true;
+    return result;
 }
 
 /* this does not save the previous contents of stream->work_buffer. It's a work buffer!!
@@ -870,6 +1155,7 @@ static Uint8 *EnsureAudioStreamWorkBufferSize(SDL_AudioStream *stream, size_t ne
     SDL_aligned_free(stream->work_buffer);
     stream->work_buffer = ptr;
     stream->work_buffer_allocation = newlen;
+    stream->stats_work_buffer_reallocs++;
     return ptr;
 }
 
@@ -993,8 +1279,8 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
     if (resample_rate == 0) {
         Uint8* work_buffer = NULL;
 
-        // Ensure we have enough scratch space for any conversions
-        if ((src_format != dst_format) || (src_channels != dst_channels)) {
+        // Ensure we have enough scratch space for any conversions (gain adjustment goes through float, too, which might not fit in `buf`)
+        if ((src_format != dst_format) || (src_channels != dst_channels) || (gain != 1.0f)) {
             work_buffer = EnsureAudioStreamWorkBufferSize(stream, output_frames * max_frame_size);
 
             if (!work_buffer) {
@@ -1029,36 +1315,39 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
     // The size of the frame used when resampling
     const int resample_frame_size = SDL_AUDIO_BYTESIZE(resample_format) * resample_channels;
 
-    // The main portion of the work_buffer can be used to store 3 things:
-    // src_sample_frame_size * (left_padding+input_buffer+right_padding)
+    // adjust gain either before resampling or after, depending on which point has less
+    // samples to process.
+    const float preresample_gain = (input_frames > output_frames) ? 1.0f : gain;
+    const float postresample_gain = (input_frames > output_frames) ? gain : 1.0f;
+
+    // Check if we can resample directly into the output buffer, with nothing left to do afterwards.
+    // Some other formats may fit directly into the output buffer, but i'd rather process data in a SIMD-aligned buffer.
+    const bool resample_to_output = (dst_format == resample_format) && (dst_channels == resample_channels) && !dst_map && (postresample_gain == 1.0f);
+
+    // The main portion of the work_buffer holds the input, converted to the resample format:
     //   resample_frame_size * (left_padding+input_buffer+right_padding)
-    // dst_sample_frame_size * output_frames
+    // (SDL_ReadFromAudioQueue needs max_frame_size per frame as scratch space while it gets there.)
     //
-    // ResampleAudio also requires an additional buffer if it can't write straight to the output:
-    //   resample_frame_size * output_frames
-    //
-    // Note, ConvertAudio requires (num_frames * max_sample_frame_size) of scratch space
+    // If the resampled output needs any more work, that's done a block at a time, which needs two more SIMD-aligned areas:
+    //   resample_frame_size * AUDIOSTREAM_BLOCK_FRAMES for the resampled block
+    //   max_frame_size * AUDIOSTREAM_BLOCK_FRAMES as ConvertAudio scratch space
     const int work_buffer_frames = input_frames + (padding_frames * 2);
     int work_buffer_capacity = work_buffer_frames * max_frame_size;
-    int resample_buffer_offset = -1;
+    int resample_block_offset = -1;
+    int convert_block_offset = -1;
 
-    // Check if we can resample directly into the output buffer.
-    // Note, this is just to avoid extra copies.
-    // Some other formats may fit directly into the output buffer, but i'd rather process data in a SIMD-aligned buffer.
-    if ((dst_format != resample_format) || (dst_channels != resample_channels)) {
-        // Allocate space for converting the resampled output to the destination format
-        int resample_convert_bytes = output_frames * max_frame_size;
-        work_buffer_capacity = SDL_max(work_buffer_capacity, resample_convert_bytes);
+    if (!resample_to_output) {
+        const int simd_alignment = (int) SDL_GetSIMDAlignment();
 
-        // SIMD-align the buffer
-        int simd_alignment = (int) SDL_GetSIMDAlignment();
         work_buffer_capacity += simd_alignment - 1;
         work_buffer_capacity -= work_buffer_capacity % simd_alignment;
+        resample_block_offset = work_buffer_capacity;
+        work_buffer_capacity += AUDIOSTREAM_BLOCK_FRAMES * resample_frame_size;
 
-        // Allocate space for the resampled output
-        int resample_bytes = output_frames * resample_frame_size;
-        resample_buffer_offset = work_buffer_capacity;
-        work_buffer_capacity += resample_bytes;
+        work_buffer_capacity += simd_alignment - 1;
+        work_buffer_capacity -= work_buffer_capacity % simd_alignment;
+        convert_block_offset = work_buffer_capacity;
+        work_buffer_capacity += AUDIOSTREAM_BLOCK_FRAMES * max_frame_size;
     }
 
     Uint8* work_buffer = EnsureAudioStreamWorkBufferSize(stream, work_buffer_capacity);
@@ -1067,11 +1356,6 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
         return false;
     }
 
-    // adjust gain either before resampling or after, depending on which point has less
-    // samples to process.
-    const float preresample_gain = (input_frames > output_frames) ? 1.0f : gain;
-    const float postresample_gain = (input_frames > output_frames) ? gain : 1.0f;
-
     // (dst channel map is NULL because we'll do the final swizzle on ConvertAudio after resample.)
     const Uint8* input_buffer = SDL_ReadFromAudioQueue(stream->queue,
         NULL, resample_format, resample_channels, NULL,
@@ -1083,16 +1367,40 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
 
     input_buffer += padding_frames * resample_frame_size;
 
-    // Decide where the resampled output goes
-    void* resample_buffer = (resample_buffer_offset != -1) ? (work_buffer + resample_buffer_offset) : buf;
+    if (resample_to_output) {
+        SDL_ResampleAudio(resample_channels,
+                      (const float *) input_buffer, input_frames,
+                      (float *) buf, output_frames,
+                      resample_rate, &stream->resample_offset);
+        return true;
+    }
+
+    // Resample a block at a time, converting each block to the final format (src channel map is NULL because
+    // SDL_ReadFromAudioQueue already handled this) while it's still in the cache, instead of writing out all
+    // the resampled data and then making another full pass over it.
+    float *resample_block = (float *) (work_buffer + resample_block_offset);
+    Uint8 *convert_block = work_buffer + convert_block_offset;
+    const int dst_frame_size = SDL_AUDIO_FRAMESIZE(*dst_spec);
+    const Sint64 input_offset = (Sint64)input_frames << 32;
+    Sint64 resample_offset = stream->resample_offset;
+    Uint8 *dst = (Uint8 *) buf;
+
+    for (int i = 0; i < output_frames; i += AUDIOSTREAM_BLOCK_FRAMES) {
+        const int block_frames = SDL_min(output_frames - i, AUDIOSTREAM_BLOCK_FRAMES);
+
+        SDL_ResampleAudio(resample_channels,
+                      (const float *) input_buffer, input_frames,
+                      resample_block, block_frames,
+                      resample_rate, &resample_offset);
 
-    SDL_ResampleAudio(resample_channels,
-                  (const float *) input_buffer, input_frames,
-                  (float*) resample_buffer, output_frames,
-                  resample_rate, &stream->resample_offset);
+        // SDL_ResampleAudio leaves the offset relative to the end of the input, but we aren't done with it yet.
+        resample_offset += input_offset;
 
-    // Convert to the final format, if necessary (src channel map is NULL because SDL_ReadFromAudioQueue already handled this).
-    ConvertAudio(output_frames, resample_buffer, resample_format, resample_channels, NULL, buf, dst_format, dst_channels, dst_map, work_buffer, postresample_gain);
+        ConvertAudio(block_frames, resample_block, resample_format, resample_channels, NULL, dst, dst_format, dst_channels, dst_map, convert_block, postresample_gain);
+        dst += block_frames * dst_frame_size;
+    }
+
+    stream->resample_offset = resample_offset - input_offset;
 
     return true;
 }
@@ -1131,6 +1439,9 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
 
     len -= len % dst_frame_size;  // chop off any fractional sample frame.
 
+    // A failed drain leaves the data in the ring buffer for next time; get what's already queued.
+    DrainAudioStreamRing(stream);
+
     // give the callback a chance to fill in more stream data if it wants.
     if (stream->get_callback) {
         Sint64 total_request = len / dst_frame_size;  // start with sample frames desired
@@ -1151,6 +1462,7 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         total_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
         additional_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
         stream->get_callback(stream->get_callback_userdata, stream, (int) SDL_min(additional_request, SDL_INT_MAX), (int) SDL_min(total_request, SDL_INT_MAX));
+        DrainAudioStreamRing(stream);
     }
 
     // Process the data in chunks to avoid allocating too much memory (and potential integer overflows)
@@ -1158,6 +1470,11 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
 
     int total = 0;
 
+    // Once per call is plenty for the stats, and cheap enough to always do.
+    const Uint64 convert_start = SDL_GetTicksNS();
+    const Uint64 queued = (Uint64) SDL_GetAudioQueueQueued(stream->queue);  // the most there will be until more data is put.
+    stream->stats_queued_high_water = SDL_max(stream->stats_queued_high_water, queued);
+
     while (total < len) {
         // Audio is processed a track at a time.
         SDL_AudioSpec input_spec;
@@ -1193,9 +1510,17 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
             break;
         }
 
+        // If that used up the rest of a buffer from SDL_PutAudioStreamDataNoCopy, let the app have it back now.
+        SDL_ReleaseAudioQueueHeadData(stream->queue);
+
         total += output_frames * dst_frame_size;
     }
 
+    stream->stats_convert_ns += SDL_GetTicksNS() - convert_start;
+    if (total > 0) {
+        stream->stats_frames_converted += total / dst_frame_size;
+    }
+
     SDL_UnlockMutex(stream->lock);
 
 #if DEBUG_AUDIOSTREAM
@@ -1225,6 +1550,8 @@ int SDL_GetAudioStreamAvailable(SDL_AudioStream *stream)
         return 0;
     }
 
+    DrainAudioStreamRing(stream);
+
     Sint64 count = GetAudioStreamAvailableFrames(stream, NULL);
 
     // convert from sample frames to bytes in destination format.
@@ -1246,6 +1573,8 @@ int SDL_GetAudioStreamQueued(SDL_AudioStream *stream)
 
     SDL_LockMutex(stream->lock);
 
+    DrainAudioStreamRing(stream);
+
     size_t total = SDL_GetAudioQueueQueued(stream->queue);
 
     SDL_UnlockMutex(stream->lock);
@@ -1262,10 +1591,15 @@ bool SDL_ClearAudioStream(SDL_AudioStream *stream)
 
     SDL_LockMutex(stream->lock);
 
+    if (stream->ring) {
+        SDL_SetAtomicInt(&stream->ring->tail, SDL_GetAtomicInt(&stream->ring->head));
+    }
+
     SDL_ClearAudioQueue(stream->queue);
     SDL_zero(stream->input_spec);
     stream->input_chmap = NULL;
     stream->resample_offset = 0;
+    TrimAudioStreamQueue(stream);
 
     SDL_UnlockMutex(stream->lock);
     return true;
@@ -1292,17 +1626,13 @@ void SDL_DestroyAudioStream(SDL_AudioStream *stream)
     }
 
     SDL_aligned_free(stream->work_buffer);
+    DestroyAudioStreamRing(stream->ring);
     SDL_DestroyAudioQueue(stream->queue);
     SDL_DestroyMutex(stream->lock);
 
     SDL_free(stream);
 }
 
-static void SDLCALL DontFreeThisAudioBuffer(void *userdata, const void *buf, int len)
-{
-    // We don't own the buffer, but know it will outlive the stream
-}
-
 bool SDL_ConvertAudioSamples(const SDL_AudioSpec *src_spec, const Uint8 *src_data, int src_len, const SDL_AudioSpec *dst_spec, Uint8 **dst_data, int *dst_len)
 {
     if (dst_data) {
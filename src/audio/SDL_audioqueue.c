@@ -31,6 +31,10 @@ struct SDL_MemoryPool
     size_t block_size;
     size_t num_free;
     size_t max_free;
+    size_t min_free;        // fewest free blocks since the last trim; that many have sat unused the whole time.
+    size_t num_reserved;    // trimming never takes the pool below this many blocks.
+    size_t num_allocated;   // blocks that currently exist, whether in use or free.
+    size_t num_allocations; // times the pool had to go to the allocator after it was set up.
 };
 
 struct SDL_AudioTrack
@@ -41,7 +45,7 @@ struct SDL_AudioTrack
     SDL_AudioTrack *next;
 
     void *userdata;
-    SDL_ReleaseAudioBufferCallback callback;
+    SDL_AudioStreamDataCompleteCallback callback;
 
     Uint8 *data;
     size_t head;
@@ -74,12 +78,18 @@ static void *AllocNewMemoryPoolBlock(const SDL_MemoryPool *pool)
 static void *AllocMemoryPoolBlock(SDL_MemoryPool *pool)
 {
     if (pool->num_free == 0) {
-        return AllocNewMemoryPoolBlock(pool);
+        void *block = AllocNewMemoryPoolBlock(pool);
+        if (block) {
+            ++pool->num_allocated;
+            ++pool->num_allocations;
+        }
+        return block;
     }
 
     void *block = pool->free_blocks;
     pool->free_blocks = *(void **)block;
     --pool->num_free;
+    pool->min_free = SDL_min(pool->min_free, pool->num_free);
     return block;
 }
 
@@ -92,7 +102,25 @@ static void FreeMemoryPoolBlock(SDL_MemoryPool *pool, void *block)
         ++pool->num_free;
     } else {
         SDL_free(block);
+        --pool->num_allocated;
+    }
+}
+
+// Free the blocks that went unused since the last trim, keeping the reserved ones
+static void TrimMemoryPool(SDL_MemoryPool *pool)
+{
+    size_t excess = (pool->num_allocated > pool->num_reserved) ? (pool->num_allocated - pool->num_reserved) : 0;
+    excess = SDL_min(excess, pool->min_free);
+
+    for (; excess; --excess) {
+        void *block = pool->free_blocks;
+        pool->free_blocks = *(void **)block;
+        --pool->num_free;
+        --pool->num_allocated;
+        SDL_free(block);
     }
+
+    pool->min_free = pool->num_free;
 }
 
 // Destroy a pool and all of its blocks
@@ -101,10 +129,12 @@ static void DestroyMemoryPool(SDL_MemoryPool *pool)
     void *block = pool->free_blocks;
     pool->free_blocks = NULL;
     pool->num_free = 0;
+    pool->min_free = 0;
 
     while (block) {
         void *next = *(void **)block;
         SDL_free(block);
+        --pool->num_allocated;
         block = next;
     }
 }
@@ -133,8 +163,26 @@ static bool ReserveMemoryPoolBlocks(SDL_MemoryPool *pool, size_t num_blocks)
         *(void **)block = pool->free_blocks;
         pool->free_blocks = block;
         ++pool->num_free;
+        ++pool->num_allocated;
+    }
+
+    return true;
+}
+
+// Keep at least `num_reserved` blocks around for good, allocating them now, and cache up to `max_free` unused blocks
+static bool SetMemoryPoolBudget(SDL_MemoryPool *pool, size_t num_reserved, size_t max_free)
+{
+    pool->num_reserved = num_reserved;
+    pool->max_free = SDL_max(max_free, num_reserved);
+
+    if (pool->num_allocated < num_reserved) {
+        if (!ReserveMemoryPoolBlocks(pool, num_reserved - pool->num_allocated)) {
+            return false;
+        }
     }
 
+    // the new blocks haven't been unused for a whole trim interval yet.
+    pool->min_free = 0;
     return true;
 }
 
@@ -149,6 +197,44 @@ void SDL_DestroyAudioQueue(SDL_AudioQueue *queue)
     SDL_free(queue);
 }
 
+bool SDL_SetAudioQueueMemoryBudget(SDL_AudioQueue *queue, size_t reserve_bytes, size_t max_idle_bytes)
+{
+    const size_t chunk_size = queue->chunk_pool.block_size;
+    // Queued data rarely starts at the beginning of a chunk, so one more is needed to hold it all.
+    const size_t num_chunks = reserve_bytes ? ((reserve_bytes / chunk_size) + ((reserve_bytes % chunk_size) ? 2 : 1)) : 0;
+    const size_t max_free_chunks = max_idle_bytes / chunk_size;
+
+    // Every chunk lives in its own track, so budget for those too.
+    if (!SetMemoryPoolBudget(&queue->chunk_pool, num_chunks, max_free_chunks) ||
+        !SetMemoryPoolBudget(&queue->track_pool, num_chunks + 2, SDL_max(max_free_chunks, 8))) {
+        return false;
+    }
+
+    return true;
+}
+
+void SDL_TrimAudioQueue(SDL_AudioQueue *queue)
+{
+    TrimMemoryPool(&queue->chunk_pool);
+    TrimMemoryPool(&queue->track_pool);
+}
+
+void SDL_GetAudioQueueMemoryStats(SDL_AudioQueue *queue, size_t *resident_bytes, size_t *idle_bytes, size_t *allocations)
+{
+    const SDL_MemoryPool *chunks = &queue->chunk_pool;
+    const SDL_MemoryPool *tracks = &queue->track_pool;
+
+    if (resident_bytes) {
+        *resident_bytes = (chunks->num_allocated * chunks->block_size) + (tracks->num_allocated * tracks->block_size);
+    }
+    if (idle_bytes) {
+        *idle_bytes = (chunks->num_free * chunks->block_size) + (tracks->num_free * tracks->block_size);
+    }
+    if (allocations) {
+        *allocations = chunks->num_allocations + tracks->num_allocations;
+    }
+}
+
 SDL_AudioQueue *SDL_CreateAudioQueue(size_t chunk_size)
 {
     SDL_AudioQueue *queue = (SDL_AudioQueue *)SDL_calloc(1, sizeof(*queue));
@@ -228,10 +314,15 @@ void SDL_PopAudioQueueHead(SDL_AudioQueue *queue)
     }
 }
 
+static void SDLCALL ReleasedAudioBuffer(void *userdata, const void *buf, int len)
+{
+    // The track's data was already released by SDL_ReleaseAudioQueueHeadData.
+}
+
 SDL_AudioTrack *SDL_CreateAudioTrack(
     SDL_AudioQueue *queue, const SDL_AudioSpec *spec, const int *chmap,
     Uint8 *data, size_t len, size_t capacity,
-    SDL_ReleaseAudioBufferCallback callback, void *userdata)
+    SDL_AudioStreamDataCompleteCallback callback, void *userdata)
 {
     SDL_AudioTrack *track = (SDL_AudioTrack *)AllocMemoryPoolBlock(&queue->track_pool);
 
@@ -442,6 +533,28 @@ static void UpdateAudioQueueHistory(SDL_AudioQueue *queue,
     }
 }
 
+void SDL_ReleaseAudioQueueHeadData(SDL_AudioQueue *queue)
+{
+    SDL_AudioTrack *track = queue->head;
+
+    if (!track || (track->callback == ReleasedAudioBuffer) || (track->head < track->capacity)) {
+        return;
+    }
+
+    SDL_assert(track->head == track->tail);
+
+    UpdateAudioQueueHistory(queue, track->data, track->tail);
+    track->callback(track->userdata, track->data, (int)track->capacity);
+
+    // The (now empty) track stays at the head of the queue, so its spec and flushed state still apply.
+    track->callback = ReleasedAudioBuffer;
+    track->userdata = NULL;
+    track->data = NULL;
+    track->head = 0;
+    track->tail = 0;
+    track->capacity = 0;
+}
+
 static const Uint8 *ReadFromAudioQueue(SDL_AudioQueue *queue, Uint8 *data, size_t len)
 {
     SDL_AudioTrack *track = queue->head;
@@ -548,7 +661,7 @@ const Uint8 *SDL_ReadFromAudioQueue(SDL_AudioQueue *queue,
     size_t dst_present_bytes = present_frames * dst_frame_size;
     size_t dst_future_bytes = future_frames * dst_frame_size;
 
-    bool convert = (src_format != dst_format) || (src_channels != dst_channels);
+    bool convert = (src_format != dst_format) || (src_channels != dst_channels) || (gain != 1.0f);
 
     if (convert && !dst) {
         // The user didn't ask for the data to be copied, but we need to convert it, so store it in the scratch buffer
@@ -25,8 +25,6 @@
 
 // Internal functions used by SDL_AudioStream for queueing audio.
 
-typedef void (SDLCALL *SDL_ReleaseAudioBufferCallback)(void *userdata, const void *buffer, int buflen);
-
 typedef struct SDL_AudioQueue SDL_AudioQueue;
 typedef struct SDL_AudioTrack SDL_AudioTrack;
 
@@ -36,6 +34,16 @@ extern SDL_AudioQueue *SDL_CreateAudioQueue(size_t chunk_size);
 // Destroy an audio queue
 extern void SDL_DestroyAudioQueue(SDL_AudioQueue *queue);
 
+// Allocate enough memory to queue `reserve_bytes` of data now and never give it back, and keep up to
+// `max_idle_bytes` of memory that isn't currently queueing anything around for reuse
+extern bool SDL_SetAudioQueueMemoryBudget(SDL_AudioQueue *queue, size_t reserve_bytes, size_t max_idle_bytes);
+
+// Free the memory that went unused since the last call, except for what was reserved
+extern void SDL_TrimAudioQueue(SDL_AudioQueue *queue);
+
+// Get how much memory the queue holds (in use or not), how much of that is unused, and how many times it had to allocate more
+extern void SDL_GetAudioQueueMemoryStats(SDL_AudioQueue *queue, size_t *resident_bytes, size_t *idle_bytes, size_t *allocations);
+
 // Completely clear the queue
 extern void SDL_ClearAudioQueue(SDL_AudioQueue *queue);
 
@@ -46,6 +54,12 @@ extern void SDL_FlushAudioQueue(SDL_AudioQueue *queue);
 // REQUIRES: The head track must exist, and must have been flushed
 extern void SDL_PopAudioQueueHead(SDL_AudioQueue *queue);
 
+// If the head track has been completely read and can't take any more data, move what the resampler
+// still needs from it into the history buffer and release its data now, rather than when reading
+// moves past it (which might not happen until much later).
+// Don't call this while still using a pointer returned by SDL_ReadFromAudioQueue.
+extern void SDL_ReleaseAudioQueueHeadData(SDL_AudioQueue *queue);
+
 // Write data to the end of queue
 // REQUIRES: If the spec has changed, the last track must have been flushed
 extern bool SDL_WriteToAudioQueue(SDL_AudioQueue *queue, const SDL_AudioSpec *spec, const int *chmap, const Uint8 *data, size_t len);
@@ -53,7 +67,7 @@ extern bool SDL_WriteToAudioQueue(SDL_AudioQueue *queue, const SDL_AudioSpec *sp
 // Create a track where the input data is owned by the caller
 extern SDL_AudioTrack *SDL_CreateAudioTrack(SDL_AudioQueue *queue,
                                             const SDL_AudioSpec *spec, const int *chmap, Uint8 *data, size_t len, size_t capacity,
-                                            SDL_ReleaseAudioBufferCallback callback, void *userdata);
+                                            SDL_AudioStreamDataCompleteCallback callback, void *userdata);
 
 // Add a track to the end of the queue
 // REQUIRES: `track != NULL`
@@ -516,6 +516,293 @@ static void GenerateResamplerFilter(void)
 typedef void (*ResampleFrameFunc)(const float *src, float *dst, const Cubic *filter, float frac, int chans);
 static ResampleFrameFunc ResampleFrame[8];
 
+// Resampling several output frames per iteration. These return how many frames they wrote; the caller finishes off the rest with ResampleFrame.
+typedef int (*ResampleFramesFunc)(const float *src, float *dst, int outframes, Sint64 resample_rate, Sint64 *inout_srcpos, int chans);
+static ResampleFramesFunc ResampleFrames[8];
+
+SDL_FORCE_INLINE const float *NextResamplerFrame(const float *src, int chans, Sint64 *srcpos, Sint64 resample_rate, const Cubic **filter, float *frac)
+{
+    const int srcindex = (int)(Sint32)(*srcpos >> 32);
+    const Uint32 srcfraction = (Uint32)(*srcpos & 0xFFFFFFFF);
+    *srcpos += resample_rate;
+
+    *filter = ResamplerFilter[srcfraction >> RESAMPLER_FILTER_INTERP_BITS];
+    *frac = (float)(srcfraction & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE);
+
+    return &src[srcindex * chans];
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+// The mono and stereo kernels use the same operations in the same order as ResampleFrame_Generic_SSE, just with 2 frames side by side in each register.
+#define sdl_madd_ps(a, b, c) _mm_add_ps(a, _mm_mul_ps(b, c))
+#define sdl_madd_ps256(a, b, c) _mm256_add_ps(a, _mm256_mul_ps(b, c))
+
+// Load 4 floats for frame A into the low half, and 4 floats for frame B into the high half.
+#define sdl_load2_ps(a, b) _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a)), _mm_loadu_ps(b), 1)
+
+static void SDL_TARGETING("avx2") InterpolateFilters_AVX2(const Cubic *filter_a, float frac_a, const Cubic *filter_b, float frac_b, __m256 *f)
+{
+    const __m256 frac1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(frac_a)), _mm_set1_ps(frac_b), 1);
+    const __m256 frac2 = _mm256_mul_ps(frac1, frac1);
+    const __m256 frac3 = _mm256_mul_ps(frac1, frac2);
+    int i;
+
+    // Transposed in SetupAudioResampler
+    for (i = 0; i < 3; ++i, filter_a += 4, filter_b += 4) {
+        __m256 out = sdl_load2_ps(filter_a[0].v, filter_b[0].v);
+        out = sdl_madd_ps256(out, frac1, sdl_load2_ps(filter_a[1].v, filter_b[1].v));
+        out = sdl_madd_ps256(out, frac2, sdl_load2_ps(filter_a[2].v, filter_b[2].v));
+        out = sdl_madd_ps256(out, frac3, sdl_load2_ps(filter_a[3].v, filter_b[3].v));
+        f[i] = out;
+    }
+}
+
+static int SDL_TARGETING("avx2") ResampleFrames_Mono_AVX2(const float *src, float *dst, int outframes, Sint64 resample_rate, Sint64 *inout_srcpos, int chans)
+{
+    Sint64 srcpos = *inout_srcpos;
+    int i;
+
+    for (i = 0; i + 4 <= outframes; i += 4) {
+        const Cubic *filter_a, *filter_b, *filter_c, *filter_d;
+        float frac_a, frac_b, frac_c, frac_d;
+        const float *a = NextResamplerFrame(src, 1, &srcpos, resample_rate, &filter_a, &frac_a);
+        const float *b = NextResamplerFrame(src, 1, &srcpos, resample_rate, &filter_b, &frac_b);
+        const float *c = NextResamplerFrame(src, 1, &srcpos, resample_rate, &filter_c, &frac_c);
+        const float *d = NextResamplerFrame(src, 1, &srcpos, resample_rate, &filter_d, &frac_d);
+        __m256 f[3], g[3];
+
+        InterpolateFilters_AVX2(filter_a, frac_a, filter_b, frac_b, f);
+        InterpolateFilters_AVX2(filter_c, frac_c, filter_d, frac_d, g);
+
+        // Multiply the filters by the input
+        __m256 ab = _mm256_mul_ps(f[0], sdl_load2_ps(a + 0, b + 0));
+        __m256 cd = _mm256_mul_ps(g[0], sdl_load2_ps(c + 0, d + 0));
+        ab = sdl_madd_ps256(ab, f[1], sdl_load2_ps(a + 4, b + 4));
+        cd = sdl_madd_ps256(cd, g[1], sdl_load2_ps(c + 4, d + 4));
+        ab = sdl_madd_ps256(ab, f[2], sdl_load2_ps(a + 8, b + 8));
+        cd = sdl_madd_ps256(cd, g[2], sdl_load2_ps(c + 8, d + 8));
+
+        // Horizontal sums; the low half ends up with [a, c, a, c], the high half with [b, d, b, d]
+        __m256 sum = _mm256_hadd_ps(ab, cd);
+        sum = _mm256_hadd_ps(sum, sum);
+
+        _mm_storeu_ps(dst, _mm_unpacklo_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1)));
+        dst += 4;
+    }
+
+    *inout_srcpos = srcpos;
+    return i;
+}
+
+static int SDL_TARGETING("avx2") ResampleFrames_Stereo_AVX2(const float *src, float *dst, int outframes, Sint64 resample_rate, Sint64 *inout_srcpos, int chans)
+{
+    Sint64 srcpos = *inout_srcpos;
+    int i;
+
+    for (i = 0; i + 2 <= outframes; i += 2) {
+        const Cubic *filter_a, *filter_b;
+        float frac_a, frac_b;
+        const float *a = NextResamplerFrame(src, 2, &srcpos, resample_rate, &filter_a, &frac_a);
+        const float *b = NextResamplerFrame(src, 2, &srcpos, resample_rate, &filter_b, &frac_b);
+        __m256 f[3];
+
+        InterpolateFilters_AVX2(filter_a, frac_a, filter_b, frac_b, f);
+
+        // Duplicate each of the filter elements and multiply by the input
+        __m256 out0 = _mm256_mul_ps(sdl_load2_ps(a + 0, b + 0), _mm256_unpacklo_ps(f[0], f[0]));
+        __m256 out1 = _mm256_mul_ps(sdl_load2_ps(a + 4, b + 4), _mm256_unpackhi_ps(f[0], f[0]));
+        out0 = sdl_madd_ps256(out0, sdl_load2_ps(a + 8, b + 8), _mm256_unpacklo_ps(f[1], f[1]));
+        out1 = sdl_madd_ps256(out1, sdl_load2_ps(a + 12, b + 12), _mm256_unpackhi_ps(f[1], f[1]));
+        out0 = sdl_madd_ps256(out0, sdl_load2_ps(a + 16, b + 16), _mm256_unpacklo_ps(f[2], f[2]));
+        out1 = sdl_madd_ps256(out1, sdl_load2_ps(a + 20, b + 20), _mm256_unpackhi_ps(f[2], f[2]));
+
+        // Add the accumulators together, then the lower and upper pairs of each frame
+        __m256 out = _mm256_add_ps(out0, out1);
+        out = _mm256_add_ps(out, _mm256_permute_ps(out, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        _mm_storeu_ps(dst, _mm_movelh_ps(_mm256_castps256_ps128(out), _mm256_extractf128_ps(out, 1)));
+        dst += 4;
+    }
+
+    *inout_srcpos = srcpos;
+    return i;
+}
+
+// 5.1 and 7.1 have enough channels to fill a whole register, so these do one frame at a time across all channels.
+static void SDL_TARGETING("avx2") InterpolateFilterScales_AVX2(const Cubic *filter, float frac, float *scales)
+{
+    const __m128 frac1 = _mm_set1_ps(frac);
+    const __m128 frac2 = _mm_mul_ps(frac1, frac1);
+    const __m128 frac3 = _mm_mul_ps(frac1, frac2);
+    int i;
+
+    // Transposed in SetupAudioResampler
+    for (i = 0; i < 3; ++i, filter += 4) {
+        __m128 out = _mm_load_ps(filter[0].v);
+        out = sdl_madd_ps(out, frac1, _mm_load_ps(filter[1].v));
+        out = sdl_madd_ps(out, frac2, _mm_load_ps(filter[2].v));
+        out = sdl_madd_ps(out, frac3, _mm_load_ps(filter[3].v));
+        _mm_storeu_ps(&scales[i * 4], out);
+    }
+}
+
+static int SDL_TARGETING("avx2") ResampleFrames_8Channels_AVX2(const float *src, float *dst, int outframes, Sint64 resample_rate, Sint64 *inout_srcpos, int chans)
+{
+    Sint64 srcpos = *inout_srcpos;
+    float scales[RESAMPLER_SAMPLES_PER_FRAME];
+    int i, j;
+
+    for (i = 0; i < outframes; ++i) {
+        const Cubic *filter;
+        float frac;
+        const float *in = NextResamplerFrame(src, 8, &srcpos, resample_rate, &filter, &frac);
+        __m256 out0 = _mm256_setzero_ps();
+        __m256 out1 = _mm256_setzero_ps();
+
+        InterpolateFilterScales_AVX2(filter, frac, scales);
+
+        // Use two accumulators to improve throughput
+        for (j = 0; j < RESAMPLER_SAMPLES_PER_FRAME; j += 2, in += 16) {
+            out0 = sdl_madd_ps256(out0, _mm256_loadu_ps(in), _mm256_broadcast_ss(&scales[j]));
+            out1 = sdl_madd_ps256(out1, _mm256_loadu_ps(in + 8), _mm256_broadcast_ss(&scales[j + 1]));
+        }
+
+        _mm256_storeu_ps(dst, _mm256_add_ps(out0, out1));
+        dst += 8;
+    }
+
+    *inout_srcpos = srcpos;
+    return i;
+}
+
+static int SDL_TARGETING("avx2") ResampleFrames_6Channels_AVX2(const float *src, float *dst, int outframes, Sint64 resample_rate, Sint64 *inout_srcpos, int chans)
+{
+    const __m256i mask = _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0);
+    Sint64 srcpos = *inout_srcpos;
+    float scales[RESAMPLER_SAMPLES_PER_FRAME];
+    int i, j;
+
+    for (i = 0; i < outframes; ++i) {
+        const Cubic *filter;
+        float frac;
+        const float *in = NextResamplerFrame(src, 6, &srcpos, resample_rate, &filter, &frac);
+        __m256 out0 = _mm256_setzero_ps();
+        __m256 out1 = _mm256_setzero_ps();
+
+        InterpolateFilterScales_AVX2(filter, frac, scales);
+
+        // Masked loads, so we never touch the 2 floats past the end of the last frame.
+        for (j = 0; j < RESAMPLER_SAMPLES_PER_FRAME; j += 2, in += 12) {
+            out0 = sdl_madd_ps256(out0, _mm256_maskload_ps(in, mask), _mm256_broadcast_ss(&scales[j]));
+            out1 = sdl_madd_ps256(out1, _mm256_maskload_ps(in + 6, mask), _mm256_broadcast_ss(&scales[j + 1]));
+        }
+
+        _mm256_maskstore_ps(dst, mask, _mm256_add_ps(out0, out1));
+        dst += 6;
+    }
+
+    *inout_srcpos = srcpos;
+    return i;
+}
+
+#undef sdl_load2_ps
+#undef sdl_madd_ps256
+#undef sdl_madd_ps
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void InterpolateFilters_NEON(const Cubic *filter, float frac, float32x4_t *f)
+{
+    const float32x4_t frac1 = vdupq_n_f32(frac);
+    const float32x4_t frac2 = vmulq_f32(frac1, frac1);
+    const float32x4_t frac3 = vmulq_f32(frac1, frac2);
+    int i;
+
+    // Transposed in SetupAudioResampler
+    for (i = 0; i < 3; ++i, filter += 4) {
+        f[i] = vmlaq_f32(vmlaq_f32(vmlaq_f32(filter[0].v128, filter[1].v128, frac1), filter[2].v128, frac2), filter[3].v128, frac3);
+    }
+}
+
+// Two frames per iteration, so the loads and multiplies of one overlap with the horizontal sums of the other.
+static int ResampleFrames_Mono_NEON(const float *src, float *dst, int outframes, Sint64 resample_rate, Sint64 *inout_srcpos, int chans)
+{
+    Sint64 srcpos = *inout_srcpos;
+    int i;
+
+    for (i = 0; i + 2 <= outframes; i += 2) {
+        const Cubic *filter_a, *filter_b;
+        float frac_a, frac_b;
+        const float *a = NextResamplerFrame(src, 1, &srcpos, resample_rate, &filter_a, &frac_a);
+        const float *b = NextResamplerFrame(src, 1, &srcpos, resample_rate, &filter_b, &frac_b);
+        float32x4_t f[3], g[3];
+
+        InterpolateFilters_NEON(filter_a, frac_a, f);
+        InterpolateFilters_NEON(filter_b, frac_b, g);
+
+        float32x4_t out_a = vmulq_f32(f[0], vld1q_f32(a + 0));
+        float32x4_t out_b = vmulq_f32(g[0], vld1q_f32(b + 0));
+        out_a = vmlaq_f32(out_a, f[1], vld1q_f32(a + 4));
+        out_b = vmlaq_f32(out_b, g[1], vld1q_f32(b + 4));
+        out_a = vmlaq_f32(out_a, f[2], vld1q_f32(a + 8));
+        out_b = vmlaq_f32(out_b, g[2], vld1q_f32(b + 8));
+
+        // Horizontal sums of both frames at once
+        const float32x2_t sum_a = vadd_f32(vget_low_f32(out_a), vget_high_f32(out_a));
+        const float32x2_t sum_b = vadd_f32(vget_low_f32(out_b), vget_high_f32(out_b));
+        vst1_f32(dst, vpadd_f32(sum_a, sum_b));
+        dst += 2;
+    }
+
+    *inout_srcpos = srcpos;
+    return i;
+}
+
+static int ResampleFrames_Stereo_NEON(const float *src, float *dst, int outframes, Sint64 resample_rate, Sint64 *inout_srcpos, int chans)
+{
+    Sint64 srcpos = *inout_srcpos;
+    int i;
+
+    for (i = 0; i + 2 <= outframes; i += 2) {
+        const Cubic *filter_a, *filter_b;
+        float frac_a, frac_b;
+        const float *a = NextResamplerFrame(src, 2, &srcpos, resample_rate, &filter_a, &frac_a);
+        const float *b = NextResamplerFrame(src, 2, &srcpos, resample_rate, &filter_b, &frac_b);
+        float32x4_t f[3], g[3];
+
+        InterpolateFilters_NEON(filter_a, frac_a, f);
+        InterpolateFilters_NEON(filter_b, frac_b, g);
+
+        // Duplicate each of the filter elements and multiply by the input
+#define X(out, in, filt, idx) \
+    { \
+        const float32x4x2_t dup = vzipq_f32(filt[idx], filt[idx]); \
+        out[0] = vmlaq_f32(out[0], vld1q_f32(in + (idx * 8) + 0), dup.val[0]); \
+        out[1] = vmlaq_f32(out[1], vld1q_f32(in + (idx * 8) + 4), dup.val[1]); \
+    }
+        float32x4_t out_a[2] = { vdupq_n_f32(0), vdupq_n_f32(0) };
+        float32x4_t out_b[2] = { vdupq_n_f32(0), vdupq_n_f32(0) };
+        X(out_a, a, f, 0);
+        X(out_b, b, g, 0);
+        X(out_a, a, f, 1);
+        X(out_b, b, g, 1);
+        X(out_a, a, f, 2);
+        X(out_b, b, g, 2);
+#undef X
+
+        // Add the accumulators together, then the lower and upper pairs of each frame
+        const float32x4_t sum_a = vaddq_f32(out_a[0], out_a[1]);
+        const float32x4_t sum_b = vaddq_f32(out_b[0], out_b[1]);
+        vst1q_f32(dst, vcombine_f32(vadd_f32(vget_low_f32(sum_a), vget_high_f32(sum_a)),
+                                    vadd_f32(vget_low_f32(sum_b), vget_high_f32(sum_b))));
+        dst += 4;
+    }
+
+    *inout_srcpos = srcpos;
+    return i;
+}
+#endif
+
 // Transpose 4x4 floats
 static void Transpose4x4(Cubic *data)
 {
@@ -543,6 +830,15 @@ static void SetupAudioResampler(void)
             ResampleFrame[i] = ResampleFrame_Generic_SSE;
         }
         transpose = true;
+
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            ResampleFrames[0] = ResampleFrames_Mono_AVX2;
+            ResampleFrames[1] = ResampleFrames_Stereo_AVX2;
+            ResampleFrames[5] = ResampleFrames_6Channels_AVX2;
+            ResampleFrames[7] = ResampleFrames_8Channels_AVX2;
+        }
+#endif
     } else
 #endif
 #ifdef SDL_NEON_INTRINSICS
@@ -550,6 +846,8 @@ static void SetupAudioResampler(void)
         for (i = 0; i < 8; ++i) {
             ResampleFrame[i] = ResampleFrame_Generic_NEON;
         }
+        ResampleFrames[0] = ResampleFrames_Mono_NEON;
+        ResampleFrames[1] = ResampleFrames_Stereo_NEON;
         transpose = true;
     } else
 #endif
@@ -667,25 +965,30 @@ Sint64 SDL_GetResamplerOutputFrames(Sint64 input_frames, Sint64 resample_rate, S
 void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, int outframes,
                        Sint64 resample_rate, Sint64 *inout_resample_offset)
 {
-    int i;
+    int i = 0;
     Sint64 srcpos = *inout_resample_offset;
     ResampleFrameFunc resample_frame = ResampleFrame[chans - 1];
+    ResampleFramesFunc resample_frames = ResampleFrames[chans - 1];
 
     SDL_assert(resample_rate > 0);
 
     src -= (RESAMPLER_ZERO_CROSSINGS - 1) * chans;
 
-    for (i = 0; i < outframes; ++i) {
-        int srcindex = (int)(Sint32)(srcpos >> 32);
-        Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
-        srcpos += resample_rate;
+    if (resample_frames && (outframes > 0)) {
+        // srcpos only moves forward, so checking the first and last frames covers everything in between.
+        SDL_assert((int)(Sint32)(srcpos >> 32) >= -1);
+        SDL_assert((int)(Sint32)((srcpos + (outframes - 1) * resample_rate) >> 32) < inframes);
 
-        SDL_assert(srcindex >= -1 && srcindex < inframes);
+        i = resample_frames(src, dst, outframes, resample_rate, &srcpos, chans);
+        dst += i * chans;
+    }
 
-        const Cubic *filter = ResamplerFilter[srcfraction >> RESAMPLER_FILTER_INTERP_BITS];
-        const float frac = (float)(srcfraction & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE);
+    for (; i < outframes; ++i) {
+        SDL_assert((int)(Sint32)(srcpos >> 32) >= -1 && (int)(Sint32)(srcpos >> 32) < inframes);
 
-        const float *frame = &src[srcindex * chans];
+        const Cubic *filter;
+        float frac;
+        const float *frame = NextResamplerFrame(src, chans, &srcpos, resample_rate, &filter, &frac);
         resample_frame(frame, dst, filter, frac, chans);
 
         dst += chans;
@@ -82,9 +82,442 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(type, s, v) ((s) = (type)(((s) * (v)) / MIX_MAXVOLUME))
 #define ADJUST_VOLUME_U8(s, v)    ((s) = (Uint8)(((((s) - 128) * (v)) / MIX_MAXVOLUME) + 128))
 
-// !!! FIXME: This needs some SIMD magic.
-// !!! FIXME: Add fast-path for volume = 1
-// !!! FIXME: Use larger scales for 16-bit/32-bit integers
+// Number of samples the mixers convert or byte-swap at a time, small enough to stay in the L1 cache.
+#define MIX_CHUNK_SAMPLES 256
+
+/* SIMD mixers for data in the native byte order.
+ *
+ * The float ones add `src * volume` to `dst`, clamping to [-1, 1] if `clip` is
+ * true (the batch mixer accumulates without clipping).
+ *
+ * The integer ones give exactly the same results as the scalar code in
+ * SDL_MixAudio, which scales by `volume / MIX_MAXVOLUME` rounding towards
+ * zero, then does a saturating add. They only handle volumes up to
+ * MIX_MAXVOLUME: above that, the scalar code wraps around when scaling, which
+ * isn't worth reproducing. U8 data is mixed as S8 after flipping the top bit,
+ * which is exactly what the mix8 table does.
+ *
+ * They all return the number of samples they handled; the scalar code does the
+ * rest.
+ */
+#ifdef SDL_SSE_INTRINSICS
+static int SDL_TARGETING("sse") MixFloat32_SSE(float *dst, const float *src, float volume, bool clip, int num_samples)
+{
+    const __m128 vol = _mm_set1_ps(volume);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    int i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        __m128 a = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), vol));
+        __m128 b = _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(_mm_loadu_ps(src + i + 4), vol));
+        if (clip) {
+            a = _mm_max_ps(_mm_min_ps(a, one), minus_one);
+            b = _mm_max_ps(_mm_min_ps(b, one), minus_one);
+        }
+        _mm_storeu_ps(dst + i, a);
+        _mm_storeu_ps(dst + i + 4, b);
+    }
+
+    return i;
+}
+#endif
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") MixS8_SSE2(Sint8 *dst, const Sint8 *src, int volume, bool flip, int num_samples)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16)volume);
+    const __m128i round = _mm_set1_epi16(MIX_MAXVOLUME - 1);
+    const __m128i bias = _mm_set1_epi8(flip ? (char)0x80 : 0);
+    int i;
+
+    for (i = 0; i + 16 <= num_samples; i += 16) {
+        const __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(src + i)), bias);
+        const __m128i d = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(dst + i)), bias);
+        // Sign-extend to 16 bits, scale, and divide by 128 rounding towards zero.
+        __m128i lo = _mm_mullo_epi16(_mm_srai_epi16(_mm_unpacklo_epi8(s, s), 8), vol);
+        __m128i hi = _mm_mullo_epi16(_mm_srai_epi16(_mm_unpackhi_epi8(s, s), 8), vol);
+        lo = _mm_srai_epi16(_mm_add_epi16(lo, _mm_and_si128(_mm_srai_epi16(lo, 15), round)), 7);
+        hi = _mm_srai_epi16(_mm_add_epi16(hi, _mm_and_si128(_mm_srai_epi16(hi, 15), round)), 7);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(_mm_adds_epi8(d, _mm_packs_epi16(lo, hi)), bias));
+    }
+
+    return i;
+}
+
+static int SDL_TARGETING("sse2") MixS16_SSE2(Sint16 *dst, const Sint16 *src, int volume, int num_samples)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16)volume);
+    const __m128i round = _mm_set1_epi32(MIX_MAXVOLUME - 1);
+    int i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        // The 32-bit products, divided by 128 rounding towards zero.
+        const __m128i plo = _mm_mullo_epi16(s, vol);
+        const __m128i phi = _mm_mulhi_epi16(s, vol);
+        __m128i lo = _mm_unpacklo_epi16(plo, phi);
+        __m128i hi = _mm_unpackhi_epi16(plo, phi);
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, _mm_and_si128(_mm_srai_epi32(lo, 31), round)), 7);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, _mm_and_si128(_mm_srai_epi32(hi, 31), round)), 7);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_adds_epi16(d, _mm_packs_epi32(lo, hi)));
+    }
+
+    return i;
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+static int SDL_TARGETING("avx2") MixFloat32_AVX2(float *dst, const float *src, float volume, bool clip, int num_samples)
+{
+    const __m256 vol = _mm256_set1_ps(volume);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 minus_one = _mm256_set1_ps(-1.0f);
+    int i;
+
+    for (i = 0; i + 16 <= num_samples; i += 16) {
+        __m256 a = _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), vol));
+        __m256 b = _mm256_add_ps(_mm256_loadu_ps(dst + i + 8), _mm256_mul_ps(_mm256_loadu_ps(src + i + 8), vol));
+        if (clip) {
+            a = _mm256_max_ps(_mm256_min_ps(a, one), minus_one);
+            b = _mm256_max_ps(_mm256_min_ps(b, one), minus_one);
+        }
+        _mm256_storeu_ps(dst + i, a);
+        _mm256_storeu_ps(dst + i + 8, b);
+    }
+
+    return i;
+}
+
+static int SDL_TARGETING("avx2") MixS8_AVX2(Sint8 *dst, const Sint8 *src, int volume, bool flip, int num_samples)
+{
+    const __m256i vol = _mm256_set1_epi16((Sint16)volume);
+    const __m256i round = _mm256_set1_epi16(MIX_MAXVOLUME - 1);
+    const __m256i bias = _mm256_set1_epi8(flip ? (char)0x80 : 0);
+    int i;
+
+    for (i = 0; i + 32 <= num_samples; i += 32) {
+        const __m256i s = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(src + i)), bias);
+        const __m256i d = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(dst + i)), bias);
+        // The unpacks and the pack both work within 128-bit lanes, so the samples end up back in order.
+        __m256i lo = _mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpacklo_epi8(s, s), 8), vol);
+        __m256i hi = _mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpackhi_epi8(s, s), 8), vol);
+        lo = _mm256_srai_epi16(_mm256_add_epi16(lo, _mm256_and_si256(_mm256_srai_epi16(lo, 15), round)), 7);
+        hi = _mm256_srai_epi16(_mm256_add_epi16(hi, _mm256_and_si256(_mm256_srai_epi16(hi, 15), round)), 7);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_xor_si256(_mm256_adds_epi8(d, _mm256_packs_epi16(lo, hi)), bias));
+    }
+
+    return i;
+}
+
+static int SDL_TARGETING("avx2") MixS16_AVX2(Sint16 *dst, const Sint16 *src, int volume, int num_samples)
+{
+    const __m256i vol = _mm256_set1_epi16((Sint16)volume);
+    const __m256i round = _mm256_set1_epi32(MIX_MAXVOLUME - 1);
+    int i;
+
+    for (i = 0; i + 16 <= num_samples; i += 16) {
+        const __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        const __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+        const __m256i plo = _mm256_mullo_epi16(s, vol);
+        const __m256i phi = _mm256_mulhi_epi16(s, vol);
+        __m256i lo = _mm256_unpacklo_epi16(plo, phi);
+        __m256i hi = _mm256_unpackhi_epi16(plo, phi);
+        lo = _mm256_srai_epi32(_mm256_add_epi32(lo, _mm256_and_si256(_mm256_srai_epi32(lo, 31), round)), 7);
+        hi = _mm256_srai_epi32(_mm256_add_epi32(hi, _mm256_and_si256(_mm256_srai_epi32(hi, 31), round)), 7);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_adds_epi16(d, _mm256_packs_epi32(lo, hi)));
+    }
+
+    return i;
+}
+
+static int SDL_TARGETING("avx2") MixS32_AVX2(Sint32 *dst, const Sint32 *src, int volume, int num_samples)
+{
+    const __m256i vol = _mm256_set1_epi32(volume);
+    const __m256i low7 = _mm256_set1_epi32(MIX_MAXVOLUME - 1);
+    const __m256i max = _mm256_set1_epi32(SDL_MAX_SINT32);
+    int i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        const __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        const __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+        /* The product needs up to 39 bits, so it's split: with s = 128 * a + b,
+         * s * volume / 128 = a * volume + b * volume / 128, and the result gets
+         * rounded towards zero if s is negative and the division isn't exact.
+         */
+        const __m256i bv = _mm256_mullo_epi32(_mm256_and_si256(s, low7), vol);
+        const __m256i inexact = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_and_si256(bv, low7), _mm256_setzero_si256()), _mm256_set1_epi32(-1));
+        __m256i q = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(s, 7), vol), _mm256_srai_epi32(bv, 7));
+        q = _mm256_sub_epi32(q, _mm256_and_si256(_mm256_srai_epi32(s, 31), inexact));
+        {
+            // Saturating add: on overflow, the result takes the sign of the inputs.
+            const __m256i sum = _mm256_add_epi32(d, q);
+            const __m256i overflow = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(d, sum), _mm256_xor_si256(q, sum)), 31);
+            const __m256i saturated = _mm256_xor_si256(_mm256_srai_epi32(d, 31), max);
+            _mm256_storeu_si256((__m256i *)(dst + i), _mm256_blendv_epi8(sum, saturated, overflow));
+        }
+    }
+
+    return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int MixFloat32_NEON(float *dst, const float *src, float volume, bool clip, int num_samples)
+{
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t minus_one = vdupq_n_f32(-1.0f);
+    int i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        // Multiply and add separately to get the same rounding as the scalar code.
+        float32x4_t a = vaddq_f32(vld1q_f32(dst + i), vmulq_n_f32(vld1q_f32(src + i), volume));
+        float32x4_t b = vaddq_f32(vld1q_f32(dst + i + 4), vmulq_n_f32(vld1q_f32(src + i + 4), volume));
+        if (clip) {
+            a = vmaxq_f32(vminq_f32(a, one), minus_one);
+            b = vmaxq_f32(vminq_f32(b, one), minus_one);
+        }
+        vst1q_f32(dst + i, a);
+        vst1q_f32(dst + i + 4, b);
+    }
+
+    return i;
+}
+
+// Divides by 128, rounding towards zero like the scalar code.
+static int16x8_t MixDiv128_S16_NEON(int16x8_t p)
+{
+    return vshrq_n_s16(vaddq_s16(p, vandq_s16(vshrq_n_s16(p, 15), vdupq_n_s16(MIX_MAXVOLUME - 1))), 7);
+}
+
+static int32x4_t MixDiv128_S32_NEON(int32x4_t p)
+{
+    return vshrq_n_s32(vaddq_s32(p, vandq_s32(vshrq_n_s32(p, 31), vdupq_n_s32(MIX_MAXVOLUME - 1))), 7);
+}
+
+static int MixS8_NEON(Sint8 *dst, const Sint8 *src, int volume, bool flip, int num_samples)
+{
+    const int16x8_t vol = vdupq_n_s16((Sint16)volume);
+    const uint8x16_t bias = vdupq_n_u8(flip ? 0x80 : 0);
+    int i;
+
+    for (i = 0; i + 16 <= num_samples; i += 16) {
+        const int8x16_t s = vreinterpretq_s8_u8(veorq_u8(vld1q_u8((const Uint8 *)src + i), bias));
+        const int8x16_t d = vreinterpretq_s8_u8(veorq_u8(vld1q_u8((const Uint8 *)dst + i), bias));
+        const int16x8_t lo = MixDiv128_S16_NEON(vmulq_s16(vmovl_s8(vget_low_s8(s)), vol));
+        const int16x8_t hi = MixDiv128_S16_NEON(vmulq_s16(vmovl_s8(vget_high_s8(s)), vol));
+        const int8x16_t mixed = vqaddq_s8(d, vcombine_s8(vmovn_s16(lo), vmovn_s16(hi)));
+        vst1q_u8((Uint8 *)dst + i, veorq_u8(vreinterpretq_u8_s8(mixed), bias));
+    }
+
+    return i;
+}
+
+static int MixS16_NEON(Sint16 *dst, const Sint16 *src, int volume, int num_samples)
+{
+    const int16x4_t vol = vdup_n_s16((Sint16)volume);
+    int i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        const int16x8_t s = vld1q_s16(src + i);
+        const int32x4_t lo = MixDiv128_S32_NEON(vmull_s16(vget_low_s16(s), vol));
+        const int32x4_t hi = MixDiv128_S32_NEON(vmull_s16(vget_high_s16(s), vol));
+        vst1q_s16(dst + i, vqaddq_s16(vld1q_s16(dst + i), vcombine_s16(vmovn_s32(lo), vmovn_s32(hi))));
+    }
+
+    return i;
+}
+
+static int MixS32_NEON(Sint32 *dst, const Sint32 *src, int volume, int num_samples)
+{
+    const int32x4_t vol = vdupq_n_s32(volume);
+    const int32x4_t low7 = vdupq_n_s32(MIX_MAXVOLUME - 1);
+    int i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        // See MixS32_AVX2 for how this avoids 64-bit products.
+        const int32x4_t s = vld1q_s32(src + i);
+        const int32x4_t bv = vmulq_s32(vandq_s32(s, low7), vol);
+        const int32x4_t inexact = vreinterpretq_s32_u32(vtstq_s32(bv, low7));
+        int32x4_t q = vaddq_s32(vmulq_s32(vshrq_n_s32(s, 7), vol), vshrq_n_s32(bv, 7));
+        q = vsubq_s32(q, vandq_s32(vshrq_n_s32(s, 31), inexact));
+        vst1q_s32(dst + i, vqaddq_s32(vld1q_s32(dst + i), q));
+    }
+
+    return i;
+}
+#endif
+
+// These run the best SIMD mixer available, and finish the samples it leaves over with scalar code.
+static void MixFloat32(float *dst, const float *src, float volume, bool clip, int num_samples)
+{
+    int i = 0;
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        i = MixFloat32_AVX2(dst, src, volume, clip, num_samples);
+    }
+#endif
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        i += MixFloat32_SSE(dst + i, src + i, volume, clip, num_samples - i);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i += MixFloat32_NEON(dst + i, src + i, volume, clip, num_samples - i);
+    }
+#endif
+
+    for (; i < num_samples; i++) {
+        float sample = dst[i] + src[i] * volume;
+        if (clip) {
+            if (sample > 1.0f) {
+                sample = 1.0f;
+            } else if (sample < -1.0f) {
+                sample = -1.0f;
+            }
+        }
+        dst[i] = sample;
+    }
+}
+
+static void MixS8(Sint8 *dst, const Sint8 *src, int volume, bool flip, int num_samples)
+{
+    const int bias = flip ? 0x80 : 0;
+    int i = 0;
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        i = MixS8_AVX2(dst, src, volume, flip, num_samples);
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        i += MixS8_SSE2(dst + i, src + i, volume, flip, num_samples - i);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i += MixS8_NEON(dst + i, src + i, volume, flip, num_samples - i);
+    }
+#endif
+
+    for (; i < num_samples; i++) {
+        const int src_sample = ((Sint8)(src[i] ^ bias) * volume) / MIX_MAXVOLUME;
+        const int dst_sample = SDL_clamp((Sint8)(dst[i] ^ bias) + src_sample, SDL_MIN_SINT8, SDL_MAX_SINT8);
+        dst[i] = (Sint8)(dst_sample ^ bias);
+    }
+}
+
+static void MixS16(Sint16 *dst, const Sint16 *src, int volume, int num_samples)
+{
+    int i = 0;
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        i = MixS16_AVX2(dst, src, volume, num_samples);
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        i += MixS16_SSE2(dst + i, src + i, volume, num_samples - i);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i += MixS16_NEON(dst + i, src + i, volume, num_samples - i);
+    }
+#endif
+
+    for (; i < num_samples; i++) {
+        const int src_sample = (src[i] * volume) / MIX_MAXVOLUME;
+        dst[i] = (Sint16)SDL_clamp(dst[i] + src_sample, SDL_MIN_SINT16, SDL_MAX_SINT16);
+    }
+}
+
+static void MixS32(Sint32 *dst, const Sint32 *src, int volume, int num_samples)
+{
+    int i = 0;
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        i = MixS32_AVX2(dst, src, volume, num_samples);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i = MixS32_NEON(dst, src, volume, num_samples);
+    }
+#endif
+
+    for (; i < num_samples; i++) {
+        const Sint64 src_sample = ((Sint64)src[i] * volume) / MIX_MAXVOLUME;
+        dst[i] = (Sint32)SDL_clamp(dst[i] + src_sample, SDL_MIN_SINT32, SDL_MAX_SINT32);
+    }
+}
+
+// Mixes data in the native byte order. Returns false if there's no fast path for the format and volume.
+static bool MixAudioNative(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, int num_samples, int volume, float fvolume)
+{
+    if (!SDL_AUDIO_ISFLOAT(format) && volume > MIX_MAXVOLUME) {
+        return false;
+    }
+
+    switch (format) {
+    case SDL_AUDIO_U8:
+        MixS8((Sint8 *)dst, (const Sint8 *)src, volume, true, num_samples);
+        return true;
+    case SDL_AUDIO_S8:
+        MixS8((Sint8 *)dst, (const Sint8 *)src, volume, false, num_samples);
+        return true;
+    case SDL_AUDIO_S16:
+        MixS16((Sint16 *)dst, (const Sint16 *)src, volume, num_samples);
+        return true;
+    case SDL_AUDIO_S32:
+        MixS32((Sint32 *)dst, (const Sint32 *)src, volume, num_samples);
+        return true;
+    case SDL_AUDIO_F32:
+        MixFloat32((float *)dst, (const float *)src, fvolume, true, num_samples);
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool MixAudioFast(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, int volume, float fvolume)
+{
+    const int samplesize = SDL_AUDIO_BYTESIZE(format);
+    const int bitsize = SDL_AUDIO_BITSIZE(format);
+    const SDL_AudioFormat native = format ^ SDL_AUDIO_MASK_BIG_ENDIAN;
+    Uint32 dstbuf[MIX_CHUNK_SAMPLES];
+    Uint32 srcbuf[MIX_CHUNK_SAMPLES];
+    int num_samples = (int)(len / samplesize);
+
+    if (samplesize == 1 || SDL_AUDIO_ISBIGENDIAN(format) == (SDL_BYTEORDER == SDL_BIG_ENDIAN)) {
+        return MixAudioNative(dst, src, format, num_samples, volume, fvolume);
+    } else if (native != SDL_AUDIO_S16 && native != SDL_AUDIO_S32 && native != SDL_AUDIO_F32) {
+        return false;
+    } else if (native != SDL_AUDIO_F32 && volume > MIX_MAXVOLUME) {
+        return false;
+    }
+
+    // Byte-swapped data is swapped to the native order and back a chunk at a time, which is still much faster than the scalar code.
+    SDL_ChooseAudioConverters();
+    while (num_samples > 0) {
+        const int chunk = SDL_min(num_samples, MIX_CHUNK_SAMPLES);
+        ConvertAudioSwapEndian(dstbuf, dst, chunk, bitsize);
+        ConvertAudioSwapEndian(srcbuf, src, chunk, bitsize);
+        MixAudioNative((Uint8 *)dstbuf, (const Uint8 *)srcbuf, native, chunk, volume, fvolume);
+        ConvertAudioSwapEndian(dst, dstbuf, chunk, bitsize);
+        dst += chunk * samplesize;
+        src += chunk * samplesize;
+        num_samples -= chunk;
+    }
+
+    return true;
+}
 
 bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, float fvolume)
 {
@@ -94,6 +527,11 @@ bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 l
         return true;
     }
 
+    if (MixAudioFast(dst, src, format, len, volume, fvolume)) {
+        return true;
+    }
+
+    // This handles volumes the fast path doesn't, and reports unknown formats.
     switch (format) {
 
     case SDL_AUDIO_U8:
@@ -288,3 +726,80 @@ bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 l
 
     return true;
 }
+
+bool SDL_MixAudioBatch(Uint8 *dst, const Uint8 * const *srcs, const float *volumes, int num_srcs, SDL_AudioFormat format, Uint32 len)
+{
+    float accum[MIX_CHUNK_SAMPLES];
+    float converted[MIX_CHUNK_SAMPLES];
+    int num_samples, offset, last, i;
+
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    } else if (num_srcs < 0) {
+        return SDL_InvalidParamError("num_srcs");
+    } else if (num_srcs > 0 && !srcs) {
+        return SDL_InvalidParamError("srcs");
+    }
+
+    switch (format) {
+    case SDL_AUDIO_U8:
+    case SDL_AUDIO_S8:
+    case SDL_AUDIO_S16LE:
+    case SDL_AUDIO_S16BE:
+    case SDL_AUDIO_S32LE:
+    case SDL_AUDIO_S32BE:
+    case SDL_AUDIO_F32LE:
+    case SDL_AUDIO_F32BE:
+        break;
+    default:
+        return SDL_SetError("SDL_MixAudioBatch(): unknown audio format");
+    }
+
+    // Silent sources are skipped, and the last audible one clips the result.
+    last = -1;
+    for (i = 0; i < num_srcs; i++) {
+        if (!srcs[i]) {
+            return SDL_InvalidParamError("srcs");
+        } else if (!volumes || volumes[i] != 0.0f) {
+            last = i;
+        }
+    }
+
+    if (last < 0) {
+        return true;  // nothing to mix, leave dst untouched.
+    }
+
+    SDL_ChooseAudioConverters();
+
+    /* Each chunk of dst is mixed with all the sources while it's in the cache,
+     * accumulating in float (native float data directly in dst), and converted
+     * back and clipped only once.
+     */
+    num_samples = (int)(len / SDL_AUDIO_BYTESIZE(format));
+    for (offset = 0; offset < num_samples; offset += MIX_CHUNK_SAMPLES) {
+        const int chunk = SDL_min(num_samples - offset, MIX_CHUNK_SAMPLES);
+        const size_t byteoffset = (size_t)offset * SDL_AUDIO_BYTESIZE(format);
+
+        if (format == SDL_AUDIO_F32) {
+            for (i = 0; i <= last; i++) {
+                const float volume = volumes ? volumes[i] : 1.0f;
+                if (volume != 0.0f) {
+                    MixFloat32((float *)(dst + byteoffset), (const float *)(srcs[i] + byteoffset), volume, i == last, chunk);
+                }
+            }
+            continue;
+        }
+
+        ConvertAudioToFloat(accum, dst + byteoffset, chunk, format);
+        for (i = 0; i <= last; i++) {
+            const float volume = volumes ? volumes[i] : 1.0f;
+            if (volume != 0.0f) {
+                ConvertAudioToFloat(converted, srcs[i] + byteoffset, chunk, format);
+                MixFloat32(accum, converted, volume, i == last, chunk);
+            }
+        }
+        ConvertAudioFromFloat(dst + byteoffset, accum, chunk, format);
+    }
+
+    return true;
+}
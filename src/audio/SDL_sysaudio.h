@@ -140,6 +140,9 @@ extern int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidb
 // This is the bulk of `SDL_SetAudioStream*putChannelMap`'s work, but it lets you skip the check about changing the device end of a stream if isinput==-1.
 extern bool SetAudioStreamChannelMap(SDL_AudioStream *stream, const SDL_AudioSpec *spec, int **stream_chmap, const int *chmap, int channels, int isinput);
 
+// If you change a stream's src_spec directly instead of through SDL_SetAudioStreamFormat, call this afterwards (holding stream->lock) so a lock-free stream tags new data with the new format.
+extern void UpdateAudioStreamRingFormat(SDL_AudioStream *stream);
+
 
 typedef struct SDL_AudioDriverImpl
 {
@@ -193,6 +196,7 @@ typedef struct SDL_AudioDriver
 } SDL_AudioDriver;
 
 struct SDL_AudioQueue; // forward decl.
+struct SDL_AudioStreamRing; // forward decl.
 
 struct SDL_AudioStream
 {
@@ -222,8 +226,19 @@ struct SDL_AudioStream
     Uint8 *work_buffer;    // used for scratch space during data conversion/resampling.
     size_t work_buffer_allocation;
 
+    // Counters reported through SDL_GetAudioStreamProperties. Protected by `lock`, which getting data holds anyhow.
+    Uint64 stats_convert_ns;            // time spent converting/resampling in SDL_GetAudioStreamData.
+    Uint64 stats_frames_converted;      // output sample frames produced.
+    Uint64 stats_queued_high_water;     // most input bytes ever queued at once.
+    Uint64 stats_work_buffer_reallocs;  // times work_buffer had to grow.
+
+    bool queue_preallocated;  // true if created with SDL_PROP_AUDIOSTREAM_CREATE_PREALLOCATE_NUMBER.
+    Uint64 last_trim_ns;  // when unused queue memory was last given back.
+
     bool simplified;  // true if created via SDL_OpenAudioDeviceStream
 
+    struct SDL_AudioStreamRing *ring;  // non-NULL if created with SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BOOLEAN.
+
     SDL_LogicalAudioDevice *bound_device;
     SDL_AudioStream *next_binding;
     SDL_AudioStream *prev_binding;
@@ -270,6 +285,8 @@ struct SDL_LogicalAudioDevice
     SDL_LogicalAudioDevice *prev;
 };
 
+struct SDL_AudioMixPool; // forward decl.
+
 struct SDL_AudioDevice
 {
     // A mutex for locking access to this struct
@@ -336,6 +353,20 @@ struct SDL_AudioDevice
     // A thread to feed the audio device
     SDL_Thread *thread;
 
+    // Optional helper threads that convert bound streams in parallel (see SDL_HINT_AUDIO_DEVICE_MIXING_THREADS). NULL if unused.
+    struct SDL_AudioMixPool *mix_pool;
+
+    // Counters reported through SDL_GetAudioDeviceProperties. Protected by `lock`, which the device thread holds for each iteration anyhow.
+    Uint64 last_iterate_ns;       // when the previous iteration started, 0 if there wasn't one since the device opened.
+    Uint64 stats_periods;         // number of iterations since the device opened.
+    Uint64 stats_late_wakeups;    // iterations that started more than half a period late.
+    Uint64 stats_max_interval_ns; // longest gap between the start of two iterations.
+    Uint64 stats_process_ns;      // total time spent inside iterations.
+    Uint64 stats_max_process_ns;  // longest single iteration.
+
+    // Properties for SDL_GetAudioDeviceProperties; 0 until someone asks for them.
+    SDL_PropertiesID props;
+
     // true if this physical device is currently opened by the backend.
     bool currently_opened;
 
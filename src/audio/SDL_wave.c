@@ -496,7 +496,7 @@ static Sint16 MS_ADPCM_ProcessNibble(MS_ADPCM_ChannelState *cstate, Sint32 sampl
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
     const Uint16 max_deltaval = 65535;
-    const Uint16 adaptive[] = {
+    static const Uint16 adaptive[] = {
         230, 230, 230, 230, 307, 409, 512, 614,
         768, 614, 512, 409, 307, 230, 230, 230
     };
@@ -605,6 +605,53 @@ static bool MS_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
         blockframesleft = state->framesleft;
     }
 
+    /* Whole bytes hold two mono or one stereo sample frame. They get decoded
+     * with the channel states and previous samples kept in locals, stereo
+     * working on both channels at once. Whatever's left over goes through the
+     * generic loop below.
+     */
+    if (channels == 1) {
+        MS_ADPCM_ChannelState mono = cstate[0];
+        sample1 = state->output.data[outpos - 1];
+        sample2 = state->output.data[outpos - 2];
+
+        while (blockframesleft >= 2 && blockpos < blocksize) {
+            const Uint8 byte = state->block.data[blockpos++];
+            sample2 = MS_ADPCM_ProcessNibble(&mono, sample1, sample2, byte >> 4);
+            sample1 = MS_ADPCM_ProcessNibble(&mono, sample2, sample1, byte & 0x0f);
+            state->output.data[outpos++] = sample2;
+            state->output.data[outpos++] = sample1;
+            blockframesleft -= 2;
+            state->framesleft -= 2;
+        }
+
+        cstate[0] = mono;
+    } else if (channels == 2) {
+        MS_ADPCM_ChannelState left = cstate[0];
+        MS_ADPCM_ChannelState right = cstate[1];
+        Sint16 left1 = state->output.data[outpos - 2];
+        Sint16 left2 = state->output.data[outpos - 4];
+        Sint16 right1 = state->output.data[outpos - 1];
+        Sint16 right2 = state->output.data[outpos - 3];
+
+        while (blockframesleft > 0 && blockpos < blocksize) {
+            const Uint8 byte = state->block.data[blockpos++];
+            const Sint16 newleft = MS_ADPCM_ProcessNibble(&left, left1, left2, byte >> 4);
+            const Sint16 newright = MS_ADPCM_ProcessNibble(&right, right1, right2, byte & 0x0f);
+            state->output.data[outpos++] = newleft;
+            state->output.data[outpos++] = newright;
+            left2 = left1;
+            left1 = newleft;
+            right2 = right1;
+            right1 = newright;
+            blockframesleft--;
+            state->framesleft--;
+        }
+
+        cstate[0] = left;
+        cstate[1] = right;
+    }
+
     while (blockframesleft > 0) {
         for (c = 0; c < channels; c++) {
             if (nybble & 0x4000) {
@@ -855,13 +902,13 @@ static Sint16 IMA_ADPCM_ProcessNibble(Sint8 *cindex, Sint16 lastsample, Uint8 ny
 {
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
-    const Sint8 index_table_4b[16] = {
+    static const Sint8 index_table_4b[16] = {
         -1, -1, -1, -1,
         2, 4, 6, 8,
         -1, -1, -1, -1,
         2, 4, 6, 8
     };
-    const Uint16 step_table[89] = {
+    static const Uint16 step_table[89] = {
         7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
         34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
         143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
@@ -967,6 +1014,7 @@ static bool IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
     Uint64 bytesrequired;
     Uint32 c;
     bool result = true;
+    Sint8 *cstate = (Sint8 *)state->cstate;
 
     size_t blockpos = state->block.pos;
     size_t blocksize = state->block.size;
@@ -992,6 +1040,38 @@ static bool IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
         result = false;
     }
 
+    /* Stereo decodes the 32-bit blocks of both channels at once, so the two
+     * independent chains of samples can overlap in the CPU.
+     */
+    if (channels == 2) {
+        Sint8 leftindex = cstate[0];
+        Sint8 rightindex = cstate[1];
+        Sint16 left = state->output.data[outpos - 2];
+        Sint16 right = state->output.data[outpos - 1];
+
+        while (blockframesleft >= 8) {
+            const Uint8 *data = state->block.data + blockpos;
+            Uint32 leftnybbles = data[0] | ((Uint32)data[1] << 8) | ((Uint32)data[2] << 16) | ((Uint32)data[3] << 24);
+            Uint32 rightnybbles = data[4] | ((Uint32)data[5] << 8) | ((Uint32)data[6] << 16) | ((Uint32)data[7] << 24);
+
+            for (i = 0; i < 8; i++) {
+                left = IMA_ADPCM_ProcessNibble(&leftindex, left, leftnybbles & 0x0f);
+                right = IMA_ADPCM_ProcessNibble(&rightindex, right, rightnybbles & 0x0f);
+                state->output.data[outpos++] = left;
+                state->output.data[outpos++] = right;
+                leftnybbles >>= 4;
+                rightnybbles >>= 4;
+            }
+
+            blockpos += 8;
+            state->framesleft -= 8;
+            blockframesleft -= 8;
+        }
+
+        cstate[0] = leftindex;
+        cstate[1] = rightindex;
+    }
+
     /* Each channel has their nibbles packed into 32-bit blocks. These blocks
      * are interleaved and make up the data part of the ADPCM block. This loop
      * decodes the samples as they come from the input data and puts them at
@@ -1004,6 +1084,8 @@ static bool IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
             Uint8 nybble = 0;
             // Load previous sample which may come from the block header.
             Sint16 sample = state->output.data[outpos + c - channels];
+            // A local copy of the index doesn't have to be reloaded after every store to the output.
+            Sint8 index = cstate[c];
 
             for (i = 0; i < subblocksamples; i++) {
                 if (i & 1) {
@@ -1012,9 +1094,11 @@ static bool IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
                     nybble = state->block.data[blockpos++];
                 }
 
-                sample = IMA_ADPCM_ProcessNibble((Sint8 *)state->cstate + c, sample, nybble & 0x0f);
+                sample = IMA_ADPCM_ProcessNibble(&index, sample, nybble & 0x0f);
                 state->output.data[outpos + c + i * channels] = sample;
             }
+
+            cstate[c] = index;
         }
 
         outpos += channels * subblocksamples;
@@ -1159,7 +1243,125 @@ static bool LAW_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
-static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+/* The SIMD decoders compute the same thing as the scalar code below, 16
+ * samples at a time. They work from the back like the scalar code, so they can
+ * decode in-place, and return the number of samples at the front that are left
+ * for the scalar code.
+ *
+ * For both encodings, the magnitude is an expanded mantissa shifted left by the
+ * exponent (0 to 7), and the sign is in the top bit.
+ */
+#ifdef SDL_SSE2_INTRINSICS
+static __m128i SDL_TARGETING("sse2") LAW_ShiftLeft_SSE2(__m128i value, __m128i shift)
+{
+    // SSE2 can't shift lanes by different amounts, so this selects the shifted values bit by bit.
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i two = _mm_set1_epi16(2);
+    const __m128i four = _mm_set1_epi16(4);
+    __m128i mask;
+
+    mask = _mm_cmpeq_epi16(_mm_and_si128(shift, one), one);
+    value = _mm_add_epi16(value, _mm_and_si128(mask, value));
+    mask = _mm_cmpeq_epi16(_mm_and_si128(shift, two), two);
+    value = _mm_or_si128(_mm_andnot_si128(mask, value), _mm_and_si128(mask, _mm_slli_epi16(value, 2)));
+    mask = _mm_cmpeq_epi16(_mm_and_si128(shift, four), four);
+    value = _mm_or_si128(_mm_andnot_si128(mask, value), _mm_and_si128(mask, _mm_slli_epi16(value, 4)));
+    return value;
+}
+
+static __m128i SDL_TARGETING("sse2") LAW_Decode8_SSE2(Uint16 encoding, __m128i bytes)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nibblemask = _mm_set1_epi16(0x0f);
+    const __m128i signbit = _mm_set1_epi16(0x80);
+    __m128i mantissa, exponent, negative;
+
+    if (encoding == ALAW_CODE) {
+        const __m128i x = _mm_xor_si128(_mm_andnot_si128(signbit, bytes), _mm_set1_epi16(0x55));
+        exponent = _mm_srli_epi16(x, 4);
+        mantissa = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(x, nibblemask), 4), _mm_set1_epi16(0x8));
+        mantissa = _mm_or_si128(mantissa, _mm_and_si128(_mm_cmpgt_epi16(exponent, zero), _mm_set1_epi16(0x100)));
+        mantissa = LAW_ShiftLeft_SSE2(mantissa, _mm_subs_epu16(exponent, _mm_set1_epi16(1)));
+        negative = _mm_cmpeq_epi16(_mm_and_si128(bytes, signbit), zero);
+    } else {
+        const __m128i x = _mm_xor_si128(bytes, _mm_set1_epi16(0xff));
+        const __m128i bias = _mm_set1_epi16(0x84);
+        exponent = _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi16(0x7));
+        mantissa = _mm_add_epi16(_mm_slli_epi16(_mm_and_si128(x, nibblemask), 3), bias);
+        mantissa = _mm_sub_epi16(LAW_ShiftLeft_SSE2(mantissa, exponent), bias);
+        negative = _mm_cmpeq_epi16(_mm_and_si128(x, signbit), signbit);
+    }
+
+    return _mm_sub_epi16(_mm_xor_si128(mantissa, negative), negative);
+}
+
+static size_t SDL_TARGETING("sse2") LAW_DecodeSamples_SSE2(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t sample_count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = sample_count;
+
+    while (i >= 16) {
+        const __m128i bytes = _mm_loadu_si128((const __m128i *)(src + i - 16));
+        const __m128i lo = LAW_Decode8_SSE2(encoding, _mm_unpacklo_epi8(bytes, zero));
+        const __m128i hi = LAW_Decode8_SSE2(encoding, _mm_unpackhi_epi8(bytes, zero));
+        i -= 16;
+        _mm_storeu_si128((__m128i *)(dst + i), lo);
+        _mm_storeu_si128((__m128i *)(dst + i + 8), hi);
+    }
+
+    return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int16x8_t LAW_Decode8_NEON(Uint16 encoding, uint16x8_t bytes)
+{
+    const uint16x8_t nibblemask = vdupq_n_u16(0x0f);
+    const uint16x8_t signbit = vdupq_n_u16(0x80);
+    uint16x8_t mantissa, exponent, negative;
+    int16x8_t value;
+
+    if (encoding == ALAW_CODE) {
+        const uint16x8_t x = veorq_u16(vbicq_u16(bytes, signbit), vdupq_n_u16(0x55));
+        exponent = vshrq_n_u16(x, 4);
+        mantissa = vorrq_u16(vshlq_n_u16(vandq_u16(x, nibblemask), 4), vdupq_n_u16(0x8));
+        mantissa = vorrq_u16(mantissa, vandq_u16(vcgtq_u16(exponent, vdupq_n_u16(0)), vdupq_n_u16(0x100)));
+        mantissa = vshlq_u16(mantissa, vreinterpretq_s16_u16(vqsubq_u16(exponent, vdupq_n_u16(1))));
+        negative = vceqq_u16(vandq_u16(bytes, signbit), vdupq_n_u16(0));
+    } else {
+        const uint16x8_t x = veorq_u16(bytes, vdupq_n_u16(0xff));
+        const uint16x8_t bias = vdupq_n_u16(0x84);
+        exponent = vandq_u16(vshrq_n_u16(x, 4), vdupq_n_u16(0x7));
+        mantissa = vaddq_u16(vshlq_n_u16(vandq_u16(x, nibblemask), 3), bias);
+        mantissa = vsubq_u16(vshlq_u16(mantissa, vreinterpretq_s16_u16(exponent)), bias);
+        negative = vtstq_u16(x, signbit);
+    }
+
+    value = vreinterpretq_s16_u16(mantissa);
+    return vbslq_s16(negative, vnegq_s16(value), value);
+}
+
+static size_t LAW_DecodeSamples_NEON(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t sample_count)
+{
+    size_t i = sample_count;
+
+    while (i >= 16) {
+        const uint8x16_t bytes = vld1q_u8(src + i - 16);
+        const int16x8_t lo = LAW_Decode8_NEON(encoding, vmovl_u8(vget_low_u8(bytes)));
+        const int16x8_t hi = LAW_Decode8_NEON(encoding, vmovl_u8(vget_high_u8(bytes)));
+        i -= 16;
+        vst1q_s16(dst + i, lo);
+        vst1q_s16(dst + i + 8, hi);
+    }
+
+    return i;
+}
+#endif
+
+/* Expands companded samples to 16-bit samples. This works backwards, so dst
+ * can point to the same buffer as src.
+ */
+static bool LAW_DecodeSamples(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t sample_count)
 {
 #ifdef SDL_WAVE_LAW_LUT
     const Sint16 alaw_lut[256] = {
@@ -1200,53 +1402,28 @@ static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     };
 #endif
 
-    WaveFormat *format = &file->format;
-    WaveChunk *chunk = &file->chunk;
-    size_t i, sample_count, expanded_len;
-    Uint8 *src;
-    Sint16 *dst;
+    size_t i = sample_count;
 
-    if (chunk->length != chunk->size) {
-        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
-        if (file->sampleframes < 0) {
-            return false;
-        }
-    }
-
-    // Nothing to decode, nothing to return.
-    if (file->sampleframes == 0) {
-        *audio_buf = NULL;
-        *audio_len = 0;
-        return true;
-    }
-
-    sample_count = (size_t)file->sampleframes;
-    if (SafeMult(&sample_count, format->channels)) {
-        return SDL_SetError("WAVE file too big");
+    if (encoding != ALAW_CODE && encoding != MULAW_CODE) {
+        return SDL_SetError("Unknown companded encoding");
     }
 
-    expanded_len = sample_count;
-    if (SafeMult(&expanded_len, sizeof(Sint16))) {
-        return SDL_SetError("WAVE file too big");
-    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
-        return SDL_SetError("WAVE file too big");
+    /* The SIMD decoders take care of the back of the buffer, leaving less than
+     * 16 samples at the front. Since both work backwards, this is still safe
+     * in-place: a vector is loaded before anything is stored over it.
+     */
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        i = LAW_DecodeSamples_SSE2(encoding, src, dst, i);
     }
-
-    // 1 to avoid allocating zero bytes, to keep static analysis happy.
-    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
-    if (!src) {
-        return false;
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i = LAW_DecodeSamples_NEON(encoding, src, dst, i);
     }
-    chunk->data = NULL;
-    chunk->size = 0;
-
-    dst = (Sint16 *)src;
+#endif
 
-    /* Work backwards, since we're expanding in-place. `format` will
-     * inform the caller about the byte order.
-     */
-    i = sample_count;
-    switch (file->format.encoding) {
+    switch (encoding) {
 #ifdef SDL_WAVE_LAW_LUT
     case ALAW_CODE:
         while (i--) {
@@ -1291,8 +1468,60 @@ static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         break;
 #endif
     default:
+        break;
+    }
+
+    return true;
+}
+
+static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    size_t sample_count, expanded_len;
+    Uint8 *src;
+    Sint16 *dst;
+
+    if (chunk->length != chunk->size) {
+        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
+        if (file->sampleframes < 0) {
+            return false;
+        }
+    }
+
+    // Nothing to decode, nothing to return.
+    if (file->sampleframes == 0) {
+        *audio_buf = NULL;
+        *audio_len = 0;
+        return true;
+    }
+
+    sample_count = (size_t)file->sampleframes;
+    if (SafeMult(&sample_count, format->channels)) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    expanded_len = sample_count;
+    if (SafeMult(&expanded_len, sizeof(Sint16))) {
+        return SDL_SetError("WAVE file too big");
+    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    // 1 to avoid allocating zero bytes, to keep static analysis happy.
+    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
+    if (!src) {
+        return false;
+    }
+    chunk->data = NULL;
+    chunk->size = 0;
+
+    dst = (Sint16 *)src;
+
+    // Expanding in-place. `format` will inform the caller about the byte order.
+    if (!LAW_DecodeSamples(file->format.encoding, src, dst, sample_count)) {
         SDL_free(src);
-        return SDL_SetError("Unknown companded encoding");
+        return false;
     }
 
     *audio_buf = src;
@@ -1344,11 +1573,33 @@ static bool PCM_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
+// Shifts 24-bit samples to 32 bits, in-place. The buffer must have room for the expanded samples.
+static void PCM_ExpandSint24ToSint32(Uint8 *ptr, size_t sample_count)
+{
+    size_t i;
+
+    // work from end to start, since we're expanding in-place.
+    for (i = sample_count; i > 0; i--) {
+        const size_t o = i - 1;
+        uint8_t b[4];
+
+        b[0] = 0;
+        b[1] = ptr[o * 3];
+        b[2] = ptr[o * 3 + 1];
+        b[3] = ptr[o * 3 + 2];
+
+        ptr[o * 4 + 0] = b[0];
+        ptr[o * 4 + 1] = b[1];
+        ptr[o * 4 + 2] = b[2];
+        ptr[o * 4 + 3] = b[3];
+    }
+}
+
 static bool PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, expanded_len, sample_count;
+    size_t expanded_len, sample_count;
     Uint8 *ptr;
 
     sample_count = (size_t)file->sampleframes;
@@ -1376,21 +1627,7 @@ static bool PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32
     *audio_buf = ptr;
     *audio_len = (Uint32)expanded_len;
 
-    // work from end to start, since we're expanding in-place.
-    for (i = sample_count; i > 0; i--) {
-        const size_t o = i - 1;
-        uint8_t b[4];
-
-        b[0] = 0;
-        b[1] = ptr[o * 3];
-        b[2] = ptr[o * 3 + 1];
-        b[3] = ptr[o * 3 + 2];
-
-        ptr[o * 4 + 0] = b[0];
-        ptr[o * 4 + 1] = b[1];
-        ptr[o * 4 + 2] = b[2];
-        ptr[o * 4 + 3] = b[3];
-    }
+    PCM_ExpandSint24ToSint32(ptr, sample_count);
 
     return true;
 }
@@ -1770,7 +2007,11 @@ static bool WaveCheckFormat(WaveFile *file, size_t datalength)
     return true;
 }
 
-static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+/* Finds the fmt and data chunks and checks the format. On success, file->chunk
+ * describes the data chunk (its data isn't read) and endposition is set to the
+ * position after the WAVE file in the stream.
+ */
+static bool WaveParse(SDL_IOStream *src, WaveFile *file, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1778,7 +2019,6 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
     const char *hint;
     Sint64 RIFFstart, RIFFend, lastchunkpos;
     bool RIFFlengthknown = false;
-    WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
     WaveChunk RIFFchunk;
     WaveChunk fmtchunk;
@@ -1981,9 +2221,75 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
 
     WaveFreeChunkData(chunk);
 
-    // Process data chunk.
+    // The data chunk is processed by the caller.
     *chunk = datachunk;
 
+    if (RIFFlengthknown) {
+        *endposition = RIFFend;
+    } else {
+        *endposition = lastchunkpos;
+    }
+
+    return true;
+}
+
+static bool WaveGetSpec(WaveFile *file, SDL_AudioSpec *spec)
+{
+    WaveFormat *format = &file->format;
+
+    /* Setting up the specs. All unsupported formats were filtered out
+     * by WaveCheckFormat.
+     */
+    spec->freq = format->frequency;
+    spec->channels = (Uint8)format->channels;
+    spec->format = SDL_AUDIO_UNKNOWN;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    case ALAW_CODE:
+    case MULAW_CODE:
+        // These can be easily stored in the byte order of the system.
+        spec->format = SDL_AUDIO_S16;
+        break;
+    case IEEE_FLOAT_CODE:
+        spec->format = SDL_AUDIO_F32LE;
+        break;
+    case PCM_CODE:
+        switch (format->bitspersample) {
+        case 8:
+            spec->format = SDL_AUDIO_U8;
+            break;
+        case 16:
+            spec->format = SDL_AUDIO_S16LE;
+            break;
+        case 24: // Has been shifted to 32 bits.
+        case 32:
+            spec->format = SDL_AUDIO_S32LE;
+            break;
+        default:
+            // Just in case something unexpected happened in the checks.
+            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
+        }
+        break;
+    default:
+        return SDL_SetError("Unexpected data format");
+    }
+
+    return true;
+}
+
+static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+
+    if (!WaveParse(src, file, &endposition)) {
+        return false;
+    }
+
     if (chunk->length > 0) {
         result = WaveReadChunkData(src, chunk);
         if (result < 0) {
@@ -2027,51 +2333,12 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
         break;
     }
 
-    /* Setting up the specs. All unsupported formats were filtered out
-     * by checks earlier in this function.
-     */
-    spec->freq = format->frequency;
-    spec->channels = (Uint8)format->channels;
-    spec->format = SDL_AUDIO_UNKNOWN;
-
-    switch (format->encoding) {
-    case MS_ADPCM_CODE:
-    case IMA_ADPCM_CODE:
-    case ALAW_CODE:
-    case MULAW_CODE:
-        // These can be easily stored in the byte order of the system.
-        spec->format = SDL_AUDIO_S16;
-        break;
-    case IEEE_FLOAT_CODE:
-        spec->format = SDL_AUDIO_F32LE;
-        break;
-    case PCM_CODE:
-        switch (format->bitspersample) {
-        case 8:
-            spec->format = SDL_AUDIO_U8;
-            break;
-        case 16:
-            spec->format = SDL_AUDIO_S16LE;
-            break;
-        case 24: // Has been shifted to 32 bits.
-        case 32:
-            spec->format = SDL_AUDIO_S32LE;
-            break;
-        default:
-            // Just in case something unexpected happened in the checks.
-            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
-        }
-        break;
-    default:
-        return SDL_SetError("Unexpected data format");
+    if (!WaveGetSpec(file, spec)) {
+        return false;
     }
 
     // Report the end position back to the cleanup code.
-    if (RIFFlengthknown) {
-        chunk->position = RIFFend;
-    } else {
-        chunk->position = lastchunkpos;
-    }
+    chunk->position = endposition;
 
     return true;
 }
@@ -2135,3 +2402,364 @@ bool SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint3
     return SDL_LoadWAV_IO(SDL_IOFromFile(path, "rb"), 1, spec, audio_buf, audio_len);
 }
 
+
+/* Streaming WAVE decoding. The chunks are parsed once, then the data is read
+ * and decoded a block at a time whenever the audio stream asks for more.
+ */
+
+// PCM and companded data don't have blocks of their own, so they get decoded this many sample frames at a time.
+#define WAVE_STREAM_FRAMES_PER_BLOCK 4096
+
+#define WAVE_STREAM_PROPERTY "SDL.audiostream.wave"
+
+typedef struct WaveStream
+{
+    SDL_IOStream *src;
+    bool closeio;
+    WaveFile file;
+
+    Sint64 dataposition; // Position of the data chunk in the stream.
+    Uint64 datasize;     // Number of bytes of the data chunk that are actually in the stream.
+    Sint64 frames;       // Number of sample frames that will be decoded.
+    Sint64 nextframe;    // The next sample frame to put into the audio stream.
+    bool flushed;        // The audio stream was flushed after the last sample frame.
+
+    size_t blocksize;      // Size of an encoded block in bytes.
+    size_t framesperblock; // Number of sample frames in an encoded block.
+    size_t inframesize;    // Size of an encoded PCM or companded sample frame in bytes.
+    size_t outframesize;   // Size of a decoded sample frame in bytes.
+
+    Uint8 *block;   // The encoded block. PCM and companded data get decoded in-place.
+    Sint16 *output; // The decoded ADPCM block.
+    void *cstate;   // Decoding state for each ADPCM channel.
+} WaveStream;
+
+static void WaveStreamFree(WaveStream *ws)
+{
+    if (ws->closeio) {
+        SDL_CloseIO(ws->src);
+    }
+    WaveFreeChunkData(&ws->file.chunk);
+    SDL_free(ws->file.decoderdata);
+    SDL_free(ws->block);
+    SDL_free(ws->output);
+    SDL_free(ws->cstate);
+    SDL_free(ws);
+}
+
+static bool WaveStreamInit(WaveStream *ws, SDL_AudioSpec *spec)
+{
+    WaveFile *file = &ws->file;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    Sint64 endposition, streamsize;
+    size_t buffersize;
+
+    if (!WaveParse(ws->src, file, &endposition)) {
+        return false;
+    }
+
+    ws->dataposition = chunk->position;
+    ws->datasize = chunk->length;
+
+    // Without the data in memory, the size of the stream is the only way to find out if it's truncated.
+    streamsize = SDL_GetIOSize(ws->src);
+    if (streamsize >= 0) {
+        ws->datasize = streamsize > chunk->position ? SDL_min((Uint64)chunk->length, (Uint64)(streamsize - chunk->position)) : 0;
+    }
+
+    if (ws->datasize != chunk->length) {
+        // I/O issues or corrupt file.
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Could not read data of WAVE data chunk");
+        }
+
+        // Recalculate the number of sample frames the same way the decoders do.
+        switch (format->encoding) {
+        case MS_ADPCM_CODE:
+            if (!MS_ADPCM_CalculateSampleFrames(file, (size_t)ws->datasize)) {
+                return false;
+            }
+            break;
+        case IMA_ADPCM_CODE:
+            if (!IMA_ADPCM_CalculateSampleFrames(file, (size_t)ws->datasize)) {
+                return false;
+            }
+            break;
+        default:
+            file->sampleframes = WaveAdjustToFactValue(file, ws->datasize / format->blockalign);
+            if (file->sampleframes < 0) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    if (!WaveGetSpec(file, spec)) {
+        return false;
+    }
+
+    ws->outframesize = SDL_AUDIO_FRAMESIZE(*spec);
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        ws->blocksize = format->blockalign;
+        ws->framesperblock = format->samplesperblock;
+        ws->frames = file->sampleframes;
+        buffersize = ws->blocksize;
+
+        ws->output = (Sint16 *)SDL_malloc(ws->framesperblock * ws->outframesize);
+        // Big enough for the channel state of either decoder.
+        ws->cstate = SDL_calloc(format->channels, sizeof(MS_ADPCM_ChannelState));
+        if (!ws->output || !ws->cstate) {
+            return false;
+        }
+        break;
+    default:
+        /* The decoders count PCM and companded data in units of the block
+         * alignment, which is normally the size of a sample frame.
+         */
+        ws->inframesize = format->encoding == ALAW_CODE || format->encoding == MULAW_CODE ? format->channels : ((size_t)format->channels * format->bitspersample / 8);
+        ws->blocksize = WAVE_STREAM_FRAMES_PER_BLOCK * ws->inframesize;
+        ws->framesperblock = WAVE_STREAM_FRAMES_PER_BLOCK;
+        ws->frames = file->sampleframes * format->blockalign / (Sint64)ws->inframesize;
+        // The data is expanded in-place for 24-bit PCM and companded data.
+        buffersize = WAVE_STREAM_FRAMES_PER_BLOCK * ws->outframesize;
+        break;
+    }
+
+    ws->block = (Uint8 *)SDL_malloc(buffersize);
+    if (!ws->block) {
+        return false;
+    }
+
+    return true;
+}
+
+/* Reads and decodes an encoded block. Returns the number of sample frames
+ * decoded, which is less than expected if the data is truncated, or -1 on
+ * errors. `out` is set to the decoded data.
+ */
+static Sint64 WaveStreamDecodeBlock(WaveStream *ws, Sint64 blockindex, const Uint8 **out)
+{
+    WaveFile *file = &ws->file;
+    WaveFormat *format = &file->format;
+    const Uint64 offset = (Uint64)blockindex * ws->blocksize;
+    const Sint64 position = ws->dataposition + (Sint64)offset;
+    const size_t readsize = (size_t)SDL_min((Uint64)ws->blocksize, ws->datasize - offset);
+    Sint64 frames = SDL_min((Sint64)ws->framesperblock, ws->frames - blockindex * (Sint64)ws->framesperblock);
+    size_t blocklength;
+
+    if (SDL_SeekIO(ws->src, position, SDL_IO_SEEK_SET) != position) {
+        SDL_SetError("Could not seek to WAVE data");
+        return -1;
+    }
+
+    blocklength = SDL_ReadIO(ws->src, ws->block, readsize);
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    {
+        ADPCM_DecoderState state;
+        bool result;
+
+        SDL_zero(state);
+        state.channels = format->channels;
+        state.blocksize = format->blockalign;
+        state.blockheadersize = (size_t)state.channels * (format->encoding == MS_ADPCM_CODE ? 7 : 4);
+        state.samplesperblock = format->samplesperblock;
+        state.framesize = state.channels * sizeof(Sint16);
+        state.ddata = file->decoderdata;
+        state.cstate = ws->cstate;
+        state.framestotal = frames;
+        state.framesleft = frames;
+
+        state.block.data = ws->block;
+        state.block.size = blocklength;
+        state.block.pos = 0;
+
+        state.output.data = ws->output;
+        state.output.size = ws->framesperblock * state.channels;
+        state.output.pos = 0;
+
+        // A block too short for its header doesn't decode to anything.
+        if (frames <= 0 || blocklength < state.blockheadersize) {
+            return 0;
+        }
+
+        if (format->encoding == MS_ADPCM_CODE) {
+            if (!MS_ADPCM_DecodeBlockHeader(&state)) {
+                return -1;
+            }
+            result = MS_ADPCM_DecodeBlockData(&state);
+        } else {
+            result = IMA_ADPCM_DecodeBlockHeader(&state) && IMA_ADPCM_DecodeBlockData(&state);
+        }
+
+        if (!result) {
+            // Unexpected end. Return partial data if necessary.
+            if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+                SDL_SetError("Truncated data chunk");
+                return -1;
+            } else if (file->trunchint != TruncDropFrame) {
+                state.output.pos = 0;
+            }
+        }
+
+        frames = SDL_min(frames, (Sint64)(state.output.pos / state.channels));
+        *out = (const Uint8 *)ws->output;
+        break;
+    }
+    default:
+        frames = SDL_min(frames, (Sint64)(blocklength / ws->inframesize));
+        if (format->encoding == ALAW_CODE || format->encoding == MULAW_CODE) {
+            if (!LAW_DecodeSamples(format->encoding, ws->block, (Sint16 *)ws->block, (size_t)frames * format->channels)) {
+                return -1;
+            }
+        } else if (format->encoding == PCM_CODE && format->bitspersample == 24) {
+            PCM_ExpandSint24ToSint32(ws->block, (size_t)frames * format->channels);
+        }
+        *out = ws->block;
+        break;
+    }
+
+    return frames;
+}
+
+static void SDLCALL WaveStreamGetCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    WaveStream *ws = (WaveStream *)userdata;
+
+    while (additional_amount > 0 && ws->nextframe < ws->frames) {
+        const Sint64 blockindex = ws->nextframe / (Sint64)ws->framesperblock;
+        const Sint64 blockstart = blockindex * (Sint64)ws->framesperblock;
+        const Sint64 expected = SDL_min((Sint64)ws->framesperblock, ws->frames - blockstart);
+        const Sint64 skip = ws->nextframe - blockstart;
+        const Uint8 *data = NULL;
+        const Sint64 decoded = WaveStreamDecodeBlock(ws, blockindex, &data);
+        int len;
+
+        if (decoded > skip) {
+            len = (int)((decoded - skip) * (Sint64)ws->outframesize);
+            if (!SDL_PutAudioStreamData(stream, data + skip * (Sint64)ws->outframesize, len)) {
+                break;
+            }
+            ws->nextframe += decoded - skip;
+            additional_amount -= len;
+        }
+
+        // Errors and truncated data end the stream early.
+        if (decoded < expected) {
+            ws->nextframe = ws->frames;
+        }
+    }
+
+    if (ws->nextframe >= ws->frames && !ws->flushed) {
+        SDL_FlushAudioStream(stream);
+        ws->flushed = true;
+    }
+}
+
+static void SDLCALL WaveStreamCleanup(void *userdata, void *value)
+{
+    // Taking the stream's lock makes sure the get-callback isn't using the decoder anymore.
+    SDL_SetAudioStreamGetCallback((SDL_AudioStream *)userdata, NULL, NULL);
+    WaveStreamFree((WaveStream *)value);
+}
+
+SDL_AudioStream *SDL_OpenWAVStream_IO(SDL_IOStream *src, bool closeio, SDL_AudioSpec *spec, Sint64 *frames)
+{
+    WaveStream *ws = NULL;
+    SDL_AudioStream *stream = NULL;
+    SDL_AudioSpec wavespec;
+
+    if (spec) {
+        SDL_zerop(spec);
+    }
+    if (frames) {
+        *frames = 0;
+    }
+
+    // Make sure we are passed a valid data source
+    if (!src) {
+        return NULL; // Error may come from SDL_IOStream.
+    }
+
+    ws = (WaveStream *)SDL_calloc(1, sizeof(WaveStream));
+    if (!ws) {
+        if (closeio) {
+            SDL_CloseIO(src);
+        }
+        return NULL;
+    }
+
+    ws->src = src;
+    ws->closeio = closeio;
+    ws->file.riffhint = WaveGetRiffSizeHint();
+    ws->file.trunchint = WaveGetTruncationHint();
+    ws->file.facthint = WaveGetFactChunkHint();
+
+    SDL_zero(wavespec);
+    if (!WaveStreamInit(ws, &wavespec)) {
+        WaveStreamFree(ws);
+        return NULL;
+    }
+
+    // Nothing but the block buffers is needed from here on.
+    WaveFreeChunkData(&ws->file.chunk);
+
+    stream = SDL_CreateAudioStream(&wavespec, &wavespec);
+    if (!stream) {
+        WaveStreamFree(ws);
+        return NULL;
+    }
+
+    // The decoder is freed along with the stream's properties. This calls the cleanup on failure, too.
+    if (!SDL_SetPointerPropertyWithCleanup(SDL_GetAudioStreamProperties(stream), WAVE_STREAM_PROPERTY, ws, WaveStreamCleanup, stream)) {
+        SDL_DestroyAudioStream(stream);
+        return NULL;
+    }
+
+    SDL_SetAudioStreamGetCallback(stream, WaveStreamGetCallback, ws);
+
+    if (spec) {
+        SDL_copyp(spec, &wavespec);
+    }
+    if (frames) {
+        *frames = ws->frames;
+    }
+
+    return stream;
+}
+
+SDL_AudioStream *SDL_OpenWAVStream(const char *path, SDL_AudioSpec *spec, Sint64 *frames)
+{
+    return SDL_OpenWAVStream_IO(SDL_IOFromFile(path, "rb"), true, spec, frames);
+}
+
+bool SDL_SeekWAVStream(SDL_AudioStream *stream, Sint64 frame)
+{
+    WaveStream *ws;
+
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    ws = (WaveStream *)SDL_GetPointerProperty(SDL_GetAudioStreamProperties(stream), WAVE_STREAM_PROPERTY, NULL);
+    if (!ws) {
+        return SDL_SetError("Audio stream was not opened with SDL_OpenWAVStream_IO");
+    } else if (frame < 0 || frame > ws->frames) {
+        return SDL_InvalidParamError("frame");
+    }
+
+    // The get-callback runs with the stream locked, so this can't happen in the middle of decoding.
+    SDL_LockAudioStream(stream);
+    SDL_ClearAudioStream(stream);
+    ws->nextframe = frame;
+    ws->flushed = false;
+    SDL_UnlockAudioStream(stream);
+
+    return true;
+}
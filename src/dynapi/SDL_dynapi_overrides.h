@@ -63,6 +63,7 @@
 #define SDL_BlitGPUTexture SDL_BlitGPUTexture_REAL
 #define SDL_BlitSurface SDL_BlitSurface_REAL
 #define SDL_BlitSurface9Grid SDL_BlitSurface9Grid_REAL
+#define SDL_BlitSurfaceBatch SDL_BlitSurfaceBatch_REAL
 #define SDL_BlitSurfaceScaled SDL_BlitSurfaceScaled_REAL
 #define SDL_BlitSurfaceTiled SDL_BlitSurfaceTiled_REAL
 #define SDL_BlitSurfaceTiledWithScale SDL_BlitSurfaceTiledWithScale_REAL
@@ -102,6 +103,8 @@
 #define SDL_CopyProperties SDL_CopyProperties_REAL
 #define SDL_CopyStorageFile SDL_CopyStorageFile_REAL
 #define SDL_CreateAudioStream SDL_CreateAudioStream_REAL
+#define SDL_CreateAudioStreamWithProperties SDL_CreateAudioStreamWithProperties_REAL
+#define SDL_CreateBlitPlan SDL_CreateBlitPlan_REAL
 #define SDL_CreateColorCursor SDL_CreateColorCursor_REAL
 #define SDL_CreateCondition SDL_CreateCondition_REAL
 #define SDL_CreateCursor SDL_CreateCursor_REAL
@@ -119,6 +122,7 @@
 #define SDL_CreateHapticEffect SDL_CreateHapticEffect_REAL
 #define SDL_CreateMutex SDL_CreateMutex_REAL
 #define SDL_CreatePalette SDL_CreatePalette_REAL
+#define SDL_CreatePooledSurface SDL_CreatePooledSurface_REAL
 #define SDL_CreatePopupWindow SDL_CreatePopupWindow_REAL
 #define SDL_CreateProcess SDL_CreateProcess_REAL
 #define SDL_CreateProcessWithProperties SDL_CreateProcessWithProperties_REAL
@@ -132,6 +136,7 @@
 #define SDL_CreateSurface SDL_CreateSurface_REAL
 #define SDL_CreateSurfaceFrom SDL_CreateSurfaceFrom_REAL
 #define SDL_CreateSurfacePalette SDL_CreateSurfacePalette_REAL
+#define SDL_CreateSurfacePool SDL_CreateSurfacePool_REAL
 #define SDL_CreateSystemCursor SDL_CreateSystemCursor_REAL
 #define SDL_CreateTexture SDL_CreateTexture_REAL
 #define SDL_CreateTextureFromSurface SDL_CreateTextureFromSurface_REAL
@@ -146,6 +151,7 @@
 #define SDL_Delay SDL_Delay_REAL
 #define SDL_DelayNS SDL_DelayNS_REAL
 #define SDL_DestroyAudioStream SDL_DestroyAudioStream_REAL
+#define SDL_DestroyBlitPlan SDL_DestroyBlitPlan_REAL
 #define SDL_DestroyCondition SDL_DestroyCondition_REAL
 #define SDL_DestroyCursor SDL_DestroyCursor_REAL
 #define SDL_DestroyEnvironment SDL_DestroyEnvironment_REAL
@@ -159,6 +165,7 @@
 #define SDL_DestroyRenderer SDL_DestroyRenderer_REAL
 #define SDL_DestroySemaphore SDL_DestroySemaphore_REAL
 #define SDL_DestroySurface SDL_DestroySurface_REAL
+#define SDL_DestroySurfacePool SDL_DestroySurfacePool_REAL
 #define SDL_DestroyTexture SDL_DestroyTexture_REAL
 #define SDL_DestroyWindow SDL_DestroyWindow_REAL
 #define SDL_DestroyWindowSurface SDL_DestroyWindowSurface_REAL
@@ -180,6 +187,7 @@
 #define SDL_EGL_GetWindowSurface SDL_EGL_GetWindowSurface_REAL
 #define SDL_EGL_SetAttributeCallbacks SDL_EGL_SetAttributeCallbacks_REAL
 #define SDL_EnableScreenSaver SDL_EnableScreenSaver_REAL
+#define SDL_EncodeSurfaceRLE SDL_EncodeSurfaceRLE_REAL
 #define SDL_EndGPUComputePass SDL_EndGPUComputePass_REAL
 #define SDL_EndGPUCopyPass SDL_EndGPUCopyPass_REAL
 #define SDL_EndGPURenderPass SDL_EndGPURenderPass_REAL
@@ -246,6 +254,7 @@
 #define SDL_GetAudioDeviceFormat SDL_GetAudioDeviceFormat_REAL
 #define SDL_GetAudioDeviceGain SDL_GetAudioDeviceGain_REAL
 #define SDL_GetAudioDeviceName SDL_GetAudioDeviceName_REAL
+#define SDL_GetAudioDeviceProperties SDL_GetAudioDeviceProperties_REAL
 #define SDL_GetAudioDriver SDL_GetAudioDriver_REAL
 #define SDL_GetAudioFormatName SDL_GetAudioFormatName_REAL
 #define SDL_GetAudioPlaybackDevices SDL_GetAudioPlaybackDevices_REAL
@@ -524,6 +533,7 @@
 #define SDL_GetSurfaceColorspace SDL_GetSurfaceColorspace_REAL
 #define SDL_GetSurfaceImages SDL_GetSurfaceImages_REAL
 #define SDL_GetSurfacePalette SDL_GetSurfacePalette_REAL
+#define SDL_GetSurfacePoolStats SDL_GetSurfacePoolStats_REAL
 #define SDL_GetSurfaceProperties SDL_GetSurfaceProperties_REAL
 #define SDL_GetSystemRAM SDL_GetSystemRAM_REAL
 #define SDL_GetSystemTheme SDL_GetSystemTheme_REAL
@@ -573,6 +583,7 @@
 #define SDL_GetWindowSize SDL_GetWindowSize_REAL
 #define SDL_GetWindowSizeInPixels SDL_GetWindowSizeInPixels_REAL
 #define SDL_GetWindowSurface SDL_GetWindowSurface_REAL
+#define SDL_GetWindowSurfaceDamage SDL_GetWindowSurfaceDamage_REAL
 #define SDL_GetWindowSurfaceVSync SDL_GetWindowSurfaceVSync_REAL
 #define SDL_GetWindowTitle SDL_GetWindowTitle_REAL
 #define SDL_GetWindows SDL_GetWindows_REAL
@@ -671,6 +682,7 @@
 #define SDL_Metal_GetLayer SDL_Metal_GetLayer_REAL
 #define SDL_MinimizeWindow SDL_MinimizeWindow_REAL
 #define SDL_MixAudio SDL_MixAudio_REAL
+#define SDL_MixAudioBatch SDL_MixAudioBatch_REAL
 #define SDL_OnApplicationDidChangeStatusBarOrientation SDL_OnApplicationDidChangeStatusBarOrientation_REAL
 #define SDL_OnApplicationDidEnterBackground SDL_OnApplicationDidEnterBackground_REAL
 #define SDL_OnApplicationDidEnterForeground SDL_OnApplicationDidEnterForeground_REAL
@@ -693,6 +705,8 @@
 #define SDL_OpenTitleStorage SDL_OpenTitleStorage_REAL
 #define SDL_OpenURL SDL_OpenURL_REAL
 #define SDL_OpenUserStorage SDL_OpenUserStorage_REAL
+#define SDL_OpenWAVStream SDL_OpenWAVStream_REAL
+#define SDL_OpenWAVStream_IO SDL_OpenWAVStream_IO_REAL
 #define SDL_OutOfMemory SDL_OutOfMemory_REAL
 #define SDL_PauseAudioDevice SDL_PauseAudioDevice_REAL
 #define SDL_PauseAudioStreamDevice SDL_PauseAudioStreamDevice_REAL
@@ -710,6 +724,7 @@
 #define SDL_PushGPUFragmentUniformData SDL_PushGPUFragmentUniformData_REAL
 #define SDL_PushGPUVertexUniformData SDL_PushGPUVertexUniformData_REAL
 #define SDL_PutAudioStreamData SDL_PutAudioStreamData_REAL
+#define SDL_PutAudioStreamDataNoCopy SDL_PutAudioStreamDataNoCopy_REAL
 #define SDL_QueryGPUFence SDL_QueryGPUFence_REAL
 #define SDL_Quit SDL_Quit_REAL
 #define SDL_QuitSubSystem SDL_QuitSubSystem_REAL
@@ -786,6 +801,7 @@
 #define SDL_ResumeAudioDevice SDL_ResumeAudioDevice_REAL
 #define SDL_ResumeAudioStreamDevice SDL_ResumeAudioStreamDevice_REAL
 #define SDL_ResumeHaptic SDL_ResumeHaptic_REAL
+#define SDL_RotateSurface90 SDL_RotateSurface90_REAL
 #define SDL_RumbleGamepad SDL_RumbleGamepad_REAL
 #define SDL_RumbleGamepadTriggers SDL_RumbleGamepadTriggers_REAL
 #define SDL_RumbleJoystick SDL_RumbleJoystick_REAL
@@ -798,6 +814,7 @@
 #define SDL_ScreenKeyboardShown SDL_ScreenKeyboardShown_REAL
 #define SDL_ScreenSaverEnabled SDL_ScreenSaverEnabled_REAL
 #define SDL_SeekIO SDL_SeekIO_REAL
+#define SDL_SeekWAVStream SDL_SeekWAVStream_REAL
 #define SDL_SendAndroidBackButton SDL_SendAndroidBackButton_REAL
 #define SDL_SendAndroidMessage SDL_SendAndroidMessage_REAL
 #define SDL_SendGamepadEffect SDL_SendGamepadEffect_REAL
@@ -973,6 +990,8 @@
 #define SDL_UnlockSurface SDL_UnlockSurface_REAL
 #define SDL_UnlockTexture SDL_UnlockTexture_REAL
 #define SDL_UnmapGPUTransferBuffer SDL_UnmapGPUTransferBuffer_REAL
+#define SDL_UnpremultiplyAlpha SDL_UnpremultiplyAlpha_REAL
+#define SDL_UnpremultiplySurfaceAlpha SDL_UnpremultiplySurfaceAlpha_REAL
 #define SDL_UnregisterApp SDL_UnregisterApp_REAL
 #define SDL_UnsetEnvironmentVariable SDL_UnsetEnvironmentVariable_REAL
 #define SDL_UpdateGamepads SDL_UpdateGamepads_REAL
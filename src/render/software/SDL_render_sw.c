@@ -680,6 +680,11 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
         return false;
     }
 
+    // The drawing functions below write to the pixels directly
+    if (!SDL_UnshareSurfacePixels(surface)) {
+        return false;
+    }
+
     drawstate.viewport = NULL;
     drawstate.cliprect = NULL;
     drawstate.surface_cliprect_dirty = true;
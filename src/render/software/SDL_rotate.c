@@ -171,82 +171,25 @@ void SDLgfx_rotozoomSurfaceSizeTrig(int width, int height, double angle, const S
     }
 }
 
-// Computes source pointer X/Y increments for a rotation that's a multiple of 90 degrees.
-static void computeSourceIncrements90(SDL_Surface *src, int bpp, int angle, int flipx, int flipy,
-                                      int *sincx, int *sincy, int *signx, int *signy)
+// Performs a fast rotation/flip when the angle is a multiple of 90 degrees.
+static void transformSurface90(SDL_Surface *src, SDL_Surface *dst, int angle, int flipx, int flipy)
 {
-    int pitch = flipy ? -src->pitch : src->pitch;
-    if (flipx) {
-        bpp = -bpp;
-    }
-    switch (angle) { // 0:0 deg, 1:90 deg, 2:180 deg, 3:270 deg
-    case 0:
-        *sincx = bpp;
-        *sincy = pitch - src->w * *sincx;
-        *signx = *signy = 1;
-        break;
-    case 1:
-        *sincx = -pitch;
-        *sincy = bpp - *sincx * src->h;
-        *signx = 1;
-        *signy = -1;
-        break;
-    case 2:
-        *sincx = -bpp;
-        *sincy = -src->w * *sincx - pitch;
-        *signx = *signy = -1;
-        break;
-    case 3:
-    default:
-        *sincx = pitch;
-        *sincy = -*sincx * src->h - bpp;
-        *signx = -1;
-        *signy = 1;
-        break;
-    }
-    if (flipx) {
-        *signx = -*signx;
-    }
-    if (flipy) {
-        *signy = -*signy;
-    }
-}
-
-// Performs a relatively fast rotation/flip when the angle is a multiple of 90 degrees.
-#define TRANSFORM_SURFACE_90(pixelType)                                                                     \
-    int dy, dincy = dst->pitch - dst->w * sizeof(pixelType), sincx, sincy, signx, signy;                    \
-    Uint8 *sp = (Uint8 *)src->pixels, *dp = (Uint8 *)dst->pixels, *de;                                      \
-                                                                                                            \
-    computeSourceIncrements90(src, sizeof(pixelType), angle, flipx, flipy, &sincx, &sincy, &signx, &signy); \
-    if (signx < 0)                                                                                          \
-        sp += (src->w - 1) * sizeof(pixelType);                                                             \
-    if (signy < 0)                                                                                          \
-        sp += (src->h - 1) * src->pitch;                                                                    \
-                                                                                                            \
-    for (dy = 0; dy < dst->h; sp += sincy, dp += dincy, dy++) {                                             \
-        if (sincx == sizeof(pixelType)) { /* if advancing src and dest equally, use SDL_memcpy */           \
-            SDL_memcpy(dp, sp, dst->w * sizeof(pixelType));                                                 \
-            sp += dst->w * sizeof(pixelType);                                                               \
-            dp += dst->w * sizeof(pixelType);                                                               \
-        } else {                                                                                            \
-            for (de = dp + dst->w * sizeof(pixelType); dp != de; sp += sincx, dp += sizeof(pixelType)) {    \
-                *(pixelType *)dp = *(pixelType *)sp;                                                        \
-            }                                                                                               \
-        }                                                                                                   \
+    // Flipping both ways is half a turn
+    if (flipx && flipy) {
+        angle = (angle + 2) % 4;
+        flipx = flipy = 0;
     }
 
-static void transformSurfaceRGBA90(SDL_Surface *src, SDL_Surface *dst, int angle, int flipx, int flipy)
-{
-    TRANSFORM_SURFACE_90(tColorRGBA);
-}
+    SDL_RotatePixels90(src->w, src->h, SDL_BYTESPERPIXEL(src->format), src->pixels, src->pitch, dst->pixels, dst->pitch, angle);
 
-static void transformSurfaceY90(SDL_Surface *src, SDL_Surface *dst, int angle, int flipx, int flipy)
-{
-    TRANSFORM_SURFACE_90(tColorY);
+    // The source is flipped before it's rotated, so a quarter turn swaps the directions
+    if (flipx) {
+        SDL_FlipSurface(dst, (angle & 1) ? SDL_FLIP_VERTICAL : SDL_FLIP_HORIZONTAL);
+    } else if (flipy) {
+        SDL_FlipSurface(dst, (angle & 1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_VERTICAL);
+    }
 }
 
-#undef TRANSFORM_SURFACE_90
-
 /**
 Internal 32 bit rotozoomer with optional anti-aliasing.
 
@@ -585,7 +528,7 @@ SDL_Surface *SDLgfx_rotateSurface(SDL_Surface *src, double angle, int smooth, in
     if (is8bit) {
         // Call the 8-bit transformation routine to do the rotation
         if (angle90 >= 0) {
-            transformSurfaceY90(src, rz_dst, angle90, flipx, flipy);
+            transformSurface90(src, rz_dst, angle90, flipx, flipy);
         } else {
             transformSurfaceY(src, rz_dst, (int)sangleinv, (int)cangleinv,
                               flipx, flipy, rect_dest, center);
@@ -593,7 +536,7 @@ SDL_Surface *SDLgfx_rotateSurface(SDL_Surface *src, double angle, int smooth, in
     } else {
         // Call the 32-bit transformation routine to do the rotation
         if (angle90 >= 0) {
-            transformSurfaceRGBA90(src, rz_dst, angle90, flipx, flipy);
+            transformSurface90(src, rz_dst, angle90, flipx, flipy);
         } else {
             transformSurfaceRGBA(src, rz_dst, (int)sangleinv, (int)cangleinv,
                                  flipx, flipy, smooth, rect_dest, center);
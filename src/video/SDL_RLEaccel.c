@@ -50,6 +50,10 @@
  * binary transparency and for per-surface alpha blending, and for surfaces
  * with per-pixel alpha. The details differ, however:
  *
+ * Both sequences begin with an SDL_PixelFormat value; for colorkeyed
+ * surfaces it's the format of the surface itself, for per-pixel alpha
+ * it describes the target pixel format, to provide reliable un-encoding.
+ *
  * Encoding of colorkeyed surfaces:
  *
  *   Encoded pixels always have the same format as the target surface.
@@ -62,9 +66,6 @@
  *
  * Encoding of surfaces with per-pixel alpha:
  *
- *   The sequence begins with an SDL_PixelFormat value describing the target
- *   pixel format, to provide reliable un-encoding.
- *
  *   Each scan line is encoded twice: First all completely opaque pixels,
  *   encoded in the target format as described above, and then all
  *   partially transparent (translucent) pixels (where 1 <= alpha <= 254),
@@ -107,24 +108,103 @@
  * remaining in parallel. This is safe to do because of the gap to the left
  * of each component, so the bits from the multiplication don't collide.
  * This can be used for any RGB permutation of course.
+ *
+ * Per component this is d + ((s - d) * alpha >> 8), which is the same as
+ * (d * (256 - alpha) + s * alpha) >> 8, and that is what the vectorized
+ * versions compute, 16 bits per component.
  */
-#define ALPHA_BLIT32_888(to, from, length, bpp, alpha)       \
-    do {                                                     \
-        int i;                                               \
-        Uint32 *src = (Uint32 *)(from);                      \
-        Uint32 *dst = (Uint32 *)(to);                        \
-        for (i = 0; i < (int)(length); i++) {                \
-            Uint32 s = *src++;                               \
-            Uint32 d = *dst;                                 \
-            Uint32 s1 = s & 0xff00ff;                        \
-            Uint32 d1 = d & 0xff00ff;                        \
-            d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff; \
-            s &= 0xff00;                                     \
-            d &= 0xff00;                                     \
-            d = (d + ((s - d) * alpha >> 8)) & 0xff00;       \
-            *dst++ = d1 | d;                                 \
-        }                                                    \
-    } while (0)
+typedef void (*SDL_RLEBlend32Func)(Uint32 *dst, const Uint32 *src, int n, unsigned alpha);
+
+static void RLEBlendAlpha888(Uint32 *dst, const Uint32 *src, int n, unsigned alpha)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        Uint32 s = *src++;
+        Uint32 d = *dst;
+        Uint32 s1 = s & 0xff00ff;
+        Uint32 d1 = d & 0xff00ff;
+        d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+        s &= 0xff00;
+        d &= 0xff00;
+        d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+        *dst++ = d1 | d;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+// blend 16-bit components: (d * (256 - a) + s * a) >> 8
+static __m128i SDL_TARGETING("sse2") RLEBlendComponents_SSE2(__m128i s, __m128i d, __m128i a)
+{
+    const __m128i ia = _mm_sub_epi16(_mm_set1_epi16(256), a);
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(d, ia), _mm_mullo_epi16(s, a)), 8);
+}
+
+static void SDL_TARGETING("sse2") RLEBlendAlpha888_SSE2(Uint32 *dst, const Uint32 *src, int n, unsigned alpha)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00ffffff);
+    const __m128i a = _mm_set1_epi16((short)alpha);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        const __m128i lo = RLEBlendComponents_SSE2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), a);
+        const __m128i hi = RLEBlendComponents_SSE2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), a);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_and_si128(_mm_packus_epi16(lo, hi), rgbmask));
+    }
+    RLEBlendAlpha888(dst + i, src + i, n - i, alpha);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+// blend 8-bit components: (d * (256 - a) + s * a) >> 8
+static uint8x16_t RLEBlendComponents_NEON(uint8x16_t s, uint8x16_t d, uint8x16_t a)
+{
+    const uint8x16_t ia = vmvnq_u8(a); // 255 - a, d is added once more below
+    uint16x8_t lo = vmull_u8(vget_low_u8(d), vget_low_u8(ia));
+    uint16x8_t hi = vmull_u8(vget_high_u8(d), vget_high_u8(ia));
+    lo = vaddw_u8(lo, vget_low_u8(d));
+    hi = vaddw_u8(hi, vget_high_u8(d));
+    lo = vmlal_u8(lo, vget_low_u8(s), vget_low_u8(a));
+    hi = vmlal_u8(hi, vget_high_u8(s), vget_high_u8(a));
+    return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+}
+
+static void RLEBlendAlpha888_NEON(Uint32 *dst, const Uint32 *src, int n, unsigned alpha)
+{
+    const uint32x4_t rgbmask = vdupq_n_u32(0x00ffffff);
+    const uint8x16_t a = vdupq_n_u8((Uint8)alpha);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const uint8x16_t s = vreinterpretq_u8_u32(vld1q_u32(src + i));
+        const uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        const uint32x4_t result = vreinterpretq_u32_u8(RLEBlendComponents_NEON(s, d, a));
+        vst1q_u32(dst + i, vandq_u32(result, rgbmask));
+    }
+    RLEBlendAlpha888(dst + i, src + i, n - i, alpha);
+}
+#endif
+
+static SDL_RLEBlend32Func SDL_GetRLEBlendAlpha888Func(void)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return RLEBlendAlpha888_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return RLEBlendAlpha888_NEON;
+    }
+#endif
+    return RLEBlendAlpha888;
+}
+
+// blend_888 is set up by the blitter using this
+#define ALPHA_BLIT32_888(to, from, length, bpp, alpha) \
+    blend_888((Uint32 *)(to), (const Uint32 *)(from), (int)(length), alpha)
 
 /*
  * For 16bpp pixels we can go a step further: put the middle component
@@ -435,6 +515,7 @@ static void RLEClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                         Uint8 *dstbuf, const SDL_Rect *srcrect, unsigned alpha)
 {
     const SDL_PixelFormatDetails *fmt = surf_dst->internal->format;
+    const SDL_RLEBlend32Func blend_888 = SDL_GetRLEBlendAlpha888Func();
 
     CHOOSE_BLIT(RLECLIPBLIT, alpha, fmt);
 }
@@ -513,6 +594,7 @@ static bool SDLCALL SDL_RLEBlit(SDL_Surface *surf_src, const SDL_Rect *srcrect,
         RLEClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect, alpha);
     } else {
         const SDL_PixelFormatDetails *fmt = surf_src->internal->format;
+        const SDL_RLEBlend32Func blend_888 = SDL_GetRLEBlendAlpha888Func();
 
 #define RLEBLIT(bpp, Type, do_blit)                                   \
     do {                                                              \
@@ -604,15 +686,96 @@ done:
         dst = (Uint16)(d | d >> 16);       \
     } while (0)
 
+// Each translucent pixel carries its own alpha, so the alpha argument is unused
+static void RLEBlendTransl888(Uint32 *dst, const Uint32 *src, int n, unsigned unused)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_888(src[i], dst[i]);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") RLEBlendTransl888_SSE2(Uint32 *dst, const Uint32 *src, int n, unsigned unused)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set1_epi32((int)0xff000000);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        const __m128i s_lo = _mm_unpacklo_epi8(s, zero);
+        const __m128i s_hi = _mm_unpackhi_epi8(s, zero);
+        // spread the alpha of each pixel to all of its components
+        const __m128i a_lo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i a_hi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s_hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i lo = RLEBlendComponents_SSE2(s_lo, _mm_unpacklo_epi8(d, zero), a_lo);
+        const __m128i hi = RLEBlendComponents_SSE2(s_hi, _mm_unpackhi_epi8(d, zero), a_hi);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_packus_epi16(lo, hi), opaque));
+    }
+    RLEBlendTransl888(dst + i, src + i, n - i, unused);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void RLEBlendTransl888_NEON(Uint32 *dst, const Uint32 *src, int n, unsigned unused)
+{
+    const uint32x4_t opaque = vdupq_n_u32(0xff000000);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const uint32x4_t s = vld1q_u32(src + i);
+        const uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+        // spread the alpha of each pixel to all of its components
+        const uint8x16_t a = vreinterpretq_u8_u32(vmulq_n_u32(vshrq_n_u32(s, 24), 0x01010101));
+        const uint32x4_t result = vreinterpretq_u32_u8(RLEBlendComponents_NEON(vreinterpretq_u8_u32(s), d, a));
+        vst1q_u32(dst + i, vorrq_u32(result, opaque));
+    }
+    RLEBlendTransl888(dst + i, src + i, n - i, unused);
+}
+#endif
+
+static SDL_RLEBlend32Func SDL_GetRLEBlendTransl888Func(void)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return RLEBlendTransl888_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return RLEBlendTransl888_NEON;
+    }
+#endif
+    return RLEBlendTransl888;
+}
+
+/*
+ * Blend a run of translucent pixels. The 32bpp blitters set up blend_transl
+ * to do a whole run at a time.
+ */
+#define BLIT_TRANSL_RUN(do_blend, dst, src, n) \
+    do {                                       \
+        int i;                                 \
+        for (i = 0; i < (int)(n); i++)         \
+            do_blend((src)[i], (dst)[i]);      \
+    } while (0)
+
+#define BLIT_TRANSL_565_RUN(dst, src, n) BLIT_TRANSL_RUN(BLIT_TRANSL_565, dst, src, n)
+#define BLIT_TRANSL_555_RUN(dst, src, n) BLIT_TRANSL_RUN(BLIT_TRANSL_555, dst, src, n)
+#define BLIT_TRANSL_888_RUN(dst, src, n) blend_transl(dst, src, (int)(n), 0)
+
 // blit a pixel-alpha RLE surface clipped at the right and/or left edges
 static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                              Uint8 *dstbuf, const SDL_Rect *srcrect)
 {
     const SDL_PixelFormatDetails *df = surf_dst->internal->format;
+    const SDL_RLEBlend32Func blend_transl = SDL_GetRLEBlendTransl888Func();
     /*
      * clipped blitter: Ptype is the destination pixel type,
      * Ctype the translucent count type, and do_blend the macro
-     * to blend one pixel.
+     * to blend a run of pixels.
      */
 #define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend)                          \
     do {                                                                  \
@@ -667,13 +830,9 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                     }                                                     \
                     if (crun > right - cofs)                              \
                         crun = right - cofs;                              \
-                    if (crun > 0) {                                       \
-                        Ptype *dst = (Ptype *)dstbuf + cofs;              \
-                        Uint32 *src = (Uint32 *)srcbuf + (cofs - ofs);    \
-                        int i;                                            \
-                        for (i = 0; i < crun; i++)                        \
-                            do_blend(src[i], dst[i]);                     \
-                    }                                                     \
+                    if (crun > 0)                                         \
+                        do_blend((Ptype *)dstbuf + cofs,                  \
+                                 (Uint32 *)srcbuf + (cofs - ofs), crun);  \
                     srcbuf += run * 4;                                    \
                     ofs += run;                                           \
                 }                                                         \
@@ -685,13 +844,13 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
     switch (df->bytes_per_pixel) {
     case 2:
         if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_565);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_565_RUN);
         } else {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_555);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_555_RUN);
         }
         break;
     case 4:
-        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_888);
+        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_888_RUN);
         break;
     }
 }
@@ -779,11 +938,12 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
     if (srcrect->x || srcrect->w != surf_src->w) {
         RLEAlphaClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect);
     } else {
+        const SDL_RLEBlend32Func blend_transl = SDL_GetRLEBlendTransl888Func();
 
         /*
          * non-clipped blitter. Ptype is the destination pixel type,
          * Ctype the translucent count type, and do_blend the
-         * macro to blend one pixel.
+         * macro to blend a run of pixels.
          */
 #define RLEALPHABLIT(Ptype, Ctype, do_blend)                         \
     do {                                                             \
@@ -815,14 +975,9 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
                 run = ((Uint16 *)srcbuf)[1];                         \
                 srcbuf += 4;                                         \
                 if (run) {                                           \
-                    Ptype *dst = (Ptype *)dstbuf + ofs;              \
-                    unsigned i;                                      \
-                    for (i = 0; i < run; i++) {                      \
-                        Uint32 src = *(Uint32 *)srcbuf;              \
-                        do_blend(src, *dst);                         \
-                        srcbuf += 4;                                 \
-                        dst++;                                       \
-                    }                                                \
+                    do_blend((Ptype *)dstbuf + ofs, (Uint32 *)srcbuf, \
+                             run);                                   \
+                    srcbuf += run * 4;                               \
                     ofs += run;                                      \
                 }                                                    \
             } while (ofs < w);                                       \
@@ -833,13 +988,13 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
         switch (df->bytes_per_pixel) {
         case 2:
             if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_565);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_565_RUN);
             } else {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_555);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_555_RUN);
             }
             break;
         case 4:
-            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_888);
+            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_888_RUN);
             break;
         }
     }
@@ -982,37 +1137,326 @@ static int uncopy_32(Uint32 *dst, const void *src, int n,
     return n * 4;
 }
 
-#define ISOPAQUE(pixel, fmt) ((((pixel)&fmt->Amask) >> fmt->Ashift) == 255)
+typedef int (*SDL_RLECopyFunc)(void *dst, const Uint32 *src, int n,
+                               const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt);
+
+// encode 32bpp rgba into 32bpp rgba when only the alpha has to move to the top byte, and it's already there
+static int copy_32_identity(void *dst, const Uint32 *src, int n,
+                            const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
+{
+    SDL_memcpy(dst, src, (size_t)n * 4);
+    return n * 4;
+}
+
+/*
+ * Find the end of a span of 32-bit pixels: starting at x, skip the pixels
+ * for which ((pixel & mask) == v1 || (pixel & mask) == v2) is equal to
+ * 'match', and return the index of the first one that isn't, or w.
+ *
+ * This is used to find the opaque, translucent and transparent spans, which
+ * is where most of the encoding time goes for 32bpp surfaces.
+ */
+typedef int (*SDL_RLEScan32Func)(const Uint32 *row, int x, int w, Uint32 mask, Uint32 v1, Uint32 v2, bool match);
+
+static int RLEScan32(const Uint32 *row, int x, int w, Uint32 mask, Uint32 v1, Uint32 v2, bool match)
+{
+    while (x < w) {
+        const Uint32 pixel = row[x] & mask;
+        if ((pixel == v1 || pixel == v2) != match) {
+            break;
+        }
+        ++x;
+    }
+    return x;
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") RLEScan32_SSE2(const Uint32 *row, int x, int w, Uint32 mask, Uint32 v1, Uint32 v2, bool match)
+{
+    const __m128i vmask = _mm_set1_epi32((int)mask);
+    const __m128i vv1 = _mm_set1_epi32((int)v1);
+    const __m128i vv2 = _mm_set1_epi32((int)v2);
+    const int flip = match ? 0xf : 0;
+
+    // Four pixels at a time until one of them ends the span, the scalar loop finds which
+    for (; x + 4 <= w; x += 4) {
+        const __m128i pixels = _mm_and_si128(_mm_loadu_si128((const __m128i *)(row + x)), vmask);
+        const __m128i eq = _mm_or_si128(_mm_cmpeq_epi32(pixels, vv1), _mm_cmpeq_epi32(pixels, vv2));
+        if (_mm_movemask_ps(_mm_castsi128_ps(eq)) ^ flip) {
+            break;
+        }
+    }
+    return RLEScan32(row, x, w, mask, v1, v2, match);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int RLEScan32_NEON(const Uint32 *row, int x, int w, Uint32 mask, Uint32 v1, Uint32 v2, bool match)
+{
+    const uint32x4_t vmask = vdupq_n_u32(mask);
+    const uint32x4_t vv1 = vdupq_n_u32(v1);
+    const uint32x4_t vv2 = vdupq_n_u32(v2);
+    const uint32x4_t flip = vdupq_n_u32(match ? 0xFFFFFFFF : 0);
+
+    for (; x + 4 <= w; x += 4) {
+        const uint32x4_t pixels = vandq_u32(vld1q_u32(row + x), vmask);
+        const uint32x4_t eq = vorrq_u32(vceqq_u32(pixels, vv1), vceqq_u32(pixels, vv2));
+        const uint16x4_t stop = vmovn_u32(veorq_u32(eq, flip));
+        if (vget_lane_u64(vreinterpret_u64_u16(stop), 0)) {
+            break;
+        }
+    }
+    return RLEScan32(row, x, w, mask, v1, v2, match);
+}
+#endif
+
+static SDL_RLEScan32Func SDL_GetRLEScan32Func(void)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return RLEScan32_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return RLEScan32_NEON;
+    }
+#endif
+    return RLEScan32;
+}
+
+/*
+ * Each scan line is encoded on its own, so large surfaces are encoded in
+ * bands of rows, in parallel if blit threads are enabled. Every band starts
+ * at the worst case position of its first row, and once all of them are
+ * done the rows are moved down into place. When the whole surface is a
+ * single band the rows are already in place.
+ */
+typedef struct
+{
+    size_t start; // offset of the encoded row in the buffer
+    size_t size;  // size of the encoded row
+    bool blank;   // true if the row has no visible pixels
+} SDL_RLERow;
+
+typedef struct
+{
+    SDL_Surface *surface;
+    const SDL_PixelFormatDetails *df;
+    Uint8 *rlebuf;
+    size_t header;     // size of the header before the first row
+    size_t row_stride; // worst case size of an encoded row, a multiple of 4
+    SDL_RLERow *rows;
+    SDL_RLEScan32Func scan;
+    SDL_RLECopyFunc copy_opaque;
+    SDL_RLECopyFunc copy_transl;
+    int max_opaque_run;
+} SDL_RLEEncodeJob;
+
+static bool RLEInitEncodeJob(SDL_RLEEncodeJob *job, SDL_Surface *surface, size_t header, size_t row_size)
+{
+    size_t size;
+
+    SDL_zerop(job);
+    job->surface = surface;
+    job->header = header;
+    // Rows start 32-bit aligned, which the 16bpp alpha encoding relies on
+    job->row_stride = (row_size + 3) & ~(size_t)3;
+    job->scan = SDL_GetRLEScan32Func();
+
+    // the worst case size of all rows, the header and the end marker
+    if (!SDL_size_mul_check_overflow(surface->h, job->row_stride, &size) ||
+        !SDL_size_add_check_overflow(size, header + 4, &size)) {
+        return false;
+    }
+    job->rlebuf = (Uint8 *)SDL_malloc(size);
+    if (!job->rlebuf) {
+        return false;
+    }
+    job->rows = (SDL_RLERow *)SDL_malloc(surface->h * sizeof(*job->rows));
+    if (!job->rows) {
+        SDL_free(job->rlebuf);
+        return false;
+    }
+    return true;
+}
+
+// Encode all rows, move them together and return the end of the last non-blank one
+static Uint8 *RLEEncodeRows(SDL_RLEEncodeJob *job, SDL_BlitRowsFunc encode_rows)
+{
+    Uint8 *rlebuf = job->rlebuf;
+    size_t end = job->header;
+    size_t lastline = end; // end of last non-blank line
+    int y;
+
+    if (!SDL_RunBlitRowsParallel(job->surface->w, job->surface->h, encode_rows, job)) {
+        encode_rows(job, 0, job->surface->h);
+    }
+
+    for (y = 0; y < job->surface->h; y++) {
+        const SDL_RLERow *row = &job->rows[y];
+        if (row->start != end) {
+            SDL_memmove(rlebuf + end, rlebuf + row->start, row->size);
+        }
+        end += row->size;
+        if (!row->blank) {
+            lastline = end;
+        }
+    }
+    SDL_free(job->rows);
+    job->rows = NULL;
+
+    return rlebuf + lastline; // back up past trailing blank lines
+}
+
+// Release the original pixels and the unused part of the encoding buffer
+static void RLEFinishEncoding(SDL_Surface *surface, Uint8 *rlebuf, Uint8 *dst)
+{
+    // Now that we have it encoded, release the original pixels
+    SDL_FreeSurfacePixels(surface);
+
+    // reallocate the buffer to release unused memory
+    {
+        // If SDL_realloc returns NULL, the original block is left intact
+        Uint8 *p = (Uint8 *)SDL_realloc(rlebuf, dst - rlebuf);
+        if (!p) {
+            p = rlebuf;
+        }
+        surface->internal->map.data = p;
+    }
+}
+
+// opaque counts are 8 or 16 bits, depending on target depth
+#define ADD_OPAQUE_COUNTS(n, m)           \
+    if (df->bytes_per_pixel == 4) {       \
+        ((Uint16 *)dst)[0] = (Uint16)n;   \
+        ((Uint16 *)dst)[1] = (Uint16)m;   \
+        dst += 4;                         \
+    } else {                              \
+        dst[0] = (Uint8)n;                \
+        dst[1] = (Uint8)m;                \
+        dst += 2;                         \
+    }
+
+// translucent counts are always 16 bit
+#define ADD_TRANSL_COUNTS(n, m) \
+    (((Uint16 *)dst)[0] = (Uint16)n, ((Uint16 *)dst)[1] = (Uint16)m, dst += 4)
+
+static void RLEAlphaRows(void *userdata, int y0, int h)
+{
+    SDL_RLEEncodeJob *job = (SDL_RLEEncodeJob *)userdata;
+    SDL_Surface *surface = job->surface;
+    const SDL_PixelFormatDetails *sf = surface->internal->format;
+    const SDL_PixelFormatDetails *df = job->df;
+    const SDL_RLEScan32Func scan = job->scan;
+    const SDL_RLECopyFunc copy_opaque = job->copy_opaque;
+    const SDL_RLECopyFunc copy_transl = job->copy_transl;
+    const int max_opaque_run = job->max_opaque_run;
+    const int max_transl_run = 65535;
+    const Uint32 amask = sf->Amask;
+    const int w = surface->w;
+    Uint8 *dst = job->rlebuf + job->header + y0 * job->row_stride;
+    int x, y;
+
+    for (y = y0; y < y0 + h; y++) {
+        const Uint32 *src = (const Uint32 *)((const Uint8 *)surface->pixels + y * surface->pitch);
+        Uint8 *linestart = dst;
+        int runstart, skipstart;
+        int blankline = 0;
+        // First encode all opaque pixels of a scan line
+        x = 0;
+        do {
+            int run, skip, len;
+            skipstart = x;
+            x = scan(src, x, w, amask, amask, amask, false);
+            runstart = x;
+            x = scan(src, x, w, amask, amask, amask, true);
+            skip = runstart - skipstart;
+            if (skip == w) {
+                blankline = 1;
+            }
+            run = x - runstart;
+            while (skip > max_opaque_run) {
+                ADD_OPAQUE_COUNTS(max_opaque_run, 0);
+                skip -= max_opaque_run;
+            }
+            len = SDL_min(run, max_opaque_run);
+            ADD_OPAQUE_COUNTS(skip, len);
+            dst += copy_opaque(dst, src + runstart, len, sf, df);
+            runstart += len;
+            run -= len;
+            while (run) {
+                len = SDL_min(run, max_opaque_run);
+                ADD_OPAQUE_COUNTS(0, len);
+                dst += copy_opaque(dst, src + runstart, len, sf, df);
+                runstart += len;
+                run -= len;
+            }
+        } while (x < w);
+
+        // Make sure the next output address is 32-bit aligned
+        dst += (uintptr_t)dst & 2;
+
+        // Next, encode all translucent pixels of the same scan line
+        x = 0;
+        do {
+            int run, skip, len;
+            skipstart = x;
+            x = scan(src, x, w, amask, 0, amask, true);
+            runstart = x;
+            x = scan(src, x, w, amask, 0, amask, false);
+            skip = runstart - skipstart;
+            blankline &= (skip == w);
+            run = x - runstart;
+            while (skip > max_transl_run) {
+                ADD_TRANSL_COUNTS(max_transl_run, 0);
+                skip -= max_transl_run;
+            }
+            len = SDL_min(run, max_transl_run);
+            ADD_TRANSL_COUNTS(skip, len);
+            dst += copy_transl(dst, src + runstart, len, sf, df);
+            runstart += len;
+            run -= len;
+            while (run) {
+                len = SDL_min(run, max_transl_run);
+                ADD_TRANSL_COUNTS(0, len);
+                dst += copy_transl(dst, src + runstart, len, sf, df);
+                runstart += len;
+                run -= len;
+            }
+        } while (x < w);
 
-#define ISTRANSL(pixel, fmt) \
-    ((unsigned)((((pixel)&fmt->Amask) >> fmt->Ashift) - 1U) < 254U)
+        job->rows[y].start = linestart - job->rlebuf;
+        job->rows[y].size = dst - linestart;
+        job->rows[y].blank = (blankline != 0);
+    }
+}
 
 // convert surface to be quickly alpha-blittable onto dest, if possible
 static bool RLEAlphaSurface(SDL_Surface *surface)
 {
     SDL_Surface *dest;
+    const SDL_PixelFormatDetails *sf = surface->internal->format;
     const SDL_PixelFormatDetails *df;
-    int maxsize = 0;
+    size_t row_size = 0;
     int max_opaque_run;
-    int max_transl_run = 65535;
     unsigned masksum;
-    Uint8 *rlebuf, *dst;
-    int (*copy_opaque)(void *, const Uint32 *, int,
-                       const SDL_PixelFormatDetails *, const SDL_PixelFormatDetails *);
-    int (*copy_transl)(void *, const Uint32 *, int,
-                       const SDL_PixelFormatDetails *, const SDL_PixelFormatDetails *);
+    Uint8 *dst;
+    SDL_RLECopyFunc copy_opaque;
+    SDL_RLECopyFunc copy_transl;
+    SDL_RLEEncodeJob job;
 
     dest = surface->internal->map.info.dst_surface;
     if (!dest) {
         return false;
     }
     df = dest->internal->format;
-    if (surface->internal->format->bits_per_pixel != 32) {
-        return false; // only 32bpp source supported
+    if (sf->bits_per_pixel != 32 || sf->Abits != 8) {
+        return false; // only 32bpp source with 8-bit alpha supported
     }
 
     /* find out whether the destination is one we support,
-       and determine the max size of the encoded result */
+       and determine the max size of an encoded row */
     masksum = df->Rmask | df->Gmask | df->Bmask;
     switch (df->bytes_per_pixel) {
     case 2:
@@ -1041,165 +1485,51 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
 
         /* worst case is alternating opaque and translucent pixels,
            with room for alignment padding between lines */
-        maxsize = surface->h * (2 + (4 + 2) * (surface->w + 1)) + 2;
+        row_size = 2 + (4 + 2) * ((size_t)surface->w + 1);
         break;
     case 4:
         if (masksum != 0x00ffffff) {
             return false; // requires unused high byte
         }
-        copy_opaque = copy_32;
-        copy_transl = copy_32;
+        if (sf->Amask == 0xff000000 &&
+            sf->Rmask == df->Rmask && sf->Gmask == df->Gmask && sf->Bmask == df->Bmask) {
+            copy_opaque = copy_32_identity;
+        } else {
+            copy_opaque = copy_32;
+        }
+        copy_transl = copy_opaque;
         max_opaque_run = 255; // runs stored as short ints
 
         // worst case is alternating opaque and translucent pixels
-        maxsize = surface->h * 2 * 4 * (surface->w + 1) + 4;
+        row_size = 2 * 4 * ((size_t)surface->w + 1);
         break;
     default:
         return false; // anything else unsupported right now
     }
 
-    maxsize += sizeof(SDL_PixelFormat);
-    rlebuf = (Uint8 *)SDL_malloc(maxsize);
-    if (!rlebuf) {
+    if (!RLEInitEncodeJob(&job, surface, sizeof(SDL_PixelFormat), row_size)) {
         return false;
     }
+    job.df = df;
+    job.copy_opaque = copy_opaque;
+    job.copy_transl = copy_transl;
+    job.max_opaque_run = max_opaque_run;
+
     // save the destination format so we can undo the encoding later
-    *(SDL_PixelFormat *)rlebuf = df->format;
-    dst = rlebuf + sizeof(SDL_PixelFormat);
+    *(SDL_PixelFormat *)job.rlebuf = df->format;
 
     // Do the actual encoding
-    {
-        int x, y;
-        int h = surface->h, w = surface->w;
-        const SDL_PixelFormatDetails *sf = surface->internal->format;
-        Uint32 *src = (Uint32 *)surface->pixels;
-        Uint8 *lastline = dst; // end of last non-blank line
-
-        // opaque counts are 8 or 16 bits, depending on target depth
-#define ADD_OPAQUE_COUNTS(n, m)           \
-    if (df->bytes_per_pixel == 4) {         \
-        ((Uint16 *)dst)[0] = (Uint16)n;   \
-        ((Uint16 *)dst)[1] = (Uint16)m;   \
-        dst += 4;                         \
-    } else {                              \
-        dst[0] = (Uint8)n;                \
-        dst[1] = (Uint8)m;                \
-        dst += 2;                         \
-    }
-
-        // translucent counts are always 16 bit
-#define ADD_TRANSL_COUNTS(n, m) \
-    (((Uint16 *)dst)[0] = (Uint16)n, ((Uint16 *)dst)[1] = (Uint16)m, dst += 4)
-
-        for (y = 0; y < h; y++) {
-            int runstart, skipstart;
-            int blankline = 0;
-            // First encode all opaque pixels of a scan line
-            x = 0;
-            do {
-                int run, skip, len;
-                skipstart = x;
-                while (x < w && !ISOPAQUE(src[x], sf)) {
-                    x++;
-                }
-                runstart = x;
-                while (x < w && ISOPAQUE(src[x], sf)) {
-                    x++;
-                }
-                skip = runstart - skipstart;
-                if (skip == w) {
-                    blankline = 1;
-                }
-                run = x - runstart;
-                while (skip > max_opaque_run) {
-                    ADD_OPAQUE_COUNTS(max_opaque_run, 0);
-                    skip -= max_opaque_run;
-                }
-                len = SDL_min(run, max_opaque_run);
-                ADD_OPAQUE_COUNTS(skip, len);
-                dst += copy_opaque(dst, src + runstart, len, sf, df);
-                runstart += len;
-                run -= len;
-                while (run) {
-                    len = SDL_min(run, max_opaque_run);
-                    ADD_OPAQUE_COUNTS(0, len);
-                    dst += copy_opaque(dst, src + runstart, len, sf, df);
-                    runstart += len;
-                    run -= len;
-                }
-            } while (x < w);
-
-            // Make sure the next output address is 32-bit aligned
-            dst += (uintptr_t)dst & 2;
+    dst = RLEEncodeRows(&job, RLEAlphaRows);
+    ADD_OPAQUE_COUNTS(0, 0);
 
-            // Next, encode all translucent pixels of the same scan line
-            x = 0;
-            do {
-                int run, skip, len;
-                skipstart = x;
-                while (x < w && !ISTRANSL(src[x], sf)) {
-                    x++;
-                }
-                runstart = x;
-                while (x < w && ISTRANSL(src[x], sf)) {
-                    x++;
-                }
-                skip = runstart - skipstart;
-                blankline &= (skip == w);
-                run = x - runstart;
-                while (skip > max_transl_run) {
-                    ADD_TRANSL_COUNTS(max_transl_run, 0);
-                    skip -= max_transl_run;
-                }
-                len = SDL_min(run, max_transl_run);
-                ADD_TRANSL_COUNTS(skip, len);
-                dst += copy_transl(dst, src + runstart, len, sf, df);
-                runstart += len;
-                run -= len;
-                while (run) {
-                    len = SDL_min(run, max_transl_run);
-                    ADD_TRANSL_COUNTS(0, len);
-                    dst += copy_transl(dst, src + runstart, len, sf, df);
-                    runstart += len;
-                    run -= len;
-                }
-                if (!blankline) {
-                    lastline = dst;
-                }
-            } while (x < w);
+    RLEFinishEncoding(surface, job.rlebuf, dst);
 
-            src += surface->pitch >> 2;
-        }
-        dst = lastline; // back up past trailing blank lines
-        ADD_OPAQUE_COUNTS(0, 0);
-    }
+    return true;
+}
 
 #undef ADD_OPAQUE_COUNTS
 #undef ADD_TRANSL_COUNTS
 
-    // Now that we have it encoded, release the original pixels
-    if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
-        } else {
-            SDL_free(surface->pixels);
-        }
-        surface->pixels = NULL;
-    }
-
-    // reallocate the buffer to release unused memory
-    {
-        Uint8 *p = (Uint8 *)SDL_realloc(rlebuf, dst - rlebuf);
-        if (!p) {
-            p = rlebuf;
-        }
-        surface->internal->map.data = p;
-    }
-
-    return true;
-}
-
 static Uint32 getpix_8(const Uint8 *srcbuf)
 {
     return *srcbuf;
@@ -1226,59 +1556,6 @@ static Uint32 getpix_32(const Uint8 *srcbuf)
 
 typedef Uint32 (*getpix_func)(const Uint8 *);
 
-static const getpix_func getpixes[4] = {
-    getpix_8, getpix_16, getpix_24, getpix_32
-};
-
-static bool RLEColorkeySurface(SDL_Surface *surface)
-{
-    Uint8 *rlebuf, *dst;
-    int maxn;
-    int y;
-    Uint8 *srcbuf, *lastline;
-    int maxsize = 0;
-    const int bpp = surface->internal->format->bytes_per_pixel;
-    getpix_func getpix;
-    Uint32 ckey, rgbmask;
-    int w, h;
-
-    // calculate the worst case size for the compressed surface
-    switch (bpp) {
-    case 1:
-        /* worst case is alternating opaque and transparent pixels,
-           starting with an opaque pixel */
-        maxsize = surface->h * 3 * (surface->w / 2 + 1) + 2;
-        break;
-    case 2:
-    case 3:
-        // worst case is solid runs, at most 255 pixels wide
-        maxsize = surface->h * (2 * (surface->w / 255 + 1) + surface->w * bpp) + 2;
-        break;
-    case 4:
-        // worst case is solid runs, at most 65535 pixels wide
-        maxsize = surface->h * (4 * (surface->w / 65535 + 1) + surface->w * 4) + 4;
-        break;
-
-    default:
-        return false;
-    }
-
-    rlebuf = (Uint8 *)SDL_malloc(maxsize);
-    if (!rlebuf) {
-        return false;
-    }
-
-    // Set up the conversion
-    srcbuf = (Uint8 *)surface->pixels;
-    maxn = bpp == 4 ? 65535 : 255;
-    dst = rlebuf;
-    rgbmask = ~surface->internal->format->Amask;
-    ckey = surface->internal->map.info.colorkey & rgbmask;
-    lastline = dst;
-    getpix = getpixes[bpp - 1];
-    w = surface->w;
-    h = surface->h;
-
 #define ADD_COUNTS(n, m)                \
     if (bpp == 4) {                     \
         ((Uint16 *)dst)[0] = (Uint16)n; \
@@ -1290,7 +1567,24 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
         dst += 2;                       \
     }
 
-    for (y = 0; y < h; y++) {
+/*
+ * This is inlined once per pixel size, with bpp and getpix constant, so the
+ * pixel fetches are not indirect calls. 32bpp spans are found with the
+ * vectorized scan.
+ */
+SDL_FORCE_INLINE void RLEColorkeyRowsBpp(SDL_RLEEncodeJob *job, int y0, int h, const int bpp, getpix_func getpix)
+{
+    SDL_Surface *surface = job->surface;
+    const int maxn = bpp == 4 ? 65535 : 255;
+    const Uint32 rgbmask = ~surface->internal->format->Amask;
+    const Uint32 ckey = surface->internal->map.info.colorkey & rgbmask;
+    const int w = surface->w;
+    Uint8 *dst = job->rlebuf + job->header + y0 * job->row_stride;
+    int y;
+
+    for (y = y0; y < y0 + h; y++) {
+        const Uint8 *srcbuf = (const Uint8 *)surface->pixels + y * surface->pitch;
+        Uint8 *linestart = dst;
         int x = 0;
         int blankline = 0;
         do {
@@ -1300,12 +1594,18 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
             int skipstart = x;
 
             // find run of transparent, then opaque pixels
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey) {
-                x++;
-            }
-            runstart = x;
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey) {
-                x++;
+            if (bpp == 4) {
+                x = job->scan((const Uint32 *)srcbuf, x, w, rgbmask, ckey, ckey, true);
+                runstart = x;
+                x = job->scan((const Uint32 *)srcbuf, x, w, rgbmask, ckey, ckey, false);
+            } else {
+                while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey) {
+                    x++;
+                }
+                runstart = x;
+                while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey) {
+                    x++;
+                }
             }
             skip = runstart - skipstart;
             if (skip == w) {
@@ -1332,42 +1632,80 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
                 runstart += len;
                 run -= len;
             }
-            if (!blankline) {
-                lastline = dst;
-            }
         } while (x < w);
 
-        srcbuf += surface->pitch;
+        job->rows[y].start = linestart - job->rlebuf;
+        job->rows[y].size = dst - linestart;
+        job->rows[y].blank = (blankline != 0);
     }
-    dst = lastline; // back up bast trailing blank lines
-    ADD_COUNTS(0, 0);
+}
 
-#undef ADD_COUNTS
+static void RLEColorkeyRows(void *userdata, int y, int h)
+{
+    SDL_RLEEncodeJob *job = (SDL_RLEEncodeJob *)userdata;
 
-    // Now that we have it encoded, release the original pixels
-    if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-            SDL_aligned_free(surface->pixels);
-            surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
-        } else {
-            SDL_free(surface->pixels);
-        }
-        surface->pixels = NULL;
+    switch (job->surface->internal->format->bytes_per_pixel) {
+    case 1:
+        RLEColorkeyRowsBpp(job, y, h, 1, getpix_8);
+        break;
+    case 2:
+        RLEColorkeyRowsBpp(job, y, h, 2, getpix_16);
+        break;
+    case 3:
+        RLEColorkeyRowsBpp(job, y, h, 3, getpix_24);
+        break;
+    case 4:
+        RLEColorkeyRowsBpp(job, y, h, 4, getpix_32);
+        break;
     }
+}
 
-    // reallocate the buffer to release unused memory
-    {
-        // If SDL_realloc returns NULL, the original block is left intact
-        Uint8 *p = (Uint8 *)SDL_realloc(rlebuf, dst - rlebuf);
-        if (!p) {
-            p = rlebuf;
-        }
-        surface->internal->map.data = p;
+static bool RLEColorkeySurface(SDL_Surface *surface)
+{
+    Uint8 *dst;
+    size_t row_size = 0;
+    const int bpp = surface->internal->format->bytes_per_pixel;
+    const size_t w = surface->w;
+    SDL_RLEEncodeJob job;
+
+    // calculate the worst case size for a compressed row
+    switch (bpp) {
+    case 1:
+        /* worst case is alternating opaque and transparent pixels,
+           starting with an opaque pixel */
+        row_size = 3 * (w / 2 + 1);
+        break;
+    case 2:
+    case 3:
+        // worst case is solid runs, at most 255 pixels wide
+        row_size = 2 * (w / 255 + 1) + w * bpp;
+        break;
+    case 4:
+        // worst case is solid runs, at most 65535 pixels wide
+        row_size = 4 * (w / 65535 + 1) + w * 4;
+        break;
+
+    default:
+        return false;
+    }
+
+    if (!RLEInitEncodeJob(&job, surface, sizeof(SDL_PixelFormat), row_size)) {
+        return false;
     }
 
+    // save the pixel format, the blitter expects the same header as with per-pixel alpha
+    *(SDL_PixelFormat *)job.rlebuf = surface->format;
+
+    dst = RLEEncodeRows(&job, RLEColorkeyRows);
+    ADD_COUNTS(0, 0);
+
+    RLEFinishEncoding(surface, job.rlebuf, dst);
+
     return true;
 }
 
+#undef ADD_COUNTS
+
 bool SDL_RLESurface(SDL_Surface *surface)
 {
     int flags;
@@ -1525,6 +1863,7 @@ void SDL_UnRLESurface(SDL_Surface *surface, bool recode)
             if (surface->internal->map.info.flags & SDL_COPY_RLE_COLORKEY) {
                 SDL_Rect full;
                 size_t size;
+                Uint8 alpha;
 
                 // re-create the original surface
                 if (!SDL_size_mul_check_overflow(surface->h, surface->pitch, &size)) {
@@ -1543,11 +1882,14 @@ void SDL_UnRLESurface(SDL_Surface *surface, bool recode)
                 // fill it with the background color
                 SDL_FillSurfaceRect(surface, NULL, surface->internal->map.info.colorkey);
 
-                // now render the encoded surface
+                // now render the encoded surface, without the surface alpha
                 full.x = full.y = 0;
                 full.w = surface->w;
                 full.h = surface->h;
+                alpha = surface->internal->map.info.a;
+                surface->internal->map.info.a = 255;
                 SDL_RLEBlit(surface, &full, surface, &full);
+                surface->internal->map.info.a = alpha;
             } else {
                 if (!UnRLEAlpha(surface)) {
                     // Oh crap...
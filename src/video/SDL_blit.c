@@ -28,9 +28,239 @@
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 
+// Optional pool of helper threads that split large blits into bands of rows. See SDL_HINT_SURFACE_BLIT_THREADS.
+
+#define SDL_MAX_BLIT_THREADS 64
+#define SDL_BLIT_THREADS_MIN_PIXELS (256 * 256)  // smaller blits aren't worth waking threads up for.
+#define SDL_BLIT_THREADS_MIN_ROWS   16           // keep bands big enough that they don't share much cache.
+
+typedef struct SDL_BlitThreadPool
+{
+    SDL_Thread **threads;
+    int num_threads;
+    SDL_Semaphore *start_sem;
+    SDL_Semaphore *done_sem;
+    SDL_AtomicInt shutdown;
+
+    // The current job. Only changed by the submitting thread while the workers are idle.
+    SDL_BlitRowsFunc func;
+    void *userdata;
+    int height;
+    int band_rows;
+    int num_bands;
+    SDL_AtomicInt next_band;
+} SDL_BlitThreadPool;
+
+static SDL_BlitThreadPool *blit_pool;
+static SDL_InitState blit_pool_init;
+static SDL_Mutex *blit_pool_lock;  // held by whoever is using (or creating, or destroying) the pool.
+static bool blit_pool_busy;        // SDL_Mutex is recursive, so this catches a blit from inside a band on the submitting thread.
+
+// Pull bands off the current job until there are none left.
+static void RunBlitPoolBands(SDL_BlitThreadPool *pool)
+{
+    int band;
+    while ((band = SDL_AddAtomicInt(&pool->next_band, 1)) < pool->num_bands) {
+        const int y = band * pool->band_rows;
+        pool->func(pool->userdata, y, SDL_min(pool->band_rows, pool->height - y));
+    }
+}
+
+static int SDLCALL BlitWorkerThread(void *data)  // thread entry point
+{
+    SDL_BlitThreadPool *pool = (SDL_BlitThreadPool *)data;
+
+    while (true) {
+        SDL_WaitSemaphore(pool->start_sem);
+        if (SDL_GetAtomicInt(&pool->shutdown)) {
+            break;
+        }
+        RunBlitPoolBands(pool);
+        SDL_SignalSemaphore(pool->done_sem);
+    }
+
+    return 0;
+}
+
+static void DestroyBlitThreadPool(SDL_BlitThreadPool *pool)
+{
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    SDL_SetAtomicInt(&pool->shutdown, 1);
+    for (i = 0; i < pool->num_threads; i++) {
+        if (pool->threads[i]) {
+            SDL_SignalSemaphore(pool->start_sem);
+        }
+    }
+    for (i = 0; i < pool->num_threads; i++) {
+        if (pool->threads[i]) {
+            SDL_WaitThread(pool->threads[i], NULL);
+        }
+    }
+
+    SDL_DestroySemaphore(pool->start_sem);
+    SDL_DestroySemaphore(pool->done_sem);
+    SDL_free(pool->threads);
+    SDL_free(pool);
+}
+
+static SDL_BlitThreadPool *CreateBlitThreadPool(int num_threads)
+{
+    SDL_BlitThreadPool *pool;
+    char name[32];
+    int i;
+
+    pool = (SDL_BlitThreadPool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(*pool->threads));
+    pool->start_sem = SDL_CreateSemaphore(0);
+    pool->done_sem = SDL_CreateSemaphore(0);
+    if (!pool->threads || !pool->start_sem || !pool->done_sem) {
+        DestroyBlitThreadPool(pool);
+        return NULL;
+    }
+
+    pool->num_threads = num_threads;
+    for (i = 0; i < num_threads; i++) {
+        (void)SDL_snprintf(name, sizeof(name), "SDLBlit%d", i);
+        pool->threads[i] = SDL_CreateThread(BlitWorkerThread, name, pool);
+        if (!pool->threads[i]) {
+            DestroyBlitThreadPool(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+static int GetBlitThreadCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+    if (hint) {
+        const int val = SDL_atoi(hint);
+        if (val > 0) {
+            return SDL_min(val, SDL_MAX_BLIT_THREADS);
+        }
+    }
+    return 0;
+}
+
+bool SDL_RunBlitRowsParallel(int width, int height, SDL_BlitRowsFunc func, void *userdata)
+{
+    SDL_BlitThreadPool *pool;
+    int num_threads, num_bands, i;
+
+    if ((Sint64)width * height < SDL_BLIT_THREADS_MIN_PIXELS || height < (SDL_BLIT_THREADS_MIN_ROWS * 2)) {
+        return false;
+    }
+
+    num_threads = GetBlitThreadCount();
+    if (num_threads == 0) {
+        return false;
+    }
+
+    if (SDL_ShouldInit(&blit_pool_init)) {
+        blit_pool_lock = SDL_CreateMutex();
+        SDL_SetInitialized(&blit_pool_init, true);
+    }
+    if (!blit_pool_lock) {
+        return false;
+    }
+
+    // If another thread is using the pool, or this is a blit from inside a band, just do it here.
+    if (!SDL_TryLockMutex(blit_pool_lock)) {
+        return false;
+    }
+    if (blit_pool_busy) {
+        SDL_UnlockMutex(blit_pool_lock);
+        return false;
+    }
+
+    if (blit_pool && blit_pool->num_threads != num_threads) {
+        DestroyBlitThreadPool(blit_pool);
+        blit_pool = NULL;
+    }
+    if (!blit_pool) {
+        blit_pool = CreateBlitThreadPool(num_threads);
+        if (!blit_pool) {
+            SDL_UnlockMutex(blit_pool_lock);
+            return false;
+        }
+    }
+    pool = blit_pool;
+    blit_pool_busy = true;
+
+    // the calling thread takes a band, too.
+    num_bands = SDL_min(num_threads + 1, height / SDL_BLIT_THREADS_MIN_ROWS);
+    pool->func = func;
+    pool->userdata = userdata;
+    pool->height = height;
+    pool->band_rows = (height + num_bands - 1) / num_bands;
+    pool->num_bands = (height + pool->band_rows - 1) / pool->band_rows;
+    SDL_SetAtomicInt(&pool->next_band, 0);
+
+    for (i = 0; i < pool->num_bands - 1; i++) {
+        SDL_SignalSemaphore(pool->start_sem);
+    }
+
+    RunBlitPoolBands(pool);
+
+    for (i = 0; i < pool->num_bands - 1; i++) {
+        SDL_WaitSemaphore(pool->done_sem);
+    }
+
+    blit_pool_busy = false;
+    SDL_UnlockMutex(blit_pool_lock);
+    return true;
+}
+
+void SDL_QuitBlitThreads(void)
+{
+    if (!SDL_ShouldQuit(&blit_pool_init)) {
+        return;
+    }
+
+    if (blit_pool_lock) {
+        SDL_LockMutex(blit_pool_lock);  // wait for a blit that's still running.
+        DestroyBlitThreadPool(blit_pool);
+        blit_pool = NULL;
+        SDL_UnlockMutex(blit_pool_lock);
+        SDL_DestroyMutex(blit_pool_lock);
+        blit_pool_lock = NULL;
+    }
+
+    SDL_SetInitialized(&blit_pool_init, false);
+}
+
+typedef struct
+{
+    SDL_BlitFunc blit;
+    const SDL_BlitInfo *info;
+} SDL_SoftBlitJob;
+
+static void SoftBlitRows(void *userdata, int y, int h)
+{
+    const SDL_SoftBlitJob *job = (const SDL_SoftBlitJob *)userdata;
+    SDL_BlitInfo band;
+
+    SDL_copyp(&band, job->info);
+    band.src += (size_t)y * band.src_pitch;
+    band.dst += (size_t)y * band.dst_pitch;
+    band.src_h = h;
+    band.dst_h = h;
+    job->blit(&band);
+}
+
 // The general purpose software blit routine
-static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
-                                SDL_Surface *dst, const SDL_Rect *dstrect)
+bool SDL_SoftBlitWithMap(SDL_BlitMap *map, SDL_Surface *src, const SDL_Rect *srcrect,
+                         SDL_Surface *dst, const SDL_Rect *dstrect)
 {
     bool okay;
     int src_locked;
@@ -61,7 +291,7 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
     // Set up source and destination buffer pointers, and BLIT!
     if (okay) {
         SDL_BlitFunc RunBlit;
-        SDL_BlitInfo *info = &src->internal->map.info;
+        SDL_BlitInfo *info = &map->info;
 
         // Set up the blit information
         info->src = (Uint8 *)src->pixels +
@@ -80,10 +310,20 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
         info->dst_pitch = dst->pitch;
         info->dst_skip =
             info->dst_pitch - info->dst_w * info->dst_fmt->bytes_per_pixel;
-        RunBlit = (SDL_BlitFunc)src->internal->map.data;
-
-        // Run the actual software blit
-        RunBlit(info);
+        RunBlit = (SDL_BlitFunc)map->data;
+
+        /* Run the actual software blit, in bands of rows across the blit threads if it's big enough.
+           Bands of a scaled blit wouldn't step through the source exactly like the whole blit does,
+           blitting onto itself might read rows another band already wrote, and blits to palettized
+           surfaces share a color lookup cache. */
+        SDL_SoftBlitJob job;
+        job.blit = RunBlit;
+        job.info = info;
+        if ((info->flags & SDL_COPY_NEAREST) || src->pixels == dst->pixels ||
+            SDL_ISPIXELFORMAT_INDEXED(dst->format) ||
+            !SDL_RunBlitRowsParallel(info->dst_w, info->dst_h, SoftBlitRows, &job)) {
+            RunBlit(info);
+        }
     }
 
     // We need to unlock the surfaces if they're locked
@@ -97,6 +337,12 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
     return okay;
 }
 
+static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
+                                SDL_Surface *dst, const SDL_Rect *dstrect)
+{
+    return SDL_SoftBlitWithMap(&src->internal->map, src, srcrect, dst, dstrect);
+}
+
 #if SDL_HAVE_BLIT_AUTO
 
 #ifdef SDL_PLATFORM_MACOS
@@ -140,6 +386,15 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(SDL_PixelFormat src_format, SDL_PixelForm
         if (SDL_HasSSE2()) {
             features |= SDL_CPU_SSE2;
         }
+        if (SDL_HasSSE41()) {
+            features |= SDL_CPU_SSE4_1;
+        }
+        if (SDL_HasAVX2()) {
+            features |= SDL_CPU_AVX2;
+        }
+        if (SDL_HasNEON()) {
+            features |= SDL_CPU_NEON;
+        }
         if (SDL_HasAltiVec()) {
             if (SDL_UseAltivecPrefetch()) {
                 features |= SDL_CPU_ALTIVEC_PREFETCH;
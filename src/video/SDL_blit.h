@@ -54,6 +54,12 @@ extern const Uint16 SDL_expand_byte_10[];
 #define SDL_CPU_SSE2               0x00000004
 #define SDL_CPU_ALTIVEC_PREFETCH   0x00000008
 #define SDL_CPU_ALTIVEC_NOPREFETCH 0x00000010
+#define SDL_CPU_SSE4_1             0x00000020
+#define SDL_CPU_AVX2               0x00000040
+#define SDL_CPU_NEON               0x00000080
+
+// Inverse palette used to map colors to indices when blitting to a paletted surface
+typedef struct SDL_InversePalette SDL_InversePalette;
 
 typedef struct
 {
@@ -72,7 +78,7 @@ typedef struct
     const SDL_PixelFormatDetails *dst_fmt;
     const SDL_Palette *dst_pal;
     Uint8 *table;
-    SDL_HashTable *palette_map;
+    SDL_InversePalette *palette_map;
     int flags;
     Uint32 colorkey;
     Uint8 r, g, b, a;
@@ -80,6 +86,9 @@ typedef struct
 
 typedef void (*SDL_BlitFunc)(SDL_BlitInfo *info);
 
+// Processes `h` rows starting at row `y` of a blit.
+typedef void (*SDL_BlitRowsFunc)(void *userdata, int y, int h);
+
 typedef struct
 {
     SDL_PixelFormat src_format;
@@ -108,6 +117,16 @@ typedef struct SDL_BlitMap
 // Functions found in SDL_blit.c
 extern bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst);
 
+/* Runs the software blit function chosen for `map` from `src` to `dst`, which need to have the formats
+   `map` was calculated for. The rectangles have to be clipped already. */
+extern bool SDL_SoftBlitWithMap(SDL_BlitMap *map, SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+
+/* Runs `func` over all `height` rows of a blit, split into bands across the threads requested with
+   SDL_HINT_SURFACE_BLIT_THREADS and the calling thread. Returns false without calling `func` if the
+   blit is too small to be worth it or the threads aren't available; the caller does it all then. */
+extern bool SDL_RunBlitRowsParallel(int width, int height, SDL_BlitRowsFunc func, void *userdata);
+extern void SDL_QuitBlitThreads(void);
+
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface);
 extern SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface);
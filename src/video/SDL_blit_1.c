@@ -506,6 +506,349 @@ static void Blit1toNAlphaKey(SDL_BlitInfo *info)
     }
 }
 
+/* Vectorized index expansion: AVX2 gathers the colors of 8 indices at once
+   from the map, while small palettes of up to 16 colors keep each byte of
+   the map in a register and look the indices up with byte shuffles. */
+
+#ifdef SDL_AVX2_INTRINSICS
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") Blit1toN_AVX2(SDL_BlitInfo *info, int bpp, bool key)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    const Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const Uint8 *map = info->table;
+    const Uint32 ckey = info->colorkey;
+    const __m256i keyv = _mm256_set1_epi32((int)ckey);
+    const __m256i low16 = _mm256_set1_epi32(0xffff);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+            __m256i pixels;
+
+            if (bpp == 4) {
+                pixels = _mm256_i32gather_epi32((const int *)map, index, 4);
+            } else {
+                // the map has a spare entry, so this reads past the last 16-bit color safely
+                pixels = _mm256_i32gather_epi32((const int *)map, index, 2);
+            }
+
+            if (bpp == 4) {
+                if (key) {
+                    pixels = _mm256_blendv_epi8(pixels, _mm256_loadu_si256((const __m256i *)dst), _mm256_cmpeq_epi32(index, keyv));
+                }
+                _mm256_storeu_si256((__m256i *)dst, pixels);
+            } else {
+                __m128i packed;
+
+                pixels = _mm256_permute4x64_epi64(_mm256_packus_epi32(_mm256_and_si256(pixels, low16), pixels), 0x08);
+                packed = _mm256_castsi256_si128(pixels);
+                if (key) {
+                    __m256i mask = _mm256_cmpeq_epi32(index, keyv);
+                    mask = _mm256_permute4x64_epi64(_mm256_packs_epi32(mask, mask), 0x08);
+                    packed = _mm_blendv_epi8(packed, _mm_loadu_si128((const __m128i *)dst), _mm256_castsi256_si128(mask));
+                }
+                _mm_storeu_si128((__m128i *)dst, packed);
+            }
+            src += 8;
+            dst += 8 * bpp;
+        }
+        for (; n; --n) {
+            if (!key || *src != ckey) {
+                SDL_memcpy(dst, &map[*src * bpp], bpp);
+            }
+            src++;
+            dst += bpp;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void SDL_TARGETING("avx2") Blit1to2_AVX2(SDL_BlitInfo *info)
+{
+    Blit1toN_AVX2(info, 2, false);
+}
+
+static void SDL_TARGETING("avx2") Blit1to2Key_AVX2(SDL_BlitInfo *info)
+{
+    Blit1toN_AVX2(info, 2, true);
+}
+
+static void SDL_TARGETING("avx2") Blit1to4_AVX2(SDL_BlitInfo *info)
+{
+    Blit1toN_AVX2(info, 4, false);
+}
+
+static void SDL_TARGETING("avx2") Blit1to4Key_AVX2(SDL_BlitInfo *info)
+{
+    Blit1toN_AVX2(info, 4, true);
+}
+#endif // SDL_AVX2_INTRINSICS
+
+// Split the first 16 map entries into one 16 byte table per byte of the color
+static void GetSmallPaletteTables(const SDL_BlitInfo *info, int bpp, Uint8 tables[4][16])
+{
+    int i, k;
+
+    for (i = 0; i < 16; ++i) {
+        for (k = 0; k < bpp; ++k) {
+            tables[k][i] = info->table[i * bpp + k];
+        }
+    }
+}
+
+#ifdef SDL_SSE4_1_INTRINSICS
+SDL_FORCE_INLINE void SDL_TARGETING("sse4.1") Blit1toNSmall_SSE41(SDL_BlitInfo *info, int bpp, bool key)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    const Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const Uint8 *map = info->table;
+    const Uint32 ckey = info->colorkey;
+    const __m128i keyv = _mm_set1_epi8((char)ckey);
+    const __m128i high = _mm_set1_epi8((char)0xf0);
+    Uint8 tables[4][16];
+    __m128i t0, t1, t2, t3;
+
+    GetSmallPaletteTables(info, bpp, tables);
+    t0 = _mm_loadu_si128((const __m128i *)tables[0]);
+    t1 = _mm_loadu_si128((const __m128i *)tables[1]);
+    t2 = _mm_loadu_si128((const __m128i *)tables[2]);
+    t3 = _mm_loadu_si128((const __m128i *)tables[3]);
+
+    while (height--) {
+        int n = width;
+
+        while (n > 0) {
+            __m128i index, b0, b1, m;
+            int i;
+
+            if (n < 16 || !_mm_testz_si128(index = _mm_loadu_si128((const __m128i *)src), high)) {
+                // Tail of the row, or indices that aren't in the tables
+                const int count = SDL_min(n, 16);
+                for (i = 0; i < count; ++i) {
+                    if (!key || src[i] != ckey) {
+                        SDL_memcpy(dst + i * bpp, &map[src[i] * bpp], bpp);
+                    }
+                }
+                src += count;
+                dst += count * bpp;
+                n -= count;
+                continue;
+            }
+
+            b0 = _mm_shuffle_epi8(t0, index);
+            b1 = _mm_shuffle_epi8(t1, index);
+            m = _mm_cmpeq_epi8(index, keyv);
+            if (bpp == 4) {
+                const __m128i b2 = _mm_shuffle_epi8(t2, index);
+                const __m128i b3 = _mm_shuffle_epi8(t3, index);
+                const __m128i lo01 = _mm_unpacklo_epi8(b0, b1);
+                const __m128i hi01 = _mm_unpackhi_epi8(b0, b1);
+                const __m128i lo23 = _mm_unpacklo_epi8(b2, b3);
+                const __m128i hi23 = _mm_unpackhi_epi8(b2, b3);
+                __m128i out[4];
+
+                out[0] = _mm_unpacklo_epi16(lo01, lo23);
+                out[1] = _mm_unpackhi_epi16(lo01, lo23);
+                out[2] = _mm_unpacklo_epi16(hi01, hi23);
+                out[3] = _mm_unpackhi_epi16(hi01, hi23);
+                if (key) {
+                    const __m128i mlo = _mm_unpacklo_epi8(m, m);
+                    const __m128i mhi = _mm_unpackhi_epi8(m, m);
+                    out[0] = _mm_blendv_epi8(out[0], _mm_loadu_si128((const __m128i *)dst), _mm_unpacklo_epi16(mlo, mlo));
+                    out[1] = _mm_blendv_epi8(out[1], _mm_loadu_si128((const __m128i *)dst + 1), _mm_unpackhi_epi16(mlo, mlo));
+                    out[2] = _mm_blendv_epi8(out[2], _mm_loadu_si128((const __m128i *)dst + 2), _mm_unpacklo_epi16(mhi, mhi));
+                    out[3] = _mm_blendv_epi8(out[3], _mm_loadu_si128((const __m128i *)dst + 3), _mm_unpackhi_epi16(mhi, mhi));
+                }
+                for (i = 0; i < 4; ++i) {
+                    _mm_storeu_si128((__m128i *)dst + i, out[i]);
+                }
+            } else {
+                __m128i out0 = _mm_unpacklo_epi8(b0, b1);
+                __m128i out1 = _mm_unpackhi_epi8(b0, b1);
+
+                if (key) {
+                    out0 = _mm_blendv_epi8(out0, _mm_loadu_si128((const __m128i *)dst), _mm_unpacklo_epi8(m, m));
+                    out1 = _mm_blendv_epi8(out1, _mm_loadu_si128((const __m128i *)dst + 1), _mm_unpackhi_epi8(m, m));
+                }
+                _mm_storeu_si128((__m128i *)dst, out0);
+                _mm_storeu_si128((__m128i *)dst + 1, out1);
+            }
+            src += 16;
+            dst += 16 * bpp;
+            n -= 16;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") Blit1to2Small_SSE41(SDL_BlitInfo *info)
+{
+    Blit1toNSmall_SSE41(info, 2, false);
+}
+
+static void SDL_TARGETING("sse4.1") Blit1to2KeySmall_SSE41(SDL_BlitInfo *info)
+{
+    Blit1toNSmall_SSE41(info, 2, true);
+}
+
+static void SDL_TARGETING("sse4.1") Blit1to4Small_SSE41(SDL_BlitInfo *info)
+{
+    Blit1toNSmall_SSE41(info, 4, false);
+}
+
+static void SDL_TARGETING("sse4.1") Blit1to4KeySmall_SSE41(SDL_BlitInfo *info)
+{
+    Blit1toNSmall_SSE41(info, 4, true);
+}
+#endif // SDL_SSE4_1_INTRINSICS
+
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+SDL_FORCE_INLINE void Blit1toNSmall_NEON(SDL_BlitInfo *info, int bpp, bool key)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    const Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const Uint8 *map = info->table;
+    const Uint32 ckey = info->colorkey;
+    const uint8x16_t keyv = vdupq_n_u8((Uint8)ckey);
+    Uint8 tables[4][16];
+    uint8x16_t t0, t1, t2, t3;
+
+    GetSmallPaletteTables(info, bpp, tables);
+    t0 = vld1q_u8(tables[0]);
+    t1 = vld1q_u8(tables[1]);
+    t2 = vld1q_u8(tables[2]);
+    t3 = vld1q_u8(tables[3]);
+
+    while (height--) {
+        int n = width;
+
+        while (n > 0) {
+            uint8x16_t index, m;
+            int i;
+
+            if (n < 16 || vmaxvq_u8(index = vld1q_u8(src)) >= 16) {
+                // Tail of the row, or indices that aren't in the tables
+                const int count = SDL_min(n, 16);
+                for (i = 0; i < count; ++i) {
+                    if (!key || src[i] != ckey) {
+                        SDL_memcpy(dst + i * bpp, &map[src[i] * bpp], bpp);
+                    }
+                }
+                src += count;
+                dst += count * bpp;
+                n -= count;
+                continue;
+            }
+
+            m = vceqq_u8(index, keyv);
+            if (bpp == 4) {
+                uint8x16x4_t out;
+                out.val[0] = vqtbl1q_u8(t0, index);
+                out.val[1] = vqtbl1q_u8(t1, index);
+                out.val[2] = vqtbl1q_u8(t2, index);
+                out.val[3] = vqtbl1q_u8(t3, index);
+                if (key) {
+                    const uint8x16x4_t prev = vld4q_u8(dst);
+                    for (i = 0; i < 4; ++i) {
+                        out.val[i] = vbslq_u8(m, prev.val[i], out.val[i]);
+                    }
+                }
+                vst4q_u8(dst, out);
+            } else {
+                uint8x16x2_t out;
+                out.val[0] = vqtbl1q_u8(t0, index);
+                out.val[1] = vqtbl1q_u8(t1, index);
+                if (key) {
+                    const uint8x16x2_t prev = vld2q_u8(dst);
+                    for (i = 0; i < 2; ++i) {
+                        out.val[i] = vbslq_u8(m, prev.val[i], out.val[i]);
+                    }
+                }
+                vst2q_u8(dst, out);
+            }
+            src += 16;
+            dst += 16 * bpp;
+            n -= 16;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void Blit1to2Small_NEON(SDL_BlitInfo *info)
+{
+    Blit1toNSmall_NEON(info, 2, false);
+}
+
+static void Blit1to2KeySmall_NEON(SDL_BlitInfo *info)
+{
+    Blit1toNSmall_NEON(info, 2, true);
+}
+
+static void Blit1to4Small_NEON(SDL_BlitInfo *info)
+{
+    Blit1toNSmall_NEON(info, 4, false);
+}
+
+static void Blit1to4KeySmall_NEON(SDL_BlitInfo *info)
+{
+    Blit1toNSmall_NEON(info, 4, true);
+}
+#endif // SDL_NEON_INTRINSICS && __ARM_ARCH >= 8
+
+// Pick a vectorized blit for 16 and 32-bit destinations, or NULL for the scalar one
+static SDL_BlitFunc SDL_CalculateBlit1Vector(SDL_Surface *surface, int which, bool key)
+{
+    const SDL_Palette *pal = surface->internal->palette;
+    const bool small = (pal && pal->ncolors <= 16);
+
+    if (which != 2 && which != 4) {
+        return NULL;
+    }
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (small && SDL_HasSSE41()) {
+        if (which == 2) {
+            return key ? Blit1to2KeySmall_SSE41 : Blit1to2Small_SSE41;
+        }
+        return key ? Blit1to4KeySmall_SSE41 : Blit1to4Small_SSE41;
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+    if (small && SDL_HasNEON()) {
+        if (which == 2) {
+            return key ? Blit1to2KeySmall_NEON : Blit1to2Small_NEON;
+        }
+        return key ? Blit1to4KeySmall_NEON : Blit1to4Small_NEON;
+    }
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        if (which == 2) {
+            return key ? Blit1to2Key_AVX2 : Blit1to2_AVX2;
+        }
+        return key ? Blit1to4Key_AVX2 : Blit1to4_AVX2;
+    }
+#endif
+    (void)small;
+    return NULL;
+}
+
 static const SDL_BlitFunc one_blit[] = {
     (SDL_BlitFunc)NULL, Blit1to1, Blit1to2, Blit1to3, Blit1to4
 };
@@ -516,6 +859,7 @@ static const SDL_BlitFunc one_blitkey[] = {
 
 SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
 {
+    SDL_BlitFunc blit;
     int which;
 
     if (SDL_BITSPERPIXEL(surface->internal->map.info.dst_fmt->format) < 8) {
@@ -526,12 +870,20 @@ SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
 
     switch (surface->internal->map.info.flags & ~SDL_COPY_RLE_MASK) {
     case 0:
+        blit = SDL_CalculateBlit1Vector(surface, which, false);
+        if (blit) {
+            return blit;
+        }
         if (which < SDL_arraysize(one_blit)) {
             return one_blit[which];
         }
         break;
 
     case SDL_COPY_COLORKEY:
+        blit = SDL_CalculateBlit1Vector(surface, which, true);
+        if (blit) {
+            return blit;
+        }
         if (which < SDL_arraysize(one_blitkey)) {
             return one_blitkey[which];
         }
@@ -539,6 +891,10 @@ SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
 
     case SDL_COPY_COLORKEY | SDL_COPY_BLEND:  // this is not super-robust but handles a specific case we found sdl12-compat.
         if (surface->internal->map.info.a == 255) {
+            blit = SDL_CalculateBlit1Vector(surface, which, true);
+            if (blit) {
+                return blit;
+            }
             if (which < SDL_arraysize(one_blitkey)) {
                 return one_blitkey[which];
             }
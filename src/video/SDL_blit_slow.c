@@ -69,7 +69,7 @@ void SDL_Blit_Slow(SDL_BlitInfo *info)
     const SDL_Palette *src_pal = info->src_pal;
     const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
     const SDL_Palette *dst_pal = info->dst_pal;
-    SDL_HashTable *palette_map = info->palette_map;
+    SDL_InversePalette *palette_map = info->palette_map;
     int srcbpp = src_fmt->bytes_per_pixel;
     int dstbpp = dst_fmt->bytes_per_pixel;
     SlowBlitPixelAccess src_access;
@@ -728,6 +728,561 @@ static void WriteFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL
     }
 }
 
+/* Plain conversions through SDL_Blit_Slow_Float(), e.g. HDR10 video frames to sRGB, are done a
+ * chunk of pixels at a time instead: the source pixels are unpacked into planes of linear floats,
+ * tonemapped and converted to the destination primaries, and then packed into the destination.
+ */
+#define SLOW_FLOAT_CHUNK_PIXELS 64
+
+/* Transfer function tables, sampled 64 times per octave from 2^-30 up to 1.0 and interpolated
+ * linearly in between. Values below 2^-30 are interpolated from 0, which is close enough for all
+ * of the curves here, and values outside of 0..1 go through the exact function. There's one extra
+ * sample past 1.0 so 1.0 itself can be looked up too.
+ */
+#define TRANSFER_LUT_OCTAVES      30
+#define TRANSFER_LUT_MIN_EXPONENT (127 - TRANSFER_LUT_OCTAVES)
+#define TRANSFER_LUT_MIN_VALUE    (1.0f / (1 << TRANSFER_LUT_OCTAVES))
+#define TRANSFER_LUT_STEP_BITS    17
+#define TRANSFER_LUT_SIZE         ((TRANSFER_LUT_OCTAVES << (23 - TRANSFER_LUT_STEP_BITS)) + 2)
+
+typedef float (*SDL_TransferFunc)(float v);
+
+static float sRGBtoLinear_LUT[TRANSFER_LUT_SIZE];
+static float sRGBfromLinear_LUT[TRANSFER_LUT_SIZE];
+static float PQtoNits_LUT[TRANSFER_LUT_SIZE];
+static float PQfromNits_LUT[TRANSFER_LUT_SIZE]; // indexed by nits / 10000
+
+// Exact tables for 8-bit and 10-bit channels
+static float sRGB8toLinear[256];
+static float sRGB10toLinear[1024];
+static float PQ10toNits[1024];
+
+static float PQfromNormalizedNits(float v)
+{
+    return SDL_PQfromNits(v * 10000.0f);
+}
+
+static void FillTransferLUT(float *lut, SDL_TransferFunc func)
+{
+    int i;
+
+    for (i = 0; i < TRANSFER_LUT_SIZE; ++i) {
+        const Uint32 bits = ((Uint32)TRANSFER_LUT_MIN_EXPONENT << 23) + ((Uint32)i << TRANSFER_LUT_STEP_BITS);
+        float v;
+
+        SDL_memcpy(&v, &bits, sizeof(v));
+        lut[i] = func(v);
+    }
+}
+
+static void SetupTransferLUTs(void)
+{
+    static SDL_InitState init;
+    int i;
+
+    if (!SDL_ShouldInit(&init)) {
+        return;
+    }
+
+    FillTransferLUT(sRGBtoLinear_LUT, SDL_sRGBtoLinear);
+    FillTransferLUT(sRGBfromLinear_LUT, SDL_sRGBfromLinear);
+    FillTransferLUT(PQtoNits_LUT, SDL_PQtoNits);
+    FillTransferLUT(PQfromNits_LUT, PQfromNormalizedNits);
+    for (i = 0; i < 256; ++i) {
+        sRGB8toLinear[i] = SDL_sRGBtoLinear((float)i / 255.0f);
+    }
+    for (i = 0; i < 1024; ++i) {
+        sRGB10toLinear[i] = SDL_sRGBtoLinear((float)i / 1023.0f);
+        PQ10toNits[i] = SDL_PQtoNits((float)i / 1023.0f);
+    }
+
+    SDL_SetInitialized(&init, true);
+}
+
+static SDL_INLINE float EvalTransferLUT(const float *lut, SDL_TransferFunc func, float v)
+{
+    if (v >= 0.0f && v <= 1.0f) {
+        Uint32 bits, index;
+        float frac;
+
+        if (v < TRANSFER_LUT_MIN_VALUE) {
+            return v * (lut[0] / TRANSFER_LUT_MIN_VALUE);
+        }
+        SDL_memcpy(&bits, &v, sizeof(bits));
+        bits -= ((Uint32)TRANSFER_LUT_MIN_EXPONENT << 23);
+        index = bits >> TRANSFER_LUT_STEP_BITS;
+        frac = (float)(bits & ((1 << TRANSFER_LUT_STEP_BITS) - 1)) * (1.0f / (1 << TRANSFER_LUT_STEP_BITS));
+        return lut[index] + (lut[index + 1] - lut[index]) * frac;
+    }
+    return func(v);
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+// Returns how many values were done, the rest are left for the scalar loop
+static int SDL_TARGETING("sse2") EvalTransferLUTPlane_SSE2(const float *lut, SDL_TransferFunc func, float *plane, int n)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 lo = _mm_set1_ps(TRANSFER_LUT_MIN_VALUE);
+    const __m128 hi = _mm_set1_ps(1.0f);
+    const __m128 lo_slope = _mm_set1_ps(lut[0] / TRANSFER_LUT_MIN_VALUE);
+    const __m128i base = _mm_set1_epi32(TRANSFER_LUT_MIN_EXPONENT << 23);
+    const __m128i frac_mask = _mm_set1_epi32((1 << TRANSFER_LUT_STEP_BITS) - 1);
+    const __m128 frac_scale = _mm_set1_ps(1.0f / (1 << TRANSFER_LUT_STEP_BITS));
+    int i, j;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128 v = _mm_loadu_ps(&plane[i]);
+
+        if (_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(v, hi))) == 0xF) {
+            const __m128 small = _mm_cmplt_ps(v, lo);
+            const __m128i bits = _mm_sub_epi32(_mm_castps_si128(_mm_max_ps(v, lo)), base);
+            const __m128 frac = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(bits, frac_mask)), frac_scale);
+            Uint32 index[4];
+            __m128 v0, v1, result;
+
+            _mm_storeu_si128((__m128i *)index, _mm_srli_epi32(bits, TRANSFER_LUT_STEP_BITS));
+            v0 = _mm_setr_ps(lut[index[0]], lut[index[1]], lut[index[2]], lut[index[3]]);
+            v1 = _mm_setr_ps(lut[index[0] + 1], lut[index[1] + 1], lut[index[2] + 1], lut[index[3] + 1]);
+            result = _mm_add_ps(v0, _mm_mul_ps(_mm_sub_ps(v1, v0), frac));
+            result = _mm_or_ps(_mm_and_ps(small, _mm_mul_ps(v, lo_slope)), _mm_andnot_ps(small, result));
+            _mm_storeu_ps(&plane[i], result);
+        } else {
+            for (j = i; j < i + 4; ++j) {
+                plane[j] = EvalTransferLUT(lut, func, plane[j]);
+            }
+        }
+    }
+    return i;
+}
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+// Returns how many values were done, the rest are left for the scalar loop
+static int EvalTransferLUTPlane_NEON(const float *lut, SDL_TransferFunc func, float *plane, int n)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t lo = vdupq_n_f32(TRANSFER_LUT_MIN_VALUE);
+    const float32x4_t hi = vdupq_n_f32(1.0f);
+    const float lo_slope = lut[0] / TRANSFER_LUT_MIN_VALUE;
+    const uint32x4_t base = vdupq_n_u32(TRANSFER_LUT_MIN_EXPONENT << 23);
+    const uint32x4_t frac_mask = vdupq_n_u32((1 << TRANSFER_LUT_STEP_BITS) - 1);
+    int i, j;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const float32x4_t v = vld1q_f32(&plane[i]);
+        const uint32x4_t in_range = vandq_u32(vcgeq_f32(v, zero), vcleq_f32(v, hi));
+        const uint32x2_t all = vand_u32(vget_low_u32(in_range), vget_high_u32(in_range));
+
+        if (vget_lane_u32(all, 0) & vget_lane_u32(all, 1)) {
+            const uint32x4_t small = vcltq_f32(v, lo);
+            const uint32x4_t bits = vsubq_u32(vreinterpretq_u32_f32(vmaxq_f32(v, lo)), base);
+            const float32x4_t frac = vmulq_n_f32(vcvtq_f32_u32(vandq_u32(bits, frac_mask)), 1.0f / (1 << TRANSFER_LUT_STEP_BITS));
+            Uint32 index[4];
+            float lut0[4], lut1[4];
+            float32x4_t v0, v1;
+
+            vst1q_u32(index, vshrq_n_u32(bits, TRANSFER_LUT_STEP_BITS));
+            for (j = 0; j < 4; ++j) {
+                lut0[j] = lut[index[j]];
+                lut1[j] = lut[index[j] + 1];
+            }
+            v0 = vld1q_f32(lut0);
+            v1 = vld1q_f32(lut1);
+            vst1q_f32(&plane[i], vbslq_f32(small, vmulq_n_f32(v, lo_slope), vmlaq_f32(v0, vsubq_f32(v1, v0), frac)));
+        } else {
+            for (j = i; j < i + 4; ++j) {
+                plane[j] = EvalTransferLUT(lut, func, plane[j]);
+            }
+        }
+    }
+    return i;
+}
+#endif // SDL_NEON_INTRINSICS
+
+static void EvalTransferLUTPlane(const float *lut, SDL_TransferFunc func, float *plane, int n)
+{
+    int i = 0;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        i = EvalTransferLUTPlane_SSE2(lut, func, plane, n);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        i = EvalTransferLUTPlane_NEON(lut, func, plane, n);
+    }
+#endif
+    for (; i < n; ++i) {
+        plane[i] = EvalTransferLUT(lut, func, plane[i]);
+    }
+}
+
+typedef enum
+{
+    FloatPixelLayout_Unsupported,
+    FloatPixelLayout_Packed32,
+    FloatPixelLayout_ArrayU16,
+    FloatPixelLayout_ArrayF16,
+    FloatPixelLayout_ArrayF32
+} FloatPixelLayout;
+
+// How to get linear RGBA out of or into a row of pixels, see GetFloatPixelRow()
+typedef struct
+{
+    FloatPixelLayout layout;
+    int bpp;
+
+    // Packed32: the position and largest value of R, G, B and A, with max 0 if the channel is missing
+    int shift[4];
+    Uint32 max[4];
+    Uint32 fill; // bits set in every written pixel
+
+    // Packed32: exact table for the RGB channel codes, or NULL
+    const float *code_lut;
+    float code_lut_scale;
+
+    // Arrays: the component of R, G, B and A, with A -1 if it's missing
+    int index[4];
+
+    SDL_TransferCharacteristics transfer;
+    float white_point;
+} FloatPixelRow;
+
+static bool GetFloatPixelRow(const SDL_PixelFormatDetails *fmt, SDL_Colorspace colorspace, float white_point, FloatPixelRow *row)
+{
+    const SDL_PixelFormat format = fmt->format;
+
+    SDL_zerop(row);
+    row->bpp = fmt->bytes_per_pixel;
+    row->transfer = SDL_COLORSPACETRANSFER(colorspace);
+    row->white_point = white_point;
+
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format)) {
+        return false;
+    }
+
+    if (fmt->bytes_per_pixel == 4) {
+        const int bits = fmt->Rbits;
+
+        if ((bits != 8 && bits != 10) || fmt->Gbits != bits || fmt->Bbits != bits) {
+            return false;
+        }
+        row->layout = FloatPixelLayout_Packed32;
+        row->shift[0] = fmt->Rshift;
+        row->shift[1] = fmt->Gshift;
+        row->shift[2] = fmt->Bshift;
+        row->shift[3] = fmt->Ashift;
+        row->max[0] = row->max[1] = row->max[2] = (1u << bits) - 1;
+        row->max[3] = fmt->Amask ? ((1u << fmt->Abits) - 1) : 0;
+        if (SDL_ISPIXELFORMAT_10BIT(format) && !fmt->Amask) {
+            // The X bits of the 10-bit formats are written as opaque alpha
+            row->fill = 0xC0000000;
+        }
+
+        if (row->transfer == SDL_TRANSFER_CHARACTERISTICS_SRGB) {
+            row->code_lut = (bits == 8) ? sRGB8toLinear : sRGB10toLinear;
+            row->code_lut_scale = 1.0f;
+        } else if (row->transfer == SDL_TRANSFER_CHARACTERISTICS_PQ && bits == 10) {
+            row->code_lut = PQ10toNits;
+            row->code_lut_scale = 1.0f / white_point;
+        }
+        return true;
+    }
+
+    if (fmt->bytes_per_pixel > 4) {
+        int num_components;
+
+        switch (SDL_PIXELTYPE(format)) {
+        case SDL_PIXELTYPE_ARRAYU16:
+            row->layout = FloatPixelLayout_ArrayU16;
+            num_components = fmt->bytes_per_pixel / 2;
+            break;
+        case SDL_PIXELTYPE_ARRAYF16:
+            row->layout = FloatPixelLayout_ArrayF16;
+            num_components = fmt->bytes_per_pixel / 2;
+            break;
+        case SDL_PIXELTYPE_ARRAYF32:
+            row->layout = FloatPixelLayout_ArrayF32;
+            num_components = fmt->bytes_per_pixel / 4;
+            break;
+        default:
+            return false;
+        }
+
+        switch (SDL_PIXELORDER(format)) {
+        case SDL_ARRAYORDER_RGB:
+            row->index[0] = 0;
+            row->index[1] = 1;
+            row->index[2] = 2;
+            row->index[3] = -1;
+            break;
+        case SDL_ARRAYORDER_RGBA:
+            row->index[0] = 0;
+            row->index[1] = 1;
+            row->index[2] = 2;
+            row->index[3] = 3;
+            break;
+        case SDL_ARRAYORDER_ARGB:
+            row->index[0] = 1;
+            row->index[1] = 2;
+            row->index[2] = 3;
+            row->index[3] = 0;
+            break;
+        case SDL_ARRAYORDER_BGR:
+            row->index[0] = 2;
+            row->index[1] = 1;
+            row->index[2] = 0;
+            row->index[3] = -1;
+            break;
+        case SDL_ARRAYORDER_BGRA:
+            row->index[0] = 2;
+            row->index[1] = 1;
+            row->index[2] = 0;
+            row->index[3] = 3;
+            break;
+        case SDL_ARRAYORDER_ABGR:
+            row->index[0] = 3;
+            row->index[1] = 2;
+            row->index[2] = 1;
+            row->index[3] = 0;
+            break;
+        default:
+            return false;
+        }
+        if (row->index[3] >= num_components) {
+            row->index[3] = -1;
+        }
+        return (row->index[0] < num_components && row->index[2] < num_components);
+    }
+
+    return false;
+}
+
+static void ReadFloatPixelRow(const FloatPixelRow *row, const Uint8 *src, Uint64 posx, Uint64 incx, int n, float planes[4][SLOW_FLOAT_CHUNK_PIXELS])
+{
+    bool decoded = false;
+    int i, c;
+
+    switch (row->layout) {
+    case FloatPixelLayout_Packed32:
+    {
+        Uint32 pixels[SLOW_FLOAT_CHUNK_PIXELS];
+
+        for (i = 0; i < n; ++i) {
+            pixels[i] = *(const Uint32 *)(src + (posx >> 16) * 4);
+            posx += incx;
+        }
+        for (c = 0; c < 4; ++c) {
+            const int shift = row->shift[c];
+            const Uint32 max = row->max[c];
+            float *plane = planes[c];
+
+            if (!max) {
+                for (i = 0; i < n; ++i) {
+                    plane[i] = 1.0f;
+                }
+            } else if (c < 3 && row->code_lut) {
+                const float *lut = row->code_lut;
+                const float scale = row->code_lut_scale;
+
+                for (i = 0; i < n; ++i) {
+                    plane[i] = lut[(pixels[i] >> shift) & max] * scale;
+                }
+            } else {
+                const float scale = 1.0f / (float)max;
+
+                for (i = 0; i < n; ++i) {
+                    plane[i] = (float)((pixels[i] >> shift) & max) * scale;
+                }
+            }
+        }
+        decoded = (row->code_lut != NULL);
+        break;
+    }
+    case FloatPixelLayout_ArrayU16:
+        for (i = 0; i < n; ++i) {
+            const Uint16 *pixel = (const Uint16 *)(src + (posx >> 16) * row->bpp);
+
+            for (c = 0; c < 3; ++c) {
+                planes[c][i] = (float)pixel[row->index[c]] / SDL_MAX_UINT16;
+            }
+            planes[3][i] = (row->index[3] >= 0) ? (float)pixel[row->index[3]] / SDL_MAX_UINT16 : 1.0f;
+            posx += incx;
+        }
+        break;
+    case FloatPixelLayout_ArrayF16:
+        for (i = 0; i < n; ++i) {
+            const Uint16 *pixel = (const Uint16 *)(src + (posx >> 16) * row->bpp);
+
+            for (c = 0; c < 3; ++c) {
+                planes[c][i] = half_to_float(pixel[row->index[c]]);
+            }
+            planes[3][i] = (row->index[3] >= 0) ? half_to_float(pixel[row->index[3]]) : 1.0f;
+            posx += incx;
+        }
+        break;
+    case FloatPixelLayout_ArrayF32:
+        for (i = 0; i < n; ++i) {
+            const float *pixel = (const float *)(src + (posx >> 16) * row->bpp);
+
+            for (c = 0; c < 3; ++c) {
+                planes[c][i] = pixel[row->index[c]];
+            }
+            planes[3][i] = (row->index[3] >= 0) ? pixel[row->index[3]] : 1.0f;
+            posx += incx;
+        }
+        break;
+    default:
+        SDL_assert(!"Unsupported float pixel layout");
+        break;
+    }
+
+    if (decoded) {
+        return;
+    }
+
+    // Convert to nits so src and dst are guaranteed to be linear and in the same units
+    for (c = 0; c < 3; ++c) {
+        float *plane = planes[c];
+
+        switch (row->transfer) {
+        case SDL_TRANSFER_CHARACTERISTICS_SRGB:
+            EvalTransferLUTPlane(sRGBtoLinear_LUT, SDL_sRGBtoLinear, plane, n);
+            break;
+        case SDL_TRANSFER_CHARACTERISTICS_PQ:
+        {
+            const float scale = 1.0f / row->white_point;
+
+            EvalTransferLUTPlane(PQtoNits_LUT, SDL_PQtoNits, plane, n);
+            for (i = 0; i < n; ++i) {
+                plane[i] *= scale;
+            }
+            break;
+        }
+        case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
+        {
+            const float scale = 1.0f / row->white_point;
+
+            for (i = 0; i < n; ++i) {
+                plane[i] *= scale;
+            }
+            break;
+        }
+        default:
+            // Unknown, leave it alone
+            break;
+        }
+    }
+}
+
+static void WriteFloatPixelRow(const FloatPixelRow *row, Uint8 *dst, int n, float planes[4][SLOW_FLOAT_CHUNK_PIXELS])
+{
+    // Values outside of 0..1 are clamped after encoding anyway, clamping them first keeps them in the tables
+    const bool unorm = (row->layout == FloatPixelLayout_Packed32 || row->layout == FloatPixelLayout_ArrayU16);
+    int i, c;
+
+    // We converted to nits so src and dst are guaranteed to be linear and in the same units
+    for (c = 0; c < 3; ++c) {
+        float *plane = planes[c];
+
+        switch (row->transfer) {
+        case SDL_TRANSFER_CHARACTERISTICS_SRGB:
+            if (unorm) {
+                for (i = 0; i < n; ++i) {
+                    plane[i] = SDL_clamp(plane[i], 0.0f, 1.0f);
+                }
+            }
+            EvalTransferLUTPlane(sRGBfromLinear_LUT, SDL_sRGBfromLinear, plane, n);
+            break;
+        case SDL_TRANSFER_CHARACTERISTICS_PQ:
+        {
+            const float scale = row->white_point / 10000.0f;
+
+            // SDL_PQfromNits() clamps to 10000 nits
+            for (i = 0; i < n; ++i) {
+                plane[i] = SDL_clamp(plane[i] * scale, 0.0f, 1.0f);
+            }
+            EvalTransferLUTPlane(PQfromNits_LUT, PQfromNormalizedNits, plane, n);
+            break;
+        }
+        case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
+        {
+            const float scale = row->white_point;
+
+            for (i = 0; i < n; ++i) {
+                plane[i] *= scale;
+            }
+            break;
+        }
+        default:
+            // Unknown, leave it alone
+            break;
+        }
+    }
+
+    switch (row->layout) {
+    case FloatPixelLayout_Packed32:
+    {
+        Uint32 pixels[SLOW_FLOAT_CHUNK_PIXELS];
+
+        for (i = 0; i < n; ++i) {
+            pixels[i] = row->fill;
+        }
+        for (c = 0; c < 4; ++c) {
+            const int shift = row->shift[c];
+            const float max = (float)row->max[c];
+            const float *plane = planes[c];
+
+            if (!row->max[c]) {
+                continue;
+            }
+            for (i = 0; i < n; ++i) {
+                pixels[i] |= (Uint32)(int)(SDL_clamp(plane[i], 0.0f, 1.0f) * max + 0.5f) << shift;
+            }
+        }
+        SDL_memcpy(dst, pixels, n * sizeof(Uint32));
+        break;
+    }
+    case FloatPixelLayout_ArrayU16:
+        for (i = 0; i < n; ++i) {
+            Uint16 *pixel = (Uint16 *)(dst + i * row->bpp);
+
+            for (c = 0; c < 4; ++c) {
+                if (row->index[c] >= 0) {
+                    pixel[row->index[c]] = (Uint16)(SDL_clamp(planes[c][i], 0.0f, 1.0f) * SDL_MAX_UINT16 + 0.5f);
+                }
+            }
+        }
+        break;
+    case FloatPixelLayout_ArrayF16:
+        for (i = 0; i < n; ++i) {
+            Uint16 *pixel = (Uint16 *)(dst + i * row->bpp);
+
+            for (c = 0; c < 4; ++c) {
+                if (row->index[c] >= 0) {
+                    pixel[row->index[c]] = float_to_half(planes[c][i]);
+                }
+            }
+        }
+        break;
+    case FloatPixelLayout_ArrayF32:
+        for (i = 0; i < n; ++i) {
+            float *pixel = (float *)(dst + i * row->bpp);
+
+            for (c = 0; c < 4; ++c) {
+                if (row->index[c] >= 0) {
+                    pixel[row->index[c]] = planes[c][i];
+                }
+            }
+        }
+        break;
+    default:
+        SDL_assert(!"Unsupported float pixel layout");
+        break;
+    }
+}
+
 typedef enum
 {
     SDL_TONEMAP_NONE,
@@ -785,7 +1340,7 @@ static void TonemapChrome(float *r, float *g, float *b, float tonemap_a, float t
     }
 }
 
-static void ApplyTonemap(SDL_TonemapContext *ctx, float *r, float *g, float *b)
+static void ApplyTonemap(const SDL_TonemapContext *ctx, float *r, float *g, float *b)
 {
     switch (ctx->op) {
     case SDL_TONEMAP_LINEAR:
@@ -802,6 +1357,197 @@ static void ApplyTonemap(SDL_TonemapContext *ctx, float *r, float *g, float *b)
     }
 }
 
+static void TonemapRow(const SDL_TonemapContext *ctx, const float *color_primaries_matrix, int start, int n, float planes[4][SLOW_FLOAT_CHUNK_PIXELS])
+{
+    float *r = planes[0];
+    float *g = planes[1];
+    float *b = planes[2];
+    int i;
+
+    for (i = start; i < n; ++i) {
+        if (ctx->op) {
+            ApplyTonemap(ctx, &r[i], &g[i], &b[i]);
+        }
+        if (color_primaries_matrix) {
+            SDL_ConvertColorPrimaries(&r[i], &g[i], &b[i], color_primaries_matrix);
+        }
+    }
+}
+
+#ifdef SDL_SSE_INTRINSICS
+static SDL_INLINE void SDL_TARGETING("sse") ConvertColorPrimaries_SSE(__m128 *r, __m128 *g, __m128 *b, const float *matrix)
+{
+    const __m128 v0 = *r;
+    const __m128 v1 = *g;
+    const __m128 v2 = *b;
+
+    *r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(matrix[0]), v0), _mm_mul_ps(_mm_set1_ps(matrix[1]), v1)), _mm_mul_ps(_mm_set1_ps(matrix[2]), v2));
+    *g = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(matrix[3]), v0), _mm_mul_ps(_mm_set1_ps(matrix[4]), v1)), _mm_mul_ps(_mm_set1_ps(matrix[5]), v2));
+    *b = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(matrix[6]), v0), _mm_mul_ps(_mm_set1_ps(matrix[7]), v1)), _mm_mul_ps(_mm_set1_ps(matrix[8]), v2));
+}
+
+static void SDL_TARGETING("sse") TonemapRow_SSE(const SDL_TonemapContext *ctx, const float *color_primaries_matrix, int n, float planes[4][SLOW_FLOAT_CHUNK_PIXELS])
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128 r = _mm_loadu_ps(&planes[0][i]);
+        __m128 g = _mm_loadu_ps(&planes[1][i]);
+        __m128 b = _mm_loadu_ps(&planes[2][i]);
+
+        if (ctx->op == SDL_TONEMAP_LINEAR) {
+            const __m128 scale = _mm_set1_ps(ctx->data.linear.scale);
+            r = _mm_mul_ps(r, scale);
+            g = _mm_mul_ps(g, scale);
+            b = _mm_mul_ps(b, scale);
+        } else if (ctx->op == SDL_TONEMAP_CHROME) {
+            __m128 vmax, scale, mask;
+
+            if (ctx->data.chrome.color_primaries_matrix) {
+                ConvertColorPrimaries_SSE(&r, &g, &b, ctx->data.chrome.color_primaries_matrix);
+            }
+            vmax = _mm_max_ps(r, _mm_max_ps(g, b));
+            scale = _mm_div_ps(_mm_add_ps(one, _mm_mul_ps(_mm_set1_ps(ctx->data.chrome.a), vmax)),
+                               _mm_add_ps(one, _mm_mul_ps(_mm_set1_ps(ctx->data.chrome.b), vmax)));
+            mask = _mm_cmpgt_ps(vmax, zero);
+            scale = _mm_or_ps(_mm_and_ps(mask, scale), _mm_andnot_ps(mask, one));
+            r = _mm_mul_ps(r, scale);
+            g = _mm_mul_ps(g, scale);
+            b = _mm_mul_ps(b, scale);
+        }
+        if (color_primaries_matrix) {
+            ConvertColorPrimaries_SSE(&r, &g, &b, color_primaries_matrix);
+        }
+
+        _mm_storeu_ps(&planes[0][i], r);
+        _mm_storeu_ps(&planes[1][i], g);
+        _mm_storeu_ps(&planes[2][i], b);
+    }
+    TonemapRow(ctx, color_primaries_matrix, i, n, planes);
+}
+#endif // SDL_SSE_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_INLINE void ConvertColorPrimaries_NEON(float32x4_t *r, float32x4_t *g, float32x4_t *b, const float *matrix)
+{
+    const float32x4_t v0 = *r;
+    const float32x4_t v1 = *g;
+    const float32x4_t v2 = *b;
+
+    *r = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(v0, matrix[0]), v1, matrix[1]), v2, matrix[2]);
+    *g = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(v0, matrix[3]), v1, matrix[4]), v2, matrix[5]);
+    *b = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(v0, matrix[6]), v1, matrix[7]), v2, matrix[8]);
+}
+
+static void TonemapRow_NEON(const SDL_TonemapContext *ctx, const float *color_primaries_matrix, int n, float planes[4][SLOW_FLOAT_CHUNK_PIXELS])
+{
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        float32x4_t r = vld1q_f32(&planes[0][i]);
+        float32x4_t g = vld1q_f32(&planes[1][i]);
+        float32x4_t b = vld1q_f32(&planes[2][i]);
+
+        if (ctx->op == SDL_TONEMAP_LINEAR) {
+            r = vmulq_n_f32(r, ctx->data.linear.scale);
+            g = vmulq_n_f32(g, ctx->data.linear.scale);
+            b = vmulq_n_f32(b, ctx->data.linear.scale);
+        } else if (ctx->op == SDL_TONEMAP_CHROME) {
+            float32x4_t vmax, num, den, recip, scale;
+
+            if (ctx->data.chrome.color_primaries_matrix) {
+                ConvertColorPrimaries_NEON(&r, &g, &b, ctx->data.chrome.color_primaries_matrix);
+            }
+            vmax = vmaxq_f32(r, vmaxq_f32(g, b));
+            num = vmlaq_n_f32(one, vmax, ctx->data.chrome.a);
+            den = vmlaq_n_f32(one, vmax, ctx->data.chrome.b);
+            // No vdivq_f32() on 32-bit ARM, refine the reciprocal estimate instead
+            recip = vrecpeq_f32(den);
+            recip = vmulq_f32(recip, vrecpsq_f32(den, recip));
+            recip = vmulq_f32(recip, vrecpsq_f32(den, recip));
+            scale = vmulq_f32(num, recip);
+            scale = vbslq_f32(vcgtq_f32(vmax, zero), scale, one);
+            r = vmulq_f32(r, scale);
+            g = vmulq_f32(g, scale);
+            b = vmulq_f32(b, scale);
+        }
+        if (color_primaries_matrix) {
+            ConvertColorPrimaries_NEON(&r, &g, &b, color_primaries_matrix);
+        }
+
+        vst1q_f32(&planes[0][i], r);
+        vst1q_f32(&planes[1][i], g);
+        vst1q_f32(&planes[2][i], b);
+    }
+    TonemapRow(ctx, color_primaries_matrix, i, n, planes);
+}
+#endif // SDL_NEON_INTRINSICS
+
+typedef void (*SDL_TonemapRowFunc)(const SDL_TonemapContext *ctx, const float *color_primaries_matrix, int n, float planes[4][SLOW_FLOAT_CHUNK_PIXELS]);
+
+static void TonemapRow_Scalar(const SDL_TonemapContext *ctx, const float *color_primaries_matrix, int n, float planes[4][SLOW_FLOAT_CHUNK_PIXELS])
+{
+    TonemapRow(ctx, color_primaries_matrix, 0, n, planes);
+}
+
+static SDL_TonemapRowFunc GetTonemapRowFunc(void)
+{
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        return TonemapRow_SSE;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return TonemapRow_NEON;
+    }
+#endif
+    return TonemapRow_Scalar;
+}
+
+// Pure format and colorspace conversions of formats that GetFloatPixelRow() knows about
+static void SDL_Blit_Slow_Float_Rows(SDL_BlitInfo *info, const FloatPixelRow *src_row, const FloatPixelRow *dst_row,
+                                     const SDL_TonemapContext *tonemap, const float *color_primaries_matrix)
+{
+    const SDL_TonemapRowFunc tonemap_row = (tonemap->op || color_primaries_matrix) ? GetTonemapRowFunc() : NULL;
+    float planes[4][SLOW_FLOAT_CHUNK_PIXELS];
+    Uint64 posy, posx;
+    Uint64 incy, incx;
+
+    SetupTransferLUTs();
+
+    incy = ((Uint64)info->src_h << 16) / info->dst_h;
+    incx = ((Uint64)info->src_w << 16) / info->dst_w;
+    posy = incy / 2; // start at the middle of pixel
+
+    while (info->dst_h--) {
+        const Uint8 *src = info->src + (posy >> 16) * info->src_pitch;
+        Uint8 *dst = info->dst;
+        int x = 0;
+
+        posx = incx / 2; // start at the middle of pixel
+        while (x < info->dst_w) {
+            const int n = SDL_min(info->dst_w - x, SLOW_FLOAT_CHUNK_PIXELS);
+
+            ReadFloatPixelRow(src_row, src, posx, incx, n, planes);
+            if (tonemap_row) {
+                tonemap_row(tonemap, color_primaries_matrix, n, planes);
+            }
+            WriteFloatPixelRow(dst_row, dst, n, planes);
+
+            posx += incx * n;
+            dst += n * dst_row->bpp;
+            x += n;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
 /* The SECOND TRUE BLITTER
  * This one is even slower than the first, but also handles large pixel formats and colorspace conversion
  */
@@ -821,7 +1567,7 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
     const SDL_Palette *src_pal = info->src_pal;
     const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
     const SDL_Palette *dst_pal = info->dst_pal;
-    SDL_HashTable *palette_map = info->palette_map;
+    SDL_InversePalette *palette_map = info->palette_map;
     int srcbpp = src_fmt->bytes_per_pixel;
     int dstbpp = dst_fmt->bytes_per_pixel;
     SlowBlitPixelAccess src_access;
@@ -886,6 +1632,16 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
         color_primaries_matrix = SDL_GetColorPrimariesConversionMatrix(src_primaries, dst_primaries);
     }
 
+    if (!(flags & (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK))) {
+        FloatPixelRow src_row, dst_row;
+
+        if (GetFloatPixelRow(src_fmt, src_colorspace, src_white_point, &src_row) &&
+            GetFloatPixelRow(dst_fmt, dst_colorspace, dst_white_point, &dst_row)) {
+            SDL_Blit_Slow_Float_Rows(info, &src_row, &dst_row, &tonemap, color_primaries_matrix);
+            return;
+        }
+    }
+
     src_access = GetPixelAccessMethod(src_fmt->format);
     dst_access = GetPixelAccessMethod(dst_fmt->format);
     if (dst_access == SlowBlitPixelAccess_Index8) {
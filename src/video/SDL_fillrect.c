@@ -226,6 +226,264 @@ static void SDL_FillSurfaceRect4(Uint8 *pixels, int pitch, Uint32 color, int w,
     }
 }
 
+/* The vector fills store a repeating byte pattern, which handles every pixel size the
+ * same way: 8, 16 and 32-bit colors repeat every 4 bytes and 24-bit colors every 3,
+ * so 48 and 96 byte blocks always hold a whole number of pixels.
+ */
+#define SDL_FILL_PATTERN_SIZE 128
+
+// Rectangles this big won't be read back from the cache before they're evicted, so stream them.
+#define SDL_FILL_STREAM_MIN_BYTES (4 * 1024 * 1024)
+
+// Filling is cheap, so the area has to be bigger than for blits before threads pay off.
+#define SDL_FILL_THREADS_MIN_PIXELS (512 * 512)
+
+typedef void (*SDL_FillPatternFunc)(Uint8 *pixels, int pitch, const Uint8 *pattern, int period, int n, int h, bool stream);
+
+/* Copies the last n < 16 bytes of a row from the pattern with overlapping stores,
+ * a variable length memcpy costs more than the row itself for narrow rectangles.
+ */
+SDL_FORCE_INLINE void SDL_FillPatternTail(Uint8 *p, const Uint8 *phase, int n)
+{
+    if (n >= 8) {
+        Uint64 head, tail;
+        SDL_memcpy(&head, phase, sizeof(head));
+        SDL_memcpy(&tail, phase + n - 8, sizeof(tail));
+        SDL_memcpy(p, &head, sizeof(head));
+        SDL_memcpy(p + n - 8, &tail, sizeof(tail));
+    } else if (n >= 4) {
+        Uint32 head, tail;
+        SDL_memcpy(&head, phase, sizeof(head));
+        SDL_memcpy(&tail, phase + n - 4, sizeof(tail));
+        SDL_memcpy(p, &head, sizeof(head));
+        SDL_memcpy(p + n - 4, &tail, sizeof(tail));
+    } else {
+        while (n--) {
+            *p++ = *phase++;
+        }
+    }
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_FillSurfacePatternAVX2(Uint8 *pixels, int pitch, const Uint8 *pattern, int period, int n, int h, bool stream)
+{
+    // Only stream rows long enough to have aligned blocks after the head.
+    const bool aligned = (stream && n >= 128);
+
+    while (h--) {
+        Uint8 *p = pixels;
+        const Uint8 *phase = pattern;
+        int remaining = n;
+        __m256i v0, v1, v2;
+
+        if (aligned) {
+            const int adjust = (int)((32 - ((uintptr_t)p & 31)) & 31);
+            SDL_memcpy(p, pattern, adjust);
+            p += adjust;
+            remaining -= adjust;
+            phase += adjust % period;
+        }
+        v0 = _mm256_loadu_si256((const __m256i *)phase);
+        v1 = _mm256_loadu_si256((const __m256i *)(phase + 32));
+        v2 = _mm256_loadu_si256((const __m256i *)(phase + 64));
+        if (aligned) {
+            for (; remaining >= 96; remaining -= 96, p += 96) {
+                _mm256_stream_si256((__m256i *)p, v0);
+                _mm256_stream_si256((__m256i *)(p + 32), v1);
+                _mm256_stream_si256((__m256i *)(p + 64), v2);
+            }
+        } else {
+            for (; remaining >= 96; remaining -= 96, p += 96) {
+                _mm256_storeu_si256((__m256i *)p, v0);
+                _mm256_storeu_si256((__m256i *)(p + 32), v1);
+                _mm256_storeu_si256((__m256i *)(p + 64), v2);
+            }
+        }
+        if (remaining >= 32) {
+            _mm256_storeu_si256((__m256i *)p, v0);
+            if (remaining >= 64) {
+                _mm256_storeu_si256((__m256i *)(p + 32), v1);
+            }
+            _mm256_storeu_si256((__m256i *)(p + remaining - 32), _mm256_loadu_si256((const __m256i *)(phase + remaining - 32)));
+        } else if (remaining >= 16) {
+            _mm_storeu_si128((__m128i *)p, _mm_loadu_si128((const __m128i *)phase));
+            _mm_storeu_si128((__m128i *)(p + remaining - 16), _mm_loadu_si128((const __m128i *)(phase + remaining - 16)));
+        } else {
+            SDL_FillPatternTail(p, phase, remaining);
+        }
+        pixels += pitch;
+    }
+    if (aligned) {
+        _mm_sfence();
+    }
+}
+#endif // SDL_AVX2_INTRINSICS
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") SDL_FillSurfacePatternSSE2(Uint8 *pixels, int pitch, const Uint8 *pattern, int period, int n, int h, bool stream)
+{
+    const bool aligned = (stream && n >= 64);
+
+    while (h--) {
+        Uint8 *p = pixels;
+        const Uint8 *phase = pattern;
+        int remaining = n;
+        __m128i v0, v1, v2;
+
+        if (aligned) {
+            const int adjust = (int)((16 - ((uintptr_t)p & 15)) & 15);
+            SDL_memcpy(p, pattern, adjust);
+            p += adjust;
+            remaining -= adjust;
+            phase += adjust % period;
+        }
+        v0 = _mm_loadu_si128((const __m128i *)phase);
+        v1 = _mm_loadu_si128((const __m128i *)(phase + 16));
+        v2 = _mm_loadu_si128((const __m128i *)(phase + 32));
+        if (aligned) {
+            for (; remaining >= 48; remaining -= 48, p += 48) {
+                _mm_stream_si128((__m128i *)p, v0);
+                _mm_stream_si128((__m128i *)(p + 16), v1);
+                _mm_stream_si128((__m128i *)(p + 32), v2);
+            }
+        } else {
+            for (; remaining >= 48; remaining -= 48, p += 48) {
+                _mm_storeu_si128((__m128i *)p, v0);
+                _mm_storeu_si128((__m128i *)(p + 16), v1);
+                _mm_storeu_si128((__m128i *)(p + 32), v2);
+            }
+        }
+        if (remaining >= 16) {
+            _mm_storeu_si128((__m128i *)p, v0);
+            if (remaining >= 32) {
+                _mm_storeu_si128((__m128i *)(p + 16), v1);
+            }
+            _mm_storeu_si128((__m128i *)(p + remaining - 16), _mm_loadu_si128((const __m128i *)(phase + remaining - 16)));
+        } else {
+            SDL_FillPatternTail(p, phase, remaining);
+        }
+        pixels += pitch;
+    }
+    if (aligned) {
+        _mm_sfence();
+    }
+}
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+static void SDL_FillSurfacePatternNEON(Uint8 *pixels, int pitch, const Uint8 *pattern, int period, int n, int h, bool stream)
+{
+    // There's no non-temporal store intrinsic, so large fills use regular stores.
+    const uint8x16_t v0 = vld1q_u8(pattern);
+    const uint8x16_t v1 = vld1q_u8(pattern + 16);
+    const uint8x16_t v2 = vld1q_u8(pattern + 32);
+
+    (void)period;
+    (void)stream;
+
+    while (h--) {
+        Uint8 *p = pixels;
+        int remaining = n;
+
+        for (; remaining >= 48; remaining -= 48, p += 48) {
+            vst1q_u8(p, v0);
+            vst1q_u8(p + 16, v1);
+            vst1q_u8(p + 32, v2);
+        }
+        if (remaining >= 16) {
+            vst1q_u8(p, v0);
+            if (remaining >= 32) {
+                vst1q_u8(p + 16, v1);
+            }
+            vst1q_u8(p + remaining - 16, vld1q_u8(pattern + remaining - 16));
+        } else {
+            SDL_FillPatternTail(p, pattern, remaining);
+        }
+        pixels += pitch;
+    }
+}
+#endif // SDL_NEON_INTRINSICS
+
+typedef struct
+{
+    SDL_Surface *dst;
+    const SDL_Rect *rects;
+    int count;
+    void (*fill_function)(Uint8 *pixels, int pitch, Uint32 color, int w, int h);
+    SDL_FillPatternFunc pattern_function;
+    Uint32 color;
+    int period;
+    Uint8 pattern[SDL_FILL_PATTERN_SIZE];
+} SDL_FillRectsJob;
+
+// Fills rows y to y + h of an already clipped rectangle
+static void FillRectRows(const SDL_FillRectsJob *job, const SDL_Rect *rect, int y, int h)
+{
+    SDL_Surface *dst = job->dst;
+    const int bpp = SDL_BYTESPERPIXEL(dst->format);
+    Uint8 *pixels = (Uint8 *)dst->pixels + (size_t)(rect->y + y) * dst->pitch + (size_t)rect->x * bpp;
+
+    if (job->pattern_function) {
+        const bool stream = ((Sint64)rect->w * rect->h * bpp >= SDL_FILL_STREAM_MIN_BYTES);
+        job->pattern_function(pixels, dst->pitch, job->pattern, job->period, rect->w * bpp, h, stream);
+    } else {
+        job->fill_function(pixels, dst->pitch, job->color, rect->w, h);
+    }
+}
+
+// Fills rows y to y + h of the clipped rectangles, as if they were stacked on top of each other
+static void FillRectsRows(void *userdata, int y, int h)
+{
+    const SDL_FillRectsJob *job = (const SDL_FillRectsJob *)userdata;
+    SDL_Rect clipped;
+    int i;
+
+    for (i = 0; i < job->count && h > 0; ++i) {
+        int rows;
+
+        if (!SDL_GetRectIntersection(&job->rects[i], &job->dst->internal->clip_rect, &clipped)) {
+            continue;
+        }
+        if (y >= clipped.h) {
+            y -= clipped.h;
+            continue;
+        }
+        rows = SDL_min(h, clipped.h - y);
+        FillRectRows(job, &clipped, y, rows);
+        h -= rows;
+        y = 0;
+    }
+}
+
+static bool FillRectsParallel(SDL_FillRectsJob *job)
+{
+    SDL_Rect clipped;
+    Sint64 rows = 0, area = 0;
+    int i;
+
+    // Lots of small rectangles are common, so check the area before clipping anything.
+    for (i = 0; i < job->count && area < SDL_FILL_THREADS_MIN_PIXELS; ++i) {
+        if (job->rects[i].w > 0 && job->rects[i].h > 0) {
+            area += (Sint64)job->rects[i].w * job->rects[i].h;
+        }
+    }
+    if (area < SDL_FILL_THREADS_MIN_PIXELS) {
+        return false;
+    }
+
+    area = 0;
+    for (i = 0; i < job->count; ++i) {
+        if (SDL_GetRectIntersection(&job->rects[i], &job->dst->internal->clip_rect, &clipped)) {
+            rows += clipped.h;
+            area += (Sint64)clipped.w * clipped.h;
+        }
+    }
+    if (area < SDL_FILL_THREADS_MIN_PIXELS || rows > SDL_MAX_SINT32) {
+        return false;
+    }
+    return SDL_RunBlitRowsParallel((int)(area / rows), (int)rows, FillRectsRows, job);
+}
+
 /*
  * This function performs a fast fill of the given rectangle with 'color'
  */
@@ -249,10 +507,10 @@ bool SDL_FillSurfaceRect(SDL_Surface *dst, const SDL_Rect *rect, Uint32 color)
 
 bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Uint32 color)
 {
+    SDL_FillRectsJob job;
     SDL_Rect clipped;
-    Uint8 *pixels;
-    const SDL_Rect *rect;
     void (*fill_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
+    bool parallel;
     int i;
 
     if (!SDL_SurfaceValid(dst)) {
@@ -273,6 +531,10 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         return SDL_InvalidParamError("SDL_FillSurfaceRects(): rects");
     }
 
+    if (!SDL_UnshareSurfacePixels(dst)) {
+        return false;
+    }
+
     /* This function doesn't usually work on surfaces < 8 bpp
      * Except: support for 4bits, when filling full size.
      */
@@ -282,6 +544,7 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
             if (r->x == 0 && r->y == 0 && r->w == dst->w && r->h == dst->h) {
                 if (SDL_BITSPERPIXEL(dst->format) == 4) {
                     Uint8 b = (((Uint8)color << 4) | (Uint8)color);
+                    SDL_AddSurfaceDamage(dst, NULL);
                     SDL_memset(dst->pixels, b, (size_t)dst->h * dst->pitch);
                     return true;
                 }
@@ -290,6 +553,24 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         return SDL_SetError("SDL_FillSurfaceRects(): Unsupported surface format");
     }
 
+    // The pattern fills cover every pixel size, the SSE row fills are only used on CPUs without them
+    SDL_zero(job);
+#ifdef SDL_AVX2_INTRINSICS
+    if (!job.pattern_function && SDL_HasAVX2()) {
+        job.pattern_function = SDL_FillSurfacePatternAVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (!job.pattern_function && SDL_HasSSE2()) {
+        job.pattern_function = SDL_FillSurfacePatternSSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (!job.pattern_function && SDL_HasNEON()) {
+        job.pattern_function = SDL_FillSurfacePatternNEON;
+    }
+#endif
+
     if (fill_function == NULL) {
         switch (SDL_BYTESPERPIXEL(dst->format)) {
         case 1:
@@ -297,7 +578,7 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
             color |= (color << 8);
             color |= (color << 16);
 #ifdef SDL_SSE_INTRINSICS
-            if (SDL_HasSSE()) {
+            if (!job.pattern_function && SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect1SSE;
                 break;
             }
@@ -310,7 +591,7 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         {
             color |= (color << 16);
 #ifdef SDL_SSE_INTRINSICS
-            if (SDL_HasSSE()) {
+            if (!job.pattern_function && SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect2SSE;
                 break;
             }
@@ -320,7 +601,7 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         }
 
         case 3:
-            // 24-bit RGB is a slow path, at least for now.
+            // 24-bit RGB is only vectorized by the pattern fills below.
             {
                 fill_function = SDL_FillSurfaceRect3;
                 break;
@@ -329,7 +610,7 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         case 4:
         {
 #ifdef SDL_SSE_INTRINSICS
-            if (SDL_HasSSE()) {
+            if (!job.pattern_function && SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect4SSE;
                 break;
             }
@@ -343,18 +624,49 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         }
     }
 
+    job.dst = dst;
+    job.rects = rects;
+    job.count = count;
+    job.fill_function = fill_function;
+    job.color = color;
+    if (job.pattern_function) {
+        if (SDL_BYTESPERPIXEL(dst->format) == 3) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+            const Uint8 b1 = (Uint8)(color & 0xFF);
+            const Uint8 b2 = (Uint8)((color >> 8) & 0xFF);
+            const Uint8 b3 = (Uint8)((color >> 16) & 0xFF);
+#elif SDL_BYTEORDER == SDL_BIG_ENDIAN
+            const Uint8 b1 = (Uint8)((color >> 16) & 0xFF);
+            const Uint8 b2 = (Uint8)((color >> 8) & 0xFF);
+            const Uint8 b3 = (Uint8)(color & 0xFF);
+#endif
+            for (i = 0; i + 3 <= SDL_FILL_PATTERN_SIZE; i += 3) {
+                job.pattern[i + 0] = b1;
+                job.pattern[i + 1] = b2;
+                job.pattern[i + 2] = b3;
+            }
+            job.period = 3;
+        } else {
+            // The color has already been replicated to 32 bits
+            for (i = 0; i < SDL_FILL_PATTERN_SIZE; i += 4) {
+                SDL_memcpy(&job.pattern[i], &color, sizeof(color));
+            }
+            job.period = 4;
+        }
+    }
+
+    parallel = FillRectsParallel(&job);
+
     for (i = 0; i < count; ++i) {
-        rect = &rects[i];
         // Perform clipping
-        if (!SDL_GetRectIntersection(rect, &dst->internal->clip_rect, &clipped)) {
+        if (!SDL_GetRectIntersection(&rects[i], &dst->internal->clip_rect, &clipped)) {
             continue;
         }
-        rect = &clipped;
-
-        pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch +
-                 rect->x * SDL_BYTESPERPIXEL(dst->format);
+        SDL_AddSurfaceDamage(dst, &clipped);
 
-        fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        if (!parallel) {
+            FillRectRows(&job, &clipped, 0, clipped.h);
+        }
     }
 
     // We're done!
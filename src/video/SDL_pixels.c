@@ -1103,17 +1103,13 @@ void SDL_DitherPalette(SDL_Palette *palette)
 /*
  * Match an RGB value to a particular palette index
  */
-Uint8 SDL_FindColor(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+static Uint8 FindColorRange(const SDL_Palette *pal, int start, unsigned int smallest, Uint8 pixel, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
-    // Do colorspace distance matching
-    unsigned int smallest;
     unsigned int distance;
     int rd, gd, bd, ad;
     int i;
-    Uint8 pixel = 0;
 
-    smallest = ~0U;
-    for (i = 0; i < pal->ncolors; ++i) {
+    for (i = start; i < pal->ncolors; ++i) {
         rd = pal->colors[i].r - r;
         gd = pal->colors[i].g - g;
         bd = pal->colors[i].b - b;
@@ -1130,19 +1126,300 @@ Uint8 SDL_FindColor(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     return pixel;
 }
 
-Uint8 SDL_LookupRGBAColor(SDL_HashTable *palette_map, Uint32 pixel, const SDL_Palette *pal)
+/* Reduce the per lane winners of the vectorized searches, preferring the
+   lowest index when distances are equal, like the scalar search does. */
+static Uint8 FindColorReduce(const Sint32 *distances, const Sint32 *indices, unsigned int *smallest)
+{
+    int best = 0;
+    int i;
+
+    for (i = 1; i < 4; ++i) {
+        if (distances[i] < distances[best] ||
+            (distances[i] == distances[best] && indices[i] < indices[best])) {
+            best = i;
+        }
+    }
+    *smallest = (unsigned int)distances[best];
+    return (Uint8)indices[best];
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static Uint8 SDL_TARGETING("sse2") FindColor_SSE2(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i target = _mm_unpacklo_epi8(_mm_set1_epi32((int)((Uint32)r | ((Uint32)g << 8) | ((Uint32)b << 16) | ((Uint32)a << 24))), zero);
+    const __m128i four = _mm_set1_epi32(4);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i best_distance = _mm_set1_epi32(SDL_MAX_SINT32);
+    __m128i best_index = zero;
+    Sint32 distances[4], indices[4];
+    unsigned int smallest;
+    Uint8 pixel;
+    int i;
+
+    for (i = 0; i + 4 <= pal->ncolors; i += 4) {
+        const __m128i colors = _mm_loadu_si128((const __m128i *)&pal->colors[i]);
+        __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(colors, zero), target);
+        __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(colors, zero), target);
+        __m128i distance, closer;
+
+        // rd*rd + gd*gd and bd*bd + ad*ad for each color, then add the pairs
+        lo = _mm_madd_epi16(lo, lo);
+        hi = _mm_madd_epi16(hi, hi);
+        distance = _mm_add_epi32(
+            _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0))),
+            _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(3, 1, 3, 1))));
+
+        closer = _mm_cmplt_epi32(distance, best_distance);
+        best_distance = _mm_or_si128(_mm_and_si128(closer, distance), _mm_andnot_si128(closer, best_distance));
+        best_index = _mm_or_si128(_mm_and_si128(closer, index), _mm_andnot_si128(closer, best_index));
+        index = _mm_add_epi32(index, four);
+    }
+    _mm_storeu_si128((__m128i *)distances, best_distance);
+    _mm_storeu_si128((__m128i *)indices, best_index);
+
+    pixel = FindColorReduce(distances, indices, &smallest);
+    if (smallest == 0) {
+        return pixel;
+    }
+    return FindColorRange(pal, i, smallest, pixel, r, g, b, a);
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+static Uint8 FindColor_NEON(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const Uint8 rgba[8] = { r, g, b, a, r, g, b, a };
+    const uint8x8_t target = vld1_u8(rgba);
+    const Sint32 first_indices[4] = { 0, 1, 2, 3 };
+    int32x4_t index = vld1q_s32(first_indices);
+    int32x4_t best_distance = vdupq_n_s32(SDL_MAX_SINT32);
+    int32x4_t best_index = vdupq_n_s32(0);
+    Sint32 distances[4], indices[4];
+    unsigned int smallest;
+    Uint8 pixel;
+    int i;
+
+    for (i = 0; i + 4 <= pal->ncolors; i += 4) {
+        const uint8x16_t colors = vld1q_u8((const Uint8 *)&pal->colors[i]);
+        const int16x8_t lo = vreinterpretq_s16_u16(vsubl_u8(vget_low_u8(colors), target));
+        const int16x8_t hi = vreinterpretq_s16_u16(vsubl_u8(vget_high_u8(colors), target));
+        const int32x4_t sq0 = vmull_s16(vget_low_s16(lo), vget_low_s16(lo));
+        const int32x4_t sq1 = vmull_s16(vget_high_s16(lo), vget_high_s16(lo));
+        const int32x4_t sq2 = vmull_s16(vget_low_s16(hi), vget_low_s16(hi));
+        const int32x4_t sq3 = vmull_s16(vget_high_s16(hi), vget_high_s16(hi));
+        const int32x4_t distance = vpaddq_s32(vpaddq_s32(sq0, sq1), vpaddq_s32(sq2, sq3));
+        const uint32x4_t closer = vcltq_s32(distance, best_distance);
+
+        best_distance = vbslq_s32(closer, distance, best_distance);
+        best_index = vbslq_s32(closer, index, best_index);
+        index = vaddq_s32(index, vdupq_n_s32(4));
+    }
+    vst1q_s32(distances, best_distance);
+    vst1q_s32(indices, best_index);
+
+    pixel = FindColorReduce(distances, indices, &smallest);
+    if (smallest == 0) {
+        return pixel;
+    }
+    return FindColorRange(pal, i, smallest, pixel, r, g, b, a);
+}
+#endif
+
+Uint8 SDL_FindColor(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    // Do colorspace distance matching
+    if (pal->ncolors >= 16) {
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return FindColor_SSE2(pal, r, g, b, a);
+        }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+        if (SDL_HasNEON()) {
+            return FindColor_NEON(pal, r, g, b, a);
+        }
+#endif
+    }
+    return FindColorRange(pal, 0, ~0U, 0, r, g, b, a);
+}
+
+/* The inverse palette splits the RGB cube into cells, and lazily keeps a list
+   of the palette entries that can be the closest match for any color in each
+   cell. An entry can be left out if even its nearest point in the cell is
+   further away than the furthest point of another entry. Equally close
+   entries are all kept, in palette order, so lookups give exactly the same
+   result as SDL_FindColor(). Translucent colors aren't in the cells, and are
+   cached in a hash table instead. */
+#define INVERSE_PALETTE_BITS  4
+#define INVERSE_PALETTE_SHIFT (8 - INVERSE_PALETTE_BITS)
+#define INVERSE_PALETTE_CELLS (1 << (3 * INVERSE_PALETTE_BITS))
+
+struct SDL_InversePalette
+{
+    Uint32 version;
+    int ncolors;
+    Uint32 cell_start[INVERSE_PALETTE_CELLS];
+    Uint16 cell_count[INVERSE_PALETTE_CELLS]; // 0 until the cell has been built
+    Uint8 *candidates;
+    int num_candidates;
+    int max_candidates;
+    SDL_HashTable *translucent;
+};
+
+SDL_InversePalette *SDL_CreateInversePalette(void)
+{
+    return (SDL_InversePalette *)SDL_calloc(1, sizeof(SDL_InversePalette));
+}
+
+void SDL_DestroyInversePalette(SDL_InversePalette *inverse)
+{
+    if (inverse) {
+        if (inverse->translucent) {
+            SDL_DestroyHashTable(inverse->translucent);
+        }
+        SDL_free(inverse->candidates);
+        SDL_free(inverse);
+    }
+}
+
+static void ResetInversePalette(SDL_InversePalette *inverse, const SDL_Palette *pal)
+{
+    SDL_zeroa(inverse->cell_count);
+    inverse->num_candidates = 0;
+    if (inverse->translucent) {
+        SDL_EmptyHashTable(inverse->translucent);
+    }
+    inverse->version = pal->version;
+    inverse->ncolors = pal->ncolors;
+}
+
+static int CellDistance(int value, int lo, int hi, int *max_distance)
+{
+    const int dlo = value - lo;
+    const int dhi = value - hi;
+
+    *max_distance = SDL_max(dlo * dlo, dhi * dhi);
+    if (value < lo) {
+        return dlo * dlo;
+    } else if (value > hi) {
+        return dhi * dhi;
+    }
+    return 0;
+}
+
+static bool BuildInversePaletteCell(SDL_InversePalette *inverse, const SDL_Palette *pal, int cell)
+{
+    const int size = (1 << INVERSE_PALETTE_SHIFT) - 1;
+    const int r0 = ((cell >> (2 * INVERSE_PALETTE_BITS)) & ((1 << INVERSE_PALETTE_BITS) - 1)) << INVERSE_PALETTE_SHIFT;
+    const int g0 = ((cell >> INVERSE_PALETTE_BITS) & ((1 << INVERSE_PALETTE_BITS) - 1)) << INVERSE_PALETTE_SHIFT;
+    const int b0 = (cell & ((1 << INVERSE_PALETTE_BITS) - 1)) << INVERSE_PALETTE_SHIFT;
+    int min_distance[256];
+    int bound = SDL_MAX_SINT32;
+    int count = 0;
+    int i;
+
+    if (inverse->num_candidates + pal->ncolors > inverse->max_candidates) {
+        const int max_candidates = SDL_max(inverse->max_candidates * 2, inverse->num_candidates + pal->ncolors);
+        Uint8 *candidates = (Uint8 *)SDL_realloc(inverse->candidates, max_candidates);
+        if (!candidates) {
+            return false;
+        }
+        inverse->candidates = candidates;
+        inverse->max_candidates = max_candidates;
+    }
+
+    for (i = 0; i < pal->ncolors; ++i) {
+        const SDL_Color *color = &pal->colors[i];
+        const int ad = color->a - SDL_ALPHA_OPAQUE;
+        int rmax, gmax, bmax, max_distance;
+
+        min_distance[i] = CellDistance(color->r, r0, r0 + size, &rmax) +
+                          CellDistance(color->g, g0, g0 + size, &gmax) +
+                          CellDistance(color->b, b0, b0 + size, &bmax) + ad * ad;
+        max_distance = rmax + gmax + bmax + ad * ad;
+        bound = SDL_min(bound, max_distance);
+    }
+    for (i = 0; i < pal->ncolors; ++i) {
+        if (min_distance[i] <= bound) {
+            inverse->candidates[inverse->num_candidates + count++] = (Uint8)i;
+        }
+    }
+    inverse->cell_start[cell] = (Uint32)inverse->num_candidates;
+    inverse->cell_count[cell] = (Uint16)count;
+    inverse->num_candidates += count;
+    return true;
+}
+
+static Uint8 LookupOpaqueColor(SDL_InversePalette *inverse, const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b)
+{
+    const int cell = ((r >> INVERSE_PALETTE_SHIFT) << (2 * INVERSE_PALETTE_BITS)) |
+                     ((g >> INVERSE_PALETTE_SHIFT) << INVERSE_PALETTE_BITS) |
+                     (b >> INVERSE_PALETTE_SHIFT);
+    const Uint8 *candidates;
+    unsigned int smallest = ~0U;
+    Uint8 pixel = 0;
+    int i, count;
+
+    if (!inverse->cell_count[cell] && !BuildInversePaletteCell(inverse, pal, cell)) {
+        return SDL_FindColor(pal, r, g, b, SDL_ALPHA_OPAQUE);
+    }
+
+    candidates = &inverse->candidates[inverse->cell_start[cell]];
+    count = inverse->cell_count[cell];
+    if (count == 1) {
+        return candidates[0];
+    }
+    for (i = 0; i < count; ++i) {
+        const SDL_Color *color = &pal->colors[candidates[i]];
+        const int rd = color->r - r;
+        const int gd = color->g - g;
+        const int bd = color->b - b;
+        const int ad = color->a - SDL_ALPHA_OPAQUE;
+        const unsigned int distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        if (distance < smallest) {
+            pixel = candidates[i];
+            if (distance == 0) {
+                break;
+            }
+            smallest = distance;
+        }
+    }
+    return pixel;
+}
+
+Uint8 SDL_LookupRGBAColor(SDL_InversePalette *inverse, Uint32 pixel, const SDL_Palette *pal)
 {
     Uint8 color_index = 0;
     const void *value;
-    if (SDL_FindInHashTable(palette_map, (const void *)(uintptr_t)pixel, &value)) {
+    Uint8 r = (Uint8)((pixel >> 24) & 0xFF);
+    Uint8 g = (Uint8)((pixel >> 16) & 0xFF);
+    Uint8 b = (Uint8)((pixel >>  8) & 0xFF);
+    Uint8 a = (Uint8)((pixel >>  0) & 0xFF);
+
+    if (!inverse || pal->ncolors <= 0) {
+        return SDL_FindColor(pal, r, g, b, a);
+    }
+
+    if (inverse->version != pal->version || inverse->ncolors != pal->ncolors) {
+        ResetInversePalette(inverse, pal);
+    }
+
+    if (a == SDL_ALPHA_OPAQUE) {
+        return LookupOpaqueColor(inverse, pal, r, g, b);
+    }
+
+    if (!inverse->translucent) {
+        inverse->translucent = SDL_CreateHashTable(NULL, 32, SDL_HashID, SDL_KeyMatchID, NULL, false);
+        if (!inverse->translucent) {
+            return SDL_FindColor(pal, r, g, b, a);
+        }
+    }
+    if (SDL_FindInHashTable(inverse->translucent, (const void *)(uintptr_t)pixel, &value)) {
         color_index = (Uint8)(uintptr_t)value;
     } else {
-        Uint8 r = (Uint8)((pixel >> 24) & 0xFF);
-        Uint8 g = (Uint8)((pixel >> 16) & 0xFF);
-        Uint8 b = (Uint8)((pixel >>  8) & 0xFF);
-        Uint8 a = (Uint8)((pixel >>  0) & 0xFF);
         color_index = SDL_FindColor(pal, r, g, b, a);
-        SDL_InsertIntoHashTable(palette_map, (const void *)(uintptr_t)pixel, (const void *)(uintptr_t)color_index);
+        SDL_InsertIntoHashTable(inverse->translucent, (const void *)(uintptr_t)pixel, (const void *)(uintptr_t)color_index);
     }
     return color_index;
 }
@@ -1400,7 +1677,8 @@ static Uint8 *Map1toN(const SDL_Palette *pal, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod
     }
 
     bpp = ((SDL_BYTESPERPIXEL(dst->format) == 3) ? 4 : SDL_BYTESPERPIXEL(dst->format));
-    map = (Uint8 *)SDL_calloc(256, bpp);
+    // Leave a spare entry so the vectorized blits can read 32 bits at any index
+    map = (Uint8 *)SDL_calloc(256 + 1, bpp);
     if (!map) {
         return NULL;
     }
@@ -1452,7 +1730,7 @@ void SDL_InvalidateMap(SDL_BlitMap *map)
         map->info.table = NULL;
     }
     if (map->info.palette_map) {
-        SDL_DestroyHashTable(map->info.palette_map);
+        SDL_DestroyInversePalette(map->info.palette_map);
         map->info.palette_map = NULL;
     }
 }
@@ -1508,7 +1786,7 @@ bool SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
     } else {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
             // BitField --> Palette
-            map->info.palette_map = SDL_CreateHashTable(NULL, 32, SDL_HashID, SDL_KeyMatchID, NULL, false);
+            map->info.palette_map = SDL_CreateInversePalette();
         } else {
             // BitField --> BitField
             if (srcfmt == dstfmt) {
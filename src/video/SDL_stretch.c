@@ -24,6 +24,7 @@
 
 static bool SDL_LowerSoftStretchNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
 static bool SDL_LowerSoftStretchLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+static bool SDL_LowerSoftStretchFiltered(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
 
 bool SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
 {
@@ -80,15 +81,12 @@ bool SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst
         return result;
     }
 
-    if (scaleMode != SDL_SCALEMODE_NEAREST && scaleMode != SDL_SCALEMODE_LINEAR) {
+    if (scaleMode != SDL_SCALEMODE_NEAREST && scaleMode != SDL_SCALEMODE_LINEAR &&
+        scaleMode != SDL_SCALEMODE_AREA && scaleMode != SDL_SCALEMODE_LANCZOS) {
         return SDL_InvalidParamError("scaleMode");
     }
 
     if (scaleMode != SDL_SCALEMODE_NEAREST) {
-        scaleMode = SDL_SCALEMODE_LINEAR;
-    }
-
-    if (scaleMode == SDL_SCALEMODE_LINEAR) {
         if (SDL_BYTESPERPIXEL(src->format) != 4 || src->format == SDL_PIXELFORMAT_ARGB2101010) {
             return SDL_SetError("Wrong format");
         }
@@ -153,8 +151,10 @@ bool SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst
 
     if (scaleMode == SDL_SCALEMODE_NEAREST) {
         result = SDL_LowerSoftStretchNearest(src, srcrect, dst, dstrect);
-    } else {
+    } else if (scaleMode == SDL_SCALEMODE_LINEAR) {
         result = SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect);
+    } else {
+        result = SDL_LowerSoftStretchFiltered(src, srcrect, dst, dstrect, scaleMode);
     }
 
     // We need to unlock the surfaces if they're locked
@@ -196,7 +196,9 @@ bool SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst
     left_pad_w_init = left_pad_w;                                                     \
     right_pad_w_init = right_pad_w;                                                   \
     dst_gap = dst_pitch - 4 * dst_w;                                                  \
-    middle_init = dst_w - left_pad_w - right_pad_w;
+    middle_init = dst_w - left_pad_w - right_pad_w;                                   \
+    fp_sum_h += (Sint64)y0 * fp_step_h;                                               \
+    dst = (Uint32 *)((Uint8 *)dst + (size_t)y0 * dst_pitch);
 
 #define BILINEAR___HEIGHT                                              \
     int index_h, frac_h0, frac_h1, middle;                             \
@@ -323,11 +325,11 @@ static SDL_INLINE void INTERPOL_BILINEAR(const Uint32 *s0, const Uint32 *s1, int
     INTERPOL(tmp, tmp + 1, frac_w0, frac_w1, dst);
 }
 
-static bool scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y0, int y1)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = y0; i < y1; i++) {
 
         BILINEAR___HEIGHT
 
@@ -443,11 +445,11 @@ static SDL_INLINE void SDL_TARGETING("sse2") INTERPOL_BILINEAR_SSE(const Uint32
     *dst = _mm_cvtsi128_si32(e0);
 }
 
-static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y0, int y1)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = y0; i < y1; i++) {
         int nb_block2;
         __m128i v_frac_h0;
         __m128i v_frac_h1;
@@ -561,6 +563,125 @@ static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, in
     }
     return true;
 }
+
+#ifdef SDL_AVX2_INTRINSICS
+
+static SDL_INLINE int hasAVX2(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasAVX2();
+    return val;
+}
+
+/* Load the left and right source pixels of two destination pixels, and widen them to 16 bits with the
+   channels of the left and right pixel next to each other: { l0 r0 l1 r1 l2 r2 l3 r3 } per 128-bit lane. */
+static SDL_INLINE __m256i SDL_TARGETING("avx2") LOAD_PAIRS_AVX2(const Uint32 *s0, const Uint32 *s1, __m128i interleave)
+{
+    __m128i x = _mm_loadl_epi64((const __m128i *)s0);
+    x = _mm_castpd_si128(_mm_loadh_pd(_mm_castsi128_pd(x), (const double *)s1));
+    return _mm256_cvtepu8_epi16(_mm_shuffle_epi8(x, interleave));
+}
+
+static bool SDL_TARGETING("avx2") scale_mat_AVX2(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y0, int y1)
+{
+    const __m128i interleave = _mm_setr_epi8(0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 11, 15);
+    const __m256i pixel_order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    const __m256i frac_mask = _mm256_set1_epi32((1 << PRECISION) - 1);
+    const __m256i frac_one = _mm256_set1_epi32(FRAC_ONE);
+    __m256i v_steps, pick_w[4];
+    int j;
+
+    BILINEAR___START
+
+    /* the fractional part only depends on the low bits of the position, so 32 bits are enough here */
+    v_steps = _mm256_mullo_epi32(_mm256_set1_epi32(fp_step_w), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    for (j = 0; j < 4; j++) {
+        pick_w[j] = _mm256_setr_epi32(2 * j, 2 * j, 2 * j, 2 * j, 2 * j + 1, 2 * j + 1, 2 * j + 1, 2 * j + 1);
+    }
+
+    for (i = y0; i < y1; i++) {
+        int nb_block8;
+        __m256i v_frac_h0, v_frac_h1;
+        __m128i v_frac_h0_sse, v_frac_h1_sse;
+        __m128i zero;
+
+        BILINEAR___HEIGHT
+
+        nb_block8 = middle / 8;
+        middle -= nb_block8 * 8;
+
+        v_frac_h0 = _mm256_set1_epi16((short)frac_h0);
+        v_frac_h1 = _mm256_set1_epi16((short)frac_h1);
+        v_frac_h0_sse = _mm256_castsi256_si128(v_frac_h0);
+        v_frac_h1_sse = _mm256_castsi256_si128(v_frac_h1);
+        zero = _mm_setzero_si128();
+
+        while (left_pad_w--) {
+            INTERPOL_BILINEAR_SSE(src_h0, src_h1, FRAC_ZERO, v_frac_h0_sse, v_frac_h1_sse, dst, zero);
+            dst += 1;
+        }
+
+        while (nb_block8--) {
+            int index_w[8];
+            __m256i v_frac_w, k[4], a, b;
+
+            /* weights { 1 - frac, frac } as 16-bit pairs, one per destination pixel */
+            v_frac_w = _mm256_add_epi32(_mm256_set1_epi32((int)fp_sum_w), v_steps);
+            v_frac_w = _mm256_and_si256(_mm256_srli_epi32(v_frac_w, 16 - PRECISION), frac_mask);
+            v_frac_w = _mm256_or_si256(_mm256_slli_epi32(v_frac_w, 16), _mm256_sub_epi32(frac_one, v_frac_w));
+
+            for (j = 0; j < 8; j++) {
+                index_w[j] = SRC_INDEX(fp_sum_w);
+                fp_sum_w += fp_step_w;
+            }
+
+            for (j = 0; j < 4; j++) {
+                const __m256i x0 = LOAD_PAIRS_AVX2(src_h0 + index_w[2 * j], src_h0 + index_w[2 * j + 1], interleave);
+                const __m256i x1 = LOAD_PAIRS_AVX2(src_h1 + index_w[2 * j], src_h1 + index_w[2 * j + 1], interleave);
+
+                // Interpolation vertical
+                k[j] = _mm256_add_epi16(_mm256_mullo_epi16(x0, v_frac_h1), _mm256_mullo_epi16(x1, v_frac_h0));
+
+                // Interpolation horizontal
+                k[j] = _mm256_madd_epi16(k[j], _mm256_permutevar8x32_epi32(v_frac_w, pick_w[j]));
+                k[j] = _mm256_srli_epi32(k[j], PRECISION * 2);
+            }
+
+            // Store 8 pixels
+            a = _mm256_packs_epi32(k[0], k[1]);
+            b = _mm256_packs_epi32(k[2], k[3]);
+            a = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(a, b), pixel_order);
+            _mm256_storeu_si256((__m256i *)dst, a);
+            dst += 8;
+        }
+
+        while (middle--) {
+            const Uint32 *s_00_01;
+            const Uint32 *s_10_11;
+            int index_w = 4 * SRC_INDEX(fp_sum_w);
+            int frac_w = FRAC(fp_sum_w);
+            fp_sum_w += fp_step_w;
+            s_00_01 = (const Uint32 *)((const Uint8 *)src_h0 + index_w);
+            s_10_11 = (const Uint32 *)((const Uint8 *)src_h1 + index_w);
+            INTERPOL_BILINEAR_SSE(s_00_01, s_10_11, frac_w, v_frac_h0_sse, v_frac_h1_sse, dst, zero);
+            dst += 1;
+        }
+
+        while (right_pad_w--) {
+            int index_w = 4 * (src_w - 2);
+            const Uint32 *s_00_01 = (const Uint32 *)((const Uint8 *)src_h0 + index_w);
+            const Uint32 *s_10_11 = (const Uint32 *)((const Uint8 *)src_h1 + index_w);
+            INTERPOL_BILINEAR_SSE(s_00_01, s_10_11, FRAC_ONE, v_frac_h0_sse, v_frac_h1_sse, dst, zero);
+            dst += 1;
+        }
+        dst = (Uint32 *)((Uint8 *)dst + dst_gap);
+    }
+    return true;
+}
+#endif // SDL_AVX2_INTRINSICS
 #endif
 
 #ifdef SDL_NEON_INTRINSICS
@@ -607,11 +728,11 @@ static SDL_INLINE void INTERPOL_BILINEAR_NEON(const Uint32 *s0, const Uint32 *s1
     *dst = vget_lane_u32(CAST_uint32x2_t e0, 0);
 }
 
-static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y0, int y1)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = y0; i < y1; i++) {
         int nb_block4;
         uint8x8_t v_frac_h0, v_frac_h1;
 
@@ -825,35 +946,90 @@ static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitc
 }
 #endif
 
+typedef bool (*SDL_StretchFunc)(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y0, int y1);
+
+/* Nearest scaling of 16 destination bytes at a time: the bytes are shuffled out of one or two
+   16 byte loads at src_offset in the source row, with lo selecting from the first load and
+   hi from the second one (0x80 leaves the byte to the other load). */
+typedef struct
+{
+    Uint8 lo[16];
+    Uint8 hi[16];
+    int src_offset;
+} SDL_StretchNearestBlock;
+
+struct SDL_StretchJob;
+typedef void (*SDL_StretchBlocksFunc)(const struct SDL_StretchJob *job, int y0, int y1);
+
+typedef struct SDL_StretchJob
+{
+    SDL_StretchFunc func;
+    const Uint32 *src;
+    int src_w, src_h, src_pitch;
+    Uint32 *dst;
+    int dst_w, dst_h, dst_pitch;
+
+    // Nearest scaling with shuffle tables, used instead of func if blocks_func is set
+    SDL_StretchBlocksFunc blocks_func;
+    const SDL_StretchNearestBlock *blocks;
+    int num_blocks;
+    int block_bytes;
+    int bpp;
+    bool two_loads;
+} SDL_StretchJob;
+
+static void StretchRows(void *userdata, int y, int h)
+{
+    const SDL_StretchJob *job = (const SDL_StretchJob *)userdata;
+    if (job->blocks_func) {
+        job->blocks_func(job, y, y + h);
+    } else {
+        job->func(job->src, job->src_w, job->src_h, job->src_pitch, job->dst, job->dst_w, job->dst_h, job->dst_pitch, y, y + h);
+    }
+}
+
+// Each row's source position depends only on its index, so bands come out the same as a single pass.
+static bool RunStretch(SDL_StretchJob *job)
+{
+    if (!SDL_RunBlitRowsParallel(job->dst_w, job->dst_h, StretchRows, job)) {
+        StretchRows(job, 0, job->dst_h);
+    }
+    return true;
+}
+
 bool SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
 {
-    bool result = false;
-    int src_w = srcrect->w;
-    int src_h = srcrect->h;
-    int dst_w = dstrect->w;
-    int dst_h = dstrect->h;
-    int src_pitch = s->pitch;
-    int dst_pitch = d->pitch;
-    Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * dst_pitch);
+    SDL_StretchJob job;
+
+    SDL_zero(job);
+    job.func = scale_mat;
+    job.src_w = srcrect->w;
+    job.src_h = srcrect->h;
+    job.src_pitch = s->pitch;
+    job.src = (const Uint32 *)((const Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * job.src_pitch);
+    job.dst_w = dstrect->w;
+    job.dst_h = dstrect->h;
+    job.dst_pitch = d->pitch;
+    job.dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * job.dst_pitch);
 
 #ifdef SDL_NEON_INTRINSICS
-    if (!result && hasNEON()) {
-        result = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    if (hasNEON()) {
+        job.func = scale_mat_NEON;
     }
 #endif
 
 #ifdef SDL_SSE2_INTRINSICS
-    if (!result && hasSSE2()) {
-        result = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    if (job.func == scale_mat && hasSSE2()) {
+        job.func = scale_mat_SSE;
     }
-#endif
-
-    if (!result) {
-        result = scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+#ifdef SDL_AVX2_INTRINSICS
+    if (job.func == scale_mat_SSE && hasAVX2()) {
+        job.func = scale_mat_AVX2;
     }
+#endif
+#endif
 
-    return result;
+    return RunStretch(&job);
 }
 
 #define SDL_SCALE_NEAREST__START          \
@@ -866,7 +1042,8 @@ bool SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Sur
     incy = ((Uint64)src_h << 16) / dst_h; \
     incx = ((Uint64)src_w << 16) / dst_w; \
     dst_gap = dst_pitch - bpp * dst_w;    \
-    posy = incy / 2;
+    posy = incy / 2 + y0 * incy;          \
+    dst = (Uint32 *)((Uint8 *)dst + (size_t)y0 * dst_pitch);
 
 #define SDL_SCALE_NEAREST__HEIGHT                                         \
     srcy = (posy >> 16);                                                  \
@@ -875,11 +1052,11 @@ bool SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Sur
     posx = incx / 2;                                                      \
     n = dst_w;
 
-static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y0, int y1)
 {
     Uint32 bpp = 1;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = y0; i < y1; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -894,11 +1071,11 @@ static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y0, int y1)
 {
     Uint32 bpp = 2;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = y0; i < y1; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint16 *src;
@@ -913,11 +1090,11 @@ static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y0, int y1)
 {
     Uint32 bpp = 3;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = y0; i < y1; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -934,11 +1111,11 @@ static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int y0, int y1)
 {
     Uint32 bpp = 4;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = y0; i < y1; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint32 *src;
@@ -953,26 +1130,650 @@ static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
+// Source byte offsets for the 16 destination bytes of a block starting at posx, the same positions the scalar loops use
+static SDL_INLINE void GetNearestBlockOffsets(int bpp, Uint64 posx, Uint64 incx, int *offsets)
+{
+    int i = 0, c;
+
+    while (i < 16) {
+        const int src_x = (int)(posx >> 16) * bpp;
+        for (c = 0; c < bpp && i < 16; c++) {
+            offsets[i++] = src_x + c;
+        }
+        posx += incx;
+    }
+}
+
+static SDL_INLINE void SetNearestBlockIndex(SDL_StretchNearestBlock *block, int i, int index)
+{
+    block->lo[i] = (index < 16) ? (Uint8)index : 0x80;
+    block->hi[i] = (index < 16) ? 0x80 : (Uint8)(index - 16);
+}
+
+/* Fill in the shuffle tables for a nearest stretch, returns false if some block needs source bytes
+   that are too far apart to come from two loads, or the source row is too short for the loads. */
+static bool SetupNearestBlocks(SDL_StretchJob *job, SDL_StretchNearestBlock *blocks)
+{
+    const Uint64 incx = ((Uint64)job->src_w << 16) / job->dst_w;
+    const int row_bytes = job->src_w * job->bpp;
+    const int block_pixels = job->block_bytes / job->bpp;
+    Uint64 posx = incx / 2;
+    int offsets[16];
+    int window;
+    int block, i;
+
+    job->two_loads = false;
+    for (block = 0; block < job->num_blocks; block++) {
+        SDL_StretchNearestBlock *b = &blocks[block];
+        int last = 0;
+
+        // blocks start on a pixel boundary, so the first byte comes from the leftmost source byte
+        GetNearestBlockOffsets(job->bpp, posx, incx, offsets);
+        posx += block_pixels * incx;
+        for (i = 0; i < 16; i++) {
+            last = SDL_max(last, offsets[i]);
+        }
+        if (last - offsets[0] >= 32) {
+            return false;
+        } else if (last - offsets[0] >= 16) {
+            job->two_loads = true;
+        }
+
+        b->src_offset = offsets[0];
+        for (i = 0; i < 16; i++) {
+            SetNearestBlockIndex(b, i, offsets[i] - b->src_offset);
+        }
+    }
+
+    window = job->two_loads ? 32 : 16;
+    if (row_bytes < window) {
+        return false;
+    }
+
+    // Move the loads of the last blocks back so they don't read past the end of the row
+    for (block = job->num_blocks - 1; block >= 0 && blocks[block].src_offset > row_bytes - window; block--) {
+        SDL_StretchNearestBlock *b = &blocks[block];
+        const int shift = b->src_offset - (row_bytes - window);
+
+        b->src_offset -= shift;
+        for (i = 0; i < 16; i++) {
+            const int index = (b->lo[i] < 16) ? b->lo[i] : (b->hi[i] + 16);
+            SetNearestBlockIndex(b, i, index + shift);
+        }
+    }
+    return true;
+}
+
+// The destination pixels after the last block
+static SDL_INLINE void StretchNearestTail(const SDL_StretchJob *job, const Uint8 *src_row, Uint8 *dst_row)
+{
+    const Uint64 incx = ((Uint64)job->src_w << 16) / job->dst_w;
+    const int bpp = job->bpp;
+    int x = (job->num_blocks * job->block_bytes) / bpp;
+    Uint64 posx = incx / 2 + (Uint64)x * incx;
+
+    for (; x < job->dst_w; x++) {
+        const Uint8 *src = src_row + (size_t)(posx >> 16) * bpp;
+        Uint8 *dst = dst_row + (size_t)x * bpp;
+        int c;
+        for (c = 0; c < bpp; c++) {
+            dst[c] = src[c];
+        }
+        posx += incx;
+    }
+}
+
+/* Rows that come from the same source row as the one above them are copied from it,
+   which for upscaling is most of them. */
+#define SDL_SCALE_NEAREST_BLOCKS__START                                             \
+    const Uint64 incy = ((Uint64)job->src_h << 16) / job->dst_h;                   \
+    const size_t row_bytes = (size_t)job->dst_w * job->bpp;                         \
+    const int num_blocks = job->num_blocks;                                         \
+    const int block_bytes = job->block_bytes;                                       \
+    const SDL_StretchNearestBlock *blocks = job->blocks;                            \
+    Uint64 posy = incy / 2 + y0 * incy;                                             \
+    Uint64 prev_srcy = ~(Uint64)0;                                                  \
+    Uint8 *prev_row = NULL;                                                         \
+    int i, k;                                                                       \
+    for (i = y0; i < y1; i++) {                                                     \
+        const Uint64 srcy = posy >> 16;                                             \
+        const Uint8 *src_row = (const Uint8 *)job->src + srcy * job->src_pitch;     \
+        Uint8 *dst_row = (Uint8 *)job->dst + (size_t)i * job->dst_pitch;            \
+        posy += incy;                                                               \
+        if (srcy == prev_srcy) {                                                    \
+            SDL_memcpy(dst_row, prev_row, row_bytes);                               \
+            continue;                                                               \
+        }                                                                           \
+        prev_srcy = srcy;                                                           \
+        prev_row = dst_row;
+
+#define SDL_SCALE_NEAREST_BLOCKS__END        \
+        StretchNearestTail(job, src_row, dst_row); \
+    }
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") scale_mat_nearest_blocks_SSE41(const SDL_StretchJob *job, int y0, int y1)
+{
+    SDL_SCALE_NEAREST_BLOCKS__START
+    if (job->two_loads) {
+        for (k = 0; k < num_blocks; k++) {
+            const Uint8 *src = src_row + blocks[k].src_offset;
+            __m128i v0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)src), _mm_loadu_si128((const __m128i *)blocks[k].lo));
+            __m128i v1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(src + 16)), _mm_loadu_si128((const __m128i *)blocks[k].hi));
+            _mm_storeu_si128((__m128i *)(dst_row + k * block_bytes), _mm_or_si128(v0, v1));
+        }
+    } else {
+        for (k = 0; k < num_blocks; k++) {
+            const Uint8 *src = src_row + blocks[k].src_offset;
+            __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)src), _mm_loadu_si128((const __m128i *)blocks[k].lo));
+            _mm_storeu_si128((__m128i *)(dst_row + k * block_bytes), v);
+        }
+    }
+    SDL_SCALE_NEAREST_BLOCKS__END
+}
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+static void scale_mat_nearest_blocks_NEON(const SDL_StretchJob *job, int y0, int y1)
+{
+    SDL_SCALE_NEAREST_BLOCKS__START
+    if (job->two_loads) {
+        for (k = 0; k < num_blocks; k++) {
+            const Uint8 *src = src_row + blocks[k].src_offset;
+            // vqtbl1q_u8 gives 0 for out of range indices, like 0x80 does with pshufb
+            uint8x16_t v0 = vqtbl1q_u8(vld1q_u8(src), vld1q_u8(blocks[k].lo));
+            uint8x16_t v1 = vqtbl1q_u8(vld1q_u8(src + 16), vld1q_u8(blocks[k].hi));
+            vst1q_u8(dst_row + k * block_bytes, vorrq_u8(v0, v1));
+        }
+    } else {
+        for (k = 0; k < num_blocks; k++) {
+            const Uint8 *src = src_row + blocks[k].src_offset;
+            vst1q_u8(dst_row + k * block_bytes, vqtbl1q_u8(vld1q_u8(src), vld1q_u8(blocks[k].lo)));
+        }
+    }
+    SDL_SCALE_NEAREST_BLOCKS__END
+}
+#endif
+
 bool SDL_LowerSoftStretchNearest(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
 {
-    int src_w = srcrect->w;
-    int src_h = srcrect->h;
-    int dst_w = dstrect->w;
-    int dst_h = dstrect->h;
-    int src_pitch = s->pitch;
-    int dst_pitch = d->pitch;
+    SDL_StretchJob job;
+    SDL_StretchNearestBlock *blocks = NULL;
+    bool isstack = false;
+    bool result;
     int bpp = SDL_BYTESPERPIXEL(d->format);
 
-    Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * bpp + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + dstrect->y * dst_pitch);
+    SDL_zero(job);
+    job.src_w = srcrect->w;
+    job.src_h = srcrect->h;
+    job.src_pitch = s->pitch;
+    job.src = (const Uint32 *)((const Uint8 *)s->pixels + srcrect->x * bpp + srcrect->y * job.src_pitch);
+    job.dst_w = dstrect->w;
+    job.dst_h = dstrect->h;
+    job.dst_pitch = d->pitch;
+    job.dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + dstrect->y * job.dst_pitch);
 
     if (bpp == 4) {
-        return scale_mat_nearest_4(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        job.func = scale_mat_nearest_4;
     } else if (bpp == 3) {
-        return scale_mat_nearest_3(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        job.func = scale_mat_nearest_3;
     } else if (bpp == 2) {
-        return scale_mat_nearest_2(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        job.func = scale_mat_nearest_2;
+    } else {
+        job.func = scale_mat_nearest_1;
+    }
+
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (SDL_HasSSE41()) {
+        job.blocks_func = scale_mat_nearest_blocks_SSE41;
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+    if (hasNEON()) {
+        job.blocks_func = scale_mat_nearest_blocks_NEON;
+    }
+#endif
+
+    /* Setting up the tables costs about as much as scaling a dozen rows with the scalar loops.
+       A block of 3 byte pixels stores 5 pixels and the first byte of the next one, which the
+       next block overwrites. */
+    if (job.blocks_func && job.dst_h >= 32 && job.dst_w * bpp >= 16) {
+        job.bpp = bpp;
+        job.block_bytes = (bpp == 3) ? 15 : 16;
+        job.num_blocks = (job.dst_w * bpp - 16) / job.block_bytes + 1;
+        blocks = SDL_small_alloc(SDL_StretchNearestBlock, job.num_blocks, &isstack);
+        if (blocks && SetupNearestBlocks(&job, blocks)) {
+            job.blocks = blocks;
+        } else {
+            job.blocks_func = NULL;
+        }
     } else {
-        return scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        job.blocks_func = NULL;
+    }
+
+    result = RunStretch(&job);
+
+    if (blocks) {
+        SDL_small_free(blocks, isstack);
     }
+    return result;
+}
+
+/* Area averaging and Lanczos-3 scaling are done in two passes with precomputed weights,
+   horizontally from the source into rows of 16-bit channels, then vertically from those
+   rows into the destination. The weights have FILTER_BITS bits of precision and the
+   intermediate channels keep FILTER_MID_BITS bits below the 8 bit value. Each band of
+   destination rows keeps only the last num_taps intermediate rows in a ring, so they
+   stay in the cache and every source row is only filtered once. */
+#define FILTER_BITS     14
+#define FILTER_ONE      (1 << FILTER_BITS)
+#define FILTER_MID_BITS 6
+#define FILTER_H_SHIFT  (FILTER_BITS - FILTER_MID_BITS)
+#define FILTER_V_SHIFT  (FILTER_BITS + FILTER_MID_BITS)
+
+// The weights of every destination pixel along one axis
+typedef struct
+{
+    int *start;      // first source pixel for each destination pixel
+    Sint16 *weights; // num_taps weights for each destination pixel, zero where a pixel uses fewer
+    int num_taps;
+} SDL_FilterWeights;
+
+struct SDL_FilterJob;
+typedef void (*SDL_FilterHorizontalFunc)(const struct SDL_FilterJob *job, const Uint8 *src, Sint16 *mid);
+typedef void (*SDL_FilterVerticalFunc)(const struct SDL_FilterJob *job, const Sint16 *const *mid, const Sint16 *w, Uint8 *dst);
+
+typedef struct SDL_FilterJob
+{
+    const Uint8 *src;
+    int src_pitch;
+    Uint8 *dst;
+    int dst_w, dst_pitch;
+    size_t mid_pitch; // in channels
+    int ring_rows;    // intermediate rows kept by each band
+    SDL_FilterWeights h, v;
+    SDL_FilterHorizontalFunc hfunc;
+    SDL_FilterVerticalFunc vfunc;
+    SDL_AtomicInt failed;
+} SDL_FilterJob;
+
+static double Lanczos3(double x)
+{
+    if (x == 0.0) {
+        return 1.0;
+    } else if (x <= -3.0 || x >= 3.0) {
+        return 0.0;
+    } else {
+        const double px = SDL_PI_D * x;
+        return 3.0 * SDL_sin(px) * SDL_sin(px / 3.0) / (px * px);
+    }
+}
+
+/* Compute the weights of destination pixel i, returning how many there are and the first source
+   pixel they apply to. Source pixels past the edges are replaced by the edge pixels. */
+static int GetFilterTaps(SDL_ScaleMode scaleMode, int src_n, int dst_n, int i, int max_taps, Sint16 *taps, int *first)
+{
+    const double scale = (double)src_n / dst_n;
+    const double filter_scale = SDL_max(scale, 1.0);
+    const double center = (i + 0.5) * scale;
+    const double support = (scaleMode == SDL_SCALEMODE_AREA) ? (filter_scale / 2.0) : (3.0 * filter_scale);
+    const int j0 = (int)SDL_floor(center - support);
+    const int j1 = (int)SDL_ceil(center + support);
+    const int lo = SDL_max(j0, 0);
+    const int hi = SDL_min(j1, src_n - 1);
+    double weights[64], *w = weights;
+    double sum = 0.0;
+    bool isstack = false;
+    int count = hi - lo + 1;
+    int total = 0, largest = 0;
+    int j, k;
+
+    if (count > SDL_arraysize(weights)) {
+        w = SDL_small_alloc(double, count, &isstack);
+        if (!w) {
+            return -1;
+        }
+    }
+    SDL_memset(w, 0, count * sizeof(*w));
+
+    for (j = j0; j <= j1; j++) {
+        double weight;
+        if (scaleMode == SDL_SCALEMODE_AREA) {
+            // how much of the source pixel is covered by the destination pixel
+            weight = SDL_max(SDL_min(center + support, j + 1.0) - SDL_max(center - support, (double)j), 0.0);
+        } else {
+            weight = Lanczos3((j + 0.5 - center) / filter_scale);
+        }
+        if (weight != 0.0) {
+            w[SDL_clamp(j, lo, hi) - lo] += weight;
+            sum += weight;
+        }
+    }
+
+    for (k = 0; k < count; k++) {
+        w[k] = SDL_floor(w[k] / sum * FILTER_ONE + 0.5);
+        total += (int)w[k];
+        if (w[k] > w[largest]) {
+            largest = k;
+        }
+    }
+
+    // Make the weights add up to exactly one, and drop the zero ones at either end
+    w[largest] += FILTER_ONE - total;
+    while (count > 1 && w[count - 1] == 0.0) {
+        --count;
+    }
+    k = 0;
+    while (k < count - 1 && w[k] == 0.0) {
+        ++k;
+    }
+    count -= k;
+    *first = lo + k;
+
+    if (taps) {
+        SDL_assert(count <= max_taps);
+        for (j = 0; j < count; j++) {
+            taps[j] = (Sint16)w[k + j];
+        }
+    }
+
+    if (w != weights) {
+        SDL_small_free(w, isstack);
+    }
+    return count;
+}
+
+static void FreeFilterWeights(SDL_FilterWeights *weights)
+{
+    SDL_free(weights->start);
+    SDL_free(weights->weights);
+}
+
+static bool SetupFilterWeights(SDL_FilterWeights *weights, SDL_ScaleMode scaleMode, int src_n, int dst_n)
+{
+    int i, first;
+
+    weights->num_taps = 0;
+    for (i = 0; i < dst_n; i++) {
+        const int count = GetFilterTaps(scaleMode, src_n, dst_n, i, 0, NULL, &first);
+        if (count < 0) {
+            return false;
+        }
+        weights->num_taps = SDL_max(weights->num_taps, count);
+    }
+
+    weights->start = (int *)SDL_malloc(dst_n * sizeof(*weights->start));
+    weights->weights = (Sint16 *)SDL_calloc((size_t)dst_n * weights->num_taps, sizeof(*weights->weights));
+    if (!weights->start || !weights->weights) {
+        return false;
+    }
+
+    /* Every destination pixel reads num_taps source pixels, moved back from the end of the
+       row where needed, so the loops don't depend on how many taps each pixel really has. */
+    for (i = 0; i < dst_n; i++) {
+        Sint16 *taps = &weights->weights[(size_t)i * weights->num_taps];
+        int start;
+
+        GetFilterTaps(scaleMode, src_n, dst_n, i, weights->num_taps, taps, &first);
+        start = SDL_min(first, src_n - weights->num_taps);
+        if (start < first) {
+            SDL_memmove(taps + (first - start), taps, (weights->num_taps - (first - start)) * sizeof(*taps));
+            SDL_memset(taps, 0, (first - start) * sizeof(*taps));
+        }
+        weights->start[i] = start;
+    }
+    return true;
+}
+
+static void filter_horizontal(const SDL_FilterJob *job, const Uint8 *src_row, Sint16 *mid)
+{
+    const int num_taps = job->h.num_taps;
+    int x, k, c;
+
+    for (x = 0; x < job->dst_w; x++) {
+        const Uint8 *src = src_row + job->h.start[x] * 4;
+        const Sint16 *w = &job->h.weights[(size_t)x * num_taps];
+        int sum[4] = { 0, 0, 0, 0 };
+
+        for (k = 0; k < num_taps; k++) {
+            for (c = 0; c < 4; c++) {
+                sum[c] += w[k] * src[k * 4 + c];
+            }
+        }
+        for (c = 0; c < 4; c++) {
+            const int value = (sum[c] + (1 << (FILTER_H_SHIFT - 1))) >> FILTER_H_SHIFT;
+            mid[x * 4 + c] = (Sint16)SDL_clamp(value, SDL_MIN_SINT16, SDL_MAX_SINT16);
+        }
+    }
+}
+
+static void filter_vertical(const SDL_FilterJob *job, const Sint16 *const *mid, const Sint16 *w, Uint8 *dst)
+{
+    const int num_taps = job->v.num_taps;
+    const int channels = job->dst_w * 4;
+    int x, k;
+
+    for (x = 0; x < channels; x++) {
+        int sum = 0, value;
+        for (k = 0; k < num_taps; k++) {
+            sum += w[k] * mid[k][x];
+        }
+        value = (sum + (1 << (FILTER_V_SHIFT - 1))) >> FILTER_V_SHIFT;
+        dst[x] = (Uint8)SDL_clamp(value, 0, 255);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+// Two weights for _mm_madd_epi16(), with the values of two taps interleaved
+#define FILTER_WEIGHT_PAIR_SSE(w0, w1) _mm_set1_epi32((int)(((Uint32)(Uint16)(w1) << 16) | (Uint16)(w0)))
+
+static void SDL_TARGETING("sse2") filter_horizontal_SSE(const SDL_FilterJob *job, const Uint8 *src_row, Sint16 *mid)
+{
+    const int num_taps = job->h.num_taps;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(1 << (FILTER_H_SHIFT - 1));
+    int x, k;
+
+    for (x = 0; x < job->dst_w; x++) {
+        const Uint8 *src = src_row + job->h.start[x] * 4;
+        const Sint16 *w = &job->h.weights[(size_t)x * num_taps];
+        __m128i sum = zero;
+
+        for (k = 0; k + 1 < num_taps; k += 2) {
+            // { a0 b0 a1 b1 a2 b2 a3 b3 } for pixels a and b
+            __m128i p = _mm_loadl_epi64((const __m128i *)(src + k * 4));
+            p = _mm_unpacklo_epi8(_mm_unpacklo_epi8(p, _mm_srli_si128(p, 4)), zero);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(p, FILTER_WEIGHT_PAIR_SSE(w[k], w[k + 1])));
+        }
+        if (k < num_taps) {
+            __m128i p = _mm_cvtsi32_si128(*(const int *)(src + k * 4));
+            p = _mm_unpacklo_epi8(_mm_unpacklo_epi8(p, zero), zero);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(p, FILTER_WEIGHT_PAIR_SSE(w[k], 0)));
+        }
+        sum = _mm_srai_epi32(_mm_add_epi32(sum, round), FILTER_H_SHIFT);
+        _mm_storel_epi64((__m128i *)(mid + x * 4), _mm_packs_epi32(sum, sum));
+    }
+}
+
+static void SDL_TARGETING("sse2") filter_vertical_SSE(const SDL_FilterJob *job, const Sint16 *const *mid, const Sint16 *w, Uint8 *dst)
+{
+    const int num_taps = job->v.num_taps;
+    const int channels = job->dst_w * 4;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(1 << (FILTER_V_SHIFT - 1));
+    int x, k;
+
+    // 2 pixels at a time
+    for (x = 0; x + 8 <= channels; x += 8) {
+        __m128i sum_lo = zero, sum_hi = zero;
+        for (k = 0; k + 1 < num_taps; k += 2) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(mid[k] + x));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(mid[k + 1] + x));
+            const __m128i weights = FILTER_WEIGHT_PAIR_SSE(w[k], w[k + 1]);
+            sum_lo = _mm_add_epi32(sum_lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), weights));
+            sum_hi = _mm_add_epi32(sum_hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), weights));
+        }
+        if (k < num_taps) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(mid[k] + x));
+            const __m128i weights = FILTER_WEIGHT_PAIR_SSE(w[k], 0);
+            sum_lo = _mm_add_epi32(sum_lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, zero), weights));
+            sum_hi = _mm_add_epi32(sum_hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, zero), weights));
+        }
+        sum_lo = _mm_srai_epi32(_mm_add_epi32(sum_lo, round), FILTER_V_SHIFT);
+        sum_hi = _mm_srai_epi32(_mm_add_epi32(sum_hi, round), FILTER_V_SHIFT);
+        sum_lo = _mm_packs_epi32(sum_lo, sum_hi);
+        _mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(sum_lo, sum_lo));
+    }
+
+    for (; x < channels; x++) {
+        int sum = 0, value;
+        for (k = 0; k < num_taps; k++) {
+            sum += w[k] * mid[k][x];
+        }
+        value = (sum + (1 << (FILTER_V_SHIFT - 1))) >> FILTER_V_SHIFT;
+        dst[x] = (Uint8)SDL_clamp(value, 0, 255);
+    }
+}
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+static void filter_horizontal_NEON(const SDL_FilterJob *job, const Uint8 *src_row, Sint16 *mid)
+{
+    const int num_taps = job->h.num_taps;
+    int x, k;
+
+    for (x = 0; x < job->dst_w; x++) {
+        const Uint8 *src = src_row + job->h.start[x] * 4;
+        const Sint16 *w = &job->h.weights[(size_t)x * num_taps];
+        int32x4_t sum = vdupq_n_s32(0);
+
+        for (k = 0; k < num_taps; k++) {
+            const uint8x8_t p = vreinterpret_u8_u32(vld1_dup_u32((const uint32_t *)(src + k * 4)));
+            sum = vmlal_n_s16(sum, vreinterpret_s16_u16(vget_low_u16(vmovl_u8(p))), w[k]);
+        }
+        // rounding shift, the same as adding half and shifting
+        vst1_s16(mid + x * 4, vqmovn_s32(vrshrq_n_s32(sum, FILTER_H_SHIFT)));
+    }
+}
+
+static void filter_vertical_NEON(const SDL_FilterJob *job, const Sint16 *const *mid, const Sint16 *w, Uint8 *dst)
+{
+    const int num_taps = job->v.num_taps;
+    const int channels = job->dst_w * 4;
+    int x, k;
+
+    // 2 pixels at a time
+    for (x = 0; x + 8 <= channels; x += 8) {
+        int32x4_t sum_lo = vdupq_n_s32(0), sum_hi = vdupq_n_s32(0);
+        int16x8_t values;
+        for (k = 0; k < num_taps; k++) {
+            const int16x8_t v = vld1q_s16(mid[k] + x);
+            sum_lo = vmlal_n_s16(sum_lo, vget_low_s16(v), w[k]);
+            sum_hi = vmlal_n_s16(sum_hi, vget_high_s16(v), w[k]);
+        }
+        values = vcombine_s16(vqmovn_s32(vrshrq_n_s32(sum_lo, FILTER_V_SHIFT)), vqmovn_s32(vrshrq_n_s32(sum_hi, FILTER_V_SHIFT)));
+        vst1_u8(dst + x, vqmovun_s16(values));
+    }
+
+    for (; x < channels; x++) {
+        int sum = 0, value;
+        for (k = 0; k < num_taps; k++) {
+            sum += w[k] * mid[k][x];
+        }
+        value = (sum + (1 << (FILTER_V_SHIFT - 1))) >> FILTER_V_SHIFT;
+        dst[x] = (Uint8)SDL_clamp(value, 0, 255);
+    }
+}
+#endif // SDL_NEON_INTRINSICS
+
+static void FilterRows(void *userdata, int y0, int h)
+{
+    SDL_FilterJob *job = (SDL_FilterJob *)userdata;
+    const int num_taps = job->v.num_taps;
+    const Sint16 **rows;
+    Sint16 *ring;
+    int next_row, y, k;
+
+    // Source row r is kept in slot r % ring_rows, so the rows of one destination row never collide
+    rows = (const Sint16 **)SDL_malloc(num_taps * sizeof(*rows) + job->ring_rows * job->mid_pitch * sizeof(*ring));
+    if (!rows) {
+        SDL_SetAtomicInt(&job->failed, 1);
+        return;
+    }
+    ring = (Sint16 *)(rows + num_taps);
+
+    next_row = job->v.start[y0];
+    for (y = y0; y < y0 + h; y++) {
+        const int start = job->v.start[y];
+        int r;
+
+        for (r = SDL_max(next_row, start); r < start + num_taps; r++) {
+            job->hfunc(job, job->src + (size_t)r * job->src_pitch, ring + (r % job->ring_rows) * job->mid_pitch);
+        }
+        next_row = SDL_max(next_row, start + num_taps);
+
+        for (k = 0; k < num_taps; k++) {
+            rows[k] = ring + ((start + k) % job->ring_rows) * job->mid_pitch;
+        }
+        job->vfunc(job, rows, &job->v.weights[(size_t)y * num_taps], job->dst + (size_t)y * job->dst_pitch);
+    }
+
+    SDL_free((void *)rows);
+}
+
+bool SDL_LowerSoftStretchFiltered(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
+{
+    SDL_FilterJob job;
+    int i, highest;
+    bool result = false;
+
+    SDL_zero(job);
+    job.src_pitch = s->pitch;
+    job.src = (const Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * job.src_pitch;
+    job.dst_w = dstrect->w;
+    job.dst_pitch = d->pitch;
+    job.dst = (Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * job.dst_pitch;
+    job.mid_pitch = (size_t)dstrect->w * 4;
+    job.hfunc = filter_horizontal;
+    job.vfunc = filter_vertical;
+
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        job.hfunc = filter_horizontal_NEON;
+        job.vfunc = filter_vertical_NEON;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (job.hfunc == filter_horizontal && hasSSE2()) {
+        job.hfunc = filter_horizontal_SSE;
+        job.vfunc = filter_vertical_SSE;
+    }
+#endif
+
+    if (!SetupFilterWeights(&job.h, scaleMode, srcrect->w, dstrect->w) ||
+        !SetupFilterWeights(&job.v, scaleMode, srcrect->h, dstrect->h)) {
+        goto done;
+    }
+
+    /* Trimming zero weights can move the start of a row back a little from the one before,
+       so the ring also has to keep the rows it steps back over. */
+    job.ring_rows = job.v.num_taps;
+    for (i = 0, highest = 0; i < dstrect->h; i++) {
+        highest = SDL_max(highest, job.v.start[i]);
+        job.ring_rows = SDL_max(job.ring_rows, job.v.num_taps + highest - job.v.start[i]);
+    }
+
+    if (!SDL_RunBlitRowsParallel(dstrect->w, dstrect->h, FilterRows, &job)) {
+        FilterRows(&job, 0, dstrect->h);
+    }
+    if (SDL_GetAtomicInt(&job.failed)) {
+        SDL_OutOfMemory();
+        goto done;
+    }
+    result = true;
+
+done:
+    FreeFilterWeights(&job.h);
+    FreeFilterWeights(&job.v);
+    return result;
 }
@@ -30,6 +30,13 @@
 
 #include "SDL_surface_c.h"
 
+#ifdef SDL_PLATFORM_LINUX
+#include <sys/mman.h>
+#ifdef MADV_HUGEPAGE
+#define SDL_SURFACE_POOL_HUGE_PAGES
+#endif
+#endif
+
 
 // Check to make sure we can safely check multiplication of surface w and pitch and it won't overflow size_t
 SDL_COMPILE_TIME_ASSERT(surface_size_assumptions,
@@ -227,6 +234,440 @@ SDL_Surface *SDL_CreateSurface(int width, int height, SDL_PixelFormat format)
     return surface;
 }
 
+#define SDL_SURFACE_POOL_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// Smaller buffers would waste too much of their last huge page
+#define SDL_SURFACE_POOL_HUGE_MIN_BYTES (2 * SDL_SURFACE_POOL_HUGE_PAGE_SIZE)
+
+struct SDL_SurfacePoolBuffer
+{
+    SDL_SurfacePool *pool;
+    int w;
+    int h;
+    SDL_PixelFormat format;
+    void *pixels;
+    size_t size; // rounded up to whole huge pages if huge
+    bool huge;
+    SDL_SurfacePoolBuffer *next;
+};
+
+typedef struct SDL_SurfacePoolBucket
+{
+    int w;
+    int h;
+    SDL_PixelFormat format;
+    SDL_SurfacePoolBuffer *free_buffers; // most recently released first
+    struct SDL_SurfacePoolBucket *next;
+} SDL_SurfacePoolBucket;
+
+struct SDL_SurfacePool
+{
+    SDL_Mutex *lock;
+    size_t max_free_bytes;
+    bool huge_pages;
+    bool destroyed;
+    int refcount; // the application's reference and one for each buffer in use
+    SDL_SurfacePoolBucket *buckets; // most recently used first, only the ones with free buffers
+    SDL_SurfacePoolStats stats;
+};
+
+#ifdef SDL_SURFACE_POOL_HUGE_PAGES
+static void *SDL_AllocHugePages(size_t size)
+{
+    const size_t align = SDL_SURFACE_POOL_HUGE_PAGE_SIZE;
+    Uint8 *map, *start, *end;
+
+    // Map an extra huge page and trim it so the buffer starts on a huge page boundary
+    map = (Uint8 *)mmap(NULL, size + align, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == (Uint8 *)MAP_FAILED) {
+        return NULL;
+    }
+    start = (Uint8 *)(((uintptr_t)map + align - 1) & ~(uintptr_t)(align - 1));
+    end = map + size + align;
+    if (start > map) {
+        munmap(map, start - map);
+    }
+    if (start + size < end) {
+        munmap(start + size, end - (start + size));
+    }
+
+    // This is only a hint, regular pages work too
+    madvise(start, size, MADV_HUGEPAGE);
+    return start;
+}
+#endif // SDL_SURFACE_POOL_HUGE_PAGES
+
+static void SDL_FreePoolBuffer(SDL_SurfacePoolBuffer *buffer)
+{
+#ifdef SDL_SURFACE_POOL_HUGE_PAGES
+    if (buffer->huge) {
+        munmap(buffer->pixels, buffer->size);
+    } else
+#endif
+    {
+        SDL_aligned_free(buffer->pixels);
+    }
+    SDL_free(buffer);
+}
+
+static SDL_SurfacePoolBuffer *SDL_AllocPoolBuffer(SDL_SurfacePool *pool, int w, int h, SDL_PixelFormat format, size_t size)
+{
+    SDL_SurfacePoolBuffer *buffer = (SDL_SurfacePoolBuffer *)SDL_calloc(1, sizeof(*buffer));
+    if (!buffer) {
+        return NULL;
+    }
+
+    buffer->pool = pool;
+    buffer->w = w;
+    buffer->h = h;
+    buffer->format = format;
+    buffer->size = size;
+
+#ifdef SDL_SURFACE_POOL_HUGE_PAGES
+    if (pool->huge_pages && size >= SDL_SURFACE_POOL_HUGE_MIN_BYTES) {
+        const size_t huge_size = (size + SDL_SURFACE_POOL_HUGE_PAGE_SIZE - 1) & ~(size_t)(SDL_SURFACE_POOL_HUGE_PAGE_SIZE - 1);
+
+        // Anonymous mappings are already cleared
+        buffer->pixels = SDL_AllocHugePages(huge_size);
+        if (buffer->pixels) {
+            buffer->size = huge_size;
+            buffer->huge = true;
+            return buffer;
+        }
+    }
+#endif
+
+    buffer->pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
+    if (!buffer->pixels) {
+        SDL_free(buffer);
+        return NULL;
+    }
+    // This is important for bitmaps
+    SDL_memset(buffer->pixels, 0, size);
+    return buffer;
+}
+
+// Called with the pool locked, a bucket that is found is moved to the front of the list
+static SDL_SurfacePoolBucket *SDL_GetSurfacePoolBucket(SDL_SurfacePool *pool, int w, int h, SDL_PixelFormat format, bool create)
+{
+    SDL_SurfacePoolBucket *bucket, *prev = NULL;
+
+    for (bucket = pool->buckets; bucket; prev = bucket, bucket = bucket->next) {
+        if (bucket->w == w && bucket->h == h && bucket->format == format) {
+            if (prev) {
+                prev->next = bucket->next;
+                bucket->next = pool->buckets;
+                pool->buckets = bucket;
+            }
+            return bucket;
+        }
+    }
+
+    if (!create) {
+        return NULL;
+    }
+
+    bucket = (SDL_SurfacePoolBucket *)SDL_calloc(1, sizeof(*bucket));
+    if (bucket) {
+        bucket->w = w;
+        bucket->h = h;
+        bucket->format = format;
+        bucket->next = pool->buckets;
+        pool->buckets = bucket;
+    }
+    return bucket;
+}
+
+// Called with the pool locked
+static void SDL_FreeSurfacePoolBuffers(SDL_SurfacePool *pool)
+{
+    SDL_SurfacePoolBucket *bucket, *next_bucket;
+
+    for (bucket = pool->buckets; bucket; bucket = next_bucket) {
+        SDL_SurfacePoolBuffer *buffer, *next;
+
+        for (buffer = bucket->free_buffers; buffer; buffer = next) {
+            next = buffer->next;
+            pool->stats.resident_bytes -= buffer->size;
+            pool->stats.free_bytes -= buffer->size;
+            SDL_FreePoolBuffer(buffer);
+        }
+        next_bucket = bucket->next;
+        SDL_free(bucket);
+    }
+    pool->buckets = NULL;
+}
+
+static void SDL_ReleaseSurfacePool(SDL_SurfacePool *pool)
+{
+    bool last;
+
+    SDL_LockMutex(pool->lock);
+    last = (--pool->refcount == 0);
+    SDL_UnlockMutex(pool->lock);
+
+    if (last) {
+        SDL_DestroyMutex(pool->lock);
+        SDL_free(pool);
+    }
+}
+
+SDL_SurfacePool *SDL_CreateSurfacePool(size_t max_free_bytes, bool huge_pages)
+{
+    SDL_SurfacePool *pool = (SDL_SurfacePool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->lock = SDL_CreateMutex();
+    if (!pool->lock) {
+        SDL_free(pool);
+        return NULL;
+    }
+    pool->max_free_bytes = max_free_bytes;
+    pool->huge_pages = huge_pages;
+    pool->refcount = 1;
+    return pool;
+}
+
+SDL_Surface *SDL_CreatePooledSurface(SDL_SurfacePool *pool, int width, int height, SDL_PixelFormat format)
+{
+    size_t pitch, size;
+    SDL_InternalSurface *mem;
+    SDL_Surface *surface;
+    SDL_SurfacePoolBucket *bucket;
+    SDL_SurfacePoolBuffer *buffer = NULL;
+
+    if (!pool) {
+        SDL_InvalidParamError("pool");
+        return NULL;
+    }
+
+    if (width <= 0 || height <= 0) {
+        // There are no pixels to pool
+        return SDL_CreateSurface(width, height, format);
+    }
+
+    if (!SDL_CalculateSurfaceSize(format, width, height, &size, &pitch, false /* not minimal pitch */)) {
+        // Overflow...
+        return NULL;
+    }
+
+    // Allocate and initialize the surface
+    mem = (SDL_InternalSurface *)SDL_malloc(sizeof(*mem));
+    if (!mem) {
+        return NULL;
+    }
+
+    surface = SDL_InitializeSurface(mem, width, height, format, SDL_COLORSPACE_UNKNOWN, 0, NULL, (int)pitch, false);
+    if (!surface) {
+        return NULL;
+    }
+
+    SDL_LockMutex(pool->lock);
+    bucket = SDL_GetSurfacePoolBucket(pool, width, height, format, false);
+    if (bucket) {
+        buffer = bucket->free_buffers;
+        bucket->free_buffers = buffer->next;
+        buffer->next = NULL;
+        if (!bucket->free_buffers) {
+            // Empty buckets are dropped so sizes that aren't used anymore don't pile up
+            pool->buckets = bucket->next;
+            SDL_free(bucket);
+        }
+        pool->stats.free_bytes -= buffer->size;
+        ++pool->stats.hits;
+    } else {
+        buffer = SDL_AllocPoolBuffer(pool, width, height, format, size);
+        if (buffer) {
+            pool->stats.resident_bytes += buffer->size;
+            ++pool->stats.misses;
+        }
+    }
+    if (buffer) {
+        ++pool->refcount;
+    }
+    SDL_UnlockMutex(pool->lock);
+
+    if (!buffer) {
+        SDL_DestroySurface(surface);
+        return NULL;
+    }
+
+    surface->flags &= ~SDL_SURFACE_PREALLOCATED;
+    surface->pixels = buffer->pixels;
+    surface->internal->pool_buffer = buffer;
+    return surface;
+}
+
+// Gives a pixel buffer back to its pool
+static void SDL_ReleasePooledPixels(SDL_SurfacePoolBuffer *buffer)
+{
+    SDL_SurfacePool *pool = buffer->pool;
+    SDL_SurfacePoolBucket *bucket = NULL;
+
+    SDL_LockMutex(pool->lock);
+    if (!pool->destroyed && pool->stats.free_bytes + buffer->size <= pool->max_free_bytes) {
+        bucket = SDL_GetSurfacePoolBucket(pool, buffer->w, buffer->h, buffer->format, true);
+    }
+    if (bucket) {
+        buffer->next = bucket->free_buffers;
+        bucket->free_buffers = buffer;
+        pool->stats.free_bytes += buffer->size;
+    } else {
+        pool->stats.resident_bytes -= buffer->size;
+        SDL_FreePoolBuffer(buffer);
+    }
+    SDL_UnlockMutex(pool->lock);
+
+    SDL_ReleaseSurfacePool(pool);
+}
+
+bool SDL_GetSurfacePoolStats(SDL_SurfacePool *pool, SDL_SurfacePoolStats *stats)
+{
+    if (!pool) {
+        return SDL_InvalidParamError("pool");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockMutex(pool->lock);
+    SDL_copyp(stats, &pool->stats);
+    SDL_UnlockMutex(pool->lock);
+    return true;
+}
+
+void SDL_DestroySurfacePool(SDL_SurfacePool *pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    // Surfaces that are still using the pool keep it alive until they're destroyed
+    SDL_LockMutex(pool->lock);
+    pool->destroyed = true;
+    SDL_FreeSurfacePoolBuffers(pool);
+    SDL_UnlockMutex(pool->lock);
+
+    SDL_ReleaseSurfacePool(pool);
+}
+
+struct SDL_SharedPixels
+{
+    SDL_AtomicInt refcount;
+    void *pixels;
+    bool aligned;
+    SDL_SurfacePoolBuffer *pool_buffer;
+};
+
+static void SDL_ReleaseSharedPixels(SDL_SharedPixels *shared)
+{
+    if (!SDL_AtomicDecRef(&shared->refcount)) {
+        return;
+    }
+
+    if (shared->pool_buffer) {
+        SDL_ReleasePooledPixels(shared->pool_buffer);
+    } else if (shared->aligned) {
+        SDL_aligned_free(shared->pixels);
+    } else {
+        SDL_free(shared->pixels);
+    }
+    SDL_free(shared);
+}
+
+// Returns true if the pixels of this surface can be shared with a duplicate
+static bool SDL_CanShareSurfacePixels(SDL_Surface *surface)
+{
+    if (!SDL_GetHintBoolean(SDL_HINT_SURFACE_COPY_ON_WRITE, false)) {
+        return false;
+    }
+    if (!surface->pixels || surface->w <= 0 || surface->h <= 0 ||
+        SDL_ISPIXELFORMAT_FOURCC(surface->format) ||
+        (surface->flags & SDL_SURFACE_PREALLOCATED) ||
+        (surface->internal->flags & SDL_INTERNAL_SURFACE_RLEACCEL) ||
+        surface->internal->locked > 0) {
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Create a surface of the same format that refers to the pixels of an
+ * existing one. The pixels are copied when either surface is written to.
+ */
+static SDL_Surface *SDL_CreateSharedSurface(SDL_Surface *surface)
+{
+    SDL_SharedPixels *shared = surface->internal->shared;
+    SDL_InternalSurface *mem;
+    SDL_Surface *copy;
+
+    mem = (SDL_InternalSurface *)SDL_malloc(sizeof(*mem));
+    if (!mem) {
+        return NULL;
+    }
+
+    if (!shared) {
+        // The shared store takes over the pixels of the original surface
+        shared = (SDL_SharedPixels *)SDL_malloc(sizeof(*shared));
+        if (!shared) {
+            SDL_free(mem);
+            return NULL;
+        }
+        SDL_SetAtomicInt(&shared->refcount, 1);
+        shared->pixels = surface->pixels;
+        shared->aligned = ((surface->flags & SDL_SURFACE_SIMD_ALIGNED) != 0);
+        shared->pool_buffer = surface->internal->pool_buffer;
+        surface->internal->pool_buffer = NULL;
+        surface->internal->shared = shared;
+    }
+
+    copy = SDL_InitializeSurface(mem, surface->w, surface->h, surface->format, surface->internal->colorspace, 0, surface->pixels, surface->pitch, false);
+    if (!copy) {
+        return NULL;
+    }
+    copy->flags &= ~SDL_SURFACE_PREALLOCATED;
+    copy->flags |= (surface->flags & SDL_SURFACE_SIMD_ALIGNED);
+    copy->internal->shared = shared;
+    SDL_AtomicIncRef(&shared->refcount);
+    return copy;
+}
+
+bool SDL_UnshareSurfacePixels(SDL_Surface *surface)
+{
+    SDL_SharedPixels *shared = surface->internal->shared;
+    void *pixels;
+    size_t size;
+
+    if (!shared) {
+        return true;
+    }
+
+    if (SDL_GetAtomicInt(&shared->refcount) == 1) {
+        // This is the last surface using them, take them back
+        surface->internal->pool_buffer = shared->pool_buffer;
+        surface->internal->shared = NULL;
+        SDL_free(shared);
+        return true;
+    }
+
+    if (!SDL_size_mul_check_overflow(surface->h, surface->pitch, &size)) {
+        return SDL_SetError("Surface size overflow");
+    }
+    pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
+    if (!pixels) {
+        return false;
+    }
+    SDL_memcpy(pixels, surface->pixels, size);
+
+    surface->internal->shared = NULL;
+    surface->pixels = pixels;
+    surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
+    SDL_ReleaseSharedPixels(shared);
+    return true;
+}
+
 /*
  * Create an RGB surface from an existing memory buffer using the given
  * enum SDL_PIXELFORMAT_* format
@@ -613,6 +1054,48 @@ bool SDL_SurfaceHasRLE(SDL_Surface *surface)
     return true;
 }
 
+bool SDL_EncodeSurfaceRLE(SDL_Surface *surface, SDL_PixelFormat format)
+{
+#if SDL_HAVE_RLE
+    SDL_Surface *dst;
+    bool result;
+
+    if (!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
+
+    if (format == SDL_PIXELFORMAT_UNKNOWN || SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format)) {
+        return SDL_InvalidParamError("format");
+    }
+
+    if (!(surface->internal->map.info.flags & SDL_COPY_RLE_DESIRED)) {
+        return SDL_SetError("RLE acceleration isn't enabled on this surface");
+    }
+
+    if ((surface->internal->flags & SDL_INTERNAL_SURFACE_RLEACCEL) &&
+        surface->internal->map.info.dst_fmt == SDL_GetPixelFormatDetails(format)) {
+        // Already encoded for this format
+        return true;
+    }
+
+    // The encoding only depends on the destination format, so any surface of that format will do
+    dst = SDL_CreateSurface(1, 1, format);
+    if (!dst) {
+        return false;
+    }
+    result = SDL_MapSurface(surface, dst);
+    surface->internal->map.info.dst_surface = NULL;
+    SDL_DestroySurface(dst);
+
+    if (result && !(surface->internal->flags & SDL_INTERNAL_SURFACE_RLEACCEL)) {
+        result = SDL_SetError("Surface can't be RLE encoded for this format");
+    }
+    return result;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
 bool SDL_SetSurfaceColorKey(SDL_Surface *surface, bool enabled, Uint32 key)
 {
     int flags;
@@ -995,22 +1478,18 @@ bool SDL_BlitSurfaceUnchecked(SDL_Surface *src, const SDL_Rect *srcrect,
     if (!SDL_ValidateMap(src, dst)) {
         return false;
     }
+    if (!SDL_UnshareSurfacePixels(dst)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(dst, dstrect);
     return src->internal->map.blit(src, srcrect, dst, dstrect);
 }
 
-bool SDL_BlitSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect)
+// Clips an unscaled blit to the source surface and the destination clip rectangle, returns false if nothing is left
+static bool SDL_ClipBlitRects(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_Rect *final_src, SDL_Rect *final_dst)
 {
     SDL_Rect r_src, r_dst;
 
-    // Make sure the surfaces aren't locked
-    if (!SDL_SurfaceValid(src)) {
-        return SDL_InvalidParamError("src");
-    } else if (!SDL_SurfaceValid(dst)) {
-        return SDL_InvalidParamError("dst");
-    } else if ((src->flags & SDL_SURFACE_LOCKED) || (dst->flags & SDL_SURFACE_LOCKED)) {
-        return SDL_SetError("Surfaces must not be locked during blit");
-    }
-
     // Full src surface
     r_src.x = 0;
     r_src.y = 0;
@@ -1029,7 +1508,7 @@ bool SDL_BlitSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst
     if (srcrect) {
         SDL_Rect tmp;
         if (SDL_GetRectIntersection(srcrect, &r_src, &tmp) == false) {
-            return true;
+            return false;
         }
 
         // Shift dstrect, if srcrect origin has changed
@@ -1048,7 +1527,7 @@ bool SDL_BlitSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst
     {
         SDL_Rect tmp;
         if (SDL_GetRectIntersection(&r_dst, &dst->internal->clip_rect, &tmp) == false) {
-            return true;
+            return false;
         }
 
         // Shift srcrect, if dstrect has changed
@@ -1063,6 +1542,28 @@ bool SDL_BlitSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst
 
     if (r_dst.w <= 0 || r_dst.h <= 0) {
         // No-op.
+        return false;
+    }
+
+    *final_src = r_src;
+    *final_dst = r_dst;
+    return true;
+}
+
+bool SDL_BlitSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect)
+{
+    SDL_Rect r_src, r_dst;
+
+    // Make sure the surfaces aren't locked
+    if (!SDL_SurfaceValid(src)) {
+        return SDL_InvalidParamError("src");
+    } else if (!SDL_SurfaceValid(dst)) {
+        return SDL_InvalidParamError("dst");
+    } else if ((src->flags & SDL_SURFACE_LOCKED) || (dst->flags & SDL_SURFACE_LOCKED)) {
+        return SDL_SetError("Surfaces must not be locked during blit");
+    }
+
+    if (!SDL_ClipBlitRects(src, srcrect, dst, dstrect, &r_src, &r_dst)) {
         return true;
     }
 
@@ -1093,7 +1594,9 @@ bool SDL_BlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surfac
     } else if ((src->flags & SDL_SURFACE_LOCKED) || (dst->flags & SDL_SURFACE_LOCKED)) {
         return SDL_SetError("Surfaces must not be locked during blit");
     } else if (scaleMode != SDL_SCALEMODE_NEAREST &&
-               scaleMode != SDL_SCALEMODE_LINEAR) {
+               scaleMode != SDL_SCALEMODE_LINEAR &&
+               scaleMode != SDL_SCALEMODE_AREA &&
+               scaleMode != SDL_SCALEMODE_LANCZOS) {
         return SDL_InvalidParamError("scaleMode");
     }
 
@@ -1247,6 +1750,11 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
         return SDL_SetError("Size too large for scaling");
     }
 
+    if (!SDL_UnshareSurfacePixels(dst)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(dst, dstrect);
+
     if (!(src->internal->map.info.flags & SDL_COPY_NEAREST)) {
         src->internal->map.info.flags |= SDL_COPY_NEAREST;
         SDL_InvalidateMap(&src->internal->map);
@@ -1276,7 +1784,7 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             SDL_BYTESPERPIXEL(src->format) == 4 &&
             src->format != SDL_PIXELFORMAT_ARGB2101010) {
             // fast path
-            return SDL_SoftStretch(src, srcrect, dst, dstrect, SDL_SCALEMODE_LINEAR);
+            return SDL_SoftStretch(src, srcrect, dst, dstrect, scaleMode);
         } else if (SDL_BITSPERPIXEL(src->format) < 8) {
             // Scaling bitmap not yet supported, convert to RGBA for blit
             bool result = false;
@@ -1335,7 +1843,7 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             if (is_complex_copy_flags || src->format != dst->format) {
                 SDL_Rect tmprect;
                 SDL_Surface *tmp2 = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
-                SDL_SoftStretch(src, &srcrect2, tmp2, NULL, SDL_SCALEMODE_LINEAR);
+                SDL_SoftStretch(src, &srcrect2, tmp2, NULL, scaleMode);
 
                 SDL_SetSurfaceColorMod(tmp2, r, g, b);
                 SDL_SetSurfaceAlphaMod(tmp2, alpha);
@@ -1348,7 +1856,7 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
                 result = SDL_BlitSurfaceUnchecked(tmp2, &tmprect, dst, dstrect);
                 SDL_DestroySurface(tmp2);
             } else {
-                result = SDL_SoftStretch(src, &srcrect2, dst, dstrect, SDL_SCALEMODE_LINEAR);
+                result = SDL_SoftStretch(src, &srcrect2, dst, dstrect, scaleMode);
             }
 
             SDL_DestroySurface(tmp1);
@@ -1713,14 +2221,159 @@ bool SDL_BlitSurface9Grid(SDL_Surface *src, const SDL_Rect *srcrect, int left_wi
     return true;
 }
 
-/*
- * Lock a surface to directly access the pixels
- */
-bool SDL_LockSurface(SDL_Surface *surface)
+struct SDL_BlitPlan
 {
-    if (!SDL_SurfaceValid(surface)) {
-        return SDL_InvalidParamError("surface");
-    }
+    // A surface without pixels that holds the source format and blit state, and the blit map chosen for them
+    SDL_Surface *surface;
+    SDL_PixelFormat dst_format;
+};
+
+SDL_BlitPlan *SDL_CreateBlitPlan(SDL_Surface *src, SDL_Surface *dst)
+{
+    SDL_BlitPlan *plan;
+    SDL_Surface *surface;
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+    Uint32 key;
+
+    if (!SDL_SurfaceValid(src)) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+    if (!SDL_SurfaceValid(dst)) {
+        SDL_InvalidParamError("dst");
+        return NULL;
+    }
+
+    plan = (SDL_BlitPlan *)SDL_calloc(1, sizeof(*plan));
+    if (!plan) {
+        return NULL;
+    }
+    plan->dst_format = dst->format;
+
+    surface = SDL_CreateSurfaceFrom(0, 0, src->format, NULL, 0);
+    if (!surface) {
+        goto error;
+    }
+    plan->surface = surface;
+
+    if (src->internal->palette && !SDL_SetSurfacePalette(surface, src->internal->palette)) {
+        goto error;
+    }
+    // The float blitter takes the colorspace and its HDR settings from the surface that owns the map, so those are captured, too
+    if (src->internal->props) {
+        const SDL_PropertiesID src_props = src->internal->props;
+        const SDL_PropertiesID props = SDL_GetSurfaceProperties(surface);
+        if (SDL_HasProperty(src_props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT)) {
+            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, SDL_GetFloatProperty(src_props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, 0.0f));
+        }
+        if (SDL_HasProperty(src_props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT)) {
+            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, SDL_GetFloatProperty(src_props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, 0.0f));
+        }
+        if (SDL_HasProperty(src_props, SDL_PROP_SURFACE_TONEMAP_OPERATOR_STRING)) {
+            SDL_SetStringProperty(props, SDL_PROP_SURFACE_TONEMAP_OPERATOR_STRING, SDL_GetStringProperty(src_props, SDL_PROP_SURFACE_TONEMAP_OPERATOR_STRING, NULL));
+        }
+    }
+    if (!SDL_SetSurfaceColorspace(surface, src->internal->colorspace) ||
+        !SDL_GetSurfaceBlendMode(src, &blendMode) || !SDL_SetSurfaceBlendMode(surface, blendMode) ||
+        !SDL_GetSurfaceColorMod(src, &r, &g, &b) || !SDL_SetSurfaceColorMod(surface, r, g, b) ||
+        !SDL_GetSurfaceAlphaMod(src, &a) || !SDL_SetSurfaceAlphaMod(surface, a)) {
+        goto error;
+    }
+    if (SDL_SurfaceHasColorKey(src)) {
+        if (!SDL_GetSurfaceColorKey(src, &key) || !SDL_SetSurfaceColorKey(surface, true, key)) {
+            goto error;
+        }
+    }
+
+    // Choose the blit function up front, so batches only have to check that it's still valid
+    if (!SDL_ValidateMap(surface, dst)) {
+        goto error;
+    }
+    return plan;
+
+error:
+    SDL_DestroyBlitPlan(plan);
+    return NULL;
+}
+
+bool SDL_BlitSurfaceBatch(SDL_BlitPlan *plan, const SDL_BlitBatchItem *items, int num_items, SDL_Surface *dst)
+{
+    SDL_Surface *surface;
+    bool result = true;
+    int i;
+
+    if (!plan) {
+        return SDL_InvalidParamError("plan");
+    } else if (num_items < 0 || (!items && num_items > 0)) {
+        return SDL_InvalidParamError("items");
+    } else if (!SDL_SurfaceValid(dst)) {
+        return SDL_InvalidParamError("dst");
+    } else if (dst->format != plan->dst_format) {
+        return SDL_SetError("Destination surface doesn't have the format of the blit plan");
+    } else if (dst->flags & SDL_SURFACE_LOCKED) {
+        return SDL_SetError("Surfaces must not be locked during blit");
+    }
+
+    // This only recalculates the map if a palette has changed since the last batch
+    surface = plan->surface;
+    if (!SDL_ValidateMap(surface, dst)) {
+        return false;
+    }
+    if (!SDL_UnshareSurfacePixels(dst)) {
+        return false;
+    }
+
+    // The blits take their pixels from the items, and everything else from the plan's surface
+    for (i = 0; i < num_items; ++i) {
+        SDL_Surface *src = items[i].src;
+        SDL_Rect r_src, r_dst;
+
+        if (!SDL_SurfaceValid(src)) {
+            result = SDL_SetError("Parameter 'items[%d].src' is invalid", i);
+            break;
+        } else if (src->format != surface->format || src->internal->palette != surface->internal->palette) {
+            result = SDL_SetError("Source surface doesn't have the format of the blit plan");
+            break;
+        } else if (src->flags & SDL_SURFACE_LOCKED) {
+            result = SDL_SetError("Surfaces must not be locked during blit");
+            break;
+        }
+
+        if (!SDL_ClipBlitRects(src, &items[i].srcrect, dst, &items[i].dstrect, &r_src, &r_dst)) {
+            continue;
+        }
+        SDL_AddSurfaceDamage(dst, &r_dst);
+        if (!SDL_SoftBlitWithMap(&surface->internal->map, src, &r_src, dst, &r_dst)) {
+            result = false;
+            break;
+        }
+    }
+
+    // Don't keep pointers to the caller's surfaces around in the plan
+    surface->internal->map.info.dst_surface = NULL;
+    surface->internal->map.info.src = NULL;
+    surface->internal->map.info.dst = NULL;
+    return result;
+}
+
+void SDL_DestroyBlitPlan(SDL_BlitPlan *plan)
+{
+    if (!plan) {
+        return;
+    }
+    SDL_DestroySurface(plan->surface);
+    SDL_free(plan);
+}
+
+/*
+ * Lock a surface to directly access the pixels
+ */
+bool SDL_LockSurface(SDL_Surface *surface)
+{
+    if (!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
 
     if (!surface->internal->locked) {
 #if SDL_HAVE_RLE
@@ -1732,6 +2385,14 @@ bool SDL_LockSurface(SDL_Surface *surface)
 #endif
     }
 
+    // Writes through the pixels pointer must not change other surfaces
+    if (!SDL_UnshareSurfacePixels(surface)) {
+        return false;
+    }
+
+    // We can't tell what will be changed through the pixels pointer
+    SDL_AddSurfaceDamage(surface, NULL);
+
     // Increment the surface lock count, for recursive locks
     ++surface->internal->locked;
     surface->flags |= SDL_SURFACE_LOCKED;
@@ -1765,167 +2426,1124 @@ void SDL_UnlockSurface(SDL_Surface *surface)
     surface->flags &= ~SDL_SURFACE_LOCKED;
 }
 
-static bool SDL_FlipSurfaceHorizontal(SDL_Surface *surface)
+/*
+ * Damage tracking, used to only update the parts of window surfaces that
+ * have changed. Overlapping and neighboring rectangles are merged as they
+ * are added, as long as that doesn't cover many more pixels than they did.
+ */
+#define SDL_MAX_DAMAGE_RECTS    16
+#define SDL_DAMAGE_MERGE_SLACK  1024 // pixels we'd rather update than send another rectangle
+
+struct SDL_SurfaceDamage
 {
-    bool isstack;
-    Uint8 *row, *a, *b, *tmp;
-    int i, j, bpp;
+    int num_rects;
+    SDL_Rect rects[SDL_MAX_DAMAGE_RECTS];
+    const SDL_Palette *palette;
+    Uint32 palette_version;
+};
 
-    if (SDL_BITSPERPIXEL(surface->format) < 8) {
-        // We could implement this if needed, but we'd have to flip sets of bits within a byte
-        return SDL_Unsupported();
-    }
+static Sint64 SDL_DamageArea(const SDL_Rect *rect)
+{
+    return (Sint64)rect->w * rect->h;
+}
 
-    if (surface->h <= 0) {
-        return true;
+// How many more pixels the union of two rectangles covers than the two of them
+static Sint64 SDL_DamageMergeCost(const SDL_Rect *a, const SDL_Rect *b, SDL_Rect *merged)
+{
+    SDL_Rect overlap;
+    Sint64 area = SDL_DamageArea(a) + SDL_DamageArea(b);
+
+    if (SDL_GetRectIntersection(a, b, &overlap)) {
+        area -= SDL_DamageArea(&overlap);
     }
+    SDL_GetRectUnion(a, b, merged);
+    return SDL_DamageArea(merged) - area;
+}
 
-    if (surface->w <= 1) {
+static void SDL_RemoveDamageRect(SDL_SurfaceDamage *damage, int i)
+{
+    damage->rects[i] = damage->rects[--damage->num_rects];
+}
+
+static void SDL_ResetSurfaceDamage(SDL_Surface *surface)
+{
+    SDL_SurfaceDamage *damage = surface->internal->damage;
+
+    damage->num_rects = 0;
+    damage->palette = surface->internal->palette;
+    damage->palette_version = damage->palette ? damage->palette->version : 0;
+}
+
+bool SDL_TrackSurfaceDamage(SDL_Surface *surface, bool enabled)
+{
+    if (!enabled) {
+        SDL_free(surface->internal->damage);
+        surface->internal->damage = NULL;
         return true;
     }
 
-    bpp = SDL_BYTESPERPIXEL(surface->format);
-    row = (Uint8 *)surface->pixels;
-    tmp = SDL_small_alloc(Uint8, surface->pitch, &isstack);
-    for (i = surface->h; i--; ) {
-        a = row;
-        b = a + (surface->w - 1) * bpp;
-        for (j = surface->w / 2; j--; ) {
-            SDL_memcpy(tmp, a, bpp);
-            SDL_memcpy(a, b, bpp);
-            SDL_memcpy(b, tmp, bpp);
-            a += bpp;
-            b -= bpp;
+    if (!surface->internal->damage) {
+        surface->internal->damage = (SDL_SurfaceDamage *)SDL_malloc(sizeof(*surface->internal->damage));
+        if (!surface->internal->damage) {
+            return false;
         }
-        row += surface->pitch;
+        SDL_ResetSurfaceDamage(surface);
+
+        // We don't know what has been shown so far
+        SDL_AddSurfaceDamage(surface, NULL);
     }
-    SDL_small_free(tmp, isstack);
     return true;
 }
 
-static bool SDL_FlipSurfaceVertical(SDL_Surface *surface)
+void SDL_AddSurfaceDamage(SDL_Surface *surface, const SDL_Rect *area)
 {
-    bool isstack;
-    Uint8 *a, *b, *tmp;
+    SDL_SurfaceDamage *damage = surface->internal->damage;
+    const SDL_Rect bounds = { 0, 0, surface->w, surface->h };
+    SDL_Rect rect;
+    bool merged;
     int i;
 
-    if (surface->h <= 1) {
-        return true;
+    if (!damage) {
+        return;
     }
 
-    a = (Uint8 *)surface->pixels;
-    b = a + (surface->h - 1) * surface->pitch;
-    tmp = SDL_small_alloc(Uint8, surface->pitch, &isstack);
-    for (i = surface->h / 2; i--; ) {
-        SDL_memcpy(tmp, a, surface->pitch);
-        SDL_memcpy(a, b, surface->pitch);
-        SDL_memcpy(b, tmp, surface->pitch);
-        a += surface->pitch;
-        b -= surface->pitch;
+    if (!area) {
+        rect = bounds;
+    } else if (!SDL_GetRectIntersection(area, &bounds, &rect)) {
+        return;
     }
-    SDL_small_free(tmp, isstack);
-    return true;
+
+    do {
+        int best = -1;
+        Sint64 best_cost = SDL_DAMAGE_MERGE_SLACK;
+        SDL_Rect best_union;
+
+        merged = false;
+        for (i = 0; i < damage->num_rects; ++i) {
+            SDL_Rect u;
+            const Sint64 cost = SDL_DamageMergeCost(&damage->rects[i], &rect, &u);
+
+            if (SDL_DamageArea(&u) == SDL_DamageArea(&damage->rects[i])) {
+                // Already covered
+                return;
+            }
+            if (cost <= best_cost) {
+                best = i;
+                best_cost = cost;
+                best_union = u;
+            }
+        }
+
+        if (best < 0 && damage->num_rects == SDL_MAX_DAMAGE_RECTS) {
+            // Out of room, merge with whatever adds the fewest pixels
+            for (i = 0; i < damage->num_rects; ++i) {
+                SDL_Rect u;
+                const Sint64 cost = SDL_DamageMergeCost(&damage->rects[i], &rect, &u);
+
+                if (best < 0 || cost < best_cost) {
+                    best = i;
+                    best_cost = cost;
+                    best_union = u;
+                }
+            }
+        }
+
+        if (best >= 0) {
+            /* This also drops rectangles that the new one covers, and the union
+               may now cover or touch other rectangles, so try again */
+            SDL_RemoveDamageRect(damage, best);
+            rect = best_union;
+            merged = true;
+        }
+    } while (merged);
+
+    damage->rects[damage->num_rects++] = rect;
 }
 
-bool SDL_FlipSurface(SDL_Surface *surface, SDL_FlipMode flip)
+const SDL_Rect *SDL_GetSurfaceDamage(SDL_Surface *surface, int *count)
 {
-    if (!SDL_SurfaceValid(surface)) {
-        return SDL_InvalidParamError("surface");
-    }
-    if (!surface->pixels) {
-        return true;
+    SDL_SurfaceDamage *damage = surface->internal->damage;
+    const SDL_Palette *palette = surface->internal->palette;
+
+    if (!damage) {
+        *count = 0;
+        return NULL;
     }
 
-    switch (flip) {
-    case SDL_FLIP_HORIZONTAL:
-        return SDL_FlipSurfaceHorizontal(surface);
-    case SDL_FLIP_VERTICAL:
-        return SDL_FlipSurfaceVertical(surface);
-    default:
-        return SDL_InvalidParamError("flip");
+    // Changing the palette changes every pixel
+    if (damage->palette != palette || (palette && damage->palette_version != palette->version)) {
+        SDL_ResetSurfaceDamage(surface);
+        SDL_AddSurfaceDamage(surface, NULL);
     }
+
+    *count = damage->num_rects;
+    return damage->rects;
 }
 
-SDL_Surface *SDL_ConvertSurfaceAndColorspace(SDL_Surface *surface, SDL_PixelFormat format, SDL_Palette *palette, SDL_Colorspace colorspace, SDL_PropertiesID props)
+void SDL_ClearSurfaceDamage(SDL_Surface *surface)
 {
-    SDL_Palette *temp_palette = NULL;
-    SDL_Surface *convert = NULL;
-    SDL_Colorspace src_colorspace;
-    SDL_PropertiesID src_properties;
-    Uint32 copy_flags;
-    SDL_Color copy_color;
-    SDL_Rect bounds;
-    bool result;
-    bool palette_ck_transform = false;
-    Uint8 palette_ck_value = 0;
-    Uint8 *palette_saved_alpha = NULL;
-    int palette_saved_alpha_ncolors = 0;
-
-    if (!SDL_SurfaceValid(surface)) {
-        SDL_InvalidParamError("surface");
-        goto error;
-    }
-
-    if (format == SDL_PIXELFORMAT_UNKNOWN) {
-        SDL_InvalidParamError("format");
-        goto error;
+    if (surface->internal->damage) {
+        SDL_ResetSurfaceDamage(surface);
     }
+}
 
-    // Check for empty destination palette! (results in empty image)
-    if (palette) {
-        int i;
-        for (i = 0; i < palette->ncolors; ++i) {
-            if ((palette->colors[i].r != 0xFF) || (palette->colors[i].g != 0xFF) || (palette->colors[i].b != 0xFF)) {
-                break;
-            }
+// Reverses the pixels [first, width - first) of a row in place
+static void SDL_ReverseRowScalar(Uint8 *row, int first, int width, int bpp)
+{
+    Uint8 *a = row + (size_t)first * bpp;
+    Uint8 *b = row + (size_t)(width - 1 - first) * bpp;
+
+    switch (bpp) {
+    case 1:
+        for (; a < b; ++a, --b) {
+            const Uint8 tmp = *a;
+            *a = *b;
+            *b = tmp;
         }
-        if (i == palette->ncolors) {
-            SDL_SetError("Empty destination palette");
-            goto error;
+        break;
+    case 2:
+        for (; a < b; a += 2, b -= 2) {
+            const Uint16 tmp = *(Uint16 *)a;
+            *(Uint16 *)a = *(Uint16 *)b;
+            *(Uint16 *)b = tmp;
         }
-    } else if (SDL_ISPIXELFORMAT_INDEXED(format)) {
-        // Create a dither palette for conversion
-        temp_palette = SDL_CreatePalette(1 << SDL_BITSPERPIXEL(format));
-        if (temp_palette) {
-            SDL_DitherPalette(temp_palette);
-            palette = temp_palette;
+        break;
+    case 3:
+        for (; a < b; a += 3, b -= 3) {
+            const Uint8 tmp0 = a[0], tmp1 = a[1], tmp2 = a[2];
+            a[0] = b[0];
+            a[1] = b[1];
+            a[2] = b[2];
+            b[0] = tmp0;
+            b[1] = tmp1;
+            b[2] = tmp2;
+        }
+        break;
+    case 4:
+        for (; a < b; a += 4, b -= 4) {
+            const Uint32 tmp = *(Uint32 *)a;
+            *(Uint32 *)a = *(Uint32 *)b;
+            *(Uint32 *)b = tmp;
+        }
+        break;
+    default:
+    {
+        Uint8 tmp[16];
+
+        SDL_assert(bpp <= (int)sizeof(tmp));
+        for (; a < b; a += bpp, b -= bpp) {
+            SDL_memcpy(tmp, a, bpp);
+            SDL_memcpy(a, b, bpp);
+            SDL_memcpy(b, tmp, bpp);
         }
+        break;
+    }
     }
+}
 
-    src_colorspace = surface->internal->colorspace;
-    src_properties = surface->internal->props;
+/* Reverses a vector from each end of a row at a time, and returns the number of pixels done at
+   each end. Only pixel sizes that divide the vector size are handled, the rest is left over. */
+typedef int (*SDL_ReverseRowFunc)(Uint8 *row, int width, int bpp);
 
-    // Create a new surface with the desired format
-    convert = SDL_CreateSurface(surface->w, surface->h, format);
-    if (!convert) {
-        goto error;
-    }
-    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
-        SDL_SetSurfacePalette(convert, palette);
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_INLINE __m256i SDL_TARGETING("avx2") SDL_ReverseVector_AVX2(__m256i v, int bpp)
+{
+    switch (bpp) {
+    case 1:
+        v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                    15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+        return _mm256_permute4x64_epi64(v, 0x4E);
+    case 2:
+        v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                                    14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1));
+        return _mm256_permute4x64_epi64(v, 0x4E);
+    case 4:
+        return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    case 8:
+        return _mm256_permute4x64_epi64(v, 0x1B);
+    default:
+        return _mm256_permute4x64_epi64(v, 0x4E);
     }
+}
 
-    if (colorspace == SDL_COLORSPACE_UNKNOWN) {
-        colorspace = src_colorspace;
+static int SDL_TARGETING("avx2") SDL_ReverseRow_AVX2(Uint8 *row, int width, int bpp)
+{
+    const int n = 32 / bpp;
+    Uint8 *a = row;
+    Uint8 *b = row + (size_t)width * bpp - 32;
+    int i;
+
+    for (i = 0; 2 * (i + n) <= width; i += n) {
+        const __m256i va = _mm256_loadu_si256((const __m256i *)a);
+        const __m256i vb = _mm256_loadu_si256((const __m256i *)b);
+        _mm256_storeu_si256((__m256i *)a, SDL_ReverseVector_AVX2(vb, bpp));
+        _mm256_storeu_si256((__m256i *)b, SDL_ReverseVector_AVX2(va, bpp));
+        a += 32;
+        b -= 32;
     }
-    SDL_SetSurfaceColorspace(convert, colorspace);
+    return i;
+}
+#endif // SDL_AVX2_INTRINSICS
 
-    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
-        if (!SDL_ConvertPixelsAndColorspace(surface->w, surface->h, surface->format, src_colorspace, src_properties, surface->pixels, surface->pitch, convert->format, colorspace, props, convert->pixels, convert->pitch)) {
-            goto error;
-        }
+#ifdef SDL_SSE2_INTRINSICS
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_ReverseVector_SSE2(__m128i v, int bpp)
+{
+    switch (bpp) {
+    case 1:
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        SDL_FALLTHROUGH;
+    case 2:
+        v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+        return _mm_shuffle_epi32(v, 0x4E);
+    case 4:
+        return _mm_shuffle_epi32(v, 0x1B);
+    case 8:
+        return _mm_shuffle_epi32(v, 0x4E);
+    default:
+        return v;
+    }
+}
 
-        // Save the original copy flags
-        copy_flags = surface->internal->map.info.flags;
+static int SDL_TARGETING("sse2") SDL_ReverseRow_SSE2(Uint8 *row, int width, int bpp)
+{
+    const int n = 16 / bpp;
+    Uint8 *a = row;
+    Uint8 *b = row + (size_t)width * bpp - 16;
+    int i;
 
-        goto end;
+    for (i = 0; 2 * (i + n) <= width; i += n) {
+        const __m128i va = _mm_loadu_si128((const __m128i *)a);
+        const __m128i vb = _mm_loadu_si128((const __m128i *)b);
+        _mm_storeu_si128((__m128i *)a, SDL_ReverseVector_SSE2(vb, bpp));
+        _mm_storeu_si128((__m128i *)b, SDL_ReverseVector_SSE2(va, bpp));
+        a += 16;
+        b -= 16;
     }
+    return i;
+}
+#endif // SDL_SSE2_INTRINSICS
 
-    // Save the original copy flags
-    copy_flags = surface->internal->map.info.flags;
-    copy_color.r = surface->internal->map.info.r;
-    copy_color.g = surface->internal->map.info.g;
-    copy_color.b = surface->internal->map.info.b;
-    copy_color.a = surface->internal->map.info.a;
+#ifdef SDL_NEON_INTRINSICS
+static SDL_INLINE uint8x16_t SDL_ReverseVector_NEON(uint8x16_t v, int bpp)
+{
+    switch (bpp) {
+    case 1:
+        v = vrev64q_u8(v);
+        break;
+    case 2:
+        v = vreinterpretq_u8_u16(vrev64q_u16(vreinterpretq_u16_u8(v)));
+        break;
+    case 4:
+        v = vreinterpretq_u8_u32(vrev64q_u32(vreinterpretq_u32_u8(v)));
+        break;
+    case 8:
+        break;
+    default:
+        return v;
+    }
+    return vextq_u8(v, v, 8);
+}
+
+static int SDL_ReverseRow_NEON(Uint8 *row, int width, int bpp)
+{
+    const int n = 16 / bpp;
+    Uint8 *a = row;
+    Uint8 *b = row + (size_t)width * bpp - 16;
+    int i;
+
+    for (i = 0; 2 * (i + n) <= width; i += n) {
+        const uint8x16_t va = vld1q_u8(a);
+        const uint8x16_t vb = vld1q_u8(b);
+        vst1q_u8(a, SDL_ReverseVector_NEON(vb, bpp));
+        vst1q_u8(b, SDL_ReverseVector_NEON(va, bpp));
+        a += 16;
+        b -= 16;
+    }
+    return i;
+}
+#endif // SDL_NEON_INTRINSICS
+
+static SDL_ReverseRowFunc SDL_GetReverseRowFunc(int bpp)
+{
+    if (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8 && bpp != 16) {
+        return NULL;
+    }
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return SDL_ReverseRow_AVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_ReverseRow_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_ReverseRow_NEON;
+    }
+#endif
+    return NULL;
+}
+
+// Quarter turns are done in tiles, so that the rows read and written stay in the cache
+#define SDL_ROTATE_TILE_SIZE 32
+
+typedef struct SDL_RotateJob
+{
+    int width; // of the source
+    int height;
+    int bpp;
+    const Uint8 *src;
+    int src_pitch;
+    Uint8 *dst;
+    int dst_pitch;
+    int turns;
+} SDL_RotateJob;
+
+// Copies the destination pixels [x0, x1) of rows [y0, y1) for a quarter turn
+static void SDL_RotateTileScalar(const SDL_RotateJob *job, int x0, int x1, int y0, int y1)
+{
+    const int bpp = job->bpp;
+    ptrdiff_t src_step;
+    int x, y;
+
+    // Destination rows are source columns, read downwards for a turn counter-clockwise
+    src_step = (job->turns == 1) ? -(ptrdiff_t)job->src_pitch : job->src_pitch;
+
+    for (y = y0; y < y1; ++y) {
+        const Uint8 *src;
+        Uint8 *dst = job->dst + (size_t)y * job->dst_pitch + (size_t)x0 * bpp;
+
+        if (job->turns == 1) {
+            src = job->src + (size_t)(job->height - 1 - x0) * job->src_pitch + (size_t)y * bpp;
+        } else {
+            src = job->src + (size_t)x0 * job->src_pitch + (size_t)(job->width - 1 - y) * bpp;
+        }
+
+        switch (bpp) {
+        case 1:
+            for (x = x0; x < x1; ++x, src += src_step, dst += 1) {
+                *dst = *src;
+            }
+            break;
+        case 2:
+            for (x = x0; x < x1; ++x, src += src_step, dst += 2) {
+                *(Uint16 *)dst = *(const Uint16 *)src;
+            }
+            break;
+        case 3:
+            for (x = x0; x < x1; ++x, src += src_step, dst += 3) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+            }
+            break;
+        case 4:
+            for (x = x0; x < x1; ++x, src += src_step, dst += 4) {
+                *(Uint32 *)dst = *(const Uint32 *)src;
+            }
+            break;
+        case 8:
+            for (x = x0; x < x1; ++x, src += src_step, dst += 8) {
+                *(Uint64 *)dst = *(const Uint64 *)src;
+            }
+            break;
+        default:
+            for (x = x0; x < x1; ++x, src += src_step, dst += bpp) {
+                SDL_memcpy(dst, src, bpp);
+            }
+            break;
+        }
+    }
+}
+
+/* Copies a tile of 32-bit pixels for a quarter turn, returns the number of destination columns
+   and rows done, the rest is left over */
+typedef void (*SDL_RotateTileFunc)(const SDL_RotateJob *job, int x0, int x1, int y0, int y1, int *x_done, int *y_done);
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") SDL_RotateTile32_SSE2(const SDL_RotateJob *job, int x0, int x1, int y0, int y1, int *x_done, int *y_done)
+{
+    const int w = (x1 - x0) & ~3;
+    const int h = (y1 - y0) & ~3;
+    int x, y;
+
+    for (y = y0; y < y0 + h; y += 4) {
+        Uint8 *dst = job->dst + (size_t)y * job->dst_pitch;
+
+        for (x = x0; x < x0 + w; x += 4) {
+            __m128i s0, s1, s2, s3, t0, t1, t2, t3;
+
+            /* Four source rows of four pixels, ordered so that their transpose is the destination:
+               the rows upwards from the bottom for a clockwise turn, downwards otherwise. */
+            if (job->turns == 1) {
+                const Uint8 *src = job->src + (size_t)(job->height - 1 - x) * job->src_pitch + (size_t)y * 4;
+                s0 = _mm_loadu_si128((const __m128i *)src);
+                s1 = _mm_loadu_si128((const __m128i *)(src - job->src_pitch));
+                s2 = _mm_loadu_si128((const __m128i *)(src - 2 * (ptrdiff_t)job->src_pitch));
+                s3 = _mm_loadu_si128((const __m128i *)(src - 3 * (ptrdiff_t)job->src_pitch));
+            } else {
+                const Uint8 *src = job->src + (size_t)x * job->src_pitch + (size_t)(job->width - 4 - y) * 4;
+                s0 = _mm_loadu_si128((const __m128i *)src);
+                s1 = _mm_loadu_si128((const __m128i *)(src + job->src_pitch));
+                s2 = _mm_loadu_si128((const __m128i *)(src + 2 * (ptrdiff_t)job->src_pitch));
+                s3 = _mm_loadu_si128((const __m128i *)(src + 3 * (ptrdiff_t)job->src_pitch));
+            }
+            t0 = _mm_unpacklo_epi32(s0, s1);
+            t1 = _mm_unpacklo_epi32(s2, s3);
+            t2 = _mm_unpackhi_epi32(s0, s1);
+            t3 = _mm_unpackhi_epi32(s2, s3);
+            s0 = _mm_unpacklo_epi64(t0, t1);
+            s1 = _mm_unpackhi_epi64(t0, t1);
+            s2 = _mm_unpacklo_epi64(t2, t3);
+            s3 = _mm_unpackhi_epi64(t2, t3);
+
+            // Counter-clockwise, the source columns were read right to left
+            if (job->turns == 1) {
+                _mm_storeu_si128((__m128i *)(dst + (size_t)x * 4), s0);
+                _mm_storeu_si128((__m128i *)(dst + job->dst_pitch + (size_t)x * 4), s1);
+                _mm_storeu_si128((__m128i *)(dst + 2 * (size_t)job->dst_pitch + (size_t)x * 4), s2);
+                _mm_storeu_si128((__m128i *)(dst + 3 * (size_t)job->dst_pitch + (size_t)x * 4), s3);
+            } else {
+                _mm_storeu_si128((__m128i *)(dst + (size_t)x * 4), s3);
+                _mm_storeu_si128((__m128i *)(dst + job->dst_pitch + (size_t)x * 4), s2);
+                _mm_storeu_si128((__m128i *)(dst + 2 * (size_t)job->dst_pitch + (size_t)x * 4), s1);
+                _mm_storeu_si128((__m128i *)(dst + 3 * (size_t)job->dst_pitch + (size_t)x * 4), s0);
+            }
+        }
+    }
+    *x_done = w;
+    *y_done = h;
+}
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+static void SDL_RotateTile32_NEON(const SDL_RotateJob *job, int x0, int x1, int y0, int y1, int *x_done, int *y_done)
+{
+    const int w = (x1 - x0) & ~3;
+    const int h = (y1 - y0) & ~3;
+    int x, y;
+
+    for (y = y0; y < y0 + h; y += 4) {
+        Uint8 *dst = job->dst + (size_t)y * job->dst_pitch;
+
+        for (x = x0; x < x0 + w; x += 4) {
+            uint32x4_t s0, s1, s2, s3;
+            uint32x4x2_t t01, t23;
+
+            // Same order as SDL_RotateTile32_SSE2()
+            if (job->turns == 1) {
+                const Uint8 *src = job->src + (size_t)(job->height - 1 - x) * job->src_pitch + (size_t)y * 4;
+                s0 = vld1q_u32((const Uint32 *)src);
+                s1 = vld1q_u32((const Uint32 *)(src - job->src_pitch));
+                s2 = vld1q_u32((const Uint32 *)(src - 2 * (ptrdiff_t)job->src_pitch));
+                s3 = vld1q_u32((const Uint32 *)(src - 3 * (ptrdiff_t)job->src_pitch));
+            } else {
+                const Uint8 *src = job->src + (size_t)x * job->src_pitch + (size_t)(job->width - 4 - y) * 4;
+                s0 = vld1q_u32((const Uint32 *)src);
+                s1 = vld1q_u32((const Uint32 *)(src + job->src_pitch));
+                s2 = vld1q_u32((const Uint32 *)(src + 2 * (ptrdiff_t)job->src_pitch));
+                s3 = vld1q_u32((const Uint32 *)(src + 3 * (ptrdiff_t)job->src_pitch));
+            }
+            t01 = vtrnq_u32(s0, s1);
+            t23 = vtrnq_u32(s2, s3);
+            s0 = vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0]));
+            s1 = vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1]));
+            s2 = vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0]));
+            s3 = vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1]));
+
+            if (job->turns == 1) {
+                vst1q_u32((Uint32 *)(dst + (size_t)x * 4), s0);
+                vst1q_u32((Uint32 *)(dst + job->dst_pitch + (size_t)x * 4), s1);
+                vst1q_u32((Uint32 *)(dst + 2 * (size_t)job->dst_pitch + (size_t)x * 4), s2);
+                vst1q_u32((Uint32 *)(dst + 3 * (size_t)job->dst_pitch + (size_t)x * 4), s3);
+            } else {
+                vst1q_u32((Uint32 *)(dst + (size_t)x * 4), s3);
+                vst1q_u32((Uint32 *)(dst + job->dst_pitch + (size_t)x * 4), s2);
+                vst1q_u32((Uint32 *)(dst + 2 * (size_t)job->dst_pitch + (size_t)x * 4), s1);
+                vst1q_u32((Uint32 *)(dst + 3 * (size_t)job->dst_pitch + (size_t)x * 4), s0);
+            }
+        }
+    }
+    *x_done = w;
+    *y_done = h;
+}
+#endif // SDL_NEON_INTRINSICS
+
+static void SDL_RotateRows(void *userdata, int y, int h)
+{
+    const SDL_RotateJob *job = (const SDL_RotateJob *)userdata;
+    const int bpp = job->bpp;
+    int x, ty;
+
+    if (job->turns == 0 || job->turns == 2) {
+        const SDL_ReverseRowFunc reverse_row = SDL_GetReverseRowFunc(bpp);
+        const size_t length = (size_t)job->width * bpp;
+
+        for (; h--; ++y) {
+            Uint8 *dst = job->dst + (size_t)y * job->dst_pitch;
+
+            if (job->turns == 0) {
+                SDL_memcpy(dst, job->src + (size_t)y * job->src_pitch, length);
+            } else {
+                SDL_memcpy(dst, job->src + (size_t)(job->height - 1 - y) * job->src_pitch, length);
+                SDL_ReverseRowScalar(dst, reverse_row ? reverse_row(dst, job->width, bpp) : 0, job->width, bpp);
+            }
+        }
+        return;
+    }
+
+    // The destination is job->height pixels wide
+    for (ty = y; ty < y + h; ty += SDL_ROTATE_TILE_SIZE) {
+        const int y1 = SDL_min(ty + SDL_ROTATE_TILE_SIZE, y + h);
+
+        for (x = 0; x < job->height; x += SDL_ROTATE_TILE_SIZE) {
+            const int x1 = SDL_min(x + SDL_ROTATE_TILE_SIZE, job->height);
+            int x_done = 0, y_done = 0;
+
+            if (bpp == 4) {
+#ifdef SDL_SSE2_INTRINSICS
+                if (SDL_HasSSE2()) {
+                    SDL_RotateTile32_SSE2(job, x, x1, ty, y1, &x_done, &y_done);
+                }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+                if (SDL_HasNEON()) {
+                    SDL_RotateTile32_NEON(job, x, x1, ty, y1, &x_done, &y_done);
+                }
+#endif
+            }
+            if (y_done > 0) {
+                SDL_RotateTileScalar(job, x + x_done, x1, ty, ty + y_done);
+            }
+            SDL_RotateTileScalar(job, x, x1, ty + y_done, y1);
+        }
+    }
+}
+
+void SDL_RotatePixels90(int width, int height, int bpp, const void *src, int src_pitch, void *dst, int dst_pitch, int turns)
+{
+    SDL_RotateJob job;
+    int dst_width, dst_height;
+
+    job.width = width;
+    job.height = height;
+    job.bpp = bpp;
+    job.src = (const Uint8 *)src;
+    job.src_pitch = src_pitch;
+    job.dst = (Uint8 *)dst;
+    job.dst_pitch = dst_pitch;
+    job.turns = ((turns % 4) + 4) % 4;
+
+    if (job.turns & 1) {
+        dst_width = height;
+        dst_height = width;
+    } else {
+        dst_width = width;
+        dst_height = height;
+    }
+    if (dst_width <= 0 || dst_height <= 0) {
+        return;
+    }
+
+    if (!SDL_RunBlitRowsParallel(dst_width, dst_height, SDL_RotateRows, &job)) {
+        SDL_RotateRows(&job, 0, dst_height);
+    }
+}
+
+static bool SDL_FlipSurfaceHorizontal(SDL_Surface *surface)
+{
+    SDL_ReverseRowFunc reverse_row;
+    Uint8 *row;
+    int i, bpp;
+
+    if (SDL_BITSPERPIXEL(surface->format) < 8) {
+        // We could implement this if needed, but we'd have to flip sets of bits within a byte
+        return SDL_Unsupported();
+    }
+
+    if (surface->h <= 0) {
+        return true;
+    }
+
+    if (surface->w <= 1) {
+        return true;
+    }
+
+    bpp = SDL_BYTESPERPIXEL(surface->format);
+    reverse_row = SDL_GetReverseRowFunc(bpp);
+    row = (Uint8 *)surface->pixels;
+    for (i = surface->h; i--; ) {
+        SDL_ReverseRowScalar(row, reverse_row ? reverse_row(row, surface->w, bpp) : 0, surface->w, bpp);
+        row += surface->pitch;
+    }
+    return true;
+}
+
+static bool SDL_FlipSurfaceVertical(SDL_Surface *surface)
+{
+    bool isstack;
+    Uint8 *a, *b, *tmp;
+    int i;
+
+    if (surface->h <= 1) {
+        return true;
+    }
+
+    a = (Uint8 *)surface->pixels;
+    b = a + (surface->h - 1) * surface->pitch;
+    tmp = SDL_small_alloc(Uint8, surface->pitch, &isstack);
+    for (i = surface->h / 2; i--; ) {
+        SDL_memcpy(tmp, a, surface->pitch);
+        SDL_memcpy(a, b, surface->pitch);
+        SDL_memcpy(b, tmp, surface->pitch);
+        a += surface->pitch;
+        b -= surface->pitch;
+    }
+    SDL_small_free(tmp, isstack);
+    return true;
+}
+
+bool SDL_FlipSurface(SDL_Surface *surface, SDL_FlipMode flip)
+{
+    if (!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (!surface->pixels) {
+        return true;
+    }
+
+    if (!SDL_UnshareSurfacePixels(surface)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(surface, NULL);
+
+    switch (flip) {
+    case SDL_FLIP_HORIZONTAL:
+        return SDL_FlipSurfaceHorizontal(surface);
+    case SDL_FLIP_VERTICAL:
+        return SDL_FlipSurfaceVertical(surface);
+    default:
+        return SDL_InvalidParamError("flip");
+    }
+}
+
+SDL_Surface *SDL_RotateSurface90(SDL_Surface *surface, int turns)
+{
+    SDL_Surface *rotated;
+    Uint32 copy_flags;
+    int w, h;
+
+    if (!SDL_SurfaceValid(surface)) {
+        SDL_InvalidParamError("surface");
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(surface->format) || SDL_BITSPERPIXEL(surface->format) < 8) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    turns = ((turns % 4) + 4) % 4;
+    if (turns & 1) {
+        w = surface->h;
+        h = surface->w;
+    } else {
+        w = surface->w;
+        h = surface->h;
+    }
+
+    rotated = SDL_CreateSurface(w, h, surface->format);
+    if (!rotated) {
+        return NULL;
+    }
+    SDL_SetSurfacePalette(rotated, surface->internal->palette);
+    SDL_SetSurfaceColorspace(rotated, surface->internal->colorspace);
+
+    if (SDL_MUSTLOCK(surface)) {
+        if (!SDL_LockSurface(surface)) {
+            SDL_DestroySurface(rotated);
+            return NULL;
+        }
+    }
+    if (surface->pixels) {
+        SDL_RotatePixels90(surface->w, surface->h, SDL_BYTESPERPIXEL(surface->format), surface->pixels, surface->pitch, rotated->pixels, rotated->pitch, turns);
+    }
+    if (SDL_MUSTLOCK(surface)) {
+        SDL_UnlockSurface(surface);
+    }
+
+    // Copy the blit settings
+    copy_flags = surface->internal->map.info.flags;
+    rotated->internal->map.info.r = surface->internal->map.info.r;
+    rotated->internal->map.info.g = surface->internal->map.info.g;
+    rotated->internal->map.info.b = surface->internal->map.info.b;
+    rotated->internal->map.info.a = surface->internal->map.info.a;
+    rotated->internal->map.info.colorkey = surface->internal->map.info.colorkey;
+    rotated->internal->map.info.flags = (copy_flags & ~(SDL_COPY_RLE_DESIRED | SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
+    if (copy_flags & SDL_COPY_RLE_DESIRED) {
+        SDL_SetSurfaceRLE(rotated, true);
+    }
+    return rotated;
+}
+
+SDL_Surface *SDL_ConvertSurfaceAndColorspace(SDL_Surface *surface, SDL_PixelFormat format, SDL_Palette *palette, SDL_Colorspace colorspace, SDL_PropertiesID props)
+{
+    SDL_Palette *temp_palette = NULL;
+    SDL_Surface *convert = NULL;
+    SDL_Colorspace src_colorspace;
+    SDL_PropertiesID src_properties;
+    Uint32 copy_flags;
+    SDL_Color copy_color;
+    SDL_Rect bounds;
+    bool result;
+    bool palette_ck_transform = false;
+    Uint8 palette_ck_value = 0;
+    Uint8 *palette_saved_alpha = NULL;
+    int palette_saved_alpha_ncolors = 0;
+
+    if (!SDL_SurfaceValid(surface)) {
+        SDL_InvalidParamError("surface");
+        goto error;
+    }
+
+    if (format == SDL_PIXELFORMAT_UNKNOWN) {
+        SDL_InvalidParamError("format");
+        goto error;
+    }
+
+    // Check for empty destination palette! (results in empty image)
+    if (palette) {
+        int i;
+        for (i = 0; i < palette->ncolors; ++i) {
+            if ((palette->colors[i].r != 0xFF) || (palette->colors[i].g != 0xFF) || (palette->colors[i].b != 0xFF)) {
+                break;
+            }
+        }
+        if (i == palette->ncolors) {
+            SDL_SetError("Empty destination palette");
+            goto error;
+        }
+    } else if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        // Create a dither palette for conversion
+        temp_palette = SDL_CreatePalette(1 << SDL_BITSPERPIXEL(format));
+        if (temp_palette) {
+            SDL_DitherPalette(temp_palette);
+            palette = temp_palette;
+        }
+    }
+
+    src_colorspace = surface->internal->colorspace;
+    src_properties = surface->internal->props;
+
+    // Share the pixels if the conversion wouldn't change them
+    if (format == surface->format &&
+        (colorspace == SDL_COLORSPACE_UNKNOWN || colorspace == src_colorspace) &&
+        (SDL_ISPIXELFORMAT_INDEXED(format) ? (palette == surface->internal->palette) : !(surface->internal->map.info.flags & SDL_COPY_COLORKEY)) &&
+        SDL_CanShareSurfacePixels(surface)) {
+        convert = SDL_CreateSharedSurface(surface);
+        if (!convert) {
+            goto error;
+        }
+        if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+            SDL_SetSurfacePalette(convert, palette);
+        }
+
+        copy_flags = surface->internal->map.info.flags;
+        convert->internal->map.info.r = surface->internal->map.info.r;
+        convert->internal->map.info.g = surface->internal->map.info.g;
+        convert->internal->map.info.b = surface->internal->map.info.b;
+        convert->internal->map.info.a = surface->internal->map.info.a;
+        convert->internal->map.info.flags =
+            (copy_flags &
+             ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND | SDL_COPY_RLE_DESIRED | SDL_COPY_RLE_COLORKEY |
+               SDL_COPY_RLE_ALPHAKEY));
+        if (copy_flags & SDL_COPY_COLORKEY) {
+            SDL_SetSurfaceColorKey(convert, true, surface->internal->map.info.colorkey);
+        }
+        goto end;
+    }
+
+    // Create a new surface with the desired format
+    convert = SDL_CreateSurface(surface->w, surface->h, format);
+    if (!convert) {
+        goto error;
+    }
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_SetSurfacePalette(convert, palette);
+    }
+
+    if (colorspace == SDL_COLORSPACE_UNKNOWN) {
+        colorspace = src_colorspace;
+    }
+    SDL_SetSurfaceColorspace(convert, colorspace);
+
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
+        if (!SDL_ConvertPixelsAndColorspace(surface->w, surface->h, surface->format, src_colorspace, src_properties, surface->pixels, surface->pitch, convert->format, colorspace, props, convert->pixels, convert->pitch)) {
+            goto error;
+        }
+
+        // Save the original copy flags
+        copy_flags = surface->internal->map.info.flags;
+
+        goto end;
+    }
+
+    // Save the original copy flags
+    copy_flags = surface->internal->map.info.flags;
+    copy_color.r = surface->internal->map.info.r;
+    copy_color.g = surface->internal->map.info.g;
+    copy_color.b = surface->internal->map.info.b;
+    copy_color.a = surface->internal->map.info.a;
+    surface->internal->map.info.r = 0xFF;
+    surface->internal->map.info.g = 0xFF;
+    surface->internal->map.info.b = 0xFF;
+    surface->internal->map.info.a = 0xFF;
+    surface->internal->map.info.flags = (copy_flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
+    SDL_InvalidateMap(&surface->internal->map);
+
+    // Copy over the image data
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = surface->w;
+    bounds.h = surface->h;
+
+    /* Source surface has a palette with no real alpha (0 or OPAQUE).
+     * Destination format has alpha.
+     * -> set alpha channel to be opaque */
+    if (surface->internal->palette && SDL_ISPIXELFORMAT_ALPHA(format)) {
+        bool set_opaque = false;
+
+        bool is_opaque, has_alpha_channel;
+        SDL_DetectPalette(surface->internal->palette, &is_opaque, &has_alpha_channel);
+
+        if (is_opaque) {
+            if (!has_alpha_channel) {
+                set_opaque = true;
+            }
+        }
+
+        // Set opaque and backup palette alpha values
+        if (set_opaque) {
+            int i;
+            palette_saved_alpha_ncolors = surface->internal->palette->ncolors;
+            if (palette_saved_alpha_ncolors > 0) {
+                palette_saved_alpha = SDL_stack_alloc(Uint8, palette_saved_alpha_ncolors);
+                for (i = 0; i < palette_saved_alpha_ncolors; i++) {
+                    palette_saved_alpha[i] = surface->internal->palette->colors[i].a;
+                    surface->internal->palette->colors[i].a = SDL_ALPHA_OPAQUE;
+                }
+            }
+        }
+    }
+
+    // Transform colorkey to alpha. for cases where source palette has duplicate values, and colorkey is one of them
+    if (copy_flags & SDL_COPY_COLORKEY) {
+        if (surface->internal->palette && !palette) {
+            palette_ck_transform = true;
+            palette_ck_value = surface->internal->palette->colors[surface->internal->map.info.colorkey].a;
+            surface->internal->palette->colors[surface->internal->map.info.colorkey].a = SDL_ALPHA_TRANSPARENT;
+        }
+    }
+
+    result = SDL_BlitSurfaceUnchecked(surface, &bounds, convert, &bounds);
+
+    // Restore colorkey alpha value
+    if (palette_ck_transform) {
+        surface->internal->palette->colors[surface->internal->map.info.colorkey].a = palette_ck_value;
+    }
+
+    // Restore palette alpha values
+    if (palette_saved_alpha) {
+        int i;
+        for (i = 0; i < palette_saved_alpha_ncolors; i++) {
+            surface->internal->palette->colors[i].a = palette_saved_alpha[i];
+        }
+        SDL_stack_free(palette_saved_alpha);
+    }
+
+    // Clean up the original surface, and update converted surface
+    convert->internal->map.info.r = copy_color.r;
+    convert->internal->map.info.g = copy_color.g;
+    convert->internal->map.info.b = copy_color.b;
+    convert->internal->map.info.a = copy_color.a;
+    convert->internal->map.info.flags =
+        (copy_flags &
+         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND | SDL_COPY_RLE_DESIRED | SDL_COPY_RLE_COLORKEY |
+           SDL_COPY_RLE_ALPHAKEY));
+    surface->internal->map.info.r = copy_color.r;
+    surface->internal->map.info.g = copy_color.g;
+    surface->internal->map.info.b = copy_color.b;
+    surface->internal->map.info.a = copy_color.a;
+    surface->internal->map.info.flags = copy_flags;
+    SDL_InvalidateMap(&surface->internal->map);
+
+    // SDL_BlitSurfaceUnchecked failed, and so the conversion
+    if (!result) {
+        goto error;
+    }
+
+    if (copy_flags & SDL_COPY_COLORKEY) {
+        bool set_colorkey_by_color = false;
+        bool convert_colorkey = true;
+
+        if (surface->internal->palette) {
+            if (palette &&
+                surface->internal->palette->ncolors <= palette->ncolors &&
+                (SDL_memcmp(surface->internal->palette->colors, palette->colors,
+                            surface->internal->palette->ncolors * sizeof(SDL_Color)) == 0)) {
+                // The palette is identical, just set the same colorkey
+                SDL_SetSurfaceColorKey(convert, true, surface->internal->map.info.colorkey);
+            } else if (!palette) {
+                if (SDL_ISPIXELFORMAT_ALPHA(format)) {
+                    // No need to add the colorkey, transparency is in the alpha channel
+                } else {
+                    // Only set the colorkey information
+                    set_colorkey_by_color = true;
+                    convert_colorkey = false;
+                }
+            } else {
+                set_colorkey_by_color = true;
+            }
+        } else {
+            set_colorkey_by_color = true;
+        }
+
+        if (set_colorkey_by_color) {
+            SDL_Surface *tmp;
+            SDL_Surface *tmp2;
+            int converted_colorkey = 0;
+
+            // Create a dummy surface to get the colorkey converted
+            tmp = SDL_CreateSurface(1, 1, surface->format);
+            if (!tmp) {
+                goto error;
+            }
+
+            // Share the palette, if any
+            if (surface->internal->palette) {
+                SDL_SetSurfacePalette(tmp, surface->internal->palette);
+            }
+
+            SDL_FillSurfaceRect(tmp, NULL, surface->internal->map.info.colorkey);
+
+            tmp->internal->map.info.flags &= ~SDL_COPY_COLORKEY;
+
+            // Conversion of the colorkey
+            tmp2 = SDL_ConvertSurfaceAndColorspace(tmp, format, palette, colorspace, props);
+            if (!tmp2) {
+                SDL_DestroySurface(tmp);
+                goto error;
+            }
+
+            // Get the converted colorkey
+            SDL_memcpy(&converted_colorkey, tmp2->pixels, tmp2->internal->format->bytes_per_pixel);
+
+            SDL_DestroySurface(tmp);
+            SDL_DestroySurface(tmp2);
+
+            // Set the converted colorkey on the new surface
+            SDL_SetSurfaceColorKey(convert, true, converted_colorkey);
+
+            // This is needed when converting for 3D texture upload
+            if (convert_colorkey) {
+                SDL_ConvertColorkeyToAlpha(convert, true);
+            }
+        }
+    }
+
+end:
+    if (temp_palette) {
+        SDL_DestroyPalette(temp_palette);
+    }
+
+    SDL_SetSurfaceClipRect(convert, &surface->internal->clip_rect);
+
+    /* Enable alpha blending by default if the new surface has an
+     * alpha channel or alpha modulation */
+    if (SDL_ISPIXELFORMAT_ALPHA(format) ||
+        (copy_flags & SDL_COPY_MODULATE_ALPHA)) {
+        SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND);
+    }
+    if (copy_flags & SDL_COPY_RLE_DESIRED) {
+        SDL_SetSurfaceRLE(convert, true);
+    }
+
+    // Copy alternate images
+    for (int i = 0; i < surface->internal->num_images; ++i) {
+        if (!SDL_AddSurfaceAlternateImage(convert, surface->internal->images[i])) {
+            goto error;
+        }
+    }
+
+    // We're ready to go!
+    return convert;
+
+error:
+    if (temp_palette) {
+        SDL_DestroyPalette(temp_palette);
+    }
+    if (convert) {
+        SDL_DestroySurface(convert);
+    }
+    return NULL;
+}
+
+SDL_Surface *SDL_DuplicateSurface(SDL_Surface *surface)
+{
+    if (!SDL_SurfaceValid(surface)) {
+        SDL_InvalidParamError("surface");
+        return NULL;
+    }
+
+    return SDL_ConvertSurfaceAndColorspace(surface, surface->format, surface->internal->palette, surface->internal->colorspace, surface->internal->props);
+}
+
+SDL_Surface *SDL_ScaleSurface(SDL_Surface *surface, int width, int height, SDL_ScaleMode scaleMode)
+{
+    SDL_Surface *convert = NULL;
+    Uint32 copy_flags;
+    SDL_Color copy_color;
+    bool rc;
+
+    if (!SDL_SurfaceValid(surface)) {
+        SDL_InvalidParamError("surface");
+        goto error;
+    }
+
+    if (SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
+        // We can't directly scale a YUV surface (yet!)
+        SDL_Surface *tmp = SDL_CreateSurface(surface->w, surface->h, SDL_PIXELFORMAT_ARGB8888);
+        if (!tmp) {
+            return NULL;
+        }
+
+        SDL_Surface *scaled = SDL_ScaleSurface(tmp, width, height, scaleMode);
+        SDL_DestroySurface(tmp);
+        if (!scaled) {
+            return NULL;
+        }
+        tmp = scaled;
+
+        SDL_Surface *result = SDL_ConvertSurfaceAndColorspace(tmp, surface->format, NULL, surface->internal->colorspace, surface->internal->props);
+        SDL_DestroySurface(tmp);
+        return result;
+    }
+
+    // Create a new surface with the desired size
+    convert = SDL_CreateSurface(width, height, surface->format);
+    if (!convert) {
+        goto error;
+    }
+    SDL_SetSurfacePalette(convert, surface->internal->palette);
+    SDL_SetSurfaceColorspace(convert, surface->internal->colorspace);
+
+    // Save the original copy flags
+    copy_flags = surface->internal->map.info.flags;
+    copy_color.r = surface->internal->map.info.r;
+    copy_color.g = surface->internal->map.info.g;
+    copy_color.b = surface->internal->map.info.b;
+    copy_color.a = surface->internal->map.info.a;
     surface->internal->map.info.r = 0xFF;
     surface->internal->map.info.g = 0xFF;
     surface->internal->map.info.b = 0xFF;
@@ -1933,509 +3551,1559 @@ SDL_Surface *SDL_ConvertSurfaceAndColorspace(SDL_Surface *surface, SDL_PixelForm
     surface->internal->map.info.flags = (copy_flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
     SDL_InvalidateMap(&surface->internal->map);
 
-    // Copy over the image data
-    bounds.x = 0;
-    bounds.y = 0;
-    bounds.w = surface->w;
-    bounds.h = surface->h;
+    rc = SDL_BlitSurfaceScaled(surface, NULL, convert, NULL, scaleMode);
+
+    // Clean up the original surface, and update converted surface
+    convert->internal->map.info.r = copy_color.r;
+    convert->internal->map.info.g = copy_color.g;
+    convert->internal->map.info.b = copy_color.b;
+    convert->internal->map.info.a = copy_color.a;
+    convert->internal->map.info.flags = (copy_flags & ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
+    surface->internal->map.info.r = copy_color.r;
+    surface->internal->map.info.g = copy_color.g;
+    surface->internal->map.info.b = copy_color.b;
+    surface->internal->map.info.a = copy_color.a;
+    surface->internal->map.info.flags = copy_flags;
+    SDL_InvalidateMap(&surface->internal->map);
+
+    // SDL_BlitSurfaceScaled failed, and so the conversion
+    if (!rc) {
+        goto error;
+    }
+
+    // We're ready to go!
+    return convert;
+
+error:
+    if (convert) {
+        SDL_DestroySurface(convert);
+    }
+    return NULL;
+}
+
+SDL_Surface *SDL_ConvertSurface(SDL_Surface *surface, SDL_PixelFormat format)
+{
+    if (!SDL_SurfaceValid(surface)) {
+        SDL_InvalidParamError("surface");
+        return NULL;
+    }
+
+    return SDL_ConvertSurfaceAndColorspace(surface, format, NULL, SDL_GetDefaultColorspaceForFormat(format), surface->internal->props);
+}
+
+SDL_Surface *SDL_DuplicatePixels(int width, int height, SDL_PixelFormat format, SDL_Colorspace colorspace, void *pixels, int pitch)
+{
+    SDL_Surface *surface = SDL_CreateSurface(width, height, format);
+    if (surface) {
+        int length = width * SDL_BYTESPERPIXEL(format);
+        Uint8 *src = (Uint8 *)pixels;
+        Uint8 *dst = (Uint8 *)surface->pixels;
+        int rows = height;
+        while (rows--) {
+            SDL_memcpy(dst, src, length);
+            dst += surface->pitch;
+            src += pitch;
+        }
+
+        SDL_SetSurfaceColorspace(surface, colorspace);
+    }
+    return surface;
+}
+
+/*
+ * Direct conversion between the packed RGB formats
+ *
+ * Conversions among the 16, 24 and 32-bit RGB formats (4444, 1555, 565, 888,
+ * 8888 and 2101010 in every channel order) that keep the colorspace are done
+ * right here a row at a time, without setting up surfaces and a blit map.
+ * Each channel is expanded to 8 bits the way SDL_GetRGBA() does it and reduced
+ * again the way the blitters do, so the result is the same as the generic
+ * blitter's. Padding bits in the destination are cleared, except in the
+ * 2101010 formats where the blitters set them. Pairs that have a blitter with
+ * its own rounding or padding rules are left to that blitter, see
+ * SDL_SetupConvertPixelsJob().
+ *
+ * When every channel on both sides is 8 bits wide the conversion is a byte
+ * shuffle. Everything else goes through a kernel that isolates each channel
+ * with a mask and shifts, expands it with a multiply and moves it into place
+ * with more shifts and a mask, using constants set up for the pair of formats.
+ * The SIMD versions of that kernel work on 16 and 32-bit pixels, so 24-bit rows
+ * are widened into and narrowed out of a small buffer by the shuffle kernels.
+ */
+
+#define SDL_CONVERT_PIXELS_CHUNK 256
+
+typedef struct SDL_PixelConvertChannel
+{
+    Uint32 src_mask;   // the channel in the source pixel, 0 if the source has none
+    int src_right;     // shifts that line the channel up for expand_mul
+    int src_left;
+    Uint32 expand_mul; // (value * expand_mul) >> 16 is the 8-bit channel
+    int dst_left;      // shifts and mask that put the 8-bit channel c in place
+    int dst_right;
+    Uint32 dst_mask;
+} SDL_PixelConvertChannel;
+
+/* The channels are red, green, blue and alpha. With a 10-bit destination the
+   color channels are stored as (c << 2) | 3 (or 0) and alpha as a * 3 / 255,
+   the way ARGB2101010_FROM_RGBA() does it, using dst_left for the shift and
+   dst_mask for the low bits. */
+typedef struct SDL_PixelConvert
+{
+    int src_bpp;
+    int dst_bpp;
+    bool dst_10bit;
+    Uint32 alpha; // 255 if the source has no alpha channel
+    Uint32 fill;  // bits set in every destination pixel
+    SDL_PixelConvertChannel channels[4];
+} SDL_PixelConvert;
+
+#define SDL_CONVERT_ALPHA_10BIT_MUL 772 // (a * 772) >> 16 is a * 3 / 255
+
+typedef struct SDL_PixelShuffle
+{
+    int src_bpp;
+    int dst_bpp;
+    Uint8 map[16];  // source byte for each destination byte of 4 pixels, 0x80 for none
+    Uint8 fill[16]; // the value of the destination bytes without a source byte, 0 for the others
+} SDL_PixelShuffle;
+
+typedef void (*SDL_ConvertRowFunc)(const SDL_PixelConvert *convert, const Uint8 *src, Uint8 *dst, int width);
+typedef void (*SDL_ShuffleRowFunc)(const SDL_PixelShuffle *shuffle, const Uint8 *src, Uint8 *dst, int width);
+
+typedef struct SDL_ConvertPixelsJob
+{
+    int width;
+    int src_bpp;
+    int dst_bpp;
+    const Uint8 *src;
+    int src_pitch;
+    Uint8 *dst;
+    int dst_pitch;
+    SDL_ShuffleRowFunc shuffle_row; // the whole conversion, if it's a shuffle
+    SDL_PixelShuffle shuffle;
+    SDL_ConvertRowFunc convert_row;
+    SDL_PixelConvert convert;
+    SDL_ShuffleRowFunc widen_row;   // 24-bit source pixels to 32 bits for convert_row
+    SDL_PixelShuffle widen;
+    SDL_ShuffleRowFunc narrow_row;  // 32-bit results to 24-bit destination pixels
+    SDL_PixelShuffle narrow;
+} SDL_ConvertPixelsJob;
+
+static Uint32 SDL_ConvertPixelScalar(const SDL_PixelConvert *convert, Uint32 pixel)
+{
+    Uint32 result = convert->fill;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        const SDL_PixelConvertChannel *channel = &convert->channels[i];
+        Uint32 c = ((pixel & channel->src_mask) >> channel->src_right) << channel->src_left;
+
+        c = (c * channel->expand_mul) >> 16;
+        if (i == 3) {
+            c |= convert->alpha;
+        }
+        if (!convert->dst_10bit) {
+            result |= ((c << channel->dst_left) >> channel->dst_right) & channel->dst_mask;
+        } else if (i < 3) {
+            result |= (c << channel->dst_left) | (c ? channel->dst_mask : 0);
+        } else {
+            result |= (((c * SDL_CONVERT_ALPHA_10BIT_MUL) >> 16) << channel->dst_left) & channel->dst_mask;
+        }
+    }
+    return result;
+}
+
+static void SDL_ConvertRow_Scalar(const SDL_PixelConvert *convert, const Uint8 *src, Uint8 *dst, int width)
+{
+    const int src_bpp = convert->src_bpp;
+    const int dst_bpp = convert->dst_bpp;
+
+    while (width--) {
+        Uint32 pixel;
+
+        RETRIEVE_RGB_PIXEL(src, src_bpp, pixel);
+        pixel = SDL_ConvertPixelScalar(convert, pixel);
+        switch (dst_bpp) {
+        case 2:
+            *(Uint16 *)dst = (Uint16)pixel;
+            break;
+        case 3:
+            if (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+                dst[0] = (Uint8)pixel;
+                dst[1] = (Uint8)(pixel >> 8);
+                dst[2] = (Uint8)(pixel >> 16);
+            } else {
+                dst[0] = (Uint8)(pixel >> 16);
+                dst[1] = (Uint8)(pixel >> 8);
+                dst[2] = (Uint8)pixel;
+            }
+            break;
+        default:
+            *(Uint32 *)dst = pixel;
+            break;
+        }
+        src += src_bpp;
+        dst += dst_bpp;
+    }
+}
+
+static void SDL_ShuffleRow_Scalar(const SDL_PixelShuffle *shuffle, const Uint8 *src, Uint8 *dst, int width)
+{
+    const int src_bpp = shuffle->src_bpp;
+    const int dst_bpp = shuffle->dst_bpp;
+    int i;
+
+    while (width--) {
+        for (i = 0; i < dst_bpp; ++i) {
+            const Uint8 index = shuffle->map[i];
+            dst[i] = (index & 0x80) ? shuffle->fill[i] : src[index];
+        }
+        src += src_bpp;
+        dst += dst_bpp;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+typedef struct SDL_PixelConvertChannel_SSE2
+{
+    __m128i src_mask, src_right, src_left, expand_mul, dst_left, dst_right, dst_mask;
+} SDL_PixelConvertChannel_SSE2;
+
+// Every value stays in the low 16 bits of its 32-bit lane until it's shifted into place
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse2") SDL_ConvertChannel_SSE2(__m128i px, const SDL_PixelConvertChannel_SSE2 *k, __m128i alpha, bool is_alpha, bool dst_10bit)
+{
+    __m128i c = _mm_sll_epi32(_mm_srl_epi32(_mm_and_si128(px, k->src_mask), k->src_right), k->src_left);
+
+    c = _mm_mulhi_epu16(c, k->expand_mul);
+    if (is_alpha) {
+        c = _mm_or_si128(c, alpha);
+    }
+    if (!dst_10bit) {
+        return _mm_and_si128(_mm_srl_epi32(_mm_sll_epi32(c, k->dst_left), k->dst_right), k->dst_mask);
+    } else if (!is_alpha) {
+        return _mm_or_si128(_mm_sll_epi32(c, k->dst_left), _mm_and_si128(_mm_cmpgt_epi32(c, _mm_setzero_si128()), k->dst_mask));
+    } else {
+        c = _mm_mulhi_epu16(c, _mm_set1_epi32(SDL_CONVERT_ALPHA_10BIT_MUL));
+        return _mm_and_si128(_mm_sll_epi32(c, k->dst_left), k->dst_mask);
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("sse2") SDL_ConvertRowBody_SSE2(const SDL_PixelConvert *convert, const Uint8 *src, Uint8 *dst, int width, bool dst_10bit)
+{
+    const __m128i fill = _mm_set1_epi32((int)convert->fill);
+    const __m128i alpha = _mm_set1_epi32((int)convert->alpha);
+    SDL_PixelConvertChannel_SSE2 k[4];
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        const SDL_PixelConvertChannel *channel = &convert->channels[i];
+        k[i].src_mask = _mm_set1_epi32((int)channel->src_mask);
+        k[i].src_right = _mm_cvtsi32_si128(channel->src_right);
+        k[i].src_left = _mm_cvtsi32_si128(channel->src_left);
+        k[i].expand_mul = _mm_set1_epi32((int)channel->expand_mul);
+        k[i].dst_left = _mm_cvtsi32_si128(channel->dst_left);
+        k[i].dst_right = _mm_cvtsi32_si128(channel->dst_right);
+        k[i].dst_mask = _mm_set1_epi32((int)channel->dst_mask);
+    }
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        __m128i px, result;
+
+        if (convert->src_bpp == 4) {
+            px = _mm_loadu_si128((const __m128i *)src);
+        } else {
+            px = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)src), _mm_setzero_si128());
+        }
+        result = _mm_or_si128(fill, SDL_ConvertChannel_SSE2(px, &k[0], alpha, false, dst_10bit));
+        result = _mm_or_si128(result, SDL_ConvertChannel_SSE2(px, &k[1], alpha, false, dst_10bit));
+        result = _mm_or_si128(result, SDL_ConvertChannel_SSE2(px, &k[2], alpha, false, dst_10bit));
+        result = _mm_or_si128(result, SDL_ConvertChannel_SSE2(px, &k[3], alpha, true, dst_10bit));
+        if (convert->dst_bpp == 4) {
+            _mm_storeu_si128((__m128i *)dst, result);
+        } else {
+            // Sign extend the low halves so the saturating pack keeps them intact
+            result = _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+            _mm_storel_epi64((__m128i *)dst, _mm_packs_epi32(result, result));
+        }
+        src += 4 * convert->src_bpp;
+        dst += 4 * convert->dst_bpp;
+    }
+    SDL_ConvertRow_Scalar(convert, src, dst, width - i);
+}
+
+static void SDL_TARGETING("sse2") SDL_ConvertRow_SSE2(const SDL_PixelConvert *convert, const Uint8 *src, Uint8 *dst, int width)
+{
+    if (convert->dst_10bit) {
+        SDL_ConvertRowBody_SSE2(convert, src, dst, width, true);
+    } else {
+        SDL_ConvertRowBody_SSE2(convert, src, dst, width, false);
+    }
+}
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_SSE4_1_INTRINSICS
+static void SDL_TARGETING("sse4.1") SDL_ShuffleRow_SSE41(const SDL_PixelShuffle *shuffle, const Uint8 *src, Uint8 *dst, int width)
+{
+    const __m128i map = _mm_loadu_si128((const __m128i *)shuffle->map);
+    const __m128i fill = _mm_loadu_si128((const __m128i *)shuffle->fill);
+    const int src_bpp = shuffle->src_bpp;
+    const int dst_bpp = shuffle->dst_bpp;
+    // Four 24-bit pixels are 12 bytes, but we load 16
+    const int extra = (src_bpp == 3) ? 2 : 0;
+    int i;
+
+    for (i = 0; i + 4 + extra <= width; i += 4) {
+        const __m128i v = _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)src), map), fill);
+
+        if (dst_bpp == 4) {
+            _mm_storeu_si128((__m128i *)dst, v);
+        } else {
+            const Uint32 last = (Uint32)_mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+            _mm_storel_epi64((__m128i *)dst, v);
+            SDL_memcpy(dst + 8, &last, sizeof(last));
+        }
+        src += 4 * src_bpp;
+        dst += 4 * dst_bpp;
+    }
+    SDL_ShuffleRow_Scalar(shuffle, src, dst, width - i);
+}
+#endif // SDL_SSE4_1_INTRINSICS
+
+#ifdef SDL_AVX2_INTRINSICS
+typedef struct SDL_PixelConvertChannel_AVX2
+{
+    __m256i src_mask, src_right, src_left, expand_mul, dst_left, dst_right, dst_mask;
+} SDL_PixelConvertChannel_AVX2;
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") SDL_ConvertChannel_AVX2(__m256i px, const SDL_PixelConvertChannel_AVX2 *k, __m256i alpha, bool is_alpha, bool dst_10bit)
+{
+    __m256i c = _mm256_sllv_epi32(_mm256_srlv_epi32(_mm256_and_si256(px, k->src_mask), k->src_right), k->src_left);
+
+    c = _mm256_mulhi_epu16(c, k->expand_mul);
+    if (is_alpha) {
+        c = _mm256_or_si256(c, alpha);
+    }
+    if (!dst_10bit) {
+        return _mm256_and_si256(_mm256_srlv_epi32(_mm256_sllv_epi32(c, k->dst_left), k->dst_right), k->dst_mask);
+    } else if (!is_alpha) {
+        return _mm256_or_si256(_mm256_sllv_epi32(c, k->dst_left), _mm256_and_si256(_mm256_cmpgt_epi32(c, _mm256_setzero_si256()), k->dst_mask));
+    } else {
+        c = _mm256_mulhi_epu16(c, _mm256_set1_epi32(SDL_CONVERT_ALPHA_10BIT_MUL));
+        return _mm256_and_si256(_mm256_sllv_epi32(c, k->dst_left), k->dst_mask);
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") SDL_ConvertRowBody_AVX2(const SDL_PixelConvert *convert, const Uint8 *src, Uint8 *dst, int width, bool dst_10bit)
+{
+    const __m256i fill = _mm256_set1_epi32((int)convert->fill);
+    const __m256i alpha = _mm256_set1_epi32((int)convert->alpha);
+    SDL_PixelConvertChannel_AVX2 k[4];
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        const SDL_PixelConvertChannel *channel = &convert->channels[i];
+        k[i].src_mask = _mm256_set1_epi32((int)channel->src_mask);
+        k[i].src_right = _mm256_set1_epi32(channel->src_right);
+        k[i].src_left = _mm256_set1_epi32(channel->src_left);
+        k[i].expand_mul = _mm256_set1_epi32((int)channel->expand_mul);
+        k[i].dst_left = _mm256_set1_epi32(channel->dst_left);
+        k[i].dst_right = _mm256_set1_epi32(channel->dst_right);
+        k[i].dst_mask = _mm256_set1_epi32((int)channel->dst_mask);
+    }
+
+    for (i = 0; i + 8 <= width; i += 8) {
+        __m256i px, result;
+
+        if (convert->src_bpp == 4) {
+            px = _mm256_loadu_si256((const __m256i *)src);
+        } else {
+            px = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+        }
+        result = _mm256_or_si256(fill, SDL_ConvertChannel_AVX2(px, &k[0], alpha, false, dst_10bit));
+        result = _mm256_or_si256(result, SDL_ConvertChannel_AVX2(px, &k[1], alpha, false, dst_10bit));
+        result = _mm256_or_si256(result, SDL_ConvertChannel_AVX2(px, &k[2], alpha, false, dst_10bit));
+        result = _mm256_or_si256(result, SDL_ConvertChannel_AVX2(px, &k[3], alpha, true, dst_10bit));
+        if (convert->dst_bpp == 4) {
+            _mm256_storeu_si256((__m256i *)dst, result);
+        } else {
+            result = _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0x08);
+            _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(result));
+        }
+        src += 8 * convert->src_bpp;
+        dst += 8 * convert->dst_bpp;
+    }
+    SDL_ConvertRow_Scalar(convert, src, dst, width - i);
+}
+
+static void SDL_TARGETING("avx2") SDL_ConvertRow_AVX2(const SDL_PixelConvert *convert, const Uint8 *src, Uint8 *dst, int width)
+{
+    if (convert->dst_10bit) {
+        SDL_ConvertRowBody_AVX2(convert, src, dst, width, true);
+    } else {
+        SDL_ConvertRowBody_AVX2(convert, src, dst, width, false);
+    }
+}
+#endif // SDL_AVX2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+typedef struct SDL_PixelConvertChannel_NEON
+{
+    uint32x4_t src_mask, expand_mul, dst_mask;
+    int32x4_t src_shift, dst_shift;
+} SDL_PixelConvertChannel_NEON;
+
+SDL_FORCE_INLINE uint32x4_t SDL_ConvertChannel_NEON(uint32x4_t px, const SDL_PixelConvertChannel_NEON *k, uint32x4_t alpha, bool is_alpha, bool dst_10bit)
+{
+    uint32x4_t c = vshlq_u32(vandq_u32(px, k->src_mask), k->src_shift);
+
+    c = vshrq_n_u32(vmulq_u32(c, k->expand_mul), 16);
+    if (is_alpha) {
+        c = vorrq_u32(c, alpha);
+    }
+    if (!dst_10bit) {
+        return vandq_u32(vshlq_u32(c, k->dst_shift), k->dst_mask);
+    } else if (!is_alpha) {
+        return vorrq_u32(vshlq_u32(c, k->dst_shift), vandq_u32(vtstq_u32(c, c), k->dst_mask));
+    } else {
+        c = vshrq_n_u32(vmulq_n_u32(c, SDL_CONVERT_ALPHA_10BIT_MUL), 16);
+        return vandq_u32(vshlq_u32(c, k->dst_shift), k->dst_mask);
+    }
+}
+
+SDL_FORCE_INLINE void SDL_ConvertRowBody_NEON(const SDL_PixelConvert *convert, const Uint8 *src, Uint8 *dst, int width, bool dst_10bit)
+{
+    const uint32x4_t fill = vdupq_n_u32(convert->fill);
+    const uint32x4_t alpha = vdupq_n_u32(convert->alpha);
+    SDL_PixelConvertChannel_NEON k[4];
+    int i;
 
-    /* Source surface has a palette with no real alpha (0 or OPAQUE).
-     * Destination format has alpha.
-     * -> set alpha channel to be opaque */
-    if (surface->internal->palette && SDL_ISPIXELFORMAT_ALPHA(format)) {
-        bool set_opaque = false;
+    for (i = 0; i < 4; ++i) {
+        const SDL_PixelConvertChannel *channel = &convert->channels[i];
+        k[i].src_mask = vdupq_n_u32(channel->src_mask);
+        k[i].src_shift = vdupq_n_s32(channel->src_left - channel->src_right);
+        k[i].expand_mul = vdupq_n_u32(channel->expand_mul);
+        k[i].dst_shift = vdupq_n_s32(channel->dst_left - channel->dst_right);
+        k[i].dst_mask = vdupq_n_u32(channel->dst_mask);
+    }
 
-        bool is_opaque, has_alpha_channel;
-        SDL_DetectPalette(surface->internal->palette, &is_opaque, &has_alpha_channel);
+    for (i = 0; i + 4 <= width; i += 4) {
+        uint32x4_t px, result;
+
+        if (convert->src_bpp == 4) {
+            px = vld1q_u32((const uint32_t *)src);
+        } else {
+            px = vmovl_u16(vld1_u16((const uint16_t *)src));
+        }
+        result = vorrq_u32(fill, SDL_ConvertChannel_NEON(px, &k[0], alpha, false, dst_10bit));
+        result = vorrq_u32(result, SDL_ConvertChannel_NEON(px, &k[1], alpha, false, dst_10bit));
+        result = vorrq_u32(result, SDL_ConvertChannel_NEON(px, &k[2], alpha, false, dst_10bit));
+        result = vorrq_u32(result, SDL_ConvertChannel_NEON(px, &k[3], alpha, true, dst_10bit));
+        if (convert->dst_bpp == 4) {
+            vst1q_u32((uint32_t *)dst, result);
+        } else {
+            vst1_u16((uint16_t *)dst, vmovn_u32(result));
+        }
+        src += 4 * convert->src_bpp;
+        dst += 4 * convert->dst_bpp;
+    }
+    SDL_ConvertRow_Scalar(convert, src, dst, width - i);
+}
+
+static void SDL_ConvertRow_NEON(const SDL_PixelConvert *convert, const Uint8 *src, Uint8 *dst, int width)
+{
+    if (convert->dst_10bit) {
+        SDL_ConvertRowBody_NEON(convert, src, dst, width, true);
+    } else {
+        SDL_ConvertRowBody_NEON(convert, src, dst, width, false);
+    }
+}
+
+static void SDL_ShuffleRow_NEON(const SDL_PixelShuffle *shuffle, const Uint8 *src, Uint8 *dst, int width)
+{
+    const uint8x16_t map = vld1q_u8(shuffle->map);
+    const uint8x16_t fill = vld1q_u8(shuffle->fill);
+    const int src_bpp = shuffle->src_bpp;
+    const int dst_bpp = shuffle->dst_bpp;
+    // Four 24-bit pixels are 12 bytes, but we load 16
+    const int extra = (src_bpp == 3) ? 2 : 0;
+    int i;
+
+    for (i = 0; i + 4 + extra <= width; i += 4) {
+        const uint8x16_t px = vld1q_u8(src);
+        uint8x16_t v;
+#if defined(__aarch64__) || defined(_M_ARM64)
+        v = vqtbl1q_u8(px, map);
+#else
+        uint8x8x2_t table;
+        table.val[0] = vget_low_u8(px);
+        table.val[1] = vget_high_u8(px);
+        v = vcombine_u8(vtbl2_u8(table, vget_low_u8(map)), vtbl2_u8(table, vget_high_u8(map)));
+#endif
+        v = vorrq_u8(v, fill);
+
+        if (dst_bpp == 4) {
+            vst1q_u8(dst, v);
+        } else {
+            const Uint32 last = vgetq_lane_u32(vreinterpretq_u32_u8(v), 2);
+            vst1_u8(dst, vget_low_u8(v));
+            SDL_memcpy(dst + 8, &last, sizeof(last));
+        }
+        src += 4 * src_bpp;
+        dst += 4 * dst_bpp;
+    }
+    SDL_ShuffleRow_Scalar(shuffle, src, dst, width - i);
+}
+#endif // SDL_NEON_INTRINSICS
+
+static SDL_ConvertRowFunc SDL_GetConvertRowFunc(void)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return SDL_ConvertRow_AVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_ConvertRow_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_ConvertRow_NEON;
+    }
+#endif
+    return SDL_ConvertRow_Scalar;
+}
+
+static SDL_ShuffleRowFunc SDL_GetShuffleRowFunc(void)
+{
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (SDL_HasSSE41()) {
+        return SDL_ShuffleRow_SSE41;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_ShuffleRow_NEON;
+    }
+#endif
+    return SDL_ShuffleRow_Scalar;
+}
+
+static bool SDL_IsDirectConvertFormat(SDL_PixelFormat format)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_XRGB4444:
+    case SDL_PIXELFORMAT_XBGR4444:
+    case SDL_PIXELFORMAT_ARGB4444:
+    case SDL_PIXELFORMAT_RGBA4444:
+    case SDL_PIXELFORMAT_ABGR4444:
+    case SDL_PIXELFORMAT_BGRA4444:
+    case SDL_PIXELFORMAT_XRGB1555:
+    case SDL_PIXELFORMAT_XBGR1555:
+    case SDL_PIXELFORMAT_ARGB1555:
+    case SDL_PIXELFORMAT_RGBA5551:
+    case SDL_PIXELFORMAT_ABGR1555:
+    case SDL_PIXELFORMAT_BGRA5551:
+    case SDL_PIXELFORMAT_RGB565:
+    case SDL_PIXELFORMAT_BGR565:
+    case SDL_PIXELFORMAT_RGB24:
+    case SDL_PIXELFORMAT_BGR24:
+    case SDL_PIXELFORMAT_XRGB8888:
+    case SDL_PIXELFORMAT_RGBX8888:
+    case SDL_PIXELFORMAT_XBGR8888:
+    case SDL_PIXELFORMAT_BGRX8888:
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+    case SDL_PIXELFORMAT_XRGB2101010:
+    case SDL_PIXELFORMAT_XBGR2101010:
+    case SDL_PIXELFORMAT_ARGB2101010:
+    case SDL_PIXELFORMAT_ABGR2101010:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Offset of the byte holding bits [shift, shift + 8) of a pixel in memory
+static int SDL_GetPixelByteOffset(int shift, int bpp)
+{
+    if (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+        return shift / 8;
+    } else {
+        return bpp - 1 - shift / 8;
+    }
+}
+
+// Sets up a shuffle that moves byte `shift / 8` of each pixel value, or takes the byte from fill if shifts[i] is negative
+static void SDL_SetupPixelShuffle(SDL_PixelShuffle *shuffle, int src_bpp, int dst_bpp, const int shifts[4], Uint32 fill)
+{
+    int i, j;
+
+    shuffle->src_bpp = src_bpp;
+    shuffle->dst_bpp = dst_bpp;
+    SDL_memset(shuffle->map, 0x80, sizeof(shuffle->map));
+    SDL_zeroa(shuffle->fill);
+    for (i = 0; i < 4; ++i) {
+        for (j = 0; j < dst_bpp; ++j) {
+            const int byte = SDL_GetPixelByteOffset(j * 8, dst_bpp);
+            const int shift = shifts[byte];
+            if (shift >= 0) {
+                shuffle->map[i * dst_bpp + j] = (Uint8)(i * src_bpp + SDL_GetPixelByteOffset(shift, src_bpp));
+            } else {
+                shuffle->fill[i * dst_bpp + j] = (Uint8)(fill >> (byte * 8));
+            }
+        }
+    }
+}
+
+static void SDL_SetupPixelConvertChannel(SDL_PixelConvertChannel *channel, int src_bits, int src_shift, bool src_10bit, int dst_bits, int dst_shift, bool dst_10bit, bool alpha)
+{
+    /* floor(value * 255 / max), see SDL_expand_byte, is the top 16 bits of
+       (value << (16 - bits - expand_shift)) * expand_mul */
+    static const Uint16 expand_mul[] = { 0, 0x1fe, 0x154, 0x247, 0x110, 0x41d, 0x1031, 0x4041, 0x100 };
+    static const Uint8 expand_shift[] = { 0, 0, 0, 1, 0, 2, 4, 6, 0 };
+    int shift;
+
+    SDL_zerop(channel);
+
+    if (src_bits) {
+        channel->src_mask = ((1u << src_bits) - 1) << src_shift;
+        if (src_10bit && !alpha) {
+            // The 8-bit channel is the top 8 bits of the 10-bit one
+            channel->expand_mul = 0x100;
+            shift = 16 - src_bits;
+        } else {
+            channel->expand_mul = expand_mul[src_bits];
+            shift = 16 - src_bits - expand_shift[src_bits];
+        }
+        shift -= src_shift;
+        if (shift >= 0) {
+            channel->src_left = shift;
+        } else {
+            channel->src_right = -shift;
+        }
+    }
+
+    if (!dst_bits) {
+        return;
+    }
+    if (dst_10bit) {
+        if (alpha) {
+            channel->dst_left = dst_shift;
+            channel->dst_mask = 0x3u << dst_shift;
+        } else {
+            channel->dst_left = dst_shift + 2;
+            channel->dst_mask = 0x3u << dst_shift;
+        }
+        return;
+    }
+    // c >> (8 - dst_bits) << dst_shift
+    shift = dst_shift - (8 - dst_bits);
+    if (shift >= 0) {
+        channel->dst_left = shift;
+    } else {
+        channel->dst_right = -shift;
+    }
+    channel->dst_mask = ((1u << dst_bits) - 1) << dst_shift;
+}
+
+static bool SDL_SetupConvertPixelsJob(SDL_ConvertPixelsJob *job, SDL_PixelFormat src_format, SDL_PixelFormat dst_format)
+{
+    const SDL_PixelFormatDetails *src_fmt;
+    const SDL_PixelFormatDetails *dst_fmt;
+    Uint8 src_bits[4], src_shift[4], dst_bits[4], dst_shift[4];
+    Uint32 dst_used;
+    bool src_10bit, dst_10bit, bytes = true;
+    int i;
+
+    if (!SDL_IsDirectConvertFormat(src_format) || !SDL_IsDirectConvertFormat(dst_format)) {
+        return false;
+    }
+    src_fmt = SDL_GetPixelFormatDetails(src_format);
+    dst_fmt = SDL_GetPixelFormatDetails(dst_format);
+    if (!src_fmt || !dst_fmt) {
+        return false;
+    }
+    src_10bit = SDL_ISPIXELFORMAT_10BIT(src_format);
+    dst_10bit = SDL_ISPIXELFORMAT_10BIT(dst_format);
+
+    /* These have blitters of their own, and the result has to be the same as theirs:
+       RGB565 to 8888 goes through a lookup table with its own rounding of green, and the
+       8-bit RGB to XRGB8888 / XBGR8888 byte copies leave the padding byte as it was. */
+    if (src_format == SDL_PIXELFORMAT_RGB565 && dst_fmt->bytes_per_pixel == 4 && !dst_10bit) {
+        return false;
+    }
+    if ((dst_format == SDL_PIXELFORMAT_XRGB8888 || dst_format == SDL_PIXELFORMAT_XBGR8888) &&
+        src_fmt->bytes_per_pixel >= 3 && !src_10bit) {
+        return false;
+    }
+
+    src_bits[0] = src_fmt->Rbits;
+    src_bits[1] = src_fmt->Gbits;
+    src_bits[2] = src_fmt->Bbits;
+    src_bits[3] = src_fmt->Abits;
+    src_shift[0] = src_fmt->Rshift;
+    src_shift[1] = src_fmt->Gshift;
+    src_shift[2] = src_fmt->Bshift;
+    src_shift[3] = src_fmt->Ashift;
+    dst_bits[0] = dst_fmt->Rbits;
+    dst_bits[1] = dst_fmt->Gbits;
+    dst_bits[2] = dst_fmt->Bbits;
+    dst_bits[3] = dst_fmt->Abits;
+    dst_shift[0] = dst_fmt->Rshift;
+    dst_shift[1] = dst_fmt->Gshift;
+    dst_shift[2] = dst_fmt->Bshift;
+    dst_shift[3] = dst_fmt->Ashift;
+
+    job->src_bpp = src_fmt->bytes_per_pixel;
+    job->dst_bpp = dst_fmt->bytes_per_pixel;
+    job->shuffle_row = NULL;
+    job->widen_row = NULL;
+    job->narrow_row = NULL;
+
+    for (i = 0; i < 4; ++i) {
+        if ((src_bits[i] != 0 && src_bits[i] != 8) || (dst_bits[i] != 0 && dst_bits[i] != 8)) {
+            bytes = false;
+        }
+    }
+    if (bytes && job->src_bpp >= 3 && job->dst_bpp >= 3) {
+        // Every destination byte is a source byte, opaque alpha or zero padding
+        int shifts[4] = { -1, -1, -1, -1 };
+
+        for (i = 0; i < 4; ++i) {
+            if (dst_bits[i] && src_bits[i]) {
+                shifts[dst_shift[i] / 8] = src_shift[i];
+            }
+        }
+        SDL_SetupPixelShuffle(&job->shuffle, job->src_bpp, job->dst_bpp, shifts, src_bits[3] ? 0 : dst_fmt->Amask);
+        job->shuffle_row = SDL_GetShuffleRowFunc();
+        return true;
+    }
+
+    job->convert.src_bpp = job->src_bpp;
+    job->convert.dst_bpp = job->dst_bpp;
+    job->convert.dst_10bit = dst_10bit;
+    job->convert.alpha = src_bits[3] ? 0 : 255;
+    if (dst_10bit) {
+        dst_used = dst_fmt->Rmask | dst_fmt->Gmask | dst_fmt->Bmask | dst_fmt->Amask;
+        job->convert.fill = ~dst_used;
+    } else {
+        job->convert.fill = 0;
+    }
+    for (i = 0; i < 4; ++i) {
+        SDL_SetupPixelConvertChannel(&job->convert.channels[i], src_bits[i], src_shift[i], src_10bit, dst_bits[i], dst_shift[i], dst_10bit, (i == 3));
+    }
+    job->convert_row = SDL_GetConvertRowFunc();
+
+    if (job->convert_row != SDL_ConvertRow_Scalar) {
+        // The SIMD kernels handle 16 and 32-bit pixels, 24-bit pixels are moved through 32-bit ones
+        static const int low_bytes[4] = { 0, 8, 16, -1 };
+
+        if (job->src_bpp == 3) {
+            SDL_SetupPixelShuffle(&job->widen, 3, 4, low_bytes, 0);
+            job->widen_row = SDL_GetShuffleRowFunc();
+            job->convert.src_bpp = 4;
+        }
+        if (job->dst_bpp == 3) {
+            SDL_SetupPixelShuffle(&job->narrow, 4, 3, low_bytes, 0);
+            job->narrow_row = SDL_GetShuffleRowFunc();
+            job->convert.dst_bpp = 4;
+        }
+    }
+    return true;
+}
+
+static void SDL_ConvertPixelsRows(void *userdata, int y, int h)
+{
+    const SDL_ConvertPixelsJob *job = (const SDL_ConvertPixelsJob *)userdata;
+    const Uint8 *src = job->src + (ptrdiff_t)y * job->src_pitch;
+    Uint8 *dst = job->dst + (ptrdiff_t)y * job->dst_pitch;
+    Uint32 buffer[SDL_CONVERT_PIXELS_CHUNK];
+    int x;
+
+    for (; h--; src += job->src_pitch, dst += job->dst_pitch) {
+        if (job->shuffle_row) {
+            job->shuffle_row(&job->shuffle, src, dst, job->width);
+            continue;
+        }
+        if (!job->widen_row && !job->narrow_row) {
+            job->convert_row(&job->convert, src, dst, job->width);
+            continue;
+        }
+
+        for (x = 0; x < job->width; x += SDL_CONVERT_PIXELS_CHUNK) {
+            const int count = SDL_min(job->width - x, SDL_CONVERT_PIXELS_CHUNK);
+            const Uint8 *in = src + (size_t)x * job->src_bpp;
+            Uint8 *out = dst + (size_t)x * job->dst_bpp;
+
+            if (job->widen_row) {
+                job->widen_row(&job->widen, in, (Uint8 *)buffer, count);
+                in = (const Uint8 *)buffer;
+            }
+            if (job->narrow_row) {
+                job->convert_row(&job->convert, in, (Uint8 *)buffer, count);
+                job->narrow_row(&job->narrow, (const Uint8 *)buffer, out, count);
+            } else {
+                job->convert_row(&job->convert, in, out, count);
+            }
+        }
+    }
+}
+
+/* Converts between two of the formats in SDL_IsDirectConvertFormat() with the same colorspace.
+   Returns false without touching dst if the formats aren't handled here. */
+static bool SDL_ConvertPixelsDirect(int width, int height, SDL_PixelFormat src_format, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch)
+{
+    SDL_ConvertPixelsJob job;
+
+    if (width <= 0 || height <= 0 || !SDL_SetupConvertPixelsJob(&job, src_format, dst_format)) {
+        return false;
+    }
+    job.width = width;
+    job.src = (const Uint8 *)src;
+    job.src_pitch = src_pitch;
+    job.dst = (Uint8 *)dst;
+    job.dst_pitch = dst_pitch;
+
+    // Converting in place has to go from top to bottom
+    if (src == dst || !SDL_RunBlitRowsParallel(width, height, SDL_ConvertPixelsRows, &job)) {
+        SDL_ConvertPixelsRows(&job, 0, height);
+    }
+    return true;
+}
+
+bool SDL_ConvertPixelsAndColorspace(int width, int height,
+                      SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
+                      SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
+{
+    SDL_InternalSurface src_data, dst_data;
+    SDL_Surface *src_surface;
+    SDL_Surface *dst_surface;
+    SDL_Rect rect;
+    void *nonconst_src = (void *)src;
+    bool result;
+
+    if (!src) {
+        return SDL_InvalidParamError("src");
+    }
+    if (!src_pitch) {
+        return SDL_InvalidParamError("src_pitch");
+    }
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+    if (!dst_pitch) {
+        return SDL_InvalidParamError("dst_pitch");
+    }
+
+    if (src_colorspace == SDL_COLORSPACE_UNKNOWN) {
+        src_colorspace = SDL_GetDefaultColorspaceForFormat(src_format);
+    }
+    if (dst_colorspace == SDL_COLORSPACE_UNKNOWN) {
+        dst_colorspace = SDL_GetDefaultColorspaceForFormat(dst_format);
+    }
+
+#if SDL_HAVE_YUV
+    if (SDL_ISPIXELFORMAT_FOURCC(src_format) && SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
+        return SDL_ConvertPixels_YUV_to_YUV(width, height, src_format, src_colorspace, src_properties, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    } else if (SDL_ISPIXELFORMAT_FOURCC(src_format)) {
+        return SDL_ConvertPixels_YUV_to_RGB(width, height, src_format, src_colorspace, src_properties, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    } else if (SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
+        return SDL_ConvertPixels_RGB_to_YUV(width, height, src_format, src_colorspace, src_properties, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    }
+#else
+    if (SDL_ISPIXELFORMAT_FOURCC(src_format) || SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
+        return SDL_SetError("SDL not built with YUV support");
+    }
+#endif
+
+    // Fast path for same format copy
+    if (src_format == dst_format && src_colorspace == dst_colorspace) {
+        int i;
+        const int bpp = SDL_BYTESPERPIXEL(src_format);
+        width *= bpp;
+        for (i = height; i--;) {
+            SDL_memcpy(dst, src, width);
+            src = (const Uint8 *)src + src_pitch;
+            dst = (Uint8 *)dst + dst_pitch;
+        }
+        return true;
+    }
+
+    // Fast path for conversions between the packed RGB formats
+    if (src_colorspace == dst_colorspace &&
+        SDL_ConvertPixelsDirect(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch)) {
+        return true;
+    }
+
+    src_surface = SDL_InitializeSurface(&src_data, width, height, src_format, src_colorspace, src_properties, nonconst_src, src_pitch, true);
+    if (!src_surface) {
+        return false;
+    }
+    SDL_SetSurfaceBlendMode(src_surface, SDL_BLENDMODE_NONE);
+
+    dst_surface = SDL_InitializeSurface(&dst_data, width, height, dst_format, dst_colorspace, dst_properties, dst, dst_pitch, true);
+    if (!dst_surface) {
+        return false;
+    }
+
+    // Set up the rect and go!
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = width;
+    rect.h = height;
+    result = SDL_BlitSurfaceUnchecked(src_surface, &rect, dst_surface, &rect);
+
+    SDL_DestroySurface(src_surface);
+    SDL_DestroySurface(dst_surface);
+
+    return result;
+}
+
+bool SDL_ConvertPixels(int width, int height, SDL_PixelFormat src_format, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch)
+{
+    return SDL_ConvertPixelsAndColorspace(width, height,
+                      src_format, SDL_COLORSPACE_UNKNOWN, 0, src, src_pitch,
+                      dst_format, SDL_COLORSPACE_UNKNOWN, 0, dst, dst_pitch);
+}
+
+/*
+ * Premultiply the alpha on a block of pixels
+ *
+ * The work is done a row at a time by kernels that only care where the alpha
+ * channel sits in the 32-bit pixel, so the same code handles ARGB/ABGR (alpha
+ * in the high byte) and RGBA/BGRA (alpha in the low byte). The SIMD kernels
+ * produce exactly the same results as the scalar ones and hand any leftover
+ * pixels at the end of a row to them.
+ *
+ * Here are some ideas for optimization:
+ * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
+ * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
+ */
+
+typedef void (*SDL_PremultiplyRowFunc)(const void *src, void *dst, int width, int alpha_shift);
+
+#define PREMULTIPLY_LINEAR_BITS 14
+
+/* The SIMD kernels unpremultiply 8-bit channels using a refined reciprocal of
+ * alpha instead of a division. The exact quotient c * 255 / a + 0.5 is either
+ * an integer or at least 1/510 away from one, so adding a small bias before
+ * truncating gives the same result as the integer division.
+ */
+#define UNPREMULTIPLY_BIAS (0.5f + 1.0f / 1024.0f)
+
+// sRGB to linear in 16.16 fixed point, and linear back to sRGB in 14 bits
+static Uint32 SDL_PremultiplyToLinear[256];
+static Uint8 SDL_PremultiplyFromLinear[(1 << PREMULTIPLY_LINEAR_BITS) + 1];
 
-        if (is_opaque) {
-            if (!has_alpha_channel) {
-                set_opaque = true;
-            }
-        }
+static void SDL_SetupPremultiplyLinearTables(void)
+{
+    static SDL_InitState init;
+    int i;
 
-        // Set opaque and backup palette alpha values
-        if (set_opaque) {
-            int i;
-            palette_saved_alpha_ncolors = surface->internal->palette->ncolors;
-            if (palette_saved_alpha_ncolors > 0) {
-                palette_saved_alpha = SDL_stack_alloc(Uint8, palette_saved_alpha_ncolors);
-                for (i = 0; i < palette_saved_alpha_ncolors; i++) {
-                    palette_saved_alpha[i] = surface->internal->palette->colors[i].a;
-                    surface->internal->palette->colors[i].a = SDL_ALPHA_OPAQUE;
-                }
-            }
-        }
+    if (!SDL_ShouldInit(&init)) {
+        return;
     }
 
-    // Transform colorkey to alpha. for cases where source palette has duplicate values, and colorkey is one of them
-    if (copy_flags & SDL_COPY_COLORKEY) {
-        if (surface->internal->palette && !palette) {
-            palette_ck_transform = true;
-            palette_ck_value = surface->internal->palette->colors[surface->internal->map.info.colorkey].a;
-            surface->internal->palette->colors[surface->internal->map.info.colorkey].a = SDL_ALPHA_TRANSPARENT;
-        }
+    for (i = 0; i < SDL_arraysize(SDL_PremultiplyToLinear); ++i) {
+        SDL_PremultiplyToLinear[i] = (Uint32)SDL_lroundf(SDL_sRGBtoLinear((float)i / 255.0f) * 65536.0f);
+    }
+    for (i = 0; i < SDL_arraysize(SDL_PremultiplyFromLinear); ++i) {
+        SDL_PremultiplyFromLinear[i] = (Uint8)SDL_lroundf(SDL_sRGBfromLinear((float)i / (1 << PREMULTIPLY_LINEAR_BITS)) * 255.0f);
     }
 
-    result = SDL_BlitSurfaceUnchecked(surface, &bounds, convert, &bounds);
+    SDL_SetInitialized(&init, true);
+}
 
-    // Restore colorkey alpha value
-    if (palette_ck_transform) {
-        surface->internal->palette->colors[surface->internal->map.info.colorkey].a = palette_ck_value;
-    }
+static SDL_INLINE Uint32 SDL_PremultiplyLinearToSRGB(Uint32 v)
+{
+    return SDL_PremultiplyFromLinear[(v + (1 << (16 - PREMULTIPLY_LINEAR_BITS - 1))) >> (16 - PREMULTIPLY_LINEAR_BITS)];
+}
 
-    // Restore palette alpha values
-    if (palette_saved_alpha) {
-        int i;
-        for (i = 0; i < palette_saved_alpha_ncolors; i++) {
-            surface->internal->palette->colors[i].a = palette_saved_alpha[i];
-        }
-        SDL_stack_free(palette_saved_alpha);
-    }
+// floor(x / 255) in each 16-bit half, for x <= 255 * 255
+static SDL_INLINE Uint32 SDL_PremultiplyDiv255x2(Uint32 x)
+{
+    return ((x + 0x00010001 + ((x >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+}
 
-    // Clean up the original surface, and update converted surface
-    convert->internal->map.info.r = copy_color.r;
-    convert->internal->map.info.g = copy_color.g;
-    convert->internal->map.info.b = copy_color.b;
-    convert->internal->map.info.a = copy_color.a;
-    convert->internal->map.info.flags =
-        (copy_flags &
-         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND | SDL_COPY_RLE_DESIRED | SDL_COPY_RLE_COLORKEY |
-           SDL_COPY_RLE_ALPHAKEY));
-    surface->internal->map.info.r = copy_color.r;
-    surface->internal->map.info.g = copy_color.g;
-    surface->internal->map.info.b = copy_color.b;
-    surface->internal->map.info.a = copy_color.a;
-    surface->internal->map.info.flags = copy_flags;
-    SDL_InvalidateMap(&surface->internal->map);
+static void SDL_PremultiplyAlphaRow_8888(const void *src, void *dst, int width, int alpha_shift)
+{
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const Uint32 amask = 0xFFu << alpha_shift;
+    int c;
 
-    // SDL_BlitSurfaceUnchecked failed, and so the conversion
-    if (!result) {
-        goto error;
-    }
+    for (c = width; c; --c) {
+        const Uint32 srcpixel = *src_px++;
+        const Uint32 srcA = (srcpixel >> alpha_shift) & 0xFF;
 
-    if (copy_flags & SDL_COPY_COLORKEY) {
-        bool set_colorkey_by_color = false;
-        bool convert_colorkey = true;
+        // Two channels per multiply, then put the original alpha back
+        const Uint32 even = SDL_PremultiplyDiv255x2((srcpixel & 0x00FF00FF) * srcA);
+        const Uint32 odd = SDL_PremultiplyDiv255x2(((srcpixel >> 8) & 0x00FF00FF) * srcA);
+        *dst_px++ = ((even | (odd << 8)) & ~amask) | (srcpixel & amask);
+    }
+}
 
-        if (surface->internal->palette) {
-            if (palette &&
-                surface->internal->palette->ncolors <= palette->ncolors &&
-                (SDL_memcmp(surface->internal->palette->colors, palette->colors,
-                            surface->internal->palette->ncolors * sizeof(SDL_Color)) == 0)) {
-                // The palette is identical, just set the same colorkey
-                SDL_SetSurfaceColorKey(convert, true, surface->internal->map.info.colorkey);
-            } else if (!palette) {
-                if (SDL_ISPIXELFORMAT_ALPHA(format)) {
-                    // No need to add the colorkey, transparency is in the alpha channel
-                } else {
-                    // Only set the colorkey information
-                    set_colorkey_by_color = true;
-                    convert_colorkey = false;
+static void SDL_UnpremultiplyAlphaRow_8888(const void *src, void *dst, int width, int alpha_shift)
+{
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const Uint32 amask = 0xFFu << alpha_shift;
+    int c, shift;
+
+    for (c = width; c; --c) {
+        const Uint32 srcpixel = *src_px++;
+        const Uint32 srcA = (srcpixel >> alpha_shift) & 0xFF;
+        Uint32 dstpixel = (srcpixel & amask);
+
+        if (srcA) {
+            for (shift = 0; shift < 32; shift += 8) {
+                if (shift != alpha_shift) {
+                    const Uint32 srcC = (srcpixel >> shift) & 0xFF;
+                    dstpixel |= SDL_min((srcC * 255 + srcA / 2) / srcA, 255) << shift;
                 }
-            } else {
-                set_colorkey_by_color = true;
             }
-        } else {
-            set_colorkey_by_color = true;
         }
+        *dst_px++ = dstpixel;
+    }
+}
 
-        if (set_colorkey_by_color) {
-            SDL_Surface *tmp;
-            SDL_Surface *tmp2;
-            int converted_colorkey = 0;
-
-            // Create a dummy surface to get the colorkey converted
-            tmp = SDL_CreateSurface(1, 1, surface->format);
-            if (!tmp) {
-                goto error;
-            }
-
-            // Share the palette, if any
-            if (surface->internal->palette) {
-                SDL_SetSurfacePalette(tmp, surface->internal->palette);
+static void SDL_PremultiplyAlphaRow_8888_Linear(const void *src, void *dst, int width, int alpha_shift)
+{
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const Uint32 amask = 0xFFu << alpha_shift;
+    int c, shift;
+
+    for (c = width; c; --c) {
+        const Uint32 srcpixel = *src_px++;
+        const Uint32 srcA = (srcpixel >> alpha_shift) & 0xFF;
+        Uint32 dstpixel = (srcpixel & amask);
+
+        for (shift = 0; shift < 32; shift += 8) {
+            if (shift != alpha_shift) {
+                const Uint32 srcC = SDL_PremultiplyToLinear[(srcpixel >> shift) & 0xFF];
+                dstpixel |= SDL_PremultiplyLinearToSRGB((srcC * srcA + 127) / 255) << shift;
             }
+        }
+        *dst_px++ = dstpixel;
+    }
+}
 
-            SDL_FillSurfaceRect(tmp, NULL, surface->internal->map.info.colorkey);
-
-            tmp->internal->map.info.flags &= ~SDL_COPY_COLORKEY;
-
-            // Conversion of the colorkey
-            tmp2 = SDL_ConvertSurfaceAndColorspace(tmp, format, palette, colorspace, props);
-            if (!tmp2) {
-                SDL_DestroySurface(tmp);
-                goto error;
+static void SDL_UnpremultiplyAlphaRow_8888_Linear(const void *src, void *dst, int width, int alpha_shift)
+{
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const Uint32 amask = 0xFFu << alpha_shift;
+    int c, shift;
+
+    for (c = width; c; --c) {
+        const Uint32 srcpixel = *src_px++;
+        const Uint32 srcA = (srcpixel >> alpha_shift) & 0xFF;
+        Uint32 dstpixel = (srcpixel & amask);
+
+        if (srcA) {
+            for (shift = 0; shift < 32; shift += 8) {
+                if (shift != alpha_shift) {
+                    const Uint32 srcC = SDL_PremultiplyToLinear[(srcpixel >> shift) & 0xFF];
+                    dstpixel |= SDL_PremultiplyLinearToSRGB(SDL_min((srcC * 255 + srcA / 2) / srcA, 65536)) << shift;
+                }
             }
+        }
+        *dst_px++ = dstpixel;
+    }
+}
 
-            // Get the converted colorkey
-            SDL_memcpy(&converted_colorkey, tmp2->pixels, tmp2->internal->format->bytes_per_pixel);
-
-            SDL_DestroySurface(tmp);
-            SDL_DestroySurface(tmp2);
+static void SDL_PremultiplyAlphaRow_AXYZ128(const void *src, void *dst, int width, int alpha_shift)
+{
+    const float *src_px = (const float *)src;
+    float *dst_px = (float *)dst;
+    int c;
+    float flR, flG, flB, flA;
 
-            // Set the converted colorkey on the new surface
-            SDL_SetSurfaceColorKey(convert, true, converted_colorkey);
+    for (c = width; c; --c) {
+        flA = *src_px++;
+        flR = *src_px++;
+        flG = *src_px++;
+        flB = *src_px++;
 
-            // This is needed when converting for 3D texture upload
-            if (convert_colorkey) {
-                SDL_ConvertColorkeyToAlpha(convert, true);
-            }
-        }
-    }
+        // Alpha pre-multiplication of each component.
+        flR *= flA;
+        flG *= flA;
+        flB *= flA;
 
-end:
-    if (temp_palette) {
-        SDL_DestroyPalette(temp_palette);
+        *dst_px++ = flA;
+        *dst_px++ = flR;
+        *dst_px++ = flG;
+        *dst_px++ = flB;
     }
+}
 
-    SDL_SetSurfaceClipRect(convert, &surface->internal->clip_rect);
+static void SDL_UnpremultiplyAlphaRow_AXYZ128(const void *src, void *dst, int width, int alpha_shift)
+{
+    const float *src_px = (const float *)src;
+    float *dst_px = (float *)dst;
+    int c;
+    float flR, flG, flB, flA;
 
-    /* Enable alpha blending by default if the new surface has an
-     * alpha channel or alpha modulation */
-    if (SDL_ISPIXELFORMAT_ALPHA(format) ||
-        (copy_flags & SDL_COPY_MODULATE_ALPHA)) {
-        SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND);
-    }
-    if (copy_flags & SDL_COPY_RLE_DESIRED) {
-        SDL_SetSurfaceRLE(convert, true);
-    }
+    for (c = width; c; --c) {
+        flA = *src_px++;
+        flR = *src_px++;
+        flG = *src_px++;
+        flB = *src_px++;
 
-    // Copy alternate images
-    for (int i = 0; i < surface->internal->num_images; ++i) {
-        if (!SDL_AddSurfaceAlternateImage(convert, surface->internal->images[i])) {
-            goto error;
+        if (flA != 0.0f) {
+            flR /= flA;
+            flG /= flA;
+            flB /= flA;
+        } else {
+            flR = flG = flB = 0.0f;
         }
-    }
 
-    // We're ready to go!
-    return convert;
-
-error:
-    if (temp_palette) {
-        SDL_DestroyPalette(temp_palette);
-    }
-    if (convert) {
-        SDL_DestroySurface(convert);
+        *dst_px++ = flA;
+        *dst_px++ = flR;
+        *dst_px++ = flG;
+        *dst_px++ = flB;
     }
-    return NULL;
 }
 
-SDL_Surface *SDL_DuplicateSurface(SDL_Surface *surface)
+#ifdef SDL_SSE2_INTRINSICS
+
+// Replicate the alpha byte of each pixel into all four bytes
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_SplatAlpha_SSE2(__m128i px, __m128i shift)
 {
-    if (!SDL_SurfaceValid(surface)) {
-        SDL_InvalidParamError("surface");
-        return NULL;
-    }
+    __m128i a = _mm_and_si128(_mm_srl_epi32(px, shift), _mm_set1_epi32(0xFF));
+    a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+    return _mm_or_si128(a, _mm_slli_epi32(a, 16));
+}
 
-    return SDL_ConvertSurfaceAndColorspace(surface, surface->format, surface->internal->palette, surface->internal->colorspace, surface->internal->props);
+// floor(x / 255) for x <= 255 * 255
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_Div255_SSE2(__m128i x)
+{
+    x = _mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8));
+    return _mm_srli_epi16(x, 8);
 }
 
-SDL_Surface *SDL_ScaleSurface(SDL_Surface *surface, int width, int height, SDL_ScaleMode scaleMode)
+static void SDL_TARGETING("sse2") SDL_PremultiplyAlphaRow_8888_SSE2(const void *src, void *dst, int width, int alpha_shift)
 {
-    SDL_Surface *convert = NULL;
-    Uint32 copy_flags;
-    SDL_Color copy_color;
-    bool rc;
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const __m128i shift = _mm_cvtsi32_si128(alpha_shift);
+    const __m128i amask = _mm_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m128i zero = _mm_setzero_si128();
+    int i;
 
-    if (!SDL_SurfaceValid(surface)) {
-        SDL_InvalidParamError("surface");
-        goto error;
+    for (i = 0; i + 4 <= width; i += 4) {
+        const __m128i px = _mm_loadu_si128((const __m128i *)(src_px + i));
+        const __m128i a = SDL_SplatAlpha_SSE2(px, shift);
+        __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), _mm_unpacklo_epi8(a, zero));
+        __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), _mm_unpackhi_epi8(a, zero));
+        __m128i result = _mm_packus_epi16(SDL_Div255_SSE2(lo), SDL_Div255_SSE2(hi));
+
+        result = _mm_or_si128(_mm_andnot_si128(amask, result), _mm_and_si128(amask, px));
+        _mm_storeu_si128((__m128i *)(dst_px + i), result);
     }
+    SDL_PremultiplyAlphaRow_8888(src_px + i, dst_px + i, width - i, alpha_shift);
+}
 
-    if (SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
-        // We can't directly scale a YUV surface (yet!)
-        SDL_Surface *tmp = SDL_CreateSurface(surface->w, surface->h, SDL_PIXELFORMAT_ARGB8888);
-        if (!tmp) {
-            return NULL;
-        }
+// (c * 255 + a / 2) / a, clamped to 255, or 0 if a is 0
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_UnpremultiplyChannels_SSE2(__m128i c, __m128i a)
+{
+    const __m128 fa = _mm_cvtepi32_ps(a);
+    const __m128 d = _mm_max_ps(fa, _mm_set1_ps(1.0f));
+    __m128 r = _mm_rcp_ps(d);
+    __m128 q;
+
+    r = _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(d, r)));
+    q = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), _mm_mul_ps(r, _mm_set1_ps(255.0f))), _mm_set1_ps(UNPREMULTIPLY_BIAS));
+    q = _mm_min_ps(q, _mm_set1_ps(255.0f));
+    q = _mm_and_ps(q, _mm_cmpgt_ps(fa, _mm_setzero_ps()));
+    return _mm_cvttps_epi32(q);
+}
 
-        SDL_Surface *scaled = SDL_ScaleSurface(tmp, width, height, scaleMode);
-        SDL_DestroySurface(tmp);
-        if (!scaled) {
-            return NULL;
-        }
-        tmp = scaled;
+static void SDL_TARGETING("sse2") SDL_UnpremultiplyAlphaRow_8888_SSE2(const void *src, void *dst, int width, int alpha_shift)
+{
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const __m128i shift = _mm_cvtsi32_si128(alpha_shift);
+    const __m128i amask = _mm_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m128i zero = _mm_setzero_si128();
+    int i;
 
-        SDL_Surface *result = SDL_ConvertSurfaceAndColorspace(tmp, surface->format, NULL, surface->internal->colorspace, surface->internal->props);
-        SDL_DestroySurface(tmp);
-        return result;
-    }
+    for (i = 0; i + 4 <= width; i += 4) {
+        const __m128i px = _mm_loadu_si128((const __m128i *)(src_px + i));
+        const __m128i a = SDL_SplatAlpha_SSE2(px, shift);
+        const __m128i c_lo = _mm_unpacklo_epi8(px, zero);
+        const __m128i c_hi = _mm_unpackhi_epi8(px, zero);
+        const __m128i a_lo = _mm_unpacklo_epi8(a, zero);
+        const __m128i a_hi = _mm_unpackhi_epi8(a, zero);
+        const __m128i q0 = SDL_UnpremultiplyChannels_SSE2(_mm_unpacklo_epi16(c_lo, zero), _mm_unpacklo_epi16(a_lo, zero));
+        const __m128i q1 = SDL_UnpremultiplyChannels_SSE2(_mm_unpackhi_epi16(c_lo, zero), _mm_unpackhi_epi16(a_lo, zero));
+        const __m128i q2 = SDL_UnpremultiplyChannels_SSE2(_mm_unpacklo_epi16(c_hi, zero), _mm_unpacklo_epi16(a_hi, zero));
+        const __m128i q3 = SDL_UnpremultiplyChannels_SSE2(_mm_unpackhi_epi16(c_hi, zero), _mm_unpackhi_epi16(a_hi, zero));
+        __m128i result = _mm_packus_epi16(_mm_packs_epi32(q0, q1), _mm_packs_epi32(q2, q3));
+
+        result = _mm_or_si128(_mm_andnot_si128(amask, result), _mm_and_si128(amask, px));
+        _mm_storeu_si128((__m128i *)(dst_px + i), result);
+    }
+    SDL_UnpremultiplyAlphaRow_8888(src_px + i, dst_px + i, width - i, alpha_shift);
+}
 
-    // Create a new surface with the desired size
-    convert = SDL_CreateSurface(width, height, surface->format);
-    if (!convert) {
-        goto error;
-    }
-    SDL_SetSurfacePalette(convert, surface->internal->palette);
-    SDL_SetSurfaceColorspace(convert, surface->internal->colorspace);
+#endif // SDL_SSE2_INTRINSICS
 
-    // Save the original copy flags
-    copy_flags = surface->internal->map.info.flags;
-    copy_color.r = surface->internal->map.info.r;
-    copy_color.g = surface->internal->map.info.g;
-    copy_color.b = surface->internal->map.info.b;
-    copy_color.a = surface->internal->map.info.a;
-    surface->internal->map.info.r = 0xFF;
-    surface->internal->map.info.g = 0xFF;
-    surface->internal->map.info.b = 0xFF;
-    surface->internal->map.info.a = 0xFF;
-    surface->internal->map.info.flags = (copy_flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
-    SDL_InvalidateMap(&surface->internal->map);
+#ifdef SDL_SSE_INTRINSICS
 
-    rc = SDL_BlitSurfaceScaled(surface, NULL, convert, NULL, scaleMode);
+static void SDL_TARGETING("sse") SDL_PremultiplyAlphaRow_AXYZ128_SSE(const void *src, void *dst, int width, int alpha_shift)
+{
+    const float *src_px = (const float *)src;
+    float *dst_px = (float *)dst;
+    int i;
 
-    // Clean up the original surface, and update converted surface
-    convert->internal->map.info.r = copy_color.r;
-    convert->internal->map.info.g = copy_color.g;
-    convert->internal->map.info.b = copy_color.b;
-    convert->internal->map.info.a = copy_color.a;
-    convert->internal->map.info.flags = (copy_flags & ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
-    surface->internal->map.info.r = copy_color.r;
-    surface->internal->map.info.g = copy_color.g;
-    surface->internal->map.info.b = copy_color.b;
-    surface->internal->map.info.a = copy_color.a;
-    surface->internal->map.info.flags = copy_flags;
-    SDL_InvalidateMap(&surface->internal->map);
+    for (i = 0; i < width; ++i) {
+        const __m128 px = _mm_loadu_ps(src_px + i * 4);
+        const __m128 a = _mm_shuffle_ps(px, px, _MM_SHUFFLE(0, 0, 0, 0));
 
-    // SDL_BlitSurfaceScaled failed, and so the conversion
-    if (!rc) {
-        goto error;
+        _mm_storeu_ps(dst_px + i * 4, _mm_move_ss(_mm_mul_ps(px, a), px));
     }
+}
+
+static void SDL_TARGETING("sse") SDL_UnpremultiplyAlphaRow_AXYZ128_SSE(const void *src, void *dst, int width, int alpha_shift)
+{
+    const float *src_px = (const float *)src;
+    float *dst_px = (float *)dst;
+    int i;
 
-    // We're ready to go!
-    return convert;
+    for (i = 0; i < width; ++i) {
+        const __m128 px = _mm_loadu_ps(src_px + i * 4);
+        const __m128 a = _mm_shuffle_ps(px, px, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 q = _mm_and_ps(_mm_div_ps(px, a), _mm_cmpneq_ps(a, _mm_setzero_ps()));
 
-error:
-    if (convert) {
-        SDL_DestroySurface(convert);
+        _mm_storeu_ps(dst_px + i * 4, _mm_move_ss(q, px));
     }
-    return NULL;
 }
 
-SDL_Surface *SDL_ConvertSurface(SDL_Surface *surface, SDL_PixelFormat format)
+#endif // SDL_SSE_INTRINSICS
+
+#ifdef SDL_AVX2_INTRINSICS
+
+static void SDL_TARGETING("avx2") SDL_PremultiplyAlphaRow_8888_AVX2(const void *src, void *dst, int width, int alpha_shift)
 {
-    if (!SDL_SurfaceValid(surface)) {
-        SDL_InvalidParamError("surface");
-        return NULL;
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const __m128i shift = _mm_cvtsi32_si128(alpha_shift);
+    const __m256i amask = _mm256_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+    int i;
+
+    for (i = 0; i + 8 <= width; i += 8) {
+        const __m256i px = _mm256_loadu_si256((const __m256i *)(src_px + i));
+        __m256i a = _mm256_and_si256(_mm256_srl_epi32(px, shift), _mm256_set1_epi32(0xFF));
+        __m256i lo, hi, result;
+
+        a = _mm256_or_si256(a, _mm256_slli_epi32(a, 8));
+        a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+        lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(px, zero), _mm256_unpacklo_epi8(a, zero));
+        hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(px, zero), _mm256_unpackhi_epi8(a, zero));
+        lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(lo, one), _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(hi, one), _mm256_srli_epi16(hi, 8)), 8);
+        result = _mm256_packus_epi16(lo, hi);
+
+        result = _mm256_blendv_epi8(result, px, amask);
+        _mm256_storeu_si256((__m256i *)(dst_px + i), result);
     }
+    SDL_PremultiplyAlphaRow_8888(src_px + i, dst_px + i, width - i, alpha_shift);
+}
 
-    return SDL_ConvertSurfaceAndColorspace(surface, format, NULL, SDL_GetDefaultColorspaceForFormat(format), surface->internal->props);
+static SDL_INLINE __m256i SDL_TARGETING("avx2") SDL_UnpremultiplyChannels_AVX2(__m128i c, __m128i a)
+{
+    const __m256 fa = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(a));
+    const __m256 d = _mm256_max_ps(fa, _mm256_set1_ps(1.0f));
+    __m256 r = _mm256_rcp_ps(d);
+    __m256 q;
+
+    r = _mm256_mul_ps(r, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(d, r)));
+    q = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(c)), _mm256_mul_ps(r, _mm256_set1_ps(255.0f))), _mm256_set1_ps(UNPREMULTIPLY_BIAS));
+    q = _mm256_min_ps(q, _mm256_set1_ps(255.0f));
+    q = _mm256_and_ps(q, _mm256_cmp_ps(fa, _mm256_setzero_ps(), _CMP_GT_OQ));
+    return _mm256_cvttps_epi32(q);
 }
 
-SDL_Surface *SDL_DuplicatePixels(int width, int height, SDL_PixelFormat format, SDL_Colorspace colorspace, void *pixels, int pitch)
+static void SDL_TARGETING("avx2") SDL_UnpremultiplyAlphaRow_8888_AVX2(const void *src, void *dst, int width, int alpha_shift)
 {
-    SDL_Surface *surface = SDL_CreateSurface(width, height, format);
-    if (surface) {
-        int length = width * SDL_BYTESPERPIXEL(format);
-        Uint8 *src = (Uint8 *)pixels;
-        Uint8 *dst = (Uint8 *)surface->pixels;
-        int rows = height;
-        while (rows--) {
-            SDL_memcpy(dst, src, length);
-            dst += surface->pitch;
-            src += pitch;
-        }
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const __m128i shift = _mm_cvtsi32_si128(alpha_shift);
+    const __m256i amask = _mm256_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    int i;
 
-        SDL_SetSurfaceColorspace(surface, colorspace);
-    }
-    return surface;
+    for (i = 0; i + 8 <= width; i += 8) {
+        const __m256i px = _mm256_loadu_si256((const __m256i *)(src_px + i));
+        __m256i a = _mm256_and_si256(_mm256_srl_epi32(px, shift), _mm256_set1_epi32(0xFF));
+        __m128i c_lo, c_hi, a_lo, a_hi;
+        __m256i q0, q1, q2, q3, result;
+
+        a = _mm256_or_si256(a, _mm256_slli_epi32(a, 8));
+        a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+        c_lo = _mm256_castsi256_si128(px);
+        c_hi = _mm256_extracti128_si256(px, 1);
+        a_lo = _mm256_castsi256_si128(a);
+        a_hi = _mm256_extracti128_si256(a, 1);
+
+        // Pixels 0-1, 2-3, 4-5 and 6-7
+        q0 = SDL_UnpremultiplyChannels_AVX2(c_lo, a_lo);
+        q1 = SDL_UnpremultiplyChannels_AVX2(_mm_srli_si128(c_lo, 8), _mm_srli_si128(a_lo, 8));
+        q2 = SDL_UnpremultiplyChannels_AVX2(c_hi, a_hi);
+        q3 = SDL_UnpremultiplyChannels_AVX2(_mm_srli_si128(c_hi, 8), _mm_srli_si128(a_hi, 8));
+
+        // The in-lane packs leave the pixels in the order 0 2 4 6 1 3 5 7
+        result = _mm256_packus_epi16(_mm256_packs_epi32(q0, q1), _mm256_packs_epi32(q2, q3));
+        result = _mm256_permutevar8x32_epi32(result, order);
+
+        result = _mm256_blendv_epi8(result, px, amask);
+        _mm256_storeu_si256((__m256i *)(dst_px + i), result);
+    }
+    SDL_UnpremultiplyAlphaRow_8888(src_px + i, dst_px + i, width - i, alpha_shift);
 }
 
-bool SDL_ConvertPixelsAndColorspace(int width, int height,
-                      SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
-                      SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
+static void SDL_TARGETING("avx2") SDL_PremultiplyAlphaRow_AXYZ128_AVX2(const void *src, void *dst, int width, int alpha_shift)
 {
-    SDL_InternalSurface src_data, dst_data;
-    SDL_Surface *src_surface;
-    SDL_Surface *dst_surface;
-    SDL_Rect rect;
-    void *nonconst_src = (void *)src;
-    bool result;
+    const float *src_px = (const float *)src;
+    float *dst_px = (float *)dst;
+    int i;
 
-    if (!src) {
-        return SDL_InvalidParamError("src");
-    }
-    if (!src_pitch) {
-        return SDL_InvalidParamError("src_pitch");
-    }
-    if (!dst) {
-        return SDL_InvalidParamError("dst");
-    }
-    if (!dst_pitch) {
-        return SDL_InvalidParamError("dst_pitch");
-    }
+    for (i = 0; i + 2 <= width; i += 2) {
+        const __m256 px = _mm256_loadu_ps(src_px + i * 4);
+        const __m256 a = _mm256_permute_ps(px, _MM_SHUFFLE(0, 0, 0, 0));
 
-    if (src_colorspace == SDL_COLORSPACE_UNKNOWN) {
-        src_colorspace = SDL_GetDefaultColorspaceForFormat(src_format);
-    }
-    if (dst_colorspace == SDL_COLORSPACE_UNKNOWN) {
-        dst_colorspace = SDL_GetDefaultColorspaceForFormat(dst_format);
+        _mm256_storeu_ps(dst_px + i * 4, _mm256_blend_ps(_mm256_mul_ps(px, a), px, 0x11));
     }
+    SDL_PremultiplyAlphaRow_AXYZ128(src_px + i * 4, dst_px + i * 4, width - i, alpha_shift);
+}
 
-#if SDL_HAVE_YUV
-    if (SDL_ISPIXELFORMAT_FOURCC(src_format) && SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
-        return SDL_ConvertPixels_YUV_to_YUV(width, height, src_format, src_colorspace, src_properties, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
-    } else if (SDL_ISPIXELFORMAT_FOURCC(src_format)) {
-        return SDL_ConvertPixels_YUV_to_RGB(width, height, src_format, src_colorspace, src_properties, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
-    } else if (SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
-        return SDL_ConvertPixels_RGB_to_YUV(width, height, src_format, src_colorspace, src_properties, src, src_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
-    }
-#else
-    if (SDL_ISPIXELFORMAT_FOURCC(src_format) || SDL_ISPIXELFORMAT_FOURCC(dst_format)) {
-        return SDL_SetError("SDL not built with YUV support");
-    }
-#endif
+static void SDL_TARGETING("avx2") SDL_UnpremultiplyAlphaRow_AXYZ128_AVX2(const void *src, void *dst, int width, int alpha_shift)
+{
+    const float *src_px = (const float *)src;
+    float *dst_px = (float *)dst;
+    int i;
 
-    // Fast path for same format copy
-    if (src_format == dst_format && src_colorspace == dst_colorspace) {
-        int i;
-        const int bpp = SDL_BYTESPERPIXEL(src_format);
-        width *= bpp;
-        for (i = height; i--;) {
-            SDL_memcpy(dst, src, width);
-            src = (const Uint8 *)src + src_pitch;
-            dst = (Uint8 *)dst + dst_pitch;
-        }
-        return true;
-    }
+    for (i = 0; i + 2 <= width; i += 2) {
+        const __m256 px = _mm256_loadu_ps(src_px + i * 4);
+        const __m256 a = _mm256_permute_ps(px, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m256 q = _mm256_and_ps(_mm256_div_ps(px, a), _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_NEQ_UQ));
 
-    src_surface = SDL_InitializeSurface(&src_data, width, height, src_format, src_colorspace, src_properties, nonconst_src, src_pitch, true);
-    if (!src_surface) {
-        return false;
+        _mm256_storeu_ps(dst_px + i * 4, _mm256_blend_ps(q, px, 0x11));
     }
-    SDL_SetSurfaceBlendMode(src_surface, SDL_BLENDMODE_NONE);
+    SDL_UnpremultiplyAlphaRow_AXYZ128(src_px + i * 4, dst_px + i * 4, width - i, alpha_shift);
+}
 
-    dst_surface = SDL_InitializeSurface(&dst_data, width, height, dst_format, dst_colorspace, dst_properties, dst, dst_pitch, true);
-    if (!dst_surface) {
-        return false;
+#endif // SDL_AVX2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+
+static void SDL_PremultiplyAlphaRow_8888_NEON(const void *src, void *dst, int width, int alpha_shift)
+{
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const int32x4_t shift = vdupq_n_s32(-alpha_shift);
+    const uint32x4_t amask = vdupq_n_u32(0xFFu << alpha_shift);
+    const uint16x8_t one = vdupq_n_u16(1);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        const uint32x4_t px = vld1q_u32(src_px + i);
+        const uint32x4_t a = vmulq_n_u32(vandq_u32(vshlq_u32(px, shift), vdupq_n_u32(0xFF)), 0x01010101);
+        const uint8x16_t px8 = vreinterpretq_u8_u32(px);
+        const uint8x16_t a8 = vreinterpretq_u8_u32(a);
+        uint16x8_t lo = vmull_u8(vget_low_u8(px8), vget_low_u8(a8));
+        uint16x8_t hi = vmull_u8(vget_high_u8(px8), vget_high_u8(a8));
+        uint32x4_t result;
+
+        // floor(x / 255) as (x + 1 + (x >> 8)) >> 8
+        lo = vaddq_u16(vsraq_n_u16(lo, lo, 8), one);
+        hi = vaddq_u16(vsraq_n_u16(hi, hi, 8), one);
+        result = vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+
+        vst1q_u32(dst_px + i, vbslq_u32(amask, px, result));
     }
+    SDL_PremultiplyAlphaRow_8888(src_px + i, dst_px + i, width - i, alpha_shift);
+}
 
-    // Set up the rect and go!
-    rect.x = 0;
-    rect.y = 0;
-    rect.w = width;
-    rect.h = height;
-    result = SDL_BlitSurfaceUnchecked(src_surface, &rect, dst_surface, &rect);
+static void SDL_PremultiplyAlphaRow_AXYZ128_NEON(const void *src, void *dst, int width, int alpha_shift)
+{
+    const float *src_px = (const float *)src;
+    float *dst_px = (float *)dst;
+    int i;
 
-    SDL_DestroySurface(src_surface);
-    SDL_DestroySurface(dst_surface);
+    for (i = 0; i + 4 <= width; i += 4) {
+        float32x4x4_t px = vld4q_f32(src_px + i * 4);
 
-    return result;
+        px.val[1] = vmulq_f32(px.val[1], px.val[0]);
+        px.val[2] = vmulq_f32(px.val[2], px.val[0]);
+        px.val[3] = vmulq_f32(px.val[3], px.val[0]);
+        vst4q_f32(dst_px + i * 4, px);
+    }
+    SDL_PremultiplyAlphaRow_AXYZ128(src_px + i * 4, dst_px + i * 4, width - i, alpha_shift);
 }
 
-bool SDL_ConvertPixels(int width, int height, SDL_PixelFormat src_format, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch)
+static SDL_INLINE uint32x4_t SDL_UnpremultiplyChannels_NEON(uint16x4_t c, uint16x4_t a)
 {
-    return SDL_ConvertPixelsAndColorspace(width, height,
-                      src_format, SDL_COLORSPACE_UNKNOWN, 0, src, src_pitch,
-                      dst_format, SDL_COLORSPACE_UNKNOWN, 0, dst, dst_pitch);
+    const float32x4_t fa = vcvtq_f32_u32(vmovl_u16(a));
+    const float32x4_t d = vmaxq_f32(fa, vdupq_n_f32(1.0f));
+    float32x4_t r = vrecpeq_f32(d);
+    float32x4_t q;
+
+    r = vmulq_f32(r, vrecpsq_f32(d, r));
+    r = vmulq_f32(r, vrecpsq_f32(d, r));
+    q = vmlaq_f32(vdupq_n_f32(UNPREMULTIPLY_BIAS), vcvtq_f32_u32(vmovl_u16(c)), vmulq_n_f32(r, 255.0f));
+    q = vminq_f32(q, vdupq_n_f32(255.0f));
+    return vandq_u32(vcvtq_u32_f32(q), vcgtq_f32(fa, vdupq_n_f32(0.0f)));
 }
 
-/*
- * Premultiply the alpha on a block of pixels
- *
- * Here are some ideas for optimization:
- * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
- * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
- */
+static void SDL_UnpremultiplyAlphaRow_8888_NEON(const void *src, void *dst, int width, int alpha_shift)
+{
+    const Uint32 *src_px = (const Uint32 *)src;
+    Uint32 *dst_px = (Uint32 *)dst;
+    const int32x4_t shift = vdupq_n_s32(-alpha_shift);
+    const uint32x4_t amask = vdupq_n_u32(0xFFu << alpha_shift);
+    int i;
+
+    for (i = 0; i + 4 <= width; i += 4) {
+        const uint32x4_t px = vld1q_u32(src_px + i);
+        const uint32x4_t a = vmulq_n_u32(vandq_u32(vshlq_u32(px, shift), vdupq_n_u32(0xFF)), 0x01010101);
+        const uint16x8_t c_lo = vmovl_u8(vget_low_u8(vreinterpretq_u8_u32(px)));
+        const uint16x8_t c_hi = vmovl_u8(vget_high_u8(vreinterpretq_u8_u32(px)));
+        const uint16x8_t a_lo = vmovl_u8(vget_low_u8(vreinterpretq_u8_u32(a)));
+        const uint16x8_t a_hi = vmovl_u8(vget_high_u8(vreinterpretq_u8_u32(a)));
+        const uint32x4_t q0 = SDL_UnpremultiplyChannels_NEON(vget_low_u16(c_lo), vget_low_u16(a_lo));
+        const uint32x4_t q1 = SDL_UnpremultiplyChannels_NEON(vget_high_u16(c_lo), vget_high_u16(a_lo));
+        const uint32x4_t q2 = SDL_UnpremultiplyChannels_NEON(vget_low_u16(c_hi), vget_low_u16(a_hi));
+        const uint32x4_t q3 = SDL_UnpremultiplyChannels_NEON(vget_high_u16(c_hi), vget_high_u16(a_hi));
+        const uint8x8_t r_lo = vmovn_u16(vcombine_u16(vmovn_u32(q0), vmovn_u32(q1)));
+        const uint8x8_t r_hi = vmovn_u16(vcombine_u16(vmovn_u32(q2), vmovn_u32(q3)));
+        const uint32x4_t result = vreinterpretq_u32_u8(vcombine_u8(r_lo, r_hi));
+
+        vst1q_u32(dst_px + i, vbslq_u32(amask, px, result));
+    }
+    SDL_UnpremultiplyAlphaRow_8888(src_px + i, dst_px + i, width - i, alpha_shift);
+}
+
+// Unpremultiplying floats needs exact vector division, which is only available on AArch64
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define SDL_UNPREMULTIPLY_FLOAT_NEON
 
-static void SDL_PremultiplyAlpha_AXYZ8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+static void SDL_UnpremultiplyAlphaRow_AXYZ128_NEON(const void *src, void *dst, int width, int alpha_shift)
 {
-    int c;
-    Uint32 srcpixel;
-    Uint32 srcR, srcG, srcB, srcA;
-    Uint32 dstpixel;
-    Uint32 dstR, dstG, dstB, dstA;
+    const float *src_px = (const float *)src;
+    float *dst_px = (float *)dst;
+    int i;
 
-    while (height--) {
-        const Uint32 *src_px = (const Uint32 *)src;
-        Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
-            // Component bytes extraction.
-            srcpixel = *src_px++;
-            RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
-
-            // Alpha pre-multiplication of each component.
-            dstA = srcA;
-            dstR = (srcA * srcR) / 255;
-            dstG = (srcA * srcG) / 255;
-            dstB = (srcA * srcB) / 255;
-
-            // ARGB8888 pixel recomposition.
-            ARGB8888_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
-            *dst_px++ = dstpixel;
-        }
-        src = (const Uint8 *)src + src_pitch;
-        dst = (Uint8 *)dst + dst_pitch;
+    for (i = 0; i + 4 <= width; i += 4) {
+        float32x4x4_t px = vld4q_f32(src_px + i * 4);
+        const uint32x4_t valid = vmvnq_u32(vceqq_f32(px.val[0], vdupq_n_f32(0.0f)));
+
+        px.val[1] = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vdivq_f32(px.val[1], px.val[0])), valid));
+        px.val[2] = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vdivq_f32(px.val[2], px.val[0])), valid));
+        px.val[3] = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vdivq_f32(px.val[3], px.val[0])), valid));
+        vst4q_f32(dst_px + i * 4, px);
     }
+    SDL_UnpremultiplyAlphaRow_AXYZ128(src_px + i * 4, dst_px + i * 4, width - i, alpha_shift);
 }
 
-static void SDL_PremultiplyAlpha_XYZA8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+#endif // __aarch64__
+#endif // SDL_NEON_INTRINSICS
+
+static SDL_PremultiplyRowFunc SDL_GetPremultiplyRowFunc(SDL_PixelFormat format, bool linear, bool unpremultiply)
 {
-    int c;
-    Uint32 srcpixel;
-    Uint32 srcR, srcG, srcB, srcA;
-    Uint32 dstpixel;
-    Uint32 dstR, dstG, dstB, dstA;
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        if (linear) {
+            SDL_SetupPremultiplyLinearTables();
+            return unpremultiply ? SDL_UnpremultiplyAlphaRow_8888_Linear : SDL_PremultiplyAlphaRow_8888_Linear;
+        }
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            return unpremultiply ? SDL_UnpremultiplyAlphaRow_8888_AVX2 : SDL_PremultiplyAlphaRow_8888_AVX2;
+        }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return unpremultiply ? SDL_UnpremultiplyAlphaRow_8888_SSE2 : SDL_PremultiplyAlphaRow_8888_SSE2;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return unpremultiply ? SDL_UnpremultiplyAlphaRow_8888_NEON : SDL_PremultiplyAlphaRow_8888_NEON;
+        }
+#endif
+        return unpremultiply ? SDL_UnpremultiplyAlphaRow_8888 : SDL_PremultiplyAlphaRow_8888;
 
-    while (height--) {
-        const Uint32 *src_px = (const Uint32 *)src;
-        Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
-            // Component bytes extraction.
-            srcpixel = *src_px++;
-            RGBA_FROM_RGBA8888(srcpixel, srcR, srcG, srcB, srcA);
-
-            // Alpha pre-multiplication of each component.
-            dstA = srcA;
-            dstR = (srcA * srcR) / 255;
-            dstG = (srcA * srcG) / 255;
-            dstB = (srcA * srcB) / 255;
-
-            // RGBA8888 pixel recomposition.
-            RGBA8888_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
-            *dst_px++ = dstpixel;
+    case SDL_PIXELFORMAT_ARGB128_FLOAT:
+    case SDL_PIXELFORMAT_ABGR128_FLOAT:
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            return unpremultiply ? SDL_UnpremultiplyAlphaRow_AXYZ128_AVX2 : SDL_PremultiplyAlphaRow_AXYZ128_AVX2;
         }
-        src = (const Uint8 *)src + src_pitch;
-        dst = (Uint8 *)dst + dst_pitch;
+#endif
+#ifdef SDL_SSE_INTRINSICS
+        if (SDL_HasSSE()) {
+            return unpremultiply ? SDL_UnpremultiplyAlphaRow_AXYZ128_SSE : SDL_PremultiplyAlphaRow_AXYZ128_SSE;
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (!unpremultiply && SDL_HasNEON()) {
+            return SDL_PremultiplyAlphaRow_AXYZ128_NEON;
+        }
+#ifdef SDL_UNPREMULTIPLY_FLOAT_NEON
+        if (unpremultiply && SDL_HasNEON()) {
+            return SDL_UnpremultiplyAlphaRow_AXYZ128_NEON;
+        }
+#endif
+#endif
+        return unpremultiply ? SDL_UnpremultiplyAlphaRow_AXYZ128 : SDL_PremultiplyAlphaRow_AXYZ128;
+
+    default:
+        return NULL;
     }
 }
 
-static void SDL_PremultiplyAlpha_AXYZ128(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+static void SDL_PremultiplyAlphaRows(SDL_PremultiplyRowFunc func, int alpha_shift, int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
 {
-    int c;
-    float flR, flG, flB, flA;
-
     while (height--) {
-        const float *src_px = (const float *)src;
-        float *dst_px = (float *)dst;
-        for (c = width; c; --c) {
-            flA = *src_px++;
-            flR = *src_px++;
-            flG = *src_px++;
-            flB = *src_px++;
-
-            // Alpha pre-multiplication of each component.
-            flR *= flA;
-            flG *= flA;
-            flB *= flA;
-
-            *dst_px++ = flA;
-            *dst_px++ = flR;
-            *dst_px++ = flG;
-            *dst_px++ = flB;
-        }
+        func(src, dst, width, alpha_shift);
         src = (const Uint8 *)src + src_pitch;
         dst = (Uint8 *)dst + dst_pitch;
     }
 }
 
-static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch, bool linear)
+static int SDL_GetPremultiplyAlphaShift(SDL_PixelFormat format)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        return 24;
+    default:
+        return 0;
+    }
+}
+
+static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch, bool linear, bool unpremultiply)
 {
     SDL_Surface *convert = NULL;
     void *final_dst = dst;
     int final_dst_pitch = dst_pitch;
     SDL_PixelFormat format;
     SDL_Colorspace colorspace;
+    SDL_PremultiplyRowFunc func;
+    int alpha_shift;
     bool result = false;
 
     if (!src) {
@@ -2451,9 +5119,10 @@ static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_P
         return SDL_InvalidParamError("dst_pitch");
     }
 
-    // Use a high precision format if we're converting to linear colorspace or using high precision pixel formats
-    if (linear ||
-        SDL_ISPIXELFORMAT_10BIT(src_format) || SDL_BITSPERPIXEL(src_format) > 32 ||
+    /* Use a high precision format if we're using high precision pixel formats.
+     * 8-bit pixels stay in sRGB and go through lookup tables for linear light.
+     */
+    if (SDL_ISPIXELFORMAT_10BIT(src_format) || SDL_BITSPERPIXEL(src_format) > 32 ||
         SDL_ISPIXELFORMAT_10BIT(dst_format) || SDL_BITSPERPIXEL(dst_format) > 32) {
         if (src_format == SDL_PIXELFORMAT_ARGB128_FLOAT ||
             src_format == SDL_PIXELFORMAT_ABGR128_FLOAT) {
@@ -2461,6 +5130,12 @@ static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_P
         } else {
             format = SDL_PIXELFORMAT_ARGB128_FLOAT;
         }
+        if (linear) {
+            colorspace = SDL_COLORSPACE_SRGB_LINEAR;
+        } else {
+            colorspace = SDL_COLORSPACE_SRGB;
+        }
+        linear = false;
     } else {
         if (src_format == SDL_PIXELFORMAT_ARGB8888 ||
             src_format == SDL_PIXELFORMAT_ABGR8888 ||
@@ -2470,13 +5145,15 @@ static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_P
         } else {
             format = SDL_PIXELFORMAT_ARGB8888;
         }
-    }
-    if (linear) {
-        colorspace = SDL_COLORSPACE_SRGB_LINEAR;
-    } else {
         colorspace = SDL_COLORSPACE_SRGB;
     }
 
+    func = SDL_GetPremultiplyRowFunc(format, linear, unpremultiply);
+    if (!func) {
+        return SDL_SetError("Unexpected internal pixel format");
+    }
+    alpha_shift = SDL_GetPremultiplyAlphaShift(format);
+
     if (src_format != format || src_colorspace != colorspace) {
         convert = SDL_CreateSurface(width, height, format);
         if (!convert) {
@@ -2500,23 +5177,7 @@ static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_P
         dst_pitch = convert->pitch;
     }
 
-    switch (format) {
-    case SDL_PIXELFORMAT_ARGB8888:
-    case SDL_PIXELFORMAT_ABGR8888:
-        SDL_PremultiplyAlpha_AXYZ8888(width, height, src, src_pitch, dst, dst_pitch);
-        break;
-    case SDL_PIXELFORMAT_RGBA8888:
-    case SDL_PIXELFORMAT_BGRA8888:
-        SDL_PremultiplyAlpha_XYZA8888(width, height, src, src_pitch, dst, dst_pitch);
-        break;
-    case SDL_PIXELFORMAT_ARGB128_FLOAT:
-    case SDL_PIXELFORMAT_ABGR128_FLOAT:
-        SDL_PremultiplyAlpha_AXYZ128(width, height, src, src_pitch, dst, dst_pitch);
-        break;
-    default:
-        SDL_SetError("Unexpected internal pixel format");
-        goto done;
-    }
+    SDL_PremultiplyAlphaRows(func, alpha_shift, width, height, src, src_pitch, dst, dst_pitch);
 
     if (dst != final_dst) {
         if (!SDL_ConvertPixelsAndColorspace(width, height, format, colorspace, 0, convert->pixels, convert->pitch, dst_format, dst_colorspace, dst_properties, final_dst, final_dst_pitch)) {
@@ -2539,7 +5200,7 @@ bool SDL_PremultiplyAlpha(int width, int height,
     SDL_Colorspace src_colorspace = SDL_GetDefaultColorspaceForFormat(src_format);
     SDL_Colorspace dst_colorspace = SDL_GetDefaultColorspaceForFormat(dst_format);
 
-    return SDL_PremultiplyAlphaPixelsAndColorspace(width, height, src_format, src_colorspace, 0, src, src_pitch, dst_format, dst_colorspace, 0, dst, dst_pitch, linear);
+    return SDL_PremultiplyAlphaPixelsAndColorspace(width, height, src_format, src_colorspace, 0, src, src_pitch, dst_format, dst_colorspace, 0, dst, dst_pitch, linear, false);
 }
 
 bool SDL_PremultiplySurfaceAlpha(SDL_Surface *surface, bool linear)
@@ -2550,9 +5211,42 @@ bool SDL_PremultiplySurfaceAlpha(SDL_Surface *surface, bool linear)
         return SDL_InvalidParamError("surface");
     }
 
+    if (!SDL_UnshareSurfacePixels(surface)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(surface, NULL);
+
+    colorspace = surface->internal->colorspace;
+
+    return SDL_PremultiplyAlphaPixelsAndColorspace(surface->w, surface->h, surface->format, colorspace, surface->internal->props, surface->pixels, surface->pitch, surface->format, colorspace, surface->internal->props, surface->pixels, surface->pitch, linear, false);
+}
+
+bool SDL_UnpremultiplyAlpha(int width, int height,
+                           SDL_PixelFormat src_format, const void *src, int src_pitch,
+                           SDL_PixelFormat dst_format, void *dst, int dst_pitch, bool linear)
+{
+    SDL_Colorspace src_colorspace = SDL_GetDefaultColorspaceForFormat(src_format);
+    SDL_Colorspace dst_colorspace = SDL_GetDefaultColorspaceForFormat(dst_format);
+
+    return SDL_PremultiplyAlphaPixelsAndColorspace(width, height, src_format, src_colorspace, 0, src, src_pitch, dst_format, dst_colorspace, 0, dst, dst_pitch, linear, true);
+}
+
+bool SDL_UnpremultiplySurfaceAlpha(SDL_Surface *surface, bool linear)
+{
+    SDL_Colorspace colorspace;
+
+    if (!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
+
+    if (!SDL_UnshareSurfacePixels(surface)) {
+        return false;
+    }
+    SDL_AddSurfaceDamage(surface, NULL);
+
     colorspace = surface->internal->colorspace;
 
-    return SDL_PremultiplyAlphaPixelsAndColorspace(surface->w, surface->h, surface->format, colorspace, surface->internal->props, surface->pixels, surface->pitch, surface->format, colorspace, surface->internal->props, surface->pixels, surface->pitch, linear);
+    return SDL_PremultiplyAlphaPixelsAndColorspace(surface->w, surface->h, surface->format, colorspace, surface->internal->props, surface->pixels, surface->pitch, surface->format, colorspace, surface->internal->props, surface->pixels, surface->pitch, linear, true);
 }
 
 bool SDL_ClearSurface(SDL_Surface *surface, float r, float g, float b, float a)
@@ -2835,12 +5529,21 @@ bool SDL_WriteSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 r, Uint8 g,
 
     bytes_per_pixel = SDL_BYTESPERPIXEL(surface->format);
 
+    if (!SDL_UnshareSurfacePixels(surface)) {
+        return false;
+    }
+
     if (SDL_MUSTLOCK(surface)) {
         if (!SDL_LockSurface(surface)) {
             return false;
         }
     }
 
+    if (surface->internal->damage) {
+        const SDL_Rect rect = { x, y, 1, 1 };
+        SDL_AddSurfaceDamage(surface, &rect);
+    }
+
     p = (Uint8 *)surface->pixels + y * surface->pitch + x * bytes_per_pixel;
 
     if (bytes_per_pixel <= sizeof(pixel) && !SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
@@ -2903,12 +5606,21 @@ bool SDL_WriteSurfacePixelFloat(SDL_Surface *surface, int x, int y, float r, flo
         float rgba[4];
         Uint8 *p;
 
+        if (!SDL_UnshareSurfacePixels(surface)) {
+            return false;
+        }
+
         if (SDL_MUSTLOCK(surface)) {
             if (!SDL_LockSurface(surface)) {
                 return false;
             }
         }
 
+        if (surface->internal->damage) {
+            const SDL_Rect rect = { x, y, 1, 1 };
+            SDL_AddSurfaceDamage(surface, &rect);
+        }
+
         p = (Uint8 *)surface->pixels + y * surface->pitch + x * SDL_BYTESPERPIXEL(surface->format);
 
         rgba[0] = r;
@@ -2933,6 +5645,31 @@ bool SDL_WriteSurfacePixelFloat(SDL_Surface *surface, int x, int y, float r, flo
     return result;
 }
 
+void SDL_FreeSurfacePixels(SDL_Surface *surface)
+{
+    if (surface->flags & SDL_SURFACE_PREALLOCATED) {
+        // Don't free
+        return;
+    } else if (surface->internal->shared) {
+        // Other surfaces may still be using them
+        SDL_ReleaseSharedPixels(surface->internal->shared);
+        surface->internal->shared = NULL;
+        surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
+    } else if (surface->internal->pool_buffer) {
+        // Back to the pool
+        SDL_ReleasePooledPixels(surface->internal->pool_buffer);
+        surface->internal->pool_buffer = NULL;
+    } else if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
+        // Free aligned
+        SDL_aligned_free(surface->pixels);
+        surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
+    } else {
+        // Normal
+        SDL_free(surface->pixels);
+    }
+    surface->pixels = NULL;
+}
+
 /*
  * Free a surface created by the above function.
  */
@@ -2963,16 +5700,9 @@ void SDL_DestroySurface(SDL_Surface *surface)
     }
 #endif
     SDL_SetSurfacePalette(surface, NULL);
+    SDL_TrackSurfaceDamage(surface, false);
 
-    if (surface->flags & SDL_SURFACE_PREALLOCATED) {
-        // Don't free
-    } else if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
-        // Free aligned
-        SDL_aligned_free(surface->pixels);
-    } else {
-        // Normal
-        SDL_free(surface->pixels);
-    }
+    SDL_FreeSurfacePixels(surface);
     if (!(surface->internal->flags & SDL_INTERNAL_SURFACE_STACK)) {
         SDL_free(surface);
     }
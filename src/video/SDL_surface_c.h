@@ -34,6 +34,15 @@ typedef Uint32 SDL_SurfaceDataFlags;
 #define SDL_INTERNAL_SURFACE_STACK      0x00000002u /**< Surface is allocated on the stack */
 #define SDL_INTERNAL_SURFACE_RLEACCEL   0x00000004u /**< Surface is RLE encoded */
 
+// Areas of a surface that have changed, see SDL_TrackSurfaceDamage()
+typedef struct SDL_SurfaceDamage SDL_SurfaceDamage;
+
+// A pixel buffer allocated from an SDL_SurfacePool
+typedef struct SDL_SurfacePoolBuffer SDL_SurfacePoolBuffer;
+
+// Pixels shared by several surfaces, see SDL_UnshareSurfacePixels()
+typedef struct SDL_SharedPixels SDL_SharedPixels;
+
 // Surface internal data definition
 struct SDL_SurfaceData
 {
@@ -64,6 +73,15 @@ struct SDL_SurfaceData
 
     /** info for fast blit mapping to other surfaces */
     SDL_BlitMap map;
+
+    /** areas changed since the damage was last cleared, if tracked */
+    SDL_SurfaceDamage *damage;
+
+    /** the pool the pixels came from, if any */
+    SDL_SurfacePoolBuffer *pool_buffer;
+
+    /** the pixels shared with duplicates of this surface, if any */
+    SDL_SharedPixels *shared;
 };
 
 typedef struct SDL_InternalSurface
@@ -81,6 +99,13 @@ extern float SDL_GetSurfaceSDRWhitePoint(SDL_Surface *surface, SDL_Colorspace co
 extern float SDL_GetDefaultHDRHeadroom(SDL_Colorspace colorspace);
 extern float SDL_GetSurfaceHDRHeadroom(SDL_Surface *surface, SDL_Colorspace colorspace);
 extern SDL_Surface *SDL_GetSurfaceImage(SDL_Surface *surface, float display_scale);
+extern void SDL_FreeSurfacePixels(SDL_Surface *surface);
+extern bool SDL_UnshareSurfacePixels(SDL_Surface *surface);
+extern bool SDL_TrackSurfaceDamage(SDL_Surface *surface, bool enabled);
+extern void SDL_AddSurfaceDamage(SDL_Surface *surface, const SDL_Rect *area);
+extern const SDL_Rect *SDL_GetSurfaceDamage(SDL_Surface *surface, int *count);
+extern void SDL_ClearSurfaceDamage(SDL_Surface *surface);
+extern void SDL_RotatePixels90(int width, int height, int bpp, const void *src, int src_pitch, void *dst, int dst_pitch, int turns);
 extern bool SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
 
 #endif // SDL_surface_c_h_
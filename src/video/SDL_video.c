@@ -3423,6 +3423,11 @@ SDL_Surface *SDL_GetWindowSurface(SDL_Window *window)
         if (window->surface) {
             window->surface_valid = true;
             window->surface->internal->flags |= SDL_INTERNAL_SURFACE_DONTFREE;
+
+            if (SDL_GetHintBoolean(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING, false)) {
+                // If this fails we'll just update the whole surface
+                SDL_TrackSurfaceDamage(window->surface, true);
+            }
         }
     }
     return window->surface;
@@ -3454,6 +3459,21 @@ bool SDL_UpdateWindowSurface(SDL_Window *window)
 
     CHECK_WINDOW_MAGIC(window, false);
 
+    if (window->surface_valid && window->surface->internal->damage) {
+        int numrects;
+        const SDL_Rect *rects = SDL_GetSurfaceDamage(window->surface, &numrects);
+
+        // Nothing changed since the last update, don't present the same frame again
+        if (numrects == 0) {
+            return true;
+        }
+        if (!SDL_UpdateWindowSurfaceRects(window, rects, numrects)) {
+            return false;
+        }
+        SDL_ClearSurfaceDamage(window->surface);
+        return true;
+    }
+
     full_rect.x = 0;
     full_rect.y = 0;
     SDL_GetWindowSizeInPixels(window, &full_rect.w, &full_rect.h);
@@ -3475,6 +3495,48 @@ bool SDL_UpdateWindowSurfaceRects(SDL_Window *window, const SDL_Rect *rects,
     return _this->UpdateWindowFramebuffer(_this, window, rects, numrects);
 }
 
+SDL_Rect *SDL_GetWindowSurfaceDamage(SDL_Window *window, int *count)
+{
+    const SDL_Rect *damage;
+    SDL_Rect full_rect;
+    SDL_Rect *rects;
+    int numrects;
+
+    if (count) {
+        *count = 0;
+    }
+
+    CHECK_WINDOW_MAGIC(window, NULL);
+
+    if (!window->surface_valid) {
+        SDL_SetError("Window surface is invalid, please call SDL_GetWindowSurface() to get a new surface");
+        return NULL;
+    }
+
+    if (window->surface->internal->damage) {
+        damage = SDL_GetSurfaceDamage(window->surface, &numrects);
+    } else {
+        full_rect.x = 0;
+        full_rect.y = 0;
+        SDL_GetWindowSizeInPixels(window, &full_rect.w, &full_rect.h);
+        damage = &full_rect;
+        numrects = 1;
+    }
+
+    // Allocate one extra so an empty list isn't mistaken for a failure
+    rects = (SDL_Rect *)SDL_malloc((numrects + 1) * sizeof(*rects));
+    if (!rects) {
+        return NULL;
+    }
+    if (numrects > 0) {
+        SDL_memcpy(rects, damage, numrects * sizeof(*rects));
+    }
+    if (count) {
+        *count = numrects;
+    }
+    return rects;
+}
+
 bool SDL_DestroyWindowSurface(SDL_Window *window)
 {
     CHECK_WINDOW_MAGIC(window, false);
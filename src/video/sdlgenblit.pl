@@ -628,6 +628,628 @@ __EOF__
 __EOF__
 }
 
+sub output_simdkernels
+{
+    print FILE <<'__EOF__';
+/* The SIMD blitters below handle every combination of the 32-bit formats at
+ * once: pixels are shuffled into B, G, R, A byte order, widened to 16 bits per
+ * channel, and shuffled into the destination order on the way out. The math is
+ * the same as the scalar blitters, MULT_DIV_255 included, so they produce
+ * exactly the same pixels.
+ */
+
+// Byte indices that gather a pixel's channels into B, G, R, A order (0x80 zeroes a byte)
+static Uint32 SDL_Blit8888_ShuffleIn(const SDL_PixelFormatDetails *fmt)
+{
+    Uint32 mask = ((Uint32)(fmt->Bshift >> 3)) |
+                  ((Uint32)(fmt->Gshift >> 3) << 8) |
+                  ((Uint32)(fmt->Rshift >> 3) << 16);
+    if (fmt->Amask) {
+        mask |= ((Uint32)(fmt->Ashift >> 3) << 24);
+    } else {
+        mask |= 0x80000000;
+    }
+    return mask;
+}
+
+// Byte indices that scatter B, G, R, A back to a pixel's layout, leaving any unused byte zero
+static Uint32 SDL_Blit8888_ShuffleOut(const SDL_PixelFormatDetails *fmt)
+{
+    Uint32 mask = 0x80808080;
+    mask = (mask & ~(0xFFu << fmt->Bshift)) | (0u << fmt->Bshift);
+    mask = (mask & ~(0xFFu << fmt->Gshift)) | (1u << fmt->Gshift);
+    mask = (mask & ~(0xFFu << fmt->Rshift)) | (2u << fmt->Rshift);
+    if (fmt->Amask) {
+        mask = (mask & ~(0xFFu << fmt->Ashift)) | (3u << fmt->Ashift);
+    }
+    return mask;
+}
+
+static void SDL_Blit8888_GetModulation(const SDL_BlitInfo *info, Uint16 *mod)
+{
+    const int flags = info->flags;
+    mod[0] = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    mod[1] = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    mod[2] = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    mod[3] = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+}
+
+// Fetches the next `count` source pixels of a row into `pixels`
+static SDL_INLINE void SDL_Blit8888_FetchRow(Uint32 *pixels, const Uint32 *src, int count, bool scale, Uint64 *posx, Uint64 incx)
+{
+    int i;
+    if (scale) {
+        for (i = 0; i < count; ++i) {
+            pixels[i] = src[*posx >> 16];
+            *posx += incx;
+        }
+    } else {
+        SDL_memcpy(pixels, src, count * sizeof(Uint32));
+    }
+}
+
+#ifdef SDL_SSE4_1_INTRINSICS
+
+static SDL_INLINE __m128i SDL_TARGETING("sse4.1") SDL_Blit8888_MulDiv255_SSE41(__m128i a, __m128i b)
+{
+    // (x + (x >> 8)) >> 8 == (x * 257) >> 16, for x = a * b + 1
+    return _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(1)), _mm_set1_epi16(257));
+}
+
+// Blends two pixels of 16-bit channels, the same way output_copycore() does
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse4.1") SDL_Blit8888_Blend_SSE41(__m128i s, __m128i d, int mode)
+{
+    const __m128i alpha = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+    const __m128i sA = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i inv_sA = _mm_sub_epi16(_mm_set1_epi16(255), sA);
+
+    if (mode & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
+        s = SDL_Blit8888_MulDiv255_SSE41(s, _mm_or_si128(sA, alpha));
+    }
+    switch (mode) {
+    case SDL_COPY_BLEND:
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        return _mm_add_epi16(SDL_Blit8888_MulDiv255_SSE41(inv_sA, d), s);
+    case SDL_COPY_ADD:
+    case SDL_COPY_ADD_PREMULTIPLIED:
+        return _mm_add_epi16(_mm_andnot_si128(alpha, s), d);
+    case SDL_COPY_MOD:
+        return SDL_Blit8888_MulDiv255_SSE41(_mm_or_si128(s, alpha), d);
+    case SDL_COPY_MUL:
+        return _mm_add_epi16(SDL_Blit8888_MulDiv255_SSE41(_mm_or_si128(s, alpha), d),
+                             SDL_Blit8888_MulDiv255_SSE41(d, _mm_andnot_si128(alpha, inv_sA)));
+    default:
+        return d;
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("sse4.1") SDL_Blit8888Rows_SSE41(SDL_BlitInfo *info, bool modulate, bool blend, bool scale, int mode)
+{
+    const bool widen = blend || (modulate && (info->flags & SDL_COPY_MODULATE_MASK));
+    const __m128i offsets = _mm_set_epi8(12, 12, 12, 12, 8, 8, 8, 8, 4, 4, 4, 4, 0, 0, 0, 0);
+    const __m128i src_shuffle = _mm_add_epi32(_mm_set1_epi32((int)SDL_Blit8888_ShuffleIn(info->src_fmt)), offsets);
+    const __m128i dst_shuffle = _mm_add_epi32(_mm_set1_epi32((int)SDL_Blit8888_ShuffleIn(info->dst_fmt)), offsets);
+    const __m128i out_shuffle = _mm_add_epi32(_mm_set1_epi32((int)SDL_Blit8888_ShuffleOut(info->dst_fmt)), offsets);
+    const __m128i alpha_fill = _mm_set1_epi32(info->src_fmt->Amask ? 0 : (int)0xFF000000);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i mod = _mm_set1_epi16(255);
+    Uint64 posy = 0, posx = 0, incy = 0, incx = 0;
+    Uint32 pixels[4], dstpixels[4];
+
+    if (modulate) {
+        Uint16 m[4];
+        SDL_Blit8888_GetModulation(info, m);
+        mod = _mm_setr_epi16(m[0], m[1], m[2], m[3], m[0], m[1], m[2], m[3]);
+    }
+    if (scale) {
+        incy = ((Uint64)info->src_h << 16) / info->dst_h;
+        incx = ((Uint64)info->src_w << 16) / info->dst_w;
+        posy = incy / 2;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)(scale ? info->src + (posy >> 16) * info->src_pitch : info->src);
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        posx = incx / 2;
+
+        while (n > 0) {
+            const int count = SDL_min(n, 4);
+            __m128i s, lo, hi;
+
+            if (count == 4 && !scale) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else if (count == 4) {
+                const Uint32 p0 = src[posx >> 16];
+                const Uint32 p1 = src[(posx + incx) >> 16];
+                const Uint32 p2 = src[(posx + incx * 2) >> 16];
+                const Uint32 p3 = src[(posx + incx * 3) >> 16];
+                s = _mm_setr_epi32((int)p0, (int)p1, (int)p2, (int)p3);
+                posx += incx * 4;
+            } else {
+                SDL_Blit8888_FetchRow(pixels, src, count, scale, &posx, incx);
+                s = _mm_loadu_si128((const __m128i *)pixels);
+            }
+            s = _mm_or_si128(_mm_shuffle_epi8(s, src_shuffle), alpha_fill);
+
+            if (widen) {
+                lo = _mm_unpacklo_epi8(s, zero);
+                hi = _mm_unpackhi_epi8(s, zero);
+                if (modulate) {
+                    lo = SDL_Blit8888_MulDiv255_SSE41(lo, mod);
+                    hi = SDL_Blit8888_MulDiv255_SSE41(hi, mod);
+                }
+                if (blend) {
+                    __m128i d;
+                    if (count == 4) {
+                        d = _mm_loadu_si128((const __m128i *)dst);
+                    } else {
+                        SDL_memcpy(dstpixels, dst, count * sizeof(Uint32));
+                        d = _mm_loadu_si128((const __m128i *)dstpixels);
+                    }
+                    d = _mm_shuffle_epi8(d, dst_shuffle);
+                    lo = SDL_Blit8888_Blend_SSE41(lo, _mm_unpacklo_epi8(d, zero), mode);
+                    hi = SDL_Blit8888_Blend_SSE41(hi, _mm_unpackhi_epi8(d, zero), mode);
+                }
+                s = _mm_packus_epi16(lo, hi);
+            }
+            s = _mm_shuffle_epi8(s, out_shuffle);
+
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                _mm_storeu_si128((__m128i *)dstpixels, s);
+                SDL_memcpy(dst, dstpixels, count * sizeof(Uint32));
+            }
+            if (!scale) {
+                src += count;
+            }
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+
+// Each blend mode gets its own copy of the loop, with the blending math inlined
+SDL_FORCE_INLINE void SDL_TARGETING("sse4.1") SDL_Blit8888_SSE41(SDL_BlitInfo *info, bool modulate, bool blend, bool scale)
+{
+    if (!blend) {
+        SDL_Blit8888Rows_SSE41(info, modulate, false, scale, 0);
+        return;
+    }
+    switch (info->flags & SDL_COPY_BLEND_MASK) {
+    case SDL_COPY_BLEND:
+        SDL_Blit8888Rows_SSE41(info, modulate, true, scale, SDL_COPY_BLEND);
+        break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        SDL_Blit8888Rows_SSE41(info, modulate, true, scale, SDL_COPY_BLEND_PREMULTIPLIED);
+        break;
+    case SDL_COPY_ADD:
+        SDL_Blit8888Rows_SSE41(info, modulate, true, scale, SDL_COPY_ADD);
+        break;
+    case SDL_COPY_ADD_PREMULTIPLIED:
+        SDL_Blit8888Rows_SSE41(info, modulate, true, scale, SDL_COPY_ADD_PREMULTIPLIED);
+        break;
+    case SDL_COPY_MOD:
+        SDL_Blit8888Rows_SSE41(info, modulate, true, scale, SDL_COPY_MOD);
+        break;
+    case SDL_COPY_MUL:
+        SDL_Blit8888Rows_SSE41(info, modulate, true, scale, SDL_COPY_MUL);
+        break;
+    default:
+        SDL_Blit8888Rows_SSE41(info, modulate, true, scale, 0);
+        break;
+    }
+}
+
+#endif // SDL_SSE4_1_INTRINSICS
+
+#ifdef SDL_AVX2_INTRINSICS
+
+static SDL_INLINE __m256i SDL_TARGETING("avx2") SDL_Blit8888_MulDiv255_AVX2(__m256i a, __m256i b)
+{
+    // (x + (x >> 8)) >> 8 == (x * 257) >> 16, for x = a * b + 1
+    return _mm256_mulhi_epu16(_mm256_add_epi16(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(1)), _mm256_set1_epi16(257));
+}
+
+// Blends four pixels of 16-bit channels, the same way output_copycore() does
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") SDL_Blit8888_Blend_AVX2(__m256i s, __m256i d, int mode)
+{
+    const __m256i alpha = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+    const __m256i sA = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    const __m256i inv_sA = _mm256_sub_epi16(_mm256_set1_epi16(255), sA);
+
+    if (mode & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
+        s = SDL_Blit8888_MulDiv255_AVX2(s, _mm256_or_si256(sA, alpha));
+    }
+    switch (mode) {
+    case SDL_COPY_BLEND:
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        return _mm256_add_epi16(SDL_Blit8888_MulDiv255_AVX2(inv_sA, d), s);
+    case SDL_COPY_ADD:
+    case SDL_COPY_ADD_PREMULTIPLIED:
+        return _mm256_add_epi16(_mm256_andnot_si256(alpha, s), d);
+    case SDL_COPY_MOD:
+        return SDL_Blit8888_MulDiv255_AVX2(_mm256_or_si256(s, alpha), d);
+    case SDL_COPY_MUL:
+        return _mm256_add_epi16(SDL_Blit8888_MulDiv255_AVX2(_mm256_or_si256(s, alpha), d),
+                                SDL_Blit8888_MulDiv255_AVX2(d, _mm256_andnot_si256(alpha, inv_sA)));
+    default:
+        return d;
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") SDL_Blit8888Rows_AVX2(SDL_BlitInfo *info, bool modulate, bool blend, bool scale, int mode)
+{
+    const bool widen = blend || (modulate && (info->flags & SDL_COPY_MODULATE_MASK));
+    const __m128i offsets = _mm_set_epi8(12, 12, 12, 12, 8, 8, 8, 8, 4, 4, 4, 4, 0, 0, 0, 0);
+    const __m256i src_shuffle = _mm256_broadcastsi128_si256(_mm_add_epi32(_mm_set1_epi32((int)SDL_Blit8888_ShuffleIn(info->src_fmt)), offsets));
+    const __m256i dst_shuffle = _mm256_broadcastsi128_si256(_mm_add_epi32(_mm_set1_epi32((int)SDL_Blit8888_ShuffleIn(info->dst_fmt)), offsets));
+    const __m256i out_shuffle = _mm256_broadcastsi128_si256(_mm_add_epi32(_mm_set1_epi32((int)SDL_Blit8888_ShuffleOut(info->dst_fmt)), offsets));
+    const __m256i alpha_fill = _mm256_set1_epi32(info->src_fmt->Amask ? 0 : (int)0xFF000000);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i mod = _mm256_set1_epi16(255);
+    Uint64 posy = 0, posx = 0, incy = 0, incx = 0;
+    Uint32 pixels[8], dstpixels[8];
+
+    if (modulate) {
+        Uint16 m[4];
+        SDL_Blit8888_GetModulation(info, m);
+        mod = _mm256_setr_epi16(m[0], m[1], m[2], m[3], m[0], m[1], m[2], m[3],
+                                m[0], m[1], m[2], m[3], m[0], m[1], m[2], m[3]);
+    }
+    if (scale) {
+        incy = ((Uint64)info->src_h << 16) / info->dst_h;
+        incx = ((Uint64)info->src_w << 16) / info->dst_w;
+        posy = incy / 2;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)(scale ? info->src + (posy >> 16) * info->src_pitch : info->src);
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        posx = incx / 2;
+
+        while (n > 0) {
+            const int count = SDL_min(n, 8);
+            __m256i s, lo, hi;
+
+            if (count == 8 && !scale) {
+                s = _mm256_loadu_si256((const __m256i *)src);
+            } else if (count == 8) {
+                const Uint32 p0 = src[posx >> 16];
+                const Uint32 p1 = src[(posx + incx) >> 16];
+                const Uint32 p2 = src[(posx + incx * 2) >> 16];
+                const Uint32 p3 = src[(posx + incx * 3) >> 16];
+                const Uint32 p4 = src[(posx + incx * 4) >> 16];
+                const Uint32 p5 = src[(posx + incx * 5) >> 16];
+                const Uint32 p6 = src[(posx + incx * 6) >> 16];
+                const Uint32 p7 = src[(posx + incx * 7) >> 16];
+                s = _mm256_setr_epi32((int)p0, (int)p1, (int)p2, (int)p3, (int)p4, (int)p5, (int)p6, (int)p7);
+                posx += incx * 8;
+            } else {
+                SDL_Blit8888_FetchRow(pixels, src, count, scale, &posx, incx);
+                s = _mm256_loadu_si256((const __m256i *)pixels);
+            }
+            s = _mm256_or_si256(_mm256_shuffle_epi8(s, src_shuffle), alpha_fill);
+
+            if (widen) {
+                lo = _mm256_unpacklo_epi8(s, zero);
+                hi = _mm256_unpackhi_epi8(s, zero);
+                if (modulate) {
+                    lo = SDL_Blit8888_MulDiv255_AVX2(lo, mod);
+                    hi = SDL_Blit8888_MulDiv255_AVX2(hi, mod);
+                }
+                if (blend) {
+                    __m256i d;
+                    if (count == 8) {
+                        d = _mm256_loadu_si256((const __m256i *)dst);
+                    } else {
+                        SDL_memcpy(dstpixels, dst, count * sizeof(Uint32));
+                        d = _mm256_loadu_si256((const __m256i *)dstpixels);
+                    }
+                    d = _mm256_shuffle_epi8(d, dst_shuffle);
+                    lo = SDL_Blit8888_Blend_AVX2(lo, _mm256_unpacklo_epi8(d, zero), mode);
+                    hi = SDL_Blit8888_Blend_AVX2(hi, _mm256_unpackhi_epi8(d, zero), mode);
+                }
+                s = _mm256_packus_epi16(lo, hi);
+            }
+            s = _mm256_shuffle_epi8(s, out_shuffle);
+
+            if (count == 8) {
+                _mm256_storeu_si256((__m256i *)dst, s);
+            } else {
+                _mm256_storeu_si256((__m256i *)dstpixels, s);
+                SDL_memcpy(dst, dstpixels, count * sizeof(Uint32));
+            }
+            if (!scale) {
+                src += count;
+            }
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+
+// Each blend mode gets its own copy of the loop, with the blending math inlined
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") SDL_Blit8888_AVX2(SDL_BlitInfo *info, bool modulate, bool blend, bool scale)
+{
+    if (!blend) {
+        SDL_Blit8888Rows_AVX2(info, modulate, false, scale, 0);
+        return;
+    }
+    switch (info->flags & SDL_COPY_BLEND_MASK) {
+    case SDL_COPY_BLEND:
+        SDL_Blit8888Rows_AVX2(info, modulate, true, scale, SDL_COPY_BLEND);
+        break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        SDL_Blit8888Rows_AVX2(info, modulate, true, scale, SDL_COPY_BLEND_PREMULTIPLIED);
+        break;
+    case SDL_COPY_ADD:
+        SDL_Blit8888Rows_AVX2(info, modulate, true, scale, SDL_COPY_ADD);
+        break;
+    case SDL_COPY_ADD_PREMULTIPLIED:
+        SDL_Blit8888Rows_AVX2(info, modulate, true, scale, SDL_COPY_ADD_PREMULTIPLIED);
+        break;
+    case SDL_COPY_MOD:
+        SDL_Blit8888Rows_AVX2(info, modulate, true, scale, SDL_COPY_MOD);
+        break;
+    case SDL_COPY_MUL:
+        SDL_Blit8888Rows_AVX2(info, modulate, true, scale, SDL_COPY_MUL);
+        break;
+    default:
+        SDL_Blit8888Rows_AVX2(info, modulate, true, scale, 0);
+        break;
+    }
+}
+
+#endif // SDL_AVX2_INTRINSICS
+
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+
+static SDL_INLINE uint16x8_t SDL_Blit8888_MulDiv255_NEON(uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t x = vaddq_u16(vmulq_u16(a, b), vdupq_n_u16(1));
+    return vshrq_n_u16(vsraq_n_u16(x, x, 8), 8);
+}
+
+// Blends two pixels of 16-bit channels, the same way output_copycore() does
+SDL_FORCE_INLINE uint16x8_t SDL_Blit8888_Blend_NEON(uint16x8_t s, uint16x8_t d, int mode)
+{
+    static const Uint8 alpha_splat[16] = { 6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15 };
+    static const Uint16 alpha_lanes[8] = { 0, 0, 0, 255, 0, 0, 0, 255 };
+    const uint16x8_t alpha = vld1q_u16(alpha_lanes);
+    const uint16x8_t sA = vreinterpretq_u16_u8(vqtbl1q_u8(vreinterpretq_u8_u16(s), vld1q_u8(alpha_splat)));
+    const uint16x8_t inv_sA = vsubq_u16(vdupq_n_u16(255), sA);
+
+    if (mode & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
+        s = SDL_Blit8888_MulDiv255_NEON(s, vorrq_u16(sA, alpha));
+    }
+    switch (mode) {
+    case SDL_COPY_BLEND:
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        return vaddq_u16(SDL_Blit8888_MulDiv255_NEON(inv_sA, d), s);
+    case SDL_COPY_ADD:
+    case SDL_COPY_ADD_PREMULTIPLIED:
+        return vaddq_u16(vbicq_u16(s, alpha), d);
+    case SDL_COPY_MOD:
+        return SDL_Blit8888_MulDiv255_NEON(vorrq_u16(s, alpha), d);
+    case SDL_COPY_MUL:
+        return vaddq_u16(SDL_Blit8888_MulDiv255_NEON(vorrq_u16(s, alpha), d),
+                         SDL_Blit8888_MulDiv255_NEON(d, vbicq_u16(inv_sA, alpha)));
+    default:
+        return d;
+    }
+}
+
+SDL_FORCE_INLINE void SDL_Blit8888Rows_NEON(SDL_BlitInfo *info, bool modulate, bool blend, bool scale, int mode)
+{
+    const bool widen = blend || (modulate && (info->flags & SDL_COPY_MODULATE_MASK));
+    const uint8x16_t offsets = vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(0x0404040400000000), vcreate_u64(0x0c0c0c0c08080808)));
+    const uint8x16_t src_shuffle = vreinterpretq_u8_u32(vaddq_u32(vreinterpretq_u32_u8(offsets), vdupq_n_u32(SDL_Blit8888_ShuffleIn(info->src_fmt))));
+    const uint8x16_t dst_shuffle = vreinterpretq_u8_u32(vaddq_u32(vreinterpretq_u32_u8(offsets), vdupq_n_u32(SDL_Blit8888_ShuffleIn(info->dst_fmt))));
+    const uint8x16_t out_shuffle = vreinterpretq_u8_u32(vaddq_u32(vreinterpretq_u32_u8(offsets), vdupq_n_u32(SDL_Blit8888_ShuffleOut(info->dst_fmt))));
+    const uint8x16_t alpha_fill = vreinterpretq_u8_u32(vdupq_n_u32(info->src_fmt->Amask ? 0 : 0xFF000000));
+    uint16x8_t mod = vdupq_n_u16(255);
+    Uint64 posy = 0, posx = 0, incy = 0, incx = 0;
+    Uint32 pixels[4], dstpixels[4];
+
+    if (modulate) {
+        Uint16 m[8];
+        SDL_Blit8888_GetModulation(info, m);
+        SDL_memcpy(&m[4], m, 4 * sizeof(Uint16));
+        mod = vld1q_u16(m);
+    }
+    if (scale) {
+        incy = ((Uint64)info->src_h << 16) / info->dst_h;
+        incx = ((Uint64)info->src_w << 16) / info->dst_w;
+        posy = incy / 2;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)(scale ? info->src + (posy >> 16) * info->src_pitch : info->src);
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        posx = incx / 2;
+
+        while (n > 0) {
+            const int count = SDL_min(n, 4);
+            uint8x16_t s;
+            uint16x8_t lo, hi;
+
+            if (count == 4 && !scale) {
+                s = vld1q_u8((const Uint8 *)src);
+            } else if (count == 4) {
+                uint32x4_t v = vdupq_n_u32(src[posx >> 16]);
+                v = vsetq_lane_u32(src[(posx + incx) >> 16], v, 1);
+                v = vsetq_lane_u32(src[(posx + incx * 2) >> 16], v, 2);
+                v = vsetq_lane_u32(src[(posx + incx * 3) >> 16], v, 3);
+                s = vreinterpretq_u8_u32(v);
+                posx += incx * 4;
+            } else {
+                SDL_Blit8888_FetchRow(pixels, src, count, scale, &posx, incx);
+                s = vld1q_u8((const Uint8 *)pixels);
+            }
+            s = vorrq_u8(vqtbl1q_u8(s, src_shuffle), alpha_fill);
+
+            if (widen) {
+                lo = vmovl_u8(vget_low_u8(s));
+                hi = vmovl_high_u8(s);
+                if (modulate) {
+                    lo = SDL_Blit8888_MulDiv255_NEON(lo, mod);
+                    hi = SDL_Blit8888_MulDiv255_NEON(hi, mod);
+                }
+                if (blend) {
+                    uint8x16_t d;
+                    if (count == 4) {
+                        d = vld1q_u8((const Uint8 *)dst);
+                    } else {
+                        SDL_memcpy(dstpixels, dst, count * sizeof(Uint32));
+                        d = vld1q_u8((const Uint8 *)dstpixels);
+                    }
+                    d = vqtbl1q_u8(d, dst_shuffle);
+                    lo = SDL_Blit8888_Blend_NEON(lo, vmovl_u8(vget_low_u8(d)), mode);
+                    hi = SDL_Blit8888_Blend_NEON(hi, vmovl_high_u8(d), mode);
+                }
+                s = vqmovn_high_u16(vqmovn_u16(lo), hi);
+            }
+            s = vqtbl1q_u8(s, out_shuffle);
+
+            if (count == 4) {
+                vst1q_u8((Uint8 *)dst, s);
+            } else {
+                vst1q_u8((Uint8 *)dstpixels, s);
+                SDL_memcpy(dst, dstpixels, count * sizeof(Uint32));
+            }
+            if (!scale) {
+                src += count;
+            }
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+
+// Each blend mode gets its own copy of the loop, with the blending math inlined
+SDL_FORCE_INLINE void SDL_Blit8888_NEON(SDL_BlitInfo *info, bool modulate, bool blend, bool scale)
+{
+    if (!blend) {
+        SDL_Blit8888Rows_NEON(info, modulate, false, scale, 0);
+        return;
+    }
+    switch (info->flags & SDL_COPY_BLEND_MASK) {
+    case SDL_COPY_BLEND:
+        SDL_Blit8888Rows_NEON(info, modulate, true, scale, SDL_COPY_BLEND);
+        break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        SDL_Blit8888Rows_NEON(info, modulate, true, scale, SDL_COPY_BLEND_PREMULTIPLIED);
+        break;
+    case SDL_COPY_ADD:
+        SDL_Blit8888Rows_NEON(info, modulate, true, scale, SDL_COPY_ADD);
+        break;
+    case SDL_COPY_ADD_PREMULTIPLIED:
+        SDL_Blit8888Rows_NEON(info, modulate, true, scale, SDL_COPY_ADD_PREMULTIPLIED);
+        break;
+    case SDL_COPY_MOD:
+        SDL_Blit8888Rows_NEON(info, modulate, true, scale, SDL_COPY_MOD);
+        break;
+    case SDL_COPY_MUL:
+        SDL_Blit8888Rows_NEON(info, modulate, true, scale, SDL_COPY_MUL);
+        break;
+    default:
+        SDL_Blit8888Rows_NEON(info, modulate, true, scale, 0);
+        break;
+    }
+}
+
+#endif // SDL_NEON_INTRINSICS && __ARM_ARCH >= 8
+
+__EOF__
+}
+
+# Each SIMD kernel gets one entry point per modulate/blend/scale combination,
+# shared by all of the 32-bit formats.
+my @simd_isas = (
+    [ "AVX2", "SDL_AVX2_INTRINSICS", "SDL_CPU_AVX2", "SDL_TARGETING(\"avx2\") " ],
+    [ "SSE41", "SDL_SSE4_1_INTRINSICS", "SDL_CPU_SSE4_1", "SDL_TARGETING(\"sse4.1\") " ],
+    [ "NEON", "defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)", "SDL_CPU_NEON", "" ],
+);
+
+sub simd_guard
+{
+    my $guard = shift;
+    if ( $guard =~ /^SDL_[A-Z0-9_]+$/ ) {
+        return "#ifdef $guard";
+    }
+    return "#if $guard";
+}
+
+sub simd_funcname
+{
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+    my $isa = shift;
+
+    my $name = "SDL_Blit_8888";
+    if ( $modulate ) {
+        $name .= "_Modulate";
+    }
+    if ( $blend ) {
+        $name .= "_Blend";
+    }
+    if ( $scale ) {
+        $name .= "_Scale";
+    }
+    return "${name}_$isa";
+}
+
+sub output_simdfuncs
+{
+    foreach my $isa (@simd_isas) {
+        my ($name, $guard, $cpu, $target) = @$isa;
+        print FILE simd_guard($guard) . "\n\n";
+        for (my $modulate = 0; $modulate <= 1; ++$modulate) {
+            for (my $blend = 0; $blend <= 1; ++$blend) {
+                for (my $scale = 0; $scale <= 1; ++$scale) {
+                    if ( $modulate || $blend || $scale ) {
+                        my $m = $modulate ? "true" : "false";
+                        my $b = $blend ? "true" : "false";
+                        my $s = $scale ? "true" : "false";
+                        my $func = simd_funcname($modulate, $blend, $scale, $name);
+                        print FILE <<__EOF__;
+static void ${target}$func(SDL_BlitInfo *info)
+{
+    SDL_Blit8888_$name(info, $m, $b, $s);
+}
+
+__EOF__
+                    }
+                }
+            }
+        }
+        print FILE "#endif\n\n";
+    }
+}
+
 sub output_copyfunc_h
 {
 }
@@ -641,18 +1263,26 @@ sub output_copyinc
 __EOF__
 }
 
-sub output_copyfunctable
+sub output_copyfunctable_entries
 {
-    print FILE <<__EOF__;
-SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
-__EOF__
+    my $cpu = shift;
+    my $isa = shift;
+
     for (my $i = 0; $i <= $#src_formats; ++$i) {
         my $src = $src_formats[$i];
         for (my $j = 0; $j <= $#dst_formats; ++$j) {
             my $dst = $dst_formats[$j];
+            if ( $isa ne "" && ($format_size{$src} != 4 || $format_size{$dst} != 4) ) {
+                next;
+            }
             for (my $modulate = 0; $modulate <= 1; ++$modulate) {
                 for (my $blend = 0; $blend <= 1; ++$blend) {
                     for (my $scale = 0; $scale <= 1; ++$scale) {
+                        if ( $isa ne "" && $src eq $dst && !$modulate && !$blend ) {
+                            # A scaled copy between identical formats is just a gather, which the
+                            # scalar version does already, and it keeps the X byte intact.
+                            next;
+                        }
                         if ( $modulate || $blend || $scale ) {
                             print FILE "    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, ";
                             my $flags = "";
@@ -684,16 +1314,35 @@ __EOF__
                             if ( $flags eq "" ) {
                                 $flags = "0";
                             }
-                            print FILE "($flags), SDL_CPU_ANY,";
-                            output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n");
+                            print FILE "($flags), $cpu,";
+                            if ( $isa ne "" ) {
+                                print FILE " " . simd_funcname($modulate, $blend, $scale, $isa) . " },\n";
+                            } else {
+                                output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n");
+                            }
                         }
                     }
                 }
             }
         }
     }
+}
+
+sub output_copyfunctable
+{
+    print FILE <<__EOF__;
+SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
+__EOF__
+    # SDL_ChooseBlitFunc() takes the first match, so the SIMD entries go first
+    foreach my $isa (@simd_isas) {
+        my ($name, $guard, $cpu, $target) = @$isa;
+        print FILE simd_guard($guard) . "\n";
+        output_copyfunctable_entries($cpu, $name);
+        print FILE "#endif\n";
+    }
+    output_copyfunctable_entries("SDL_CPU_ANY", "");
     print FILE <<__EOF__;
-    { 0, 0, 0, 0, NULL }
+    { SDL_PIXELFORMAT_UNKNOWN, SDL_PIXELFORMAT_UNKNOWN, 0, 0, NULL }
 };
 
 __EOF__
@@ -727,6 +1376,8 @@ close_file("SDL_blit_auto.h");
 
 open_file("SDL_blit_auto.c");
 output_copyinc();
+output_simdkernels();
+output_simdfuncs();
 for (my $i = 0; $i <= $#src_formats; ++$i) {
     for (my $j = 0; $j <= $#dst_formats; ++$j) {
         output_copyfunc_c($src_formats[$i], $dst_formats[$j]);
@@ -0,0 +1,213 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how long a playback device spends mixing each period as
+   the number of bound streams grows. Run it with and without
+   SDL_AUDIO_DEVICE_MIXING_THREADS (see --threads) to compare. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define SOURCE_FREQ   44100
+#define SOURCE_FRAMES 4096
+
+static Sint16 source_data[SOURCE_FRAMES * 2];
+static SDL_AtomicInt source_offset;
+
+/* Timing is done with two logical devices on the same physical device: the
+   one opened last is mixed first and has no streams, so its postmix callback
+   marks the start of the period, and the other one's postmix marks the end. */
+static Uint64 period_start;
+static Uint64 total_mix_ns;
+static Uint64 worst_mix_ns;
+static int total_periods;
+
+static void SDLCALL period_start_callback(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+    period_start = SDL_GetTicksNS();
+}
+
+static void SDLCALL period_end_callback(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+    const Uint64 elapsed = SDL_GetTicksNS() - period_start;
+    total_mix_ns += elapsed;
+    if (elapsed > worst_mix_ns) {
+        worst_mix_ns = elapsed;
+    }
+    total_periods++;
+}
+
+static void SDLCALL feed_stream(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    const int framesize = (int)sizeof(Sint16) * 2;
+    int frames = additional_amount / framesize;
+    while (frames > 0) {
+        const int offset = (SDL_AddAtomicInt(&source_offset, 1) * 61) % SOURCE_FRAMES;
+        const int cpy = SDL_min(frames, SOURCE_FRAMES - offset);
+        SDL_PutAudioStreamData(stream, &source_data[offset * 2], cpy * framesize);
+        frames -= cpy;
+    }
+}
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--threads N]", "[--max-streams N]", "[--seconds N]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_AudioStream **streams = NULL;
+    SDL_AudioSpec srcspec;
+    SDL_AudioSpec devspec;
+    SDL_AudioDeviceID mixdev = 0;
+    SDL_AudioDeviceID markerdev = 0;
+    int threads = 0;
+    int max_streams = 256;
+    int seconds = 2;
+    int sample_frames = 0;
+    int num_streams;
+    int created = 0;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc) {
+            if (SDL_strcmp(argv[i], "--threads") == 0) {
+                threads = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--max-streams") == 0) {
+                max_streams = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--seconds") == 0) {
+                seconds = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0 || max_streams <= 0 || seconds <= 0 || threads < 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+
+        i += consumed;
+    }
+
+    if (threads > 0) {
+        char value[16];
+        (void)SDL_snprintf(value, sizeof(value), "%d", threads);
+        SDL_SetHint(SDL_HINT_AUDIO_DEVICE_MIXING_THREADS, value);
+    }
+
+    /* the dummy driver gives us a real device thread without needing hardware. */
+    if (!SDL_GetHint(SDL_HINT_AUDIO_DRIVER)) {
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    }
+
+    if (!SDL_Init(SDL_INIT_AUDIO)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    for (i = 0; i < SOURCE_FRAMES; i++) {
+        const Sint16 sample = (Sint16)(SDL_sinf((float)i * (2.0f * SDL_PI_F * 440.0f / SOURCE_FREQ)) * 8000.0f);
+        source_data[i * 2] = sample;
+        source_data[i * 2 + 1] = sample;
+    }
+
+    mixdev = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL);
+    markerdev = mixdev ? SDL_OpenAudioDevice(mixdev, NULL) : 0;
+    if (!markerdev) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open audio device: %s\n", SDL_GetError());
+        ret = 3;
+        goto end;
+    }
+
+    SDL_GetAudioDeviceFormat(mixdev, &devspec, &sample_frames);
+    SDL_Log("Driver '%s', %d Hz, %d channels, %d sample frames per period (%.2f ms budget), %d mixing threads",
+            SDL_GetCurrentAudioDriver(), devspec.freq, devspec.channels, sample_frames,
+            (sample_frames * 1000.0) / devspec.freq, threads);
+
+    streams = (SDL_AudioStream **)SDL_calloc(max_streams, sizeof(*streams));
+    if (!streams) {
+        ret = 4;
+        goto end;
+    }
+
+    /* 44.1kHz S16 sources on (probably) a 48kHz device, so every stream has to convert and resample. */
+    srcspec.format = SDL_AUDIO_S16;
+    srcspec.channels = 2;
+    srcspec.freq = SOURCE_FREQ;
+
+    SDL_PauseAudioDevice(mixdev);
+    SDL_SetAudioPostmixCallback(markerdev, period_start_callback, NULL);
+    SDL_SetAudioPostmixCallback(mixdev, period_end_callback, NULL);
+
+    SDL_Log("%8s %10s %12s %12s %8s", "streams", "periods", "avg us", "worst us", "budget");
+    for (num_streams = 1; num_streams <= max_streams; num_streams *= 2) {
+        double avg_us;
+
+        SDL_PauseAudioDevice(mixdev);
+        for (; created < num_streams; created++) {
+            streams[created] = SDL_CreateAudioStream(&srcspec, NULL);
+            if (!streams[created] ||
+                !SDL_SetAudioStreamGain(streams[created], 1.0f / max_streams) ||
+                !SDL_SetAudioStreamGetCallback(streams[created], feed_stream, NULL) ||
+                !SDL_BindAudioStream(mixdev, streams[created])) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to set up stream #%d: %s\n", created, SDL_GetError());
+                ret = 5;
+                goto end;
+            }
+        }
+
+        /* the device is paused, so the end-of-period callback isn't touching these right now. */
+        total_mix_ns = worst_mix_ns = 0;
+        total_periods = 0;
+
+        SDL_ResumeAudioDevice(mixdev);
+        SDL_Delay(seconds * 1000);
+        SDL_PauseAudioDevice(mixdev);
+        SDL_Delay(50);  /* let any in-flight period finish. */
+
+        if (total_periods == 0) {
+            SDL_Log("%8d %10d %12s %12s %8s", num_streams, 0, "-", "-", "-");
+            continue;
+        }
+        avg_us = (double)total_mix_ns / total_periods / 1000.0;
+        SDL_Log("%8d %10d %12.1f %12.1f %7.1f%%", num_streams, total_periods, avg_us,
+                (double)worst_mix_ns / 1000.0, (avg_us * 100.0) / ((sample_frames * 1000000.0) / devspec.freq));
+    }
+
+end:
+    if (streams) {
+        for (i = 0; i < created; i++) {
+            SDL_DestroyAudioStream(streams[i]);
+        }
+        SDL_free(streams);
+    }
+    SDL_CloseAudioDevice(markerdev);
+    SDL_CloseAudioDevice(mixdev);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
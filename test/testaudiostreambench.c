@@ -0,0 +1,179 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure the cost of converting, resampling and gain-adjusting
+   audio through a single SDL_AudioStream, compared to doing it in two
+   stages (convert+resample to float, then float to the final format with
+   gain), which is roughly what a stream did before it processed resampled
+   data in cache-sized blocks. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define INPUT_FRAMES 48000
+#define CHUNK_BYTES  (4096 * 8)
+
+typedef struct
+{
+    SDL_AudioFormat src_format;
+    int src_channels;
+    int src_freq;
+    SDL_AudioFormat dst_format;
+    int dst_channels;
+    int dst_freq;
+} BenchCase;
+
+static const BenchCase cases[] = {
+    { SDL_AUDIO_S16, 2, 44100, SDL_AUDIO_F32, 2, 48000 },
+    { SDL_AUDIO_S16, 2, 48000, SDL_AUDIO_F32, 2, 44100 },
+    { SDL_AUDIO_S16, 2, 44100, SDL_AUDIO_S16, 2, 48000 },
+    { SDL_AUDIO_F32, 2, 48000, SDL_AUDIO_S16, 2, 44100 },
+    { SDL_AUDIO_S16, 1, 22050, SDL_AUDIO_F32, 2, 48000 },
+    { SDL_AUDIO_F32, 1, 44100, SDL_AUDIO_S16, 1, 48000 },
+};
+
+static Uint8 chunk[CHUNK_BYTES];
+
+/* Drain whatever `stream` has into `next` (if any), returning the number of bytes that came out the end. */
+static int drain_stream(SDL_AudioStream *stream, SDL_AudioStream *next)
+{
+    int total = 0;
+    int got;
+
+    while ((got = SDL_GetAudioStreamData(stream, chunk, sizeof(chunk))) > 0) {
+        if (next) {
+            SDL_PutAudioStreamData(next, chunk, got);
+            total += drain_stream(next, NULL);
+        } else {
+            total += got;
+        }
+    }
+    return total;
+}
+
+static double bench(const BenchCase *c, const Uint8 *input, int input_len, int iterations, bool two_stage)
+{
+    SDL_AudioSpec src, mid, dst;
+    SDL_AudioStream *stream, *second = NULL;
+    Uint64 start, elapsed;
+    int i, total = 0;
+
+    src.format = c->src_format;
+    src.channels = c->src_channels;
+    src.freq = c->src_freq;
+    dst.format = c->dst_format;
+    dst.channels = c->dst_channels;
+    dst.freq = c->dst_freq;
+    mid.format = SDL_AUDIO_F32;
+    mid.channels = SDL_min(c->src_channels, c->dst_channels);
+    mid.freq = c->dst_freq;
+
+    if (two_stage) {
+        stream = SDL_CreateAudioStream(&src, &mid);
+        second = SDL_CreateAudioStream(&mid, &dst);
+        SDL_SetAudioStreamGain(second, 0.5f);
+    } else {
+        stream = SDL_CreateAudioStream(&src, &dst);
+        SDL_SetAudioStreamGain(stream, 0.5f);
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; i++) {
+        SDL_PutAudioStreamData(stream, input, input_len);
+        SDL_FlushAudioStream(stream);
+        total += drain_stream(stream, second);
+        if (second) {
+            SDL_FlushAudioStream(second);
+            total += drain_stream(second, NULL);
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_DestroyAudioStream(stream);
+    SDL_DestroyAudioStream(second);
+
+    return (double)elapsed / (total / SDL_AUDIO_FRAMESIZE(dst));
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    Uint8 *input = NULL;
+    int iterations = 50;
+    int i, j;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+            iterations = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    input = (Uint8 *)SDL_malloc(INPUT_FRAMES * 2 * sizeof(float));
+    if (!input) {
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("%-48s %14s %14s %8s", "conversion (gain 0.5)", "stream ns/frm", "2-stage ns/frm", "speedup");
+    for (i = 0; i < SDL_arraysize(cases); i++) {
+        const BenchCase *c = &cases[i];
+        const int frame_size = SDL_AUDIO_BYTESIZE(c->src_format) * c->src_channels;
+        char name[64];
+        double single_ns, staged_ns;
+
+        if (SDL_AUDIO_ISFLOAT(c->src_format)) {
+            float *f = (float *)input;
+            for (j = 0; j < INPUT_FRAMES * c->src_channels; j++) {
+                f[j] = SDL_sinf((float)j * 0.01f) * 0.8f;
+            }
+        } else {
+            Sint16 *s = (Sint16 *)input;
+            for (j = 0; j < INPUT_FRAMES * c->src_channels; j++) {
+                s[j] = (Sint16)(SDL_sinf((float)j * 0.01f) * 26000.0f);
+            }
+        }
+
+        single_ns = bench(c, input, INPUT_FRAMES * frame_size, iterations, false);
+        staged_ns = bench(c, input, INPUT_FRAMES * frame_size, iterations, true);
+
+        (void)SDL_snprintf(name, sizeof(name), "%s/%d/%d -> %s/%d/%d",
+                           SDL_GetAudioFormatName(c->src_format), c->src_channels, c->src_freq,
+                           SDL_GetAudioFormatName(c->dst_format), c->dst_channels, c->dst_freq);
+        SDL_Log("%-48s %14.2f %14.2f %7.2fx", name, single_ns, staged_ns, (single_ns > 0.0) ? (staged_ns / single_ns) : 0.0);
+    }
+
+    SDL_free(input);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
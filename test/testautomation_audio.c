@@ -1445,6 +1445,1252 @@ cleanup:
 
     return status;
 }
+
+#define LOCKFREE_TEST_FRAMES 20000
+
+typedef struct
+{
+    SDL_AudioStream *stream;
+    const Sint16 *data;
+    int frames;
+    bool result;
+} LockFreeProducer;
+
+/* Puts data in odd-sized packets, changing the input format half way through. */
+static bool put_lockfree_test_data(SDL_AudioStream *stream, const Sint16 *data, int frames)
+{
+    SDL_AudioSpec spec;
+    int i, packet;
+
+    spec.format = SDL_AUDIO_S16;
+    spec.channels = 2;
+    spec.freq = 44100;
+
+    for (i = 0; i < frames; i += packet) {
+        if (i >= frames / 2 && spec.freq == 44100) {
+            spec.freq = 22050;
+            if (!SDL_SetAudioStreamFormat(stream, &spec, NULL)) {
+                return false;
+            }
+        }
+        packet = SDL_min(frames - i, 1 + (i % 397));
+        if (!SDL_PutAudioStreamData(stream, &data[i * 2], packet * 4)) {
+            return false;
+        }
+    }
+    return SDL_FlushAudioStream(stream);
+}
+
+static int SDLCALL lockfree_producer_thread(void *arg)
+{
+    LockFreeProducer *producer = (LockFreeProducer *)arg;
+    producer->result = put_lockfree_test_data(producer->stream, producer->data, producer->frames);
+    return 0;
+}
+
+/**
+ * Checks that a stream created with SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BOOLEAN gives the same output as a
+ * regular stream, including across a format change and with data that doesn't fit in its ring buffer.
+ *
+ * \sa SDL_CreateAudioStreamWithProperties
+ */
+static int SDLCALL audio_lockFreeStream(void *arg)
+{
+    SDL_AudioSpec src_spec, dst_spec;
+    SDL_AudioStream *reference = NULL;
+    SDL_AudioStream *stream = NULL;
+    SDL_PropertiesID props = 0;
+    SDL_Thread *thread = NULL;
+    LockFreeProducer producer;
+    Sint16 *input = NULL;
+    Uint8 *expected = NULL;
+    Uint8 *output = NULL;
+    int expected_len = 0;
+    int output_len = 0;
+    int output_capacity;
+    int pass, i, got;
+    int status = TEST_ABORTED;
+
+    src_spec.format = SDL_AUDIO_S16;
+    src_spec.channels = 2;
+    src_spec.freq = 44100;
+    dst_spec.format = SDL_AUDIO_F32;
+    dst_spec.channels = 2;
+    dst_spec.freq = 48000;
+
+    input = (Sint16 *)SDL_malloc(LOCKFREE_TEST_FRAMES * 4);
+    output_capacity = LOCKFREE_TEST_FRAMES * 8 * 3;
+    expected = (Uint8 *)SDL_malloc(output_capacity);
+    output = (Uint8 *)SDL_malloc(output_capacity);
+    if (!SDLTest_AssertCheck(input && expected && output, "Expected buffers to be allocated")) {
+        goto cleanup;
+    }
+
+    for (i = 0; i < LOCKFREE_TEST_FRAMES * 2; i++) {
+        input[i] = (Sint16)(SDL_sin(i * 0.01) * 20000.0);
+    }
+
+    reference = SDL_CreateAudioStream(&src_spec, &dst_spec);
+    if (!SDLTest_AssertCheck(reference != NULL, "Expected SDL_CreateAudioStream to succeed")) {
+        goto cleanup;
+    }
+    SDLTest_AssertCheck(put_lockfree_test_data(reference, input, LOCKFREE_TEST_FRAMES), "Expected reference stream to accept data");
+    expected_len = SDL_GetAudioStreamData(reference, expected, output_capacity);
+    SDLTest_AssertCheck(expected_len > 0, "Expected reference stream to produce data");
+
+    props = SDL_CreateProperties();
+    SDL_SetBooleanProperty(props, SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BOOLEAN, true);
+    SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BUFFER_SIZE_NUMBER, 2048);
+
+    /* first pass puts everything before getting anything, second pass puts from another thread while getting. */
+    for (pass = 0; pass < 2; pass++) {
+        stream = SDL_CreateAudioStreamWithProperties(&src_spec, &dst_spec, props);
+        if (!SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStreamWithProperties to succeed")) {
+            goto cleanup;
+        }
+
+        output_len = 0;
+        if (pass == 0) {
+            SDLTest_AssertCheck(put_lockfree_test_data(stream, input, LOCKFREE_TEST_FRAMES), "Expected lock-free stream to accept data");
+            output_len = SDL_GetAudioStreamData(stream, output, output_capacity);
+        } else {
+            producer.stream = stream;
+            producer.data = input;
+            producer.frames = LOCKFREE_TEST_FRAMES;
+            producer.result = false;
+            thread = SDL_CreateThread(lockfree_producer_thread, "LockFreeProducer", &producer);
+            if (!SDLTest_AssertCheck(thread != NULL, "Expected SDL_CreateThread to succeed")) {
+                goto cleanup;
+            }
+            while (output_len < expected_len) {
+                got = SDL_GetAudioStreamData(stream, output + output_len, SDL_min(4096, output_capacity - output_len));
+                if (got < 0) {
+                    break;
+                } else if (got == 0) {
+                    SDL_Delay(1);
+                }
+                output_len += got;
+            }
+            SDL_WaitThread(thread, NULL);
+            thread = NULL;
+            SDLTest_AssertCheck(producer.result, "Expected lock-free stream to accept data from another thread");
+            output_len += SDL_GetAudioStreamData(stream, output + output_len, output_capacity - output_len);
+        }
+
+        SDLTest_AssertCheck(output_len == expected_len, "Expected %d bytes from lock-free stream, got %d", expected_len, output_len);
+        SDLTest_AssertCheck(output_len == expected_len && SDL_memcmp(output, expected, expected_len) == 0, "Expected lock-free stream output to match the reference stream");
+
+        SDL_DestroyAudioStream(stream);
+        stream = NULL;
+    }
+
+    status = TEST_COMPLETED;
+
+cleanup:
+    SDL_DestroyProperties(props);
+    SDL_DestroyAudioStream(stream);
+    SDL_DestroyAudioStream(reference);
+    SDL_free(input);
+    SDL_free(expected);
+    SDL_free(output);
+
+    return status;
+}
+
+typedef struct
+{
+    int count;
+    const void *released[4];
+    int lengths[4];
+} NoCopyReleases;
+
+static void SDLCALL nocopy_release_callback(void *userdata, const void *buf, int buflen)
+{
+    NoCopyReleases *releases = (NoCopyReleases *)userdata;
+    if (releases->count < (int)SDL_arraysize(releases->released)) {
+        releases->released[releases->count] = buf;
+        releases->lengths[releases->count] = buflen;
+    }
+    releases->count++;
+}
+
+/* Puts data into a stream, copying it or not, and then gets it out again with the input format
+   changing while the first buffer has only been partially consumed. */
+static int nocopy_test_stream(SDL_AudioStream *stream, bool nocopy, NoCopyReleases *releases,
+                              const Sint16 *buffer_1, int length_1, const float *buffer_2, int length_2,
+                              Uint8 *output, int output_len)
+{
+    SDL_AudioSpec spec2;
+    int total, got;
+
+    spec2.format = SDL_AUDIO_F32;
+    spec2.channels = 1;
+    spec2.freq = 22050;
+
+    if (nocopy) {
+        SDLTest_AssertCheck(SDL_PutAudioStreamDataNoCopy(stream, buffer_1, length_1, nocopy_release_callback, releases), "Expected SDL_PutAudioStreamDataNoCopy(buffer_1) to succeed");
+    } else {
+        SDLTest_AssertCheck(SDL_PutAudioStreamData(stream, buffer_1, length_1), "Expected SDL_PutAudioStreamData(buffer_1) to succeed");
+    }
+
+    /* read some of the first buffer, then change the format before the rest of it has been consumed. */
+    total = SDL_GetAudioStreamData(stream, output, output_len / 4);
+    SDLTest_AssertCheck(total > 0, "Expected to get data from the first buffer");
+    if (nocopy) {
+        SDLTest_AssertCheck(releases->count == 0, "Expected buffer_1 to still be in use, released %d buffers", releases->count);
+    }
+
+    SDLTest_AssertCheck(SDL_SetAudioStreamFormat(stream, &spec2, NULL), "Expected SDL_SetAudioStreamFormat(spec2) to succeed");
+
+    if (nocopy) {
+        SDLTest_AssertCheck(SDL_PutAudioStreamDataNoCopy(stream, buffer_2, length_2, nocopy_release_callback, releases), "Expected SDL_PutAudioStreamDataNoCopy(buffer_2) to succeed");
+    } else {
+        SDLTest_AssertCheck(SDL_PutAudioStreamData(stream, buffer_2, length_2), "Expected SDL_PutAudioStreamData(buffer_2) to succeed");
+    }
+    SDLTest_AssertCheck(SDL_FlushAudioStream(stream), "Expected SDL_FlushAudioStream to succeed");
+
+    while (total < output_len && (got = SDL_GetAudioStreamData(stream, output + total, SDL_min(1000, output_len - total))) > 0) {
+        total += got;
+    }
+    return total;
+}
+
+/**
+ * Checks that SDL_PutAudioStreamDataNoCopy gives the same output as SDL_PutAudioStreamData, including when
+ * the input format changes part way through a buffer, and that buffers are released exactly once.
+ *
+ * \sa SDL_PutAudioStreamDataNoCopy
+ */
+static int SDLCALL audio_putNoCopy(void *arg)
+{
+    SDL_AudioSpec spec1, dst_spec;
+    SDL_AudioStream *reference = NULL;
+    SDL_AudioStream *stream = NULL;
+    NoCopyReleases releases;
+    Sint16 *buffer_1 = NULL;
+    float *buffer_2 = NULL;
+    Uint8 *expected = NULL;
+    Uint8 *output = NULL;
+    const int frames_1 = 10000;
+    const int frames_2 = 6000;
+    const int output_len = 48000 * 8;
+    int expected_len, result, i;
+    int status = TEST_ABORTED;
+
+    spec1.format = SDL_AUDIO_S16;
+    spec1.channels = 2;
+    spec1.freq = 44100;
+    dst_spec.format = SDL_AUDIO_F32;
+    dst_spec.channels = 2;
+    dst_spec.freq = 48000;
+
+    buffer_1 = (Sint16 *)SDL_malloc(frames_1 * 2 * sizeof(Sint16));
+    buffer_2 = (float *)SDL_malloc(frames_2 * sizeof(float));
+    expected = (Uint8 *)SDL_malloc(output_len);
+    output = (Uint8 *)SDL_malloc(output_len);
+    if (!SDLTest_AssertCheck(buffer_1 && buffer_2 && expected && output, "Expected buffers to be allocated")) {
+        goto cleanup;
+    }
+
+    for (i = 0; i < frames_1 * 2; i++) {
+        buffer_1[i] = (Sint16)(SDL_sin(i * 0.013) * 20000.0);
+    }
+    for (i = 0; i < frames_2; i++) {
+        buffer_2[i] = (float)SDL_sin(i * 0.021) * 0.6f;
+    }
+
+    reference = SDL_CreateAudioStream(&spec1, &dst_spec);
+    stream = SDL_CreateAudioStream(&spec1, &dst_spec);
+    if (!SDLTest_AssertCheck(reference && stream, "Expected SDL_CreateAudioStream to succeed")) {
+        goto cleanup;
+    }
+
+    SDL_zero(releases);
+    expected_len = nocopy_test_stream(reference, false, NULL, buffer_1, frames_1 * 4, buffer_2, frames_2 * 4, expected, output_len);
+    result = nocopy_test_stream(stream, true, &releases, buffer_1, frames_1 * 4, buffer_2, frames_2 * 4, output, output_len);
+
+    SDLTest_AssertCheck(expected_len > 0, "Expected the reference stream to produce data");
+    SDLTest_AssertCheck(result == expected_len, "Expected %d bytes, got %d", expected_len, result);
+    SDLTest_AssertCheck(result == expected_len && SDL_memcmp(output, expected, expected_len) == 0, "Expected output to match SDL_PutAudioStreamData");
+    SDLTest_AssertCheck(releases.count == 2, "Expected both buffers to be released once consumed, released %d", releases.count);
+    SDLTest_AssertCheck(releases.released[0] == buffer_1 && releases.lengths[0] == frames_1 * 4, "Expected buffer_1 to be released first");
+    SDLTest_AssertCheck(releases.released[1] == buffer_2 && releases.lengths[1] == frames_2 * 4, "Expected buffer_2 to be released second");
+
+    /* Clearing or destroying a stream releases buffers that haven't been consumed. */
+    SDL_zero(releases);
+    SDLTest_AssertCheck(SDL_PutAudioStreamDataNoCopy(stream, buffer_1, frames_1 * 4, nocopy_release_callback, &releases), "Expected SDL_PutAudioStreamDataNoCopy to succeed");
+    SDLTest_AssertCheck(SDL_ClearAudioStream(stream), "Expected SDL_ClearAudioStream to succeed");
+    SDLTest_AssertCheck(releases.count == 1, "Expected SDL_ClearAudioStream to release the buffer, released %d", releases.count);
+
+    SDL_zero(releases);
+    SDLTest_AssertCheck(SDL_PutAudioStreamDataNoCopy(stream, buffer_1, frames_1 * 4, nocopy_release_callback, &releases), "Expected SDL_PutAudioStreamDataNoCopy to succeed");
+    SDL_DestroyAudioStream(stream);
+    stream = NULL;
+    SDLTest_AssertCheck(releases.count == 1, "Expected SDL_DestroyAudioStream to release the buffer, released %d", releases.count);
+
+    /* Partial frames are refused, and the app keeps the buffer. */
+    stream = SDL_CreateAudioStream(&spec1, &dst_spec);
+    SDL_zero(releases);
+    SDLTest_AssertCheck(!SDL_PutAudioStreamDataNoCopy(stream, buffer_1, 3, nocopy_release_callback, &releases), "Expected SDL_PutAudioStreamDataNoCopy to refuse a partial frame");
+    SDLTest_AssertCheck(releases.count == 0, "Expected a refused buffer not to be released, released %d", releases.count);
+
+    status = TEST_COMPLETED;
+
+cleanup:
+    SDL_DestroyAudioStream(stream);
+    SDL_DestroyAudioStream(reference);
+    SDL_free(buffer_1);
+    SDL_free(buffer_2);
+    SDL_free(expected);
+    SDL_free(output);
+
+    return status;
+}
+
+static void wav_write_le(Uint8 **p, Uint32 value, int bytes)
+{
+    int i;
+    for (i = 0; i < bytes; i++) {
+        *(*p)++ = (Uint8)(value >> (i * 8));
+    }
+}
+
+/* Builds a WAVE file in memory. `declared_len` can be larger than `data_len` to fake a truncated file. */
+static Uint8 *wav_build(Uint16 formattag, Uint16 channels, Uint16 bits, Uint16 blockalign, Uint16 samplesperblock,
+                        const Uint8 *data, Uint32 data_len, Uint32 declared_len, size_t *wav_len)
+{
+    static const Sint16 msadpcm_coeffs[14] = { 256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232 };
+    const Uint32 fmt_len = formattag == 0x0002 ? 50 : (formattag == 0x0011 ? 20 : 16);
+    const size_t len = 12 + 8 + fmt_len + 8 + data_len;
+    Uint8 *wav = (Uint8 *)SDL_malloc(len);
+    Uint8 *p = wav;
+
+    if (!wav) {
+        return NULL;
+    }
+
+    SDL_memcpy(p, "RIFF", 4);
+    p += 4;
+    wav_write_le(&p, (Uint32)(len - 8 + (declared_len - data_len)), 4);
+    SDL_memcpy(p, "WAVEfmt ", 8);
+    p += 8;
+    wav_write_le(&p, fmt_len, 4);
+    wav_write_le(&p, formattag, 2);
+    wav_write_le(&p, channels, 2);
+    wav_write_le(&p, 44100, 4);
+    wav_write_le(&p, 44100 * blockalign, 4);
+    wav_write_le(&p, blockalign, 2);
+    wav_write_le(&p, bits, 2);
+    if (fmt_len > 16) {
+        wav_write_le(&p, fmt_len - 18, 2);
+        wav_write_le(&p, samplesperblock, 2);
+    }
+    if (formattag == 0x0002) {
+        int i;
+        wav_write_le(&p, SDL_arraysize(msadpcm_coeffs) / 2, 2);
+        for (i = 0; i < SDL_arraysize(msadpcm_coeffs); i++) {
+            wav_write_le(&p, (Uint16)msadpcm_coeffs[i], 2);
+        }
+    }
+    SDL_memcpy(p, "data", 4);
+    p += 4;
+    wav_write_le(&p, declared_len, 4);
+    SDL_memcpy(p, data, data_len);
+
+    *wav_len = len;
+    return wav;
+}
+
+/* Gets everything out of a stream that decodes on demand. */
+static int wav_stream_drain(SDL_AudioStream *stream, Uint8 *buf, int buf_len)
+{
+    int total = 0;
+    int got;
+
+    while (total < buf_len && (got = SDL_GetAudioStreamData(stream, buf + total, SDL_min(4000, buf_len - total))) > 0) {
+        total += got;
+    }
+    return total;
+}
+
+/**
+ * Check that streaming a WAVE file decodes the same data as loading it, from the start and after seeking.
+ *
+ * \sa SDL_OpenWAVStream_IO
+ * \sa SDL_SeekWAVStream
+ */
+static int SDLCALL audio_streamWAV(void *arg)
+{
+    static const struct
+    {
+        const char *name;
+        Uint16 formattag;
+        Uint16 channels;
+        Uint16 bits;
+        Uint16 blockalign;
+        Uint16 samplesperblock;
+        Uint32 data_len;
+        Uint32 declared_len;
+    } cases[] = {
+        { "16-bit PCM", 0x0001, 2, 16, 4, 0, 40000, 40000 },
+        { "24-bit PCM", 0x0001, 1, 24, 3, 0, 30000, 30000 },
+        { "mu-law", 0x0007, 2, 8, 2, 0, 20000, 20000 },
+        { "IMA ADPCM", 0x0011, 2, 4, 512, 505, 512 * 7 + 200, 512 * 7 + 200 },
+        { "truncated IMA ADPCM", 0x0011, 1, 4, 256, 505, 256 * 9 + 100, 256 * 12 },
+    };
+    Uint8 *data = NULL;
+    Uint8 *output = NULL;
+    const int output_len = 1024 * 1024;
+    int i, j;
+
+    data = (Uint8 *)SDL_malloc(40000);
+    output = (Uint8 *)SDL_malloc(output_len);
+    if (!SDLTest_AssertCheck(data && output, "Expected buffers to be allocated")) {
+        SDL_free(data);
+        SDL_free(output);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < 40000; i++) {
+        data[i] = (Uint8)(SDL_sin(i * 0.05) * 100.0 + (i * 7 % 13));
+    }
+
+    for (i = 0; i < SDL_arraysize(cases); i++) {
+        SDL_AudioSpec load_spec, stream_spec;
+        SDL_AudioStream *stream;
+        Uint8 *wav, *loaded = NULL;
+        Uint32 loaded_len = 0;
+        size_t wav_len;
+        Sint64 frames = 0;
+        int framesize, result;
+
+        /* IMA ADPCM block headers need a valid step index. */
+        if (cases[i].formattag == 0x0011) {
+            for (j = 0; j + cases[i].blockalign <= (int)cases[i].data_len; j += cases[i].blockalign) {
+                data[j + 2] = (Uint8)(j % 89);
+                data[j + 3] = 0;
+                if (cases[i].channels == 2) {
+                    data[j + 6] = (Uint8)(j % 83);
+                    data[j + 7] = 0;
+                }
+            }
+        }
+
+        wav = wav_build(cases[i].formattag, cases[i].channels, cases[i].bits, cases[i].blockalign, cases[i].samplesperblock,
+                        data, cases[i].data_len, cases[i].declared_len, &wav_len);
+        if (!SDLTest_AssertCheck(wav != NULL, "Expected the %s WAVE file to be built", cases[i].name)) {
+            continue;
+        }
+
+        result = SDL_LoadWAV_IO(SDL_IOFromConstMem(wav, wav_len), true, &load_spec, &loaded, &loaded_len);
+        SDLTest_AssertCheck(result, "Expected SDL_LoadWAV_IO to load %s, error: %s", cases[i].name, SDL_GetError());
+
+        stream = SDL_OpenWAVStream_IO(SDL_IOFromConstMem(wav, wav_len), true, &stream_spec, &frames);
+        SDLTest_AssertCheck(stream != NULL, "Expected SDL_OpenWAVStream_IO to open %s, error: %s", cases[i].name, SDL_GetError());
+
+        if (result && stream) {
+            framesize = SDL_AUDIO_FRAMESIZE(load_spec);
+            SDLTest_AssertCheck(SDL_memcmp(&load_spec, &stream_spec, sizeof(load_spec)) == 0, "Expected the same spec from both");
+            SDLTest_AssertCheck(frames * framesize == loaded_len, "Expected %d frames, got %d", (int)(loaded_len / framesize), (int)frames);
+
+            result = wav_stream_drain(stream, output, output_len);
+            SDLTest_AssertCheck(result == (int)loaded_len && SDL_memcmp(output, loaded, loaded_len) == 0,
+                                "Expected the streamed %s data to match (%d of %d bytes)", cases[i].name, result, (int)loaded_len);
+
+            /* Seek back into the middle of a block. */
+            j = (int)(frames / 3);
+            SDLTest_AssertCheck(SDL_SeekWAVStream(stream, j), "Expected SDL_SeekWAVStream to succeed");
+            result = wav_stream_drain(stream, output, output_len);
+            SDLTest_AssertCheck(result == (int)loaded_len - j * framesize && SDL_memcmp(output, loaded + j * framesize, result) == 0,
+                                "Expected the %s data after seeking to frame %d to match", cases[i].name, j);
+
+            SDLTest_AssertCheck(SDL_SeekWAVStream(stream, frames), "Expected seeking to the end to succeed");
+            SDLTest_AssertCheck(wav_stream_drain(stream, output, output_len) == 0, "Expected no data at the end");
+            SDLTest_AssertCheck(!SDL_SeekWAVStream(stream, frames + 1), "Expected seeking past the end to fail");
+        }
+
+        SDL_DestroyAudioStream(stream);
+        SDL_free(loaded);
+        SDL_free(wav);
+    }
+
+    SDLTest_AssertCheck(!SDL_SeekWAVStream(NULL, 0), "Expected SDL_SeekWAVStream to fail on a NULL stream");
+
+    SDL_free(data);
+    SDL_free(output);
+
+    return TEST_COMPLETED;
+}
+
+/* Straightforward G.711 decoders to check SDL's against. */
+static Sint16 law_reference_decode(Uint16 formattag, Uint8 byte)
+{
+    int sign, exponent, mantissa, magnitude;
+
+    if (formattag == 0x0006) {
+        byte ^= 0x55;
+        sign = (byte & 0x80) ? 1 : -1;
+        exponent = (byte >> 4) & 0x07;
+        mantissa = byte & 0x0f;
+        magnitude = exponent == 0 ? (mantissa << 4) + 8 : ((mantissa << 4) + 0x108) << (exponent - 1);
+    } else {
+        byte = (Uint8)~byte;
+        sign = (byte & 0x80) ? -1 : 1;
+        exponent = (byte >> 4) & 0x07;
+        mantissa = byte & 0x0f;
+        magnitude = (((mantissa << 3) + 0x84) << exponent) - 0x84;
+    }
+    return (Sint16)(sign * magnitude);
+}
+
+/**
+ * Check A-law and mu-law decoding against reference decoders, with lengths that exercise both the vectorized and the scalar code.
+ *
+ * \sa SDL_LoadWAV_IO
+ */
+static int SDLCALL audio_loadWAVCompanded(void *arg)
+{
+    static const Uint16 formattags[] = { 0x0006, 0x0007 };
+    static const Uint32 lengths[] = { 1, 15, 16, 17, 255, 256 * 9 + 7 };
+    Uint8 data[256 * 9 + 7];
+    int i, j, k;
+
+    for (i = 0; i < (int)sizeof(data); i++) {
+        data[i] = (Uint8)(i * 37 + i / 256);
+    }
+
+    for (i = 0; i < SDL_arraysize(formattags); i++) {
+        for (j = 0; j < SDL_arraysize(lengths); j++) {
+            SDL_AudioSpec spec;
+            Uint8 *wav, *buf = NULL;
+            Uint32 buf_len = 0;
+            size_t wav_len;
+            int mismatches = 0;
+
+            wav = wav_build(formattags[i], 1, 8, 1, 0, data, lengths[j], lengths[j], &wav_len);
+            if (!SDLTest_AssertCheck(wav != NULL, "Expected the WAVE file to be built")) {
+                continue;
+            }
+
+            if (SDLTest_AssertCheck(SDL_LoadWAV_IO(SDL_IOFromConstMem(wav, wav_len), true, &spec, &buf, &buf_len),
+                                    "Expected SDL_LoadWAV_IO to succeed, error: %s", SDL_GetError())) {
+                SDLTest_AssertCheck(spec.format == SDL_AUDIO_S16 && buf_len == lengths[j] * 2, "Expected %d S16 samples", (int)lengths[j]);
+                for (k = 0; k < (int)SDL_min(lengths[j], buf_len / 2); k++) {
+                    if (((Sint16 *)buf)[k] != law_reference_decode(formattags[i], data[k])) {
+                        mismatches++;
+                    }
+                }
+                SDLTest_AssertCheck(mismatches == 0, "Expected all %d %s samples to match, %d didn't", (int)lengths[j],
+                                    formattags[i] == 0x0006 ? "A-law" : "mu-law", mismatches);
+            }
+
+            SDL_free(buf);
+            SDL_free(wav);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/* What SDL_MixAudio computes for one native-endian sample with a volume up to 1.0. */
+static Sint64 mix_reference_int(Sint64 dst, Sint64 src, int volume, Sint64 min, Sint64 max)
+{
+    const Sint64 mixed = dst + (src * volume) / 128;
+    return mixed < min ? min : (mixed > max ? max : mixed);
+}
+
+/* Loads `blocks` stereo ADPCM blocks and compares them with `expected`. */
+static void audio_checkADPCM(Uint16 formattag, const char *name, int blockalign, int samplesperblock, const Uint8 *data, int blocks, const Sint16 *expected)
+{
+    const int samples = blocks * samplesperblock * 2;
+    SDL_AudioSpec spec;
+    Uint8 *wav, *buf = NULL;
+    Uint32 buf_len = 0;
+    size_t wav_len;
+    int i, mismatches = 0;
+
+    wav = wav_build(formattag, 2, 4, (Uint16)blockalign, (Uint16)samplesperblock, data, blocks * blockalign, blocks * blockalign, &wav_len);
+    if (!SDLTest_AssertCheck(wav != NULL, "Expected the WAVE file to be built")) {
+        return;
+    }
+
+    if (SDLTest_AssertCheck(SDL_LoadWAV_IO(SDL_IOFromConstMem(wav, wav_len), true, &spec, &buf, &buf_len),
+                            "Expected SDL_LoadWAV_IO to succeed, error: %s", SDL_GetError())) {
+        SDLTest_AssertCheck(spec.format == SDL_AUDIO_S16 && spec.channels == 2 && buf_len == (Uint32)samples * 2,
+                            "Expected %d stereo S16 samples, got %d bytes", samples, (int)buf_len);
+        for (i = 0; i < (int)SDL_min((Uint32)samples, buf_len / 2); i++) {
+            if (((Sint16 *)buf)[i] != expected[i]) {
+                if (mismatches == 0) {
+                    SDLTest_LogError("First %s mismatch at sample %d: expected %d, got %d", name, i, (int)expected[i], (int)((Sint16 *)buf)[i]);
+                }
+                mismatches++;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Expected all %d %s samples to match, %d didn't", samples, name, mismatches);
+    }
+
+    SDL_free(buf);
+    SDL_free(wav);
+}
+
+/* Straightforward ADPCM decoders, one sample of one channel at a time, to check SDL's against. */
+static Sint16 ima_reference_decode(int *index, Sint16 last, Uint8 nybble)
+{
+    static const int index_table[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+    static const int step_table[89] = {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+        107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+        876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+        5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+        27086, 29794, 32767
+    };
+    const int step = step_table[*index];
+    int delta = step >> 3;
+
+    if (nybble & 4) {
+        delta += step;
+    }
+    if (nybble & 2) {
+        delta += step >> 1;
+    }
+    if (nybble & 1) {
+        delta += step >> 2;
+    }
+    *index = SDL_clamp(*index + index_table[nybble], 0, 88);
+    return (Sint16)SDL_clamp(last + ((nybble & 8) ? -delta : delta), -32768, 32767);
+}
+
+static Sint16 msadpcm_reference_decode(int *delta, int coeff1, int coeff2, Sint16 sample1, Sint16 sample2, Uint8 nybble)
+{
+    static const int adaptive[16] = { 230, 230, 230, 230, 307, 409, 512, 614, 768, 614, 512, 409, 307, 230, 230, 230 };
+    const int predicted = (sample1 * coeff1 + sample2 * coeff2) / 256 + *delta * (nybble >= 8 ? nybble - 16 : nybble);
+
+    *delta = SDL_clamp(*delta * adaptive[nybble] / 256, 16, 65535);
+    return (Sint16)SDL_clamp(predicted, -32768, 32767);
+}
+
+/**
+ * Check stereo MS ADPCM and IMA ADPCM decoding against reference decoders.
+ *
+ * \sa SDL_LoadWAV_IO
+ */
+static int SDLCALL audio_loadWAVStereoADPCM(void *arg)
+{
+    static const int coeffs[7][2] = { { 256, 0 }, { 512, -256 }, { 0, 0 }, { 192, 64 }, { 240, 0 }, { 460, -208 }, { 392, -232 } };
+    const int blocks = 3;
+    const int blockalign = 256;
+    const int ima_frames = 1 + (blockalign - 8);
+    const int ms_frames = 2 + (blockalign - 14);
+    Uint8 data[256 * 3];
+    Sint16 expected[256 * 3 * 2];  /* a block has fewer frames than bytes */
+    Uint32 seed = 0x1234567;
+    int i, b, c;
+
+    for (i = 0; i < (int)sizeof(data); i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (Uint8)(seed >> 16);
+    }
+
+    /* IMA ADPCM: per channel, a 16-bit sample and a step index, then the channels take turns with 32 bits of nibbles. */
+    for (b = 0; b < blocks; b++) {
+        Uint8 *block = data + b * blockalign;
+        Sint16 *out = expected + b * ima_frames * 2;
+
+        for (c = 0; c < 2; c++) {
+            int index = (b * 29 + c * 41) % 89;
+            Sint16 sample = (Sint16)(block[c * 4] | (block[c * 4 + 1] << 8));
+            int frame = 1;
+
+            block[c * 4 + 2] = (Uint8)index;
+            block[c * 4 + 3] = 0;
+            out[c] = sample;
+            for (i = 0; frame < ima_frames; i++) {
+                const Uint8 byte = block[8 + (i / 4) * 8 + c * 4 + (i % 4)];
+                sample = ima_reference_decode(&index, sample, byte & 0x0f);
+                out[frame++ * 2 + c] = sample;
+                if (frame < ima_frames) {
+                    sample = ima_reference_decode(&index, sample, byte >> 4);
+                    out[frame++ * 2 + c] = sample;
+                }
+            }
+        }
+    }
+    audio_checkADPCM(0x0011, "IMA ADPCM", blockalign, ima_frames, data, blocks, expected);
+
+    /* MS ADPCM: predictors, deltas, then the two starting samples, latest first, for each channel. Each following byte is one frame. */
+    for (b = 0; b < blocks; b++) {
+        Uint8 *block = data + b * blockalign;
+        Sint16 *out = expected + b * ms_frames * 2;
+
+        for (c = 0; c < 2; c++) {
+            const int predictor = (b * 3 + c * 5) % 7;
+            int delta = 16 + ((b * 97 + c * 389) % 2000);
+            Sint16 sample1 = (Sint16)(block[6 + c * 2] | (block[7 + c * 2] << 8));
+            Sint16 sample2 = (Sint16)(block[10 + c * 2] | (block[11 + c * 2] << 8));
+
+            block[c] = (Uint8)predictor;
+            block[2 + c * 2] = (Uint8)delta;
+            block[3 + c * 2] = (Uint8)(delta >> 8);
+            out[c] = sample2;
+            out[2 + c] = sample1;
+            for (i = 2; i < ms_frames; i++) {
+                const Uint8 byte = block[14 + i - 2];
+                const Sint16 sample = msadpcm_reference_decode(&delta, coeffs[predictor][0], coeffs[predictor][1], sample1, sample2,
+                                                               c == 0 ? (byte >> 4) : (byte & 0x0f));
+                out[i * 2 + c] = sample;
+                sample2 = sample1;
+                sample1 = sample;
+            }
+        }
+    }
+    audio_checkADPCM(0x0002, "MS ADPCM", blockalign, ms_frames, data, blocks, expected);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check SDL_MixAudio against a reference, with lengths that exercise both the vectorized and the scalar code.
+ *
+ * \sa SDL_MixAudio
+ */
+static int SDLCALL audio_mixAudio(void *arg)
+{
+    static const float volumes[] = { 0.25f, 0.6f, 1.0f };
+    static const int lengths[] = { 3, 64, 1027 };
+    const int max_samples = 1027;
+    Uint8 *dst, *src, *expected;
+    int i, j, k, f;
+
+    dst = (Uint8 *)SDL_malloc(max_samples * 4);
+    src = (Uint8 *)SDL_malloc(max_samples * 4);
+    expected = (Uint8 *)SDL_malloc(max_samples * 4);
+    if (!SDLTest_AssertCheck(dst && src && expected, "Expected buffers to be allocated")) {
+        SDL_free(dst);
+        SDL_free(src);
+        SDL_free(expected);
+        return TEST_ABORTED;
+    }
+
+    for (f = 0; f < SDL_arraysize(g_audioFormats); f++) {
+        const SDL_AudioFormat format = g_audioFormats[f];
+        const int samplesize = SDL_AUDIO_BYTESIZE(format);
+        const bool swap = samplesize > 1 && (SDL_AUDIO_ISBIGENDIAN(format) != (SDL_BYTEORDER == SDL_BIG_ENDIAN));
+
+        for (i = 0; i < SDL_arraysize(volumes); i++) {
+            const int volume = (int)SDL_roundf(volumes[i] * 128);
+
+            for (j = 0; j < SDL_arraysize(lengths); j++) {
+                const int num_samples = lengths[j];
+                int mismatches = 0;
+
+                for (k = 0; k < num_samples; k++) {
+                    const float a = (float)SDL_sin(k * 0.05) * 0.7f;
+                    const float b = (float)SDL_sin(k * 0.031 + 1.0) * 0.9f;
+                    if (SDL_AUDIO_ISFLOAT(format)) {
+                        float mixed = a + b * volumes[i];
+                        Uint32 x, y, z;
+                        mixed = mixed > 1.0f ? 1.0f : (mixed < -1.0f ? -1.0f : mixed);
+                        SDL_memcpy(&x, &a, 4);
+                        SDL_memcpy(&y, &b, 4);
+                        SDL_memcpy(&z, &mixed, 4);
+                        if (swap) {
+                            x = SDL_Swap32(x);
+                            y = SDL_Swap32(y);
+                            z = SDL_Swap32(z);
+                        }
+                        SDL_memcpy(dst + k * 4, &x, 4);
+                        SDL_memcpy(src + k * 4, &y, 4);
+                        SDL_memcpy(expected + k * 4, &z, 4);
+                    } else if (samplesize == 1) {
+                        const int bias = SDL_AUDIO_ISSIGNED(format) ? 0 : 128;
+                        const Sint8 x = (Sint8)(a * 127), y = (Sint8)(b * 127);
+                        dst[k] = (Uint8)(x + bias);
+                        src[k] = (Uint8)(y + bias);
+                        expected[k] = (Uint8)(mix_reference_int(x, y, volume, SDL_MIN_SINT8, SDL_MAX_SINT8) + bias);
+                    } else if (samplesize == 2) {
+                        Uint16 x = (Uint16)(Sint16)(a * 32767), y = (Uint16)(Sint16)(b * 32767);
+                        Uint16 z = (Uint16)(Sint16)mix_reference_int((Sint16)x, (Sint16)y, volume, SDL_MIN_SINT16, SDL_MAX_SINT16);
+                        if (swap) {
+                            x = SDL_Swap16(x);
+                            y = SDL_Swap16(y);
+                            z = SDL_Swap16(z);
+                        }
+                        SDL_memcpy(dst + k * 2, &x, 2);
+                        SDL_memcpy(src + k * 2, &y, 2);
+                        SDL_memcpy(expected + k * 2, &z, 2);
+                    } else {
+                        /* Odd values make sure the rounding of negative products is covered. */
+                        Uint32 x = (Uint32)((Sint32)(a * 2147483520.0f) | 1), y = (Uint32)((Sint32)(b * 2147483520.0f) | 1);
+                        Uint32 z = (Uint32)(Sint32)mix_reference_int((Sint32)x, (Sint32)y, volume, SDL_MIN_SINT32, SDL_MAX_SINT32);
+                        if (swap) {
+                            x = SDL_Swap32(x);
+                            y = SDL_Swap32(y);
+                            z = SDL_Swap32(z);
+                        }
+                        SDL_memcpy(dst + k * 4, &x, 4);
+                        SDL_memcpy(src + k * 4, &y, 4);
+                        SDL_memcpy(expected + k * 4, &z, 4);
+                    }
+                }
+
+                SDLTest_AssertCheck(SDL_MixAudio(dst, src, format, num_samples * samplesize, volumes[i]), "Expected SDL_MixAudio to succeed");
+                for (k = 0; k < num_samples * samplesize; k++) {
+                    if (dst[k] != expected[k]) {
+                        mismatches++;
+                    }
+                }
+                SDLTest_AssertCheck(mismatches == 0, "Expected %s, volume %.2f, %d samples to match the reference, %d bytes didn't",
+                                    SDL_GetAudioFormatName(format), volumes[i], num_samples, mismatches);
+            }
+        }
+    }
+
+    SDL_free(dst);
+    SDL_free(src);
+    SDL_free(expected);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check mixing several sources at once, accumulating before clipping.
+ *
+ * \sa SDL_MixAudioBatch
+ */
+static int SDLCALL audio_mixAudioBatch(void *arg)
+{
+    const int num_samples = 1003;
+    const float volumes[3] = { 0.5f, 1.0f, 0.25f };
+    float *fdst, *fsrcs[3];
+    Sint16 *sdst, *ssrcs[3];
+    const Uint8 *srcs[3];
+    float expected;
+    int i, k, mismatches;
+
+    fdst = (float *)SDL_malloc(num_samples * sizeof(float));
+    sdst = (Sint16 *)SDL_malloc(num_samples * sizeof(Sint16));
+    for (i = 0; i < 3; i++) {
+        fsrcs[i] = (float *)SDL_malloc(num_samples * sizeof(float));
+        ssrcs[i] = (Sint16 *)SDL_malloc(num_samples * sizeof(Sint16));
+    }
+    if (!SDLTest_AssertCheck(fdst && sdst && fsrcs[0] && fsrcs[1] && fsrcs[2] && ssrcs[0] && ssrcs[1] && ssrcs[2], "Expected buffers to be allocated")) {
+        goto cleanup;
+    }
+
+    /* Sources that clip when added one at a time, but not all together. */
+    for (k = 0; k < num_samples; k++) {
+        fdst[k] = (float)SDL_sin(k * 0.01) * 0.5f;
+        fsrcs[0][k] = 0.8f;
+        fsrcs[1][k] = (k & 1) ? 0.9f : -0.9f;
+        fsrcs[2][k] = -1.6f;
+        sdst[k] = (Sint16)(fdst[k] * 32768.0f);
+        for (i = 0; i < 3; i++) {
+            ssrcs[i][k] = (Sint16)SDL_clamp(fsrcs[i][k] * 32768.0f, SDL_MIN_SINT16, SDL_MAX_SINT16);
+        }
+    }
+
+    for (i = 0; i < 3; i++) {
+        srcs[i] = (const Uint8 *)fsrcs[i];
+    }
+    SDLTest_AssertCheck(SDL_MixAudioBatch((Uint8 *)fdst, srcs, volumes, 3, SDL_AUDIO_F32, num_samples * sizeof(float)), "Expected SDL_MixAudioBatch to succeed with F32");
+    mismatches = 0;
+    for (k = 0; k < num_samples; k++) {
+        expected = (float)SDL_sin(k * 0.01) * 0.5f;
+        for (i = 0; i < 3; i++) {
+            expected = expected + fsrcs[i][k] * volumes[i];
+        }
+        expected = SDL_clamp(expected, -1.0f, 1.0f);
+        if (fdst[k] != expected) {
+            mismatches++;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Expected all F32 samples to be accumulated before clipping, %d weren't", mismatches);
+
+    for (i = 0; i < 3; i++) {
+        srcs[i] = (const Uint8 *)ssrcs[i];
+    }
+    SDLTest_AssertCheck(SDL_MixAudioBatch((Uint8 *)sdst, srcs, volumes, 3, SDL_AUDIO_S16, num_samples * sizeof(Sint16)), "Expected SDL_MixAudioBatch to succeed with S16");
+    mismatches = 0;
+    for (k = 0; k < num_samples; k++) {
+        expected = (Sint16)((float)SDL_sin(k * 0.01) * 0.5f * 32768.0f) / 32768.0f;
+        for (i = 0; i < 3; i++) {
+            expected += (ssrcs[i][k] / 32768.0f) * volumes[i];
+        }
+        expected = SDL_clamp(expected * 32768.0f, SDL_MIN_SINT16, SDL_MAX_SINT16);
+        if (SDL_fabsf(sdst[k] - expected) > 1.0f) {
+            mismatches++;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Expected all S16 samples to be accumulated before clipping, %d weren't", mismatches);
+
+    /* Silent sources leave the destination alone. */
+    {
+        const float silent[3] = { 0.0f, 0.0f, 0.0f };
+        const Sint16 before = sdst[10];
+        SDLTest_AssertCheck(SDL_MixAudioBatch((Uint8 *)sdst, srcs, silent, 3, SDL_AUDIO_S16, num_samples * sizeof(Sint16)), "Expected SDL_MixAudioBatch to succeed with silent sources");
+        SDLTest_AssertCheck(sdst[10] == before, "Expected silent sources not to change the destination");
+    }
+
+    SDLTest_AssertCheck(!SDL_MixAudioBatch(NULL, srcs, volumes, 3, SDL_AUDIO_S16, 2), "Expected SDL_MixAudioBatch to fail without a destination");
+    SDLTest_AssertCheck(!SDL_MixAudioBatch((Uint8 *)sdst, NULL, volumes, 3, SDL_AUDIO_S16, 2), "Expected SDL_MixAudioBatch to fail without sources");
+    SDLTest_AssertCheck(!SDL_MixAudioBatch((Uint8 *)sdst, srcs, volumes, 3, SDL_AUDIO_UNKNOWN, 2), "Expected SDL_MixAudioBatch to fail with an unknown format");
+    SDLTest_AssertCheck(SDL_MixAudioBatch((Uint8 *)sdst, NULL, NULL, 0, SDL_AUDIO_S16, 2), "Expected SDL_MixAudioBatch to succeed with no sources");
+
+cleanup:
+    SDL_free(fdst);
+    SDL_free(sdst);
+    for (i = 0; i < 3; i++) {
+        SDL_free(fsrcs[i]);
+        SDL_free(ssrcs[i]);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check the statistics reported through audio stream and device properties.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ * \sa SDL_GetAudioDeviceProperties
+ */
+static int SDLCALL audio_streamAndDeviceStats(void *arg)
+{
+    const SDL_AudioSpec src_spec = { SDL_AUDIO_S16, 2, 44100 };
+    const SDL_AudioSpec dst_spec = { SDL_AUDIO_F32, 2, 48000 };
+    const int src_frames = 4410;
+    const int src_len = src_frames * 4;
+    Sint16 *src = NULL;
+    float *dst = NULL;
+    SDL_AudioStream *stream = NULL;
+    SDL_AudioDeviceID devid = 0;
+    SDL_AudioDeviceID recording_devid;
+    SDL_PropertiesID props;
+    Sint64 total = 0;
+    int got;
+
+    src = (Sint16 *)SDL_calloc(src_frames, 4);
+    dst = (float *)SDL_calloc(src_frames * 2, 8);
+    stream = SDL_CreateAudioStream(&src_spec, &dst_spec);
+    if (!SDLTest_AssertCheck(src && dst && stream, "Expected buffers and stream to be created")) {
+        goto cleanup;
+    }
+
+    props = SDL_GetAudioStreamProperties(stream);
+    SDLTest_AssertCheck(props != 0, "Expected stream properties");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_FRAMES_CONVERTED_NUMBER, -1) == 0, "Expected no frames converted yet");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_WORK_BUFFER_REALLOCS_NUMBER, -1) == 0, "Expected no work buffer allocations yet");
+
+    SDL_PutAudioStreamData(stream, src, src_len);
+    SDL_PutAudioStreamData(stream, src, src_len);
+    props = SDL_GetAudioStreamProperties(stream);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUED_NUMBER, -1) == SDL_GetAudioStreamQueued(stream), "Expected queued bytes to match SDL_GetAudioStreamQueued");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUED_HIGH_WATER_NUMBER, -1) == src_len * 2, "Expected high water mark of %d bytes", src_len * 2);
+
+    SDL_FlushAudioStream(stream);
+    while ((got = SDL_GetAudioStreamData(stream, dst, src_frames * 2 * 8)) > 0) {
+        total += got / 8;
+    }
+    SDL_PutAudioStreamData(stream, src, src_len / 2);
+
+    props = SDL_GetAudioStreamProperties(stream);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_FRAMES_CONVERTED_NUMBER, -1) == total, "Expected %d frames converted", (int)total);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_CONVERT_NS_NUMBER, -1) > 0, "Expected conversion time to be counted");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_WORK_BUFFER_REALLOCS_NUMBER, -1) > 0, "Expected the work buffer to be allocated");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUED_NUMBER, -1) == src_len / 2, "Expected %d bytes queued", src_len / 2);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUED_HIGH_WATER_NUMBER, -1) == src_len * 2, "Expected the high water mark to stay at %d bytes", src_len * 2);
+
+    /* Data a lock-free stream still holds in its ring buffer counts as queued. */
+    {
+        SDL_PropertiesID create_props = SDL_CreateProperties();
+        SDL_AudioStream *lockfree;
+
+        SDL_SetBooleanProperty(create_props, SDL_PROP_AUDIOSTREAM_CREATE_LOCKFREE_BOOLEAN, true);
+        lockfree = SDL_CreateAudioStreamWithProperties(&src_spec, &dst_spec, create_props);
+        SDL_DestroyProperties(create_props);
+        if (SDLTest_AssertCheck(lockfree != NULL, "Expected a lock-free stream to be created")) {
+            SDL_PutAudioStreamData(lockfree, src, 400);
+            props = SDL_GetAudioStreamProperties(lockfree);
+            SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUED_NUMBER, -1) == 400, "Expected 400 bytes queued in the lock-free stream");
+            SDLTest_AssertCheck(SDL_GetAudioStreamQueued(lockfree) == 400, "Expected SDL_GetAudioStreamQueued to agree");
+            SDL_DestroyAudioStream(lockfree);
+        }
+    }
+
+    SDLTest_AssertCheck(SDL_GetAudioStreamProperties(NULL) == 0, "Expected no properties for a NULL stream");
+    SDLTest_AssertCheck(SDL_GetAudioDeviceProperties(0) == 0, "Expected no properties for an invalid device");
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL);
+    if (!devid) {
+        SDLTest_Log("Couldn't open a playback device, skipping device statistics: %s", SDL_GetError());
+        goto cleanup;
+    }
+    SDL_ClearAudioStream(stream);
+    SDL_SetAudioStreamFormat(stream, &src_spec, NULL);
+    SDL_BindAudioStream(devid, stream);
+    SDL_Delay(200);
+
+    props = SDL_GetAudioDeviceProperties(devid);
+    SDLTest_AssertCheck(props != 0, "Expected device properties");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_STATS_PERIODS_NUMBER, -1) > 0, "Expected the device to have processed some buffers");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_STATS_MAX_PROCESS_NS_NUMBER, -1) <= SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_STATS_PROCESS_NS_NUMBER, -1), "Expected the longest buffer to take no longer than all of them");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_STATS_LATE_WAKEUPS_NUMBER, -1) <= SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_STATS_PERIODS_NUMBER, -1), "Expected no more late wakeups than buffers");
+    SDLTest_AssertCheck(SDL_GetAudioDeviceProperties(SDL_GetAudioStreamDevice(stream)) == props, "Expected the logical device to share the physical device's properties");
+
+    /* The counters only cover the current opening of a physical device. The test harness might hold the
+       default playback device open, so check that they're reset on close with a recording device. */
+    recording_devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_RECORDING, NULL);
+    if (recording_devid) {
+        SDL_Delay(100);
+        props = SDL_GetAudioDeviceProperties(SDL_AUDIO_DEVICE_DEFAULT_RECORDING);
+        SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_STATS_PERIODS_NUMBER, -1) > 0, "Expected the recording device to have processed some buffers");
+        SDL_CloseAudioDevice(recording_devid);
+        props = SDL_GetAudioDeviceProperties(SDL_AUDIO_DEVICE_DEFAULT_RECORDING);
+        SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_STATS_PERIODS_NUMBER, -1) == 0, "Expected no buffers counted once the device is closed");
+        SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIODEVICE_STATS_PROCESS_NS_NUMBER, -1) == 0, "Expected no processing time counted once the device is closed");
+    }
+
+cleanup:
+    SDL_DestroyAudioStream(stream);
+    if (devid) {
+        SDL_CloseAudioDevice(devid);
+    }
+    SDL_free(src);
+    SDL_free(dst);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check preallocating, capping and trimming the memory an audio stream queues data in.
+ *
+ * \sa SDL_CreateAudioStreamWithProperties
+ * \sa SDL_GetAudioStreamProperties
+ */
+static int SDLCALL audio_streamQueueMemory(void *arg)
+{
+    const SDL_AudioSpec spec = { SDL_AUDIO_S16, 2, 48000 };
+    const int small_len = 48000;
+    const int burst_len = 48000 * 16;
+    Uint8 *buf = NULL;
+    SDL_AudioStream *stream = NULL;
+    SDL_PropertiesID create_props;
+    SDL_PropertiesID props;
+    Sint64 resident;
+    int i;
+
+    buf = (Uint8 *)SDL_calloc(1, burst_len);
+    create_props = SDL_CreateProperties();
+    if (!SDLTest_AssertCheck(buf && create_props, "Expected buffer and properties to be created")) {
+        goto cleanup;
+    }
+
+    SDL_SetNumberProperty(create_props, SDL_PROP_AUDIOSTREAM_CREATE_PREALLOCATE_NUMBER, -1);
+    stream = SDL_CreateAudioStreamWithProperties(&spec, &spec, create_props);
+    SDLTest_AssertCheck(stream == NULL, "Expected a negative preallocation to fail");
+
+    SDL_SetNumberProperty(create_props, SDL_PROP_AUDIOSTREAM_CREATE_PREALLOCATE_NUMBER, small_len);
+    SDL_SetNumberProperty(create_props, SDL_PROP_AUDIOSTREAM_CREATE_MAX_IDLE_NUMBER, burst_len * 2);
+    stream = SDL_CreateAudioStreamWithProperties(&spec, &spec, create_props);
+    if (!SDLTest_AssertCheck(stream != NULL, "Expected stream to be created")) {
+        goto cleanup;
+    }
+
+    props = SDL_GetAudioStreamProperties(stream);
+    resident = SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_MEMORY_NUMBER, -1);
+    SDLTest_AssertCheck(resident >= small_len, "Expected at least %d bytes preallocated, got %d", small_len, (int)resident);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_IDLE_MEMORY_NUMBER, -1) == resident, "Expected all of the memory to be idle");
+
+    /* Steady state within the budget never goes to the allocator. */
+    for (i = 0; i < 10; i++) {
+        SDL_PutAudioStreamData(stream, buf, small_len);
+        SDL_GetAudioStreamData(stream, buf, small_len);
+    }
+    props = SDL_GetAudioStreamProperties(stream);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_ALLOCATIONS_NUMBER, -1) == 0, "Expected no allocations while within the preallocated memory");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_MEMORY_NUMBER, -1) == resident, "Expected the preallocated memory to be reused");
+
+    /* A burst allocates, and the memory stays around as long as it fits under the idle cap... */
+    SDL_PutAudioStreamData(stream, buf, burst_len);
+    SDL_ClearAudioStream(stream);
+    props = SDL_GetAudioStreamProperties(stream);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_ALLOCATIONS_NUMBER, -1) > 0, "Expected a burst to allocate more memory");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_MEMORY_NUMBER, -1) >= burst_len, "Expected the burst's memory to be kept for reuse");
+
+    /* ...until it goes unused for a whole trim interval, which takes two of them to notice. */
+    for (i = 0; i < 2; i++) {
+        SDL_Delay(1100);
+        SDL_PutAudioStreamData(stream, buf, 4);
+    }
+    props = SDL_GetAudioStreamProperties(stream);
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_MEMORY_NUMBER, -1) == resident, "Expected unused memory to be trimmed back to the preallocation, got %d bytes", (int)SDL_GetNumberProperty(props, SDL_PROP_AUDIOSTREAM_STATS_QUEUE_MEMORY_NUMBER, -1));
+
+cleanup:
+    SDL_DestroyAudioStream(stream);
+    SDL_DestroyProperties(create_props);
+    SDL_free(buf);
+
+    return TEST_COMPLETED;
+}
+
+/* Runs `len` bytes of `input` through a stream with the given gain, returns the number of bytes written to `output`, or -1.
+   The output is read in a few pieces, so that later reads can find all the input they need in the queued data. */
+static int GetGainAdjustedStreamData(const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec, float gain, const void *input, int len, void *output, int output_len)
+{
+    SDL_AudioStream *stream = SDL_CreateAudioStream(src_spec, dst_spec);
+    const int piece_len = output_len / 4;
+    int result = -1;
+
+    if (stream &&
+        SDL_SetAudioStreamGain(stream, gain) &&
+        SDL_PutAudioStreamData(stream, input, len) &&
+        SDL_FlushAudioStream(stream)) {
+        result = 0;
+        while (result < output_len) {
+            const int br = SDL_GetAudioStreamData(stream, (Uint8 *)output + result, SDL_min(piece_len, output_len - result));
+            if (br <= 0) {
+                result = (br < 0) ? -1 : result;
+                break;
+            }
+            result += br;
+        }
+    }
+    SDL_DestroyAudioStream(stream);
+    return result;
+}
+
+static bool CheckAudioGuardBytes(const Uint8 *buf, int len)
+{
+    int i;
+    for (i = 0; i < len; i++) {
+        if (buf[i] != 0xAA) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Check that stream gain is applied, and stays inside the requested output, on
+ * paths that don't otherwise convert the data to float.
+ *
+ * \sa SDL_SetAudioStreamGain
+ * \sa SDL_GetAudioStreamData
+ */
+static int SDLCALL audio_streamGain(void *arg)
+{
+    const int frames = 1024;
+    const int out_frames = 256;
+    const float gain = 0.5f;
+    Uint8 *input = NULL;
+    Uint8 *output = NULL;
+    float *reference = NULL;
+    int out_len, len, i;
+    bool ok;
+
+    input = (Uint8 *)SDL_malloc(frames * 8 * sizeof(float));
+    output = (Uint8 *)SDL_malloc(out_frames * 8 * sizeof(float));
+    reference = (float *)SDL_malloc(out_frames * 8 * sizeof(float));
+    if (!SDLTest_AssertCheck(input && output && reference, "Expected buffers to be allocated")) {
+        goto cleanup;
+    }
+
+    /* Same format on both ends, only gain: converting through float must not spill past the S16 output. */
+    {
+        const SDL_AudioSpec spec = { SDL_AUDIO_S16, 2, 48000 };
+        Sint16 *samples = (Sint16 *)input;
+
+        for (i = 0; i < frames * 2; i++) {
+            samples[i] = 16000;
+        }
+        out_len = out_frames * 2 * (int)sizeof(Sint16);
+        SDL_memset(output, 0xAA, out_frames * 8 * sizeof(float));
+        len = GetGainAdjustedStreamData(&spec, &spec, gain, input, frames * 2 * (int)sizeof(Sint16), output, out_len);
+        SDLTest_AssertCheck(len == out_len, "Expected %d bytes, got %d", out_len, len);
+
+        ok = true;
+        for (i = 0; i < out_frames * 2; i++) {
+            const Sint16 sample = ((Sint16 *)output)[i];
+            if ((sample < 7999) || (sample > 8001)) {
+                SDLTest_AssertCheck(false, "Expected sample %d to be about 8000, got %d", i, (int)sample);
+                ok = false;
+                break;
+            }
+        }
+        if (ok) {
+            SDLTest_AssertPass("Gain was applied to S16 data");
+        }
+        SDLTest_AssertCheck(CheckAudioGuardBytes(output + out_len, out_frames * 8 * (int)sizeof(float) - out_len), "Expected nothing written past the requested S16 output");
+    }
+
+    /* Reducing 7.1 to mono: gain must not be applied in the (smaller) output buffer before the channels are mixed down. */
+    {
+        const SDL_AudioSpec src_spec = { SDL_AUDIO_F32, 8, 48000 };
+        const SDL_AudioSpec dst_spec = { SDL_AUDIO_F32, 1, 48000 };
+        float *samples = (float *)input;
+
+        for (i = 0; i < frames * 8; i++) {
+            samples[i] = (float)(i % 8) * 0.1f;
+        }
+        out_len = out_frames * (int)sizeof(float);
+        len = GetGainAdjustedStreamData(&src_spec, &dst_spec, 1.0f, input, frames * 8 * (int)sizeof(float), reference, out_len);
+        SDLTest_AssertCheck(len == out_len, "Expected %d bytes, got %d", out_len, len);
+
+        SDL_memset(output, 0xAA, out_frames * 8 * sizeof(float));
+        len = GetGainAdjustedStreamData(&src_spec, &dst_spec, gain, input, frames * 8 * (int)sizeof(float), output, out_len);
+        SDLTest_AssertCheck(len == out_len, "Expected %d bytes, got %d", out_len, len);
+
+        ok = true;
+        for (i = 0; i < out_frames; i++) {
+            const float sample = ((float *)output)[i];
+            if (SDL_fabsf(sample - reference[i] * gain) > 1e-6f) {
+                SDLTest_AssertCheck(false, "Expected sample %d to be %f, got %f", i, reference[i] * gain, sample);
+                ok = false;
+                break;
+            }
+        }
+        if (ok) {
+            SDLTest_AssertPass("Gain was applied to downmixed data");
+        }
+        SDLTest_AssertCheck(CheckAudioGuardBytes(output + out_len, out_frames * 8 * (int)sizeof(float) - out_len), "Expected nothing written past the requested mono output");
+    }
+
+    /* Upsampling float data, where gain is applied while reading the input and nothing else needs converting. */
+    {
+        const SDL_AudioSpec src_spec = { SDL_AUDIO_F32, 2, 24000 };
+        const SDL_AudioSpec dst_spec = { SDL_AUDIO_F32, 2, 48000 };
+        float *samples = (float *)input;
+
+        for (i = 0; i < frames * 2; i++) {
+            samples[i] = SDL_sinf((float)(i / 2) * 0.05f) * 0.8f;
+        }
+        out_len = out_frames * 2 * (int)sizeof(float);
+        len = GetGainAdjustedStreamData(&src_spec, &dst_spec, 1.0f, input, frames * 2 * (int)sizeof(float), reference, out_len);
+        SDLTest_AssertCheck(len == out_len, "Expected %d bytes, got %d", out_len, len);
+        len = GetGainAdjustedStreamData(&src_spec, &dst_spec, gain, input, frames * 2 * (int)sizeof(float), output, out_len);
+        SDLTest_AssertCheck(len == out_len, "Expected %d bytes, got %d", out_len, len);
+
+        ok = true;
+        for (i = 0; i < out_frames * 2; i++) {
+            const float sample = ((float *)output)[i];
+            if (SDL_fabsf(sample - reference[i] * gain) > 1e-5f) {
+                SDLTest_AssertCheck(false, "Expected sample %d to be %f, got %f", i, reference[i] * gain, sample);
+                ok = false;
+                break;
+            }
+        }
+        if (ok) {
+            SDLTest_AssertPass("Gain was applied to resampled data");
+        }
+    }
+
+cleanup:
+    SDL_free(input);
+    SDL_free(output);
+    SDL_free(reference);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1526,13 +2772,55 @@ static const SDLTest_TestCaseReference audioTest18 = {
     audio_formatChange, "audio_formatChange", "Check handling of format changes.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_lockFreeStream, "audio_lockFreeStream", "Check lock-free audio streams against regular ones.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest20 = {
+    audio_putNoCopy, "audio_putNoCopy", "Check queueing audio without copying it.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest21 = {
+    audio_streamWAV, "audio_streamWAV", "Check streaming WAVE files against loading them.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest22 = {
+    audio_loadWAVCompanded, "audio_loadWAVCompanded", "Check decoding A-law and mu-law WAVE files.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest23 = {
+    audio_mixAudio, "audio_mixAudio", "Check mixing audio in all formats.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest24 = {
+    audio_mixAudioBatch, "audio_mixAudioBatch", "Check mixing several audio buffers at once.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest25 = {
+    audio_streamAndDeviceStats, "audio_streamAndDeviceStats", "Check audio stream and device statistics.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest26 = {
+    audio_streamQueueMemory, "audio_streamQueueMemory", "Check preallocating and trimming audio stream queue memory.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest27 = {
+    audio_streamGain, "audio_streamGain", "Check applying gain while getting audio stream data.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest28 = {
+    audio_loadWAVStereoADPCM, "audio_loadWAVStereoADPCM", "Check decoding stereo MS ADPCM and IMA ADPCM WAVE files.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTestGetAudioFormatName,
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
     &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
-    &audioTest17, &audioTest18, NULL
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20,
+    &audioTest21, &audioTest22, &audioTest23, &audioTest24, &audioTest25, &audioTest26,
+    &audioTest27, &audioTest28, NULL
 };
 
 /* Audio test suite (global) */
@@ -302,6 +302,477 @@ static void testBlitBlendMode(int mode)
     }
 }
 
+/* Same rounding as MULT_DIV_255() in SDL_blit.h */
+static Uint32 MultDiv255(Uint32 a, Uint32 b)
+{
+    Uint32 x = a * b + 1;
+    return (x + (x >> 8)) >> 8;
+}
+
+/* Integer model of the generic 8888 blitters, which have to agree exactly whatever CPU path is taken */
+static void ExpectedModulatedBlend(Uint32 flags, const Uint8 mod[4], const Uint8 src[4], Uint8 dst[4])
+{
+    Uint32 s[4], d[4], i;
+
+    for (i = 0; i < 4; ++i) {
+        s[i] = MultDiv255(src[i], mod[i]);
+        d[i] = dst[i];
+    }
+    if (flags == SDL_BLENDMODE_BLEND || flags == SDL_BLENDMODE_ADD) {
+        for (i = 0; i < 3; ++i) {
+            s[i] = MultDiv255(s[i], s[3]);
+        }
+    }
+    switch (flags) {
+    case SDL_BLENDMODE_NONE:
+        SDL_memcpy(d, s, sizeof(d));
+        break;
+    case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        for (i = 0; i < 4; ++i) {
+            d[i] = SDL_min(MultDiv255(255 - s[3], d[i]) + s[i], 255);
+        }
+        break;
+    case SDL_BLENDMODE_ADD:
+    case SDL_BLENDMODE_ADD_PREMULTIPLIED:
+        for (i = 0; i < 3; ++i) {
+            d[i] = SDL_min(s[i] + d[i], 255);
+        }
+        break;
+    case SDL_BLENDMODE_MOD:
+        for (i = 0; i < 3; ++i) {
+            d[i] = MultDiv255(s[i], d[i]);
+        }
+        break;
+    case SDL_BLENDMODE_MUL:
+        for (i = 0; i < 3; ++i) {
+            d[i] = SDL_min(MultDiv255(s[i], d[i]) + MultDiv255(d[i], 255 - s[3]), 255);
+        }
+        break;
+    }
+    for (i = 0; i < 4; ++i) {
+        dst[i] = (Uint8)d[i];
+    }
+}
+
+/**
+ * Tests modulated blits across whole rows, so the vectorized blitters see both full blocks and tails
+ */
+static int SDLCALL surface_testBlitModulatedRows(void *arg)
+{
+    const SDL_PixelFormat src_formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 };
+    const SDL_PixelFormat dst_formats[] = { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 };
+    const SDL_BlendMode modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_BLEND_PREMULTIPLIED, SDL_BLENDMODE_ADD,
+        SDL_BLENDMODE_ADD_PREMULTIPLIED, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    const Uint8 mod[4] = { 201, 99, 0, 77 };
+    const int w = 37, h = 3;
+    int i, j, m, scaled, x, y;
+
+    for (i = 0; i < SDL_arraysize(src_formats); ++i) {
+        for (j = 0; j < SDL_arraysize(dst_formats); ++j) {
+            for (m = 0; m < SDL_arraysize(modes); ++m) {
+                for (scaled = 0; scaled <= 1; ++scaled) {
+                    const int dst_w = scaled ? w * 2 : w;
+                    const int dst_h = scaled ? h * 2 : h;
+                    const bool dst_alpha = SDL_ISPIXELFORMAT_ALPHA(dst_formats[j]);
+                    SDL_Surface *src = SDL_CreateSurface(w, h, src_formats[i]);
+                    SDL_Surface *dst = SDL_CreateSurface(dst_w, dst_h, dst_formats[j]);
+                    SDL_Surface *background = SDL_CreateSurface(dst_w, dst_h, dst_formats[j]);
+                    int errors = 0;
+                    bool ret;
+
+                    SDLTest_AssertCheck(src && dst && background, "Verify surfaces are not NULL");
+                    if (!src || !dst || !background) {
+                        SDL_DestroySurface(src);
+                        SDL_DestroySurface(dst);
+                        SDL_DestroySurface(background);
+                        return TEST_ABORTED;
+                    }
+                    for (y = 0; y < h; ++y) {
+                        for (x = 0; x < w; ++x) {
+                            SDL_WriteSurfacePixel(src, x, y, SDLTest_RandomUint8(), SDLTest_RandomUint8(), SDLTest_RandomUint8(), (x % 5) ? SDLTest_RandomUint8() : (Uint8)((x % 2) * 255));
+                        }
+                    }
+                    for (y = 0; y < dst_h; ++y) {
+                        for (x = 0; x < dst_w; ++x) {
+                            SDL_WriteSurfacePixel(background, x, y, SDLTest_RandomUint8(), SDLTest_RandomUint8(), SDLTest_RandomUint8(), SDLTest_RandomUint8());
+                        }
+                    }
+                    SDL_SetSurfaceBlendMode(background, SDL_BLENDMODE_NONE);
+                    SDL_BlitSurface(background, NULL, dst, NULL);
+
+                    SDL_SetSurfaceColorMod(src, mod[0], mod[1], mod[2]);
+                    SDL_SetSurfaceAlphaMod(src, mod[3]);
+                    SDL_SetSurfaceBlendMode(src, modes[m]);
+                    if (scaled) {
+                        ret = SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_NEAREST);
+                    } else {
+                        ret = SDL_BlitSurface(src, NULL, dst, NULL);
+                    }
+                    SDLTest_AssertCheck(ret, "Verify result from blit, expected: true, got: %i", ret);
+
+                    for (y = 0; y < dst_h; ++y) {
+                        for (x = 0; x < dst_w; ++x) {
+                            Uint8 s[4], expected[4], actual[4];
+                            SDL_ReadSurfacePixel(src, scaled ? x / 2 : x, scaled ? y / 2 : y, &s[0], &s[1], &s[2], &s[3]);
+                            SDL_ReadSurfacePixel(background, x, y, &expected[0], &expected[1], &expected[2], &expected[3]);
+                            SDL_ReadSurfacePixel(dst, x, y, &actual[0], &actual[1], &actual[2], &actual[3]);
+                            ExpectedModulatedBlend(modes[m], mod, s, expected);
+                            if (!dst_alpha) {
+                                expected[3] = actual[3];
+                            }
+                            if (SDL_memcmp(expected, actual, sizeof(actual)) != 0 && errors++ == 0) {
+                                SDLTest_LogError("%s -> %s blend mode 0x%x%s at %d,%d: expected %d,%d,%d,%d, got %d,%d,%d,%d",
+                                                 SDL_GetPixelFormatName(src_formats[i]), SDL_GetPixelFormatName(dst_formats[j]),
+                                                 modes[m], scaled ? " scaled" : "", x, y,
+                                                 expected[0], expected[1], expected[2], expected[3],
+                                                 actual[0], actual[1], actual[2], actual[3]);
+                            }
+                        }
+                    }
+                    SDLTest_AssertCheck(errors == 0, "Checking %s -> %s blend mode 0x%x%s, %d mismatched pixels",
+                                        SDL_GetPixelFormatName(src_formats[i]), SDL_GetPixelFormatName(dst_formats[j]),
+                                        modes[m], scaled ? " scaled" : "", errors);
+
+                    SDL_DestroySurface(src);
+                    SDL_DestroySurface(dst);
+                    SDL_DestroySurface(background);
+                }
+            }
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that blitting a batch with a blit plan matches blitting each surface on its own
+ */
+static int SDLCALL surface_testBlitBatch(void *arg)
+{
+    const int num_sprites = 3;
+    SDL_Surface *sprites[3];
+    SDL_Surface *dst = NULL, *reference = NULL, *other = NULL;
+    SDL_BlitPlan *plan = NULL, *linear_plan = NULL;
+    SDL_BlitBatchItem items[8];
+    int i, x, y;
+    bool ret;
+
+    for (i = 0; i < num_sprites; ++i) {
+        sprites[i] = SDL_CreateSurface(13 + i * 8, 11, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(sprites[i] != NULL, "Verify sprite %d is not NULL", i);
+        if (!sprites[i]) {
+            return TEST_ABORTED;
+        }
+        for (y = 0; y < sprites[i]->h; ++y) {
+            for (x = 0; x < sprites[i]->w; ++x) {
+                SDL_WriteSurfacePixel(sprites[i], x, y, SDLTest_RandomUint8(), SDLTest_RandomUint8(), SDLTest_RandomUint8(), SDLTest_RandomUint8());
+            }
+        }
+    }
+    dst = SDL_CreateSurface(64, 48, SDL_PIXELFORMAT_XRGB8888);
+    reference = SDL_CreateSurface(64, 48, SDL_PIXELFORMAT_XRGB8888);
+    other = SDL_CreateSurface(8, 8, SDL_PIXELFORMAT_RGB565);
+    SDLTest_AssertCheck(dst && reference && other, "Verify surfaces are not NULL");
+    if (!dst || !reference || !other) {
+        goto done;
+    }
+    SDL_FillSurfaceRect(dst, NULL, SDL_MapSurfaceRGB(dst, 40, 80, 120));
+    SDL_FillSurfaceRect(reference, NULL, SDL_MapSurfaceRGB(reference, 40, 80, 120));
+
+    /* The plan is made from the first sprite's state */
+    SDL_SetSurfaceBlendMode(sprites[0], SDL_BLENDMODE_BLEND);
+    SDL_SetSurfaceColorMod(sprites[0], 200, 150, 100);
+    SDL_SetSurfaceAlphaMod(sprites[0], 180);
+    plan = SDL_CreateBlitPlan(sprites[0], dst);
+    SDLTest_AssertPass("Call to SDL_CreateBlitPlan()");
+    SDLTest_AssertCheck(plan != NULL, "Verify result from SDL_CreateBlitPlan() is not NULL");
+    if (!plan) {
+        goto done;
+    }
+
+    /* Later changes to the source surfaces don't affect the plan */
+    SDL_SetSurfaceBlendMode(sprites[0], SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceColorMod(sprites[1], 10, 20, 30);
+
+    for (i = 0; i < SDL_arraysize(items); ++i) {
+        items[i].src = sprites[i % num_sprites];
+        items[i].srcrect.x = i % 3;
+        items[i].srcrect.y = i % 2;
+        items[i].srcrect.w = items[i].src->w - 1;
+        items[i].srcrect.h = items[i].src->h;
+        items[i].dstrect.x = i * 9 - 5;     /* the first and last ones are clipped */
+        items[i].dstrect.y = i * 5 - 2;
+        items[i].dstrect.w = 0;
+        items[i].dstrect.h = 0;
+    }
+    ret = SDL_BlitSurfaceBatch(plan, items, SDL_arraysize(items), dst);
+    SDLTest_AssertCheck(ret == true, "Verify result from SDL_BlitSurfaceBatch(), expected: true, got: %i", ret);
+
+    for (i = 0; i < SDL_arraysize(items); ++i) {
+        SDL_SetSurfaceBlendMode(items[i].src, SDL_BLENDMODE_BLEND);
+        SDL_SetSurfaceColorMod(items[i].src, 200, 150, 100);
+        SDL_SetSurfaceAlphaMod(items[i].src, 180);
+        SDL_BlitSurface(items[i].src, &items[i].srcrect, reference, &items[i].dstrect);
+    }
+    ret = SDLTest_CompareSurfaces(dst, reference, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+    /* Sources and destinations have to match the formats of the plan */
+    items[0].src = other;
+    ret = SDL_BlitSurfaceBatch(plan, items, 1, dst);
+    SDLTest_AssertCheck(ret == false, "Verify SDL_BlitSurfaceBatch() with a source of the wrong format fails, got: %i", ret);
+    items[0].src = sprites[0];
+    ret = SDL_BlitSurfaceBatch(plan, items, 1, other);
+    SDLTest_AssertCheck(ret == false, "Verify SDL_BlitSurfaceBatch() with a destination of the wrong format fails, got: %i", ret);
+    ret = SDL_BlitSurfaceBatch(plan, NULL, 0, dst);
+    SDLTest_AssertCheck(ret == true, "Verify SDL_BlitSurfaceBatch() with no items succeeds, got: %i", ret);
+
+    /* Colorspace conversion uses the plan's colorspace, not the one of the item's source */
+    SDL_SetSurfaceColorspace(sprites[0], SDL_COLORSPACE_SRGB_LINEAR);
+    linear_plan = SDL_CreateBlitPlan(sprites[0], dst);
+    SDLTest_AssertCheck(linear_plan != NULL, "Verify result from SDL_CreateBlitPlan() with a linear source is not NULL");
+    SDL_SetSurfaceColorspace(sprites[0], SDL_COLORSPACE_SRGB);
+    if (!linear_plan) {
+        goto done;
+    }
+    for (i = 0; i < SDL_arraysize(items); ++i) {
+        items[i].src = sprites[i % num_sprites];
+    }
+    SDL_FillSurfaceRect(dst, NULL, SDL_MapSurfaceRGB(dst, 40, 80, 120));
+    ret = SDL_BlitSurfaceBatch(linear_plan, items, SDL_arraysize(items), dst);
+    SDLTest_AssertCheck(ret == true, "Verify result from SDL_BlitSurfaceBatch() with a linear plan, expected: true, got: %i", ret);
+
+    SDL_FillSurfaceRect(reference, NULL, SDL_MapSurfaceRGB(reference, 40, 80, 120));
+    for (i = 0; i < SDL_arraysize(items); ++i) {
+        /* Use a fresh surface, the blit map of the sprite doesn't track colorspace changes */
+        SDL_Surface *linear = SDL_DuplicateSurface(items[i].src);
+        SDLTest_AssertCheck(linear != NULL, "Verify result from SDL_DuplicateSurface() is not NULL");
+        if (!linear) {
+            goto done;
+        }
+        SDL_SetSurfaceColorspace(linear, SDL_COLORSPACE_SRGB_LINEAR);
+        SDL_BlitSurface(linear, &items[i].srcrect, reference, &items[i].dstrect);
+        SDL_DestroySurface(linear);
+    }
+    ret = SDLTest_CompareSurfaces(dst, reference, 0);
+    SDLTest_AssertCheck(ret == 0, "Validate linear result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+done:
+    SDL_DestroyBlitPlan(linear_plan);
+    SDL_DestroyBlitPlan(plan);
+    for (i = 0; i < num_sprites; ++i) {
+        SDL_DestroySurface(sprites[i]);
+    }
+    SDL_DestroySurface(dst);
+    SDL_DestroySurface(reference);
+    SDL_DestroySurface(other);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests nearest scaling of 1 to 4 byte pixels against the source positions it is defined by,
+ * at sizes that go through the wide stretch paths, including ones with the source row end
+ * and the destination rectangle off the surface edges.
+ */
+static int SDLCALL surface_testBlitScaledNearest(void *arg)
+{
+    static const SDL_PixelFormat formats[] = { SDL_PIXELFORMAT_RGB332, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_XRGB8888 };
+    static const int sizes[][4] = {
+        { 40, 33, 160, 64 },  /* 4x across, 2x down */
+        { 61, 40, 97, 40 },   /* odd upscale */
+        { 97, 48, 61, 36 },   /* odd downscale */
+        { 128, 40, 64, 40 },  /* 2x down, which needs two loads per block for every format */
+        { 19, 64, 300, 32 },  /* many blocks from a short source row */
+    };
+    int f, i, x, y, c;
+
+    for (f = 0; f < SDL_arraysize(formats); ++f) {
+        const int bpp = SDL_BYTESPERPIXEL(formats[f]);
+
+        for (i = 0; i < SDL_arraysize(sizes); ++i) {
+            const int src_w = sizes[i][0], src_h = sizes[i][1];
+            const int dst_w = sizes[i][2], dst_h = sizes[i][3];
+            SDL_Surface *src = SDL_CreateSurface(src_w + 3, src_h, formats[f]);
+            SDL_Surface *dst = SDL_CreateSurface(dst_w + 5, dst_h + 2, formats[f]);
+            SDL_Rect srcrect, dstrect;
+            Uint64 incx, incy;
+            int mismatches = 0;
+            bool ret;
+
+            SDLTest_AssertCheck(src && dst, "Verify surfaces are not NULL");
+            if (!src || !dst) {
+                SDL_DestroySurface(src);
+                SDL_DestroySurface(dst);
+                return TEST_ABORTED;
+            }
+            for (y = 0; y < src->h; ++y) {
+                Uint8 *row = (Uint8 *)src->pixels + y * src->pitch;
+                for (x = 0; x < src->w * bpp; ++x) {
+                    row[x] = SDLTest_RandomUint8();
+                }
+            }
+            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+            srcrect.x = 3;
+            srcrect.y = 0;
+            srcrect.w = src_w;
+            srcrect.h = src_h;
+            dstrect.x = 5;
+            dstrect.y = 1;
+            dstrect.w = dst_w;
+            dstrect.h = dst_h;
+            ret = SDL_BlitSurfaceScaled(src, &srcrect, dst, &dstrect, SDL_SCALEMODE_NEAREST);
+            SDLTest_AssertCheck(ret == true, "Verify result from SDL_BlitSurfaceScaled(), expected: true, got: %i", ret);
+
+            /* each destination pixel comes from the source pixel under its center, in 16.16 fixed point */
+            incx = ((Uint64)src_w << 16) / dst_w;
+            incy = ((Uint64)src_h << 16) / dst_h;
+            for (y = 0; y < dst_h; ++y) {
+                const int sy = (int)((incy / 2 + y * incy) >> 16);
+                const Uint8 *src_row = (const Uint8 *)src->pixels + sy * src->pitch + srcrect.x * bpp;
+                const Uint8 *dst_row = (const Uint8 *)dst->pixels + (dstrect.y + y) * dst->pitch + dstrect.x * bpp;
+                for (x = 0; x < dst_w; ++x) {
+                    const int sx = (int)((incx / 2 + x * incx) >> 16);
+                    for (c = 0; c < bpp; ++c) {
+                        if (dst_row[x * bpp + c] != src_row[sx * bpp + c]) {
+                            ++mismatches;
+                        }
+                    }
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Verify %s %dx%d -> %dx%d, expected: 0 wrong bytes, got: %d",
+                                SDL_GetPixelFormatName(formats[f]), src_w, src_h, dst_w, dst_h, mismatches);
+
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests area averaging and Lanczos scaling.
+ */
+static int SDLCALL surface_testScaleFiltered(void *arg)
+{
+    static const SDL_ScaleMode modes[] = { SDL_SCALEMODE_AREA, SDL_SCALEMODE_LANCZOS };
+    SDL_Surface *src = NULL, *dst = NULL, *scaled = NULL;
+    int i, x, y, c, mismatches, worst;
+    bool ret;
+
+    src = SDL_CreateSurface(64, 48, SDL_PIXELFORMAT_ARGB8888);
+    dst = SDL_CreateSurface(32, 24, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src && dst, "Verify surfaces are not NULL");
+    if (!src || !dst) {
+        goto done;
+    }
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+    /* Halving with area averaging gives the average of each 2x2 block */
+    for (y = 0; y < src->h; ++y) {
+        for (x = 0; x < src->w; ++x) {
+            SDL_WriteSurfacePixel(src, x, y, SDLTest_RandomUint8(), SDLTest_RandomUint8(), SDLTest_RandomUint8(), SDLTest_RandomUint8());
+        }
+    }
+    ret = SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_AREA);
+    SDLTest_AssertCheck(ret == true, "Verify result from SDL_BlitSurfaceScaled(), expected: true, got: %i", ret);
+    worst = 0;
+    for (y = 0; y < dst->h; ++y) {
+        for (x = 0; x < dst->w; ++x) {
+            for (c = 0; c < 4; ++c) {
+                const Uint8 *s0 = (const Uint8 *)src->pixels + (y * 2) * src->pitch + (x * 2) * 4 + c;
+                const Uint8 *s1 = s0 + src->pitch;
+                const int sum = s0[0] + s0[4] + s1[0] + s1[4];
+                const int value = ((const Uint8 *)dst->pixels)[y * dst->pitch + x * 4 + c];
+                worst = SDL_max(worst, SDL_abs(value * 4 - sum));
+            }
+        }
+    }
+    SDLTest_AssertCheck(worst <= 2, "Verify area averaging halves exactly, expected: <= 2, got: %d", worst);
+
+    /* A one pixel checkerboard has to come out gray, where nearest scaling would give black or white */
+    for (y = 0; y < src->h; ++y) {
+        for (x = 0; x < src->w; ++x) {
+            const Uint8 v = ((x ^ y) & 1) ? 255 : 0;
+            SDL_WriteSurfacePixel(src, x, y, v, v, v, 255);
+        }
+    }
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        scaled = SDL_ScaleSurface(src, 16, 12, modes[i]);
+        SDLTest_AssertCheck(scaled != NULL, "Verify result from SDL_ScaleSurface() is not NULL");
+        if (!scaled) {
+            goto done;
+        }
+        worst = 0;
+        for (y = 0; y < scaled->h; ++y) {
+            for (x = 0; x < scaled->w; ++x) {
+                Uint8 r, g, b, a;
+                SDL_ReadSurfacePixel(scaled, x, y, &r, &g, &b, &a);
+                worst = SDL_max(worst, SDL_abs(r - 128));
+            }
+        }
+        SDLTest_AssertCheck(worst <= 8, "Verify scale mode %d doesn't alias, expected: <= 8, got: %d", modes[i], worst);
+        SDL_DestroySurface(scaled);
+        scaled = NULL;
+    }
+
+    /* A flat color stays the same when scaling up and down, also from formats that are converted first */
+    for (i = 0; i < SDL_arraysize(modes); ++i) {
+        static const SDL_PixelFormat formats[] = { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565 };
+        static const int sizes[][2] = { { 7, 5 }, { 150, 101 } };
+        int f, k;
+
+        for (f = 0; f < SDL_arraysize(formats); ++f) {
+            SDL_Surface *flat = SDL_CreateSurface(40, 30, formats[f]);
+            SDLTest_AssertCheck(flat != NULL, "Verify surface is not NULL");
+            if (!flat) {
+                goto done;
+            }
+            SDL_FillSurfaceRect(flat, NULL, SDL_MapSurfaceRGB(flat, 0x40, 0xc4, 0x10));
+            for (k = 0; k < SDL_arraysize(sizes); ++k) {
+                Uint32 expected, pixel;
+
+                scaled = SDL_ScaleSurface(flat, sizes[k][0], sizes[k][1], modes[i]);
+                SDLTest_AssertCheck(scaled != NULL, "Verify result from SDL_ScaleSurface() is not NULL");
+                if (!scaled) {
+                    SDL_DestroySurface(flat);
+                    goto done;
+                }
+                expected = *(const Uint32 *)flat->pixels & ((formats[f] == SDL_PIXELFORMAT_RGB565) ? 0xFFFF : 0xFFFFFF);
+                mismatches = 0;
+                for (y = 0; y < scaled->h; ++y) {
+                    for (x = 0; x < scaled->w; ++x) {
+                        if (formats[f] == SDL_PIXELFORMAT_RGB565) {
+                            pixel = ((const Uint16 *)((const Uint8 *)scaled->pixels + y * scaled->pitch))[x];
+                        } else {
+                            pixel = ((const Uint32 *)((const Uint8 *)scaled->pixels + y * scaled->pitch))[x] & 0xFFFFFF;
+                        }
+                        if (pixel != expected) {
+                            ++mismatches;
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(mismatches == 0, "Verify scale mode %d of %s to %dx%d keeps a flat color, expected: 0, got: %d",
+                                    modes[i], SDL_GetPixelFormatName(formats[f]), sizes[k][0], sizes[k][1], mismatches);
+                SDL_DestroySurface(scaled);
+                scaled = NULL;
+            }
+            SDL_DestroySurface(flat);
+        }
+    }
+
+    ret = SDL_BlitSurfaceScaled(src, NULL, dst, NULL, (SDL_ScaleMode)42);
+    SDLTest_AssertCheck(ret == false, "Verify SDL_BlitSurfaceScaled() with an invalid scale mode fails, got: %i", ret);
+
+done:
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+    SDL_DestroySurface(scaled);
+    return TEST_COMPLETED;
+}
+
 /* Helper to check that a file exists */
 static void AssertFileExist(const char *filename)
 {
@@ -1478,6 +1949,1342 @@ static int SDLCALL surface_testPremultiplyAlpha(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests the row kernels for alpha premultiplication against their scalar definitions.
+ */
+static int SDLCALL surface_testPremultiplyAlphaRows(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888,
+    };
+    const int width = 259, height = 3;
+    SDL_Surface *src, *dst, *fsrc, *fdst;
+    int i, x, y, ret, shift, errors;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        const SDL_PixelFormat format = formats[i];
+        const int alpha_shift = SDL_GetPixelFormatDetails(format)->Ashift;
+
+        src = SDL_CreateSurface(width, height, format);
+        dst = SDL_CreateSurface(width, height, format);
+        SDLTest_AssertCheck(src != NULL && dst != NULL, "SDL_CreateSurface()");
+        if (!src || !dst) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+            return TEST_ABORTED;
+        }
+        for (y = 0; y < height; ++y) {
+            Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+            for (x = 0; x < width; ++x) {
+                row[x] = (Uint32)SDLTest_RandomUint32();
+            }
+        }
+        /* Make sure the edge cases show up */
+        ((Uint32 *)src->pixels)[0] &= ~(0xFFu << alpha_shift);
+        ((Uint32 *)src->pixels)[1] |= (0xFFu << alpha_shift);
+
+        /* Premultiply */
+        ret = SDL_PremultiplyAlpha(width, height, format, src->pixels, src->pitch, format, dst->pixels, dst->pitch, false);
+        SDLTest_AssertCheck(ret == true, "SDL_PremultiplyAlpha(%s)", SDL_GetPixelFormatName(format));
+        errors = 0;
+        for (y = 0; y < height; ++y) {
+            const Uint32 *srow = (const Uint32 *)((const Uint8 *)src->pixels + y * src->pitch);
+            const Uint32 *drow = (const Uint32 *)((const Uint8 *)dst->pixels + y * dst->pitch);
+            for (x = 0; x < width; ++x) {
+                const Uint32 a = (srow[x] >> alpha_shift) & 0xFF;
+                for (shift = 0; shift < 32; shift += 8) {
+                    const Uint32 c = (srow[x] >> shift) & 0xFF;
+                    const Uint32 expected = (shift == alpha_shift) ? a : (a * c) / 255;
+                    if (((drow[x] >> shift) & 0xFF) != expected) {
+                        ++errors;
+                    }
+                }
+            }
+        }
+        SDLTest_AssertCheck(errors == 0, "Checking %s premultiply results, expected 0 errors, got %d", SDL_GetPixelFormatName(format), errors);
+
+        /* Unpremultiply */
+        ret = SDL_UnpremultiplyAlpha(width, height, format, src->pixels, src->pitch, format, dst->pixels, dst->pitch, false);
+        SDLTest_AssertCheck(ret == true, "SDL_UnpremultiplyAlpha(%s)", SDL_GetPixelFormatName(format));
+        errors = 0;
+        for (y = 0; y < height; ++y) {
+            const Uint32 *srow = (const Uint32 *)((const Uint8 *)src->pixels + y * src->pitch);
+            const Uint32 *drow = (const Uint32 *)((const Uint8 *)dst->pixels + y * dst->pitch);
+            for (x = 0; x < width; ++x) {
+                const Uint32 a = (srow[x] >> alpha_shift) & 0xFF;
+                for (shift = 0; shift < 32; shift += 8) {
+                    const Uint32 c = (srow[x] >> shift) & 0xFF;
+                    Uint32 expected;
+                    if (shift == alpha_shift) {
+                        expected = a;
+                    } else if (a == 0) {
+                        expected = 0;
+                    } else {
+                        expected = SDL_min((c * 255 + a / 2) / a, 255);
+                    }
+                    if (((drow[x] >> shift) & 0xFF) != expected) {
+                        ++errors;
+                    }
+                }
+            }
+        }
+        SDLTest_AssertCheck(errors == 0, "Checking %s unpremultiply results, expected 0 errors, got %d", SDL_GetPixelFormatName(format), errors);
+
+        /* Linear premultiply should agree with the float conversion path */
+        fsrc = SDL_ConvertSurface(src, SDL_PIXELFORMAT_ARGB128_FLOAT);
+        SDLTest_AssertCheck(fsrc != NULL, "SDL_ConvertSurface()");
+        ret = SDL_PremultiplyAlpha(width, height, format, src->pixels, src->pitch, format, dst->pixels, dst->pitch, true);
+        SDLTest_AssertCheck(ret == true, "SDL_PremultiplyAlpha(%s, linear)", SDL_GetPixelFormatName(format));
+        if (fsrc) {
+            ret = SDL_PremultiplySurfaceAlpha(fsrc, true);
+            SDLTest_AssertCheck(ret == true, "SDL_PremultiplySurfaceAlpha(ARGB128_FLOAT, linear)");
+            fdst = SDL_ConvertSurface(fsrc, format);
+            SDLTest_AssertCheck(fdst != NULL, "SDL_ConvertSurface()");
+            if (fdst) {
+                errors = 0;
+                for (y = 0; y < height; ++y) {
+                    const Uint8 *arow = (const Uint8 *)dst->pixels + y * dst->pitch;
+                    const Uint8 *erow = (const Uint8 *)fdst->pixels + y * fdst->pitch;
+                    for (x = 0; x < width * 4; ++x) {
+                        if (SDL_abs(arow[x] - erow[x]) > 1) {
+                            ++errors;
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(errors == 0, "Checking %s linear premultiply results, expected 0 errors, got %d", SDL_GetPixelFormatName(format), errors);
+                SDL_DestroySurface(fdst);
+            }
+            SDL_DestroySurface(fsrc);
+        }
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+    }
+
+    /* Float premultiply followed by unpremultiply gets back the original colors */
+    fsrc = SDL_CreateSurface(width, 1, SDL_PIXELFORMAT_ARGB128_FLOAT);
+    SDLTest_AssertCheck(fsrc != NULL, "SDL_CreateSurface()");
+    if (fsrc) {
+        float *pixels = (float *)fsrc->pixels;
+        float *original = (float *)SDL_malloc(width * 4 * sizeof(float));
+
+        for (x = 0; x < width * 4; ++x) {
+            pixels[x] = (float)(SDLTest_RandomIntegerInRange(1, 256)) / 256.0f;
+        }
+        SDL_memcpy(original, pixels, width * 4 * sizeof(float));
+        ret = SDL_PremultiplySurfaceAlpha(fsrc, true);
+        SDLTest_AssertCheck(ret == true, "SDL_PremultiplySurfaceAlpha(ARGB128_FLOAT)");
+        ret = SDL_UnpremultiplySurfaceAlpha(fsrc, true);
+        SDLTest_AssertCheck(ret == true, "SDL_UnpremultiplySurfaceAlpha(ARGB128_FLOAT)");
+        errors = 0;
+        for (x = 0; x < width * 4; ++x) {
+            if (SDL_fabsf(pixels[x] - original[x]) > 0.0001f) {
+                ++errors;
+            }
+        }
+        SDLTest_AssertCheck(errors == 0, "Checking float premultiply round trip, expected 0 errors, got %d", errors);
+        SDL_free(original);
+        SDL_DestroySurface(fsrc);
+    }
+
+    return TEST_COMPLETED;
+}
+
+
+/**
+ * Tests that plain colorspace conversions give the same result as blending an opaque source,
+ * which goes through the per-pixel conversion.
+ */
+static int SDLCALL surface_testConvertColorspaceRows(void *arg)
+{
+    static const struct
+    {
+        SDL_PixelFormat src_format;
+        SDL_Colorspace src_colorspace;
+        SDL_PixelFormat dst_format;
+        SDL_Colorspace dst_colorspace;
+        float max_error;
+    } cases[] = {
+        { SDL_PIXELFORMAT_XBGR2101010, SDL_COLORSPACE_HDR10, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_SRGB, 1.5f / 255.0f },
+        { SDL_PIXELFORMAT_XBGR2101010, SDL_COLORSPACE_HDR10, SDL_PIXELFORMAT_RGBA64_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0.002f },
+        { SDL_PIXELFORMAT_RGBA64_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, 1.5f / 255.0f },
+        { SDL_PIXELFORMAT_RGBA64_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, SDL_PIXELFORMAT_ABGR2101010, SDL_COLORSPACE_HDR10, 1.5f / 1023.0f },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, SDL_PIXELFORMAT_RGBA128_FLOAT, SDL_COLORSPACE_SRGB_LINEAR, 0.0001f },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_COLORSPACE_SRGB, SDL_PIXELFORMAT_ARGB2101010, SDL_COLORSPACE_HDR10, 1.5f / 1023.0f },
+    };
+    SDL_Surface *src = NULL, *dst = NULL, *ref = NULL;
+    int i, x, y, c;
+    bool ret;
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        float worst = 0.0f;
+
+        src = SDL_CreateSurface(67, 9, cases[i].src_format);
+        dst = SDL_CreateSurface(67, 9, cases[i].dst_format);
+        ref = SDL_CreateSurface(67, 9, cases[i].dst_format);
+        SDLTest_AssertCheck(src && dst && ref, "Verify surfaces are not NULL");
+        if (!src || !dst || !ref) {
+            goto done;
+        }
+        SDL_SetSurfaceColorspace(src, cases[i].src_colorspace);
+        SDL_SetSurfaceColorspace(dst, cases[i].dst_colorspace);
+        SDL_SetSurfaceColorspace(ref, cases[i].dst_colorspace);
+        if (cases[i].src_colorspace == SDL_COLORSPACE_SRGB_LINEAR) {
+            SDL_SetFloatProperty(SDL_GetSurfaceProperties(src), SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, 4.0f);
+        }
+
+        /* Random opaque pixels, up to 4x SDR white for the half float source */
+        for (y = 0; y < src->h; ++y) {
+            Uint8 *row = (Uint8 *)src->pixels + y * src->pitch;
+            for (x = 0; x < src->w; ++x) {
+                if (cases[i].src_format == SDL_PIXELFORMAT_RGBA64_FLOAT) {
+                    Uint16 *pixel = (Uint16 *)row + x * 4;
+                    for (c = 0; c < 3; ++c) {
+                        pixel[c] = (Uint16)SDLTest_RandomIntegerInRange(0, 0x4400);
+                    }
+                    pixel[3] = 0x3C00;
+                } else if (SDL_ISPIXELFORMAT_10BIT(cases[i].src_format)) {
+                    ((Uint32 *)row)[x] = SDLTest_RandomUint32() | 0xC0000000;
+                } else {
+                    ((Uint32 *)row)[x] = SDLTest_RandomUint32() | 0xFF000000;
+                }
+            }
+        }
+
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+        ret = SDL_BlitSurface(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == true, "Verify result from SDL_BlitSurface(), expected: true, got: %i", ret);
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        ret = SDL_BlitSurface(src, NULL, ref, NULL);
+        SDLTest_AssertCheck(ret == true, "Verify result from SDL_BlitSurface(), expected: true, got: %i", ret);
+
+        for (y = 0; y < dst->h; ++y) {
+            for (x = 0; x < dst->w; ++x) {
+                if (SDL_BYTESPERPIXEL(cases[i].dst_format) == 4) {
+                    /* Compare the raw channels, reading back would go through 8 bits per channel */
+                    const SDL_PixelFormatDetails *details = SDL_GetPixelFormatDetails(cases[i].dst_format);
+                    const Uint32 masks[] = { details->Rmask, details->Gmask, details->Bmask, details->Amask };
+                    const Uint32 actual = ((const Uint32 *)((const Uint8 *)dst->pixels + y * dst->pitch))[x];
+                    const Uint32 expected = ((const Uint32 *)((const Uint8 *)ref->pixels + y * ref->pitch))[x];
+                    for (c = 0; c < 4; ++c) {
+                        if (masks[c]) {
+                            const int shift = SDL_MostSignificantBitIndex32(masks[c] & ~(masks[c] << 1));
+                            const int max = (int)(masks[c] >> shift);
+                            const int delta = SDL_abs((int)((actual & masks[c]) >> shift) - (int)((expected & masks[c]) >> shift));
+                            worst = SDL_max(worst, (float)delta / max);
+                        }
+                    }
+                } else {
+                    float actual[4], expected[4];
+                    SDL_ReadSurfacePixelFloat(dst, x, y, &actual[0], &actual[1], &actual[2], &actual[3]);
+                    SDL_ReadSurfacePixelFloat(ref, x, y, &expected[0], &expected[1], &expected[2], &expected[3]);
+                    for (c = 0; c < 4; ++c) {
+                        worst = SDL_max(worst, SDL_fabsf(actual[c] - expected[c]) / SDL_max(1.0f, SDL_fabsf(expected[c])));
+                    }
+                }
+            }
+        }
+        SDLTest_AssertCheck(worst <= cases[i].max_error, "Verify %s to %s conversion matches the per-pixel conversion, expected: <= %g, got: %g",
+                            SDL_GetPixelFormatName(cases[i].src_format), SDL_GetPixelFormatName(cases[i].dst_format), cases[i].max_error, worst);
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+        SDL_DestroySurface(ref);
+        src = dst = ref = NULL;
+    }
+
+done:
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+    SDL_DestroySurface(ref);
+    return TEST_COMPLETED;
+}
+
+/* Fill with runs of transparent, opaque and translucent pixels, the way sprite sheets look */
+static void FillRLETestSurface(SDL_Surface *surface, bool colorkey)
+{
+    int x, y, run = 0, kind = 0;
+
+    for (y = 0; y < surface->h; ++y) {
+        for (x = 0; x < surface->w; ++x) {
+            Uint8 r, g, b, a;
+            if (run == 0) {
+                kind = SDLTest_RandomIntegerInRange(0, 2);
+                run = SDLTest_RandomIntegerInRange(1, (kind == 0) ? 300 : 40);
+            }
+            --run;
+            r = SDLTest_RandomUint8();
+            g = (Uint8)SDLTest_RandomIntegerInRange(8, 255); /* never the color key */
+            b = SDLTest_RandomUint8();
+            if (kind == 0) {
+                if (colorkey) {
+                    r = 255;
+                    g = 0;
+                    b = 255;
+                }
+                a = 0;
+            } else if (kind == 1) {
+                a = 255;
+            } else {
+                a = (Uint8)SDLTest_RandomIntegerInRange(1, 254);
+            }
+            SDL_WriteSurfacePixel(surface, x, y, r, g, b, a);
+        }
+    }
+    if (colorkey) {
+        SDL_SetSurfaceColorKey(surface, true, SDL_MapSurfaceRGB(surface, 255, 0, 255));
+    } else {
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND);
+    }
+}
+
+/* Compare dst with expected inside rect, or everywhere if rect is NULL, and with background outside of it */
+static int CompareRLEBlit(SDL_Surface *dst, SDL_Surface *expected, SDL_Surface *background, const SDL_Rect *rect)
+{
+    const int bpp = SDL_BYTESPERPIXEL(dst->format);
+    int x, y, errors = 0;
+
+    for (y = 0; y < dst->h; ++y) {
+        const Uint8 *row = (const Uint8 *)dst->pixels + y * dst->pitch;
+        for (x = 0; x < dst->w; ++x) {
+            const SDL_Point point = { x, y };
+            const SDL_Surface *reference = (!rect || SDL_PointInRect(&point, rect)) ? expected : background;
+            const Uint8 *ref = (const Uint8 *)reference->pixels + y * reference->pitch;
+            if (SDL_memcmp(row + x * bpp, ref + x * bpp, bpp) != 0) {
+                ++errors;
+            }
+        }
+    }
+    return errors;
+}
+
+/**
+ * Tests RLE accelerated blits: encoding on one thread, on several and ahead of time
+ * have to give the same results, and clipped blits the same pixels as unclipped ones.
+ */
+static int SDLCALL surface_testBlitRLE(void *arg)
+{
+    static const struct
+    {
+        SDL_PixelFormat src_format;
+        SDL_PixelFormat dst_format;
+        bool colorkey;
+        Uint8 alpha;
+    } cases[] = {
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, true, 255 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, true, 100 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, true, 128 },
+        { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565, true, 255 },
+        { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565, true, 100 },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_RGB24, true, 255 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, false, 255 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, false, 255 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, false, 255 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB1555, false, 255 },
+    };
+    /* Large enough to be encoded with blit threads */
+    const int w = 301, h = 263;
+    const SDL_Rect clip = { 17, 9, w - 40, h - 30 };
+    int i, mode, x, y, errors;
+    bool ret;
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        const char *name = SDL_GetPixelFormatName(cases[i].src_format);
+        const char *dst_name = SDL_GetPixelFormatName(cases[i].dst_format);
+        SDL_Surface *src = SDL_CreateSurface(w, h, cases[i].src_format);
+        SDL_Surface *background = SDL_CreateSurface(w, h, cases[i].dst_format);
+        SDL_Surface *expected = NULL;
+
+        SDLTest_AssertCheck(src && background, "Verify surfaces are not NULL");
+        if (!src || !background) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(background);
+            return TEST_ABORTED;
+        }
+        FillRLETestSurface(src, cases[i].colorkey);
+        SDL_SetSurfaceAlphaMod(src, cases[i].alpha);
+        for (y = 0; y < h; ++y) {
+            for (x = 0; x < w; ++x) {
+                SDL_WriteSurfacePixel(background, x, y, SDLTest_RandomUint8(), SDLTest_RandomUint8(), SDLTest_RandomUint8(), 255);
+            }
+        }
+
+        /* 0: encoded by the first blit, 1: the same with blit threads, 2: encoded ahead of time */
+        for (mode = 0; mode < 3; ++mode) {
+            SDL_Surface *rle = SDL_DuplicateSurface(src);
+            SDL_Surface *dst = SDL_DuplicateSurface(background);
+            SDL_Surface *clipped = SDL_DuplicateSurface(background);
+            SDL_Rect dstrect = clip;
+
+            SDLTest_AssertCheck(rle && dst && clipped, "Verify surfaces are not NULL");
+            if (!rle || !dst || !clipped) {
+                SDL_DestroySurface(rle);
+                SDL_DestroySurface(dst);
+                SDL_DestroySurface(clipped);
+                break;
+            }
+            SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, (mode == 1) ? "3" : "0");
+            SDL_SetSurfaceRLE(rle, true);
+            if (mode == 2) {
+                ret = SDL_EncodeSurfaceRLE(rle, cases[i].dst_format);
+                SDLTest_AssertCheck(ret, "SDL_EncodeSurfaceRLE(%s, %s), expected: true, got: %i", name, dst_name, ret);
+                SDLTest_AssertCheck(rle->pixels == NULL, "Verify the original pixels were released");
+            }
+            ret = SDL_BlitSurface(rle, NULL, dst, NULL);
+            SDLTest_AssertCheck(ret, "Verify result from blit, expected: true, got: %i", ret);
+            ret = SDL_BlitSurface(rle, &clip, clipped, &dstrect);
+            SDLTest_AssertCheck(ret, "Verify result from clipped blit, expected: true, got: %i", ret);
+
+            if (!expected) {
+                expected = dst;
+            } else {
+                errors = CompareRLEBlit(dst, expected, background, NULL);
+                SDLTest_AssertCheck(errors == 0, "Compare RLE blit of %s to %s in mode %d, expected 0 errors, got %d", name, dst_name, mode, errors);
+                SDL_DestroySurface(dst);
+            }
+            errors = CompareRLEBlit(clipped, expected, background, &clip);
+            SDLTest_AssertCheck(errors == 0, "Compare clipped RLE blit of %s to %s in mode %d, expected 0 errors, got %d", name, dst_name, mode, errors);
+            SDL_DestroySurface(clipped);
+
+            if (cases[i].colorkey && mode == 2) {
+                /* Locking decodes the surface again, which gives back the original pixels */
+                SDL_Surface *decoded = SDL_CreateSurface(w, h, cases[i].src_format);
+                if (decoded) {
+                    ret = SDL_LockSurface(rle);
+                    SDLTest_AssertCheck(ret && rle->pixels, "SDL_LockSurface(RLE surface)");
+                    if (ret && rle->pixels) {
+                        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+                        SDL_SetSurfaceColorKey(src, false, 0);
+                        SDL_BlitSurface(src, NULL, decoded, NULL);
+                        errors = CompareRLEBlit(rle, decoded, decoded, NULL);
+                        SDLTest_AssertCheck(errors == 0, "Compare decoded %s RLE surface, expected 0 errors, got %d", name, errors);
+                        SDL_UnlockSurface(rle);
+                        SDL_SetSurfaceColorKey(src, true, SDL_MapSurfaceRGB(src, 255, 0, 255));
+                    }
+                    SDL_DestroySurface(decoded);
+                }
+            }
+            SDL_DestroySurface(rle);
+        }
+
+        if (expected && SDL_BYTESPERPIXEL(cases[i].dst_format) == 4) {
+            /* Check against the definition: d + (s - d) * alpha / 256, rounding down */
+            errors = 0;
+            for (y = 0; y < h; ++y) {
+                for (x = 0; x < w; ++x) {
+                    Uint8 s[4], d[4], actual[4];
+                    unsigned alpha;
+                    int c;
+                    SDL_ReadSurfacePixel(src, x, y, &s[0], &s[1], &s[2], &s[3]);
+                    SDL_ReadSurfacePixel(background, x, y, &d[0], &d[1], &d[2], &d[3]);
+                    SDL_ReadSurfacePixel(expected, x, y, &actual[0], &actual[1], &actual[2], &actual[3]);
+                    if (cases[i].colorkey) {
+                        alpha = (s[0] == 255 && s[1] == 0 && s[2] == 255) ? 0 : cases[i].alpha;
+                    } else {
+                        alpha = s[3];
+                    }
+                    for (c = 0; c < 3; ++c) {
+                        int value = d[c];
+                        if (alpha == 255 || (alpha == 128 && cases[i].colorkey)) {
+                            value = (alpha == 255) ? s[c] : (s[c] + d[c]) / 2;
+                        } else if (alpha) {
+                            value = d[c] + (int)SDL_floorf((float)((s[c] - d[c]) * (int)alpha) / 256.0f);
+                        }
+                        if (actual[c] != value) {
+                            ++errors;
+                        }
+                    }
+                }
+            }
+            SDLTest_AssertCheck(errors == 0, "Check RLE blit of %s to %s with alpha %d, expected 0 errors, got %d", name, dst_name, cases[i].alpha, errors);
+        }
+
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(background);
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+
+    /* Surfaces that can't be encoded */
+    {
+        SDL_Surface *surface = SDL_CreateSurface(8, 8, SDL_PIXELFORMAT_ARGB8888);
+        if (surface) {
+            ret = SDL_EncodeSurfaceRLE(surface, SDL_PIXELFORMAT_XRGB8888);
+            SDLTest_AssertCheck(!ret, "SDL_EncodeSurfaceRLE() without RLE enabled, expected: false, got: %i", ret);
+            SDL_SetSurfaceRLE(surface, true);
+            ret = SDL_EncodeSurfaceRLE(surface, SDL_PIXELFORMAT_INDEX8);
+            SDLTest_AssertCheck(!ret, "SDL_EncodeSurfaceRLE() to INDEX8, expected: false, got: %i", ret);
+            SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_ADD);
+            ret = SDL_EncodeSurfaceRLE(surface, SDL_PIXELFORMAT_XRGB8888);
+            SDLTest_AssertCheck(!ret, "SDL_EncodeSurfaceRLE() with additive blending, expected: false, got: %i", ret);
+            SDL_DestroySurface(surface);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/* Reference for blits to paletted surfaces: the first of the closest colors */
+static Uint8 FindClosestPaletteColor(const SDL_Palette *palette, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    int best = 0;
+    int smallest = SDL_MAX_SINT32;
+    int i;
+
+    for (i = 0; i < palette->ncolors; i++) {
+        const int rd = palette->colors[i].r - r;
+        const int gd = palette->colors[i].g - g;
+        const int bd = palette->colors[i].b - b;
+        const int ad = palette->colors[i].a - a;
+        const int distance = rd * rd + gd * gd + bd * bd + ad * ad;
+        if (distance < smallest) {
+            smallest = distance;
+            best = i;
+        }
+    }
+    return (Uint8)best;
+}
+
+static void FillTestPalette(SDL_Palette *palette, int kind)
+{
+    SDL_Color colors[256];
+    int i;
+
+    for (i = 0; i < palette->ncolors; i++) {
+        switch (kind) {
+        case 0:
+            /* Random opaque colors */
+            colors[i].r = SDLTest_RandomUint8();
+            colors[i].g = SDLTest_RandomUint8();
+            colors[i].b = SDLTest_RandomUint8();
+            colors[i].a = SDL_ALPHA_OPAQUE;
+            break;
+        case 1:
+            /* A coarse grid repeated several times, so there are many ties */
+            colors[i].r = (Uint8)((i & 3) * 0x55);
+            colors[i].g = (Uint8)(((i >> 2) & 3) * 0x55);
+            colors[i].b = (Uint8)(((i >> 4) & 3) * 0x55);
+            colors[i].a = SDL_ALPHA_OPAQUE;
+            break;
+        default:
+            /* Random colors, some of them translucent */
+            colors[i].r = SDLTest_RandomUint8();
+            colors[i].g = SDLTest_RandomUint8();
+            colors[i].b = SDLTest_RandomUint8();
+            colors[i].a = (i % 3) ? SDL_ALPHA_OPAQUE : SDLTest_RandomUint8();
+            break;
+        }
+    }
+    SDL_SetPaletteColors(palette, colors, 0, palette->ncolors);
+}
+
+static int SDLCALL surface_testPaletteBlits(void *arg)
+{
+    const SDL_PixelFormat expand_formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_XRGB1555
+    };
+    const int ncolors[] = { 5, 16, 256 };
+    const int w = 71, h = 9;
+    int c, f, k, x, y, pass;
+
+    /* Expanding indices to 16 and 32-bit colors */
+    for (c = 0; c < SDL_arraysize(ncolors); c++) {
+        for (f = 0; f < SDL_arraysize(expand_formats); f++) {
+            for (k = 0; k < 2; k++) {
+                const bool colorkey = (k == 1);
+                const SDL_PixelFormatDetails *details = SDL_GetPixelFormatDetails(expand_formats[f]);
+                SDL_Palette *palette = SDL_CreatePalette(ncolors[c]);
+                SDL_Surface *src = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_INDEX8);
+                SDL_Surface *dst = SDL_CreateSurface(w, h, expand_formats[f]);
+                const SDL_Rect srcrect = { 1, 0, w - 1, h };
+                int mismatches = 0;
+
+                SDLTest_AssertCheck(palette && src && dst, "Create %d color palette and surfaces", ncolors[c]);
+                if (!palette || !src || !dst) {
+                    SDL_DestroyPalette(palette);
+                    SDL_DestroySurface(src);
+                    SDL_DestroySurface(dst);
+                    continue;
+                }
+                FillTestPalette(palette, 2);
+                SDL_SetSurfacePalette(src, palette);
+                for (y = 0; y < h; y++) {
+                    Uint8 *row = (Uint8 *)src->pixels + y * src->pitch;
+                    for (x = 0; x < w; x++) {
+                        /* Mostly valid indices, with a few that are past the end of the palette */
+                        row[x] = (x % 23) ? (Uint8)SDLTest_RandomIntegerInRange(0, ncolors[c] - 1) : SDLTest_RandomUint8();
+                    }
+                }
+                if (colorkey) {
+                    SDL_SetSurfaceColorKey(src, true, 3);
+                }
+                SDL_memset(dst->pixels, 0x5A, (size_t)dst->pitch * dst->h);
+
+                SDL_BlitSurface(src, &srcrect, dst, NULL);
+
+                for (y = 0; y < h; y++) {
+                    const Uint8 *srow = (const Uint8 *)src->pixels + y * src->pitch;
+                    const Uint8 *drow = (const Uint8 *)dst->pixels + y * dst->pitch;
+                    for (x = 0; x < srcrect.w; x++) {
+                        const Uint8 index = srow[srcrect.x + x];
+                        Uint32 expected = 0, actual;
+
+                        if (colorkey && index == 3) {
+                            expected = (details->bytes_per_pixel == 2) ? 0x5A5A : 0x5A5A5A5A;
+                        } else if (index < palette->ncolors) {
+                            const SDL_Color *color = &palette->colors[index];
+                            expected = SDL_MapRGBA(details, NULL, color->r, color->g, color->b, color->a);
+                        }
+                        if (details->bytes_per_pixel == 2) {
+                            actual = ((const Uint16 *)drow)[x];
+                        } else {
+                            actual = ((const Uint32 *)drow)[x];
+                        }
+                        if (actual != expected) {
+                            if (mismatches++ == 0) {
+                                SDLTest_LogError("Pixel (%d,%d) index %u: expected 0x%.8" SDL_PRIx32 ", got 0x%.8" SDL_PRIx32, x, y, index, expected, actual);
+                            }
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(mismatches == 0, "Expand %d colors to %s%s, expected 0 mismatches, got %d",
+                                    ncolors[c], SDL_GetPixelFormatName(expand_formats[f]), colorkey ? " with colorkey" : "", mismatches);
+
+                SDL_DestroyPalette(palette);
+                SDL_DestroySurface(src);
+                SDL_DestroySurface(dst);
+            }
+        }
+    }
+
+    /* Mapping colors to palette indices */
+    for (c = 0; c < SDL_arraysize(ncolors); c++) {
+        for (k = 0; k < 3; k++) {
+            SDL_Palette *palette = SDL_CreatePalette(ncolors[c]);
+            SDL_Surface *src = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_ARGB8888);
+            SDL_Surface *dst = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_INDEX8);
+            const SDL_PixelFormatDetails *details = SDL_GetPixelFormatDetails(SDL_PIXELFORMAT_INDEX8);
+
+            SDLTest_AssertCheck(palette && src && dst, "Create %d color palette and surfaces", ncolors[c]);
+            if (!palette || !src || !dst) {
+                SDL_DestroyPalette(palette);
+                SDL_DestroySurface(src);
+                SDL_DestroySurface(dst);
+                continue;
+            }
+            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+            SDL_SetSurfacePalette(dst, palette);
+
+            /* The second pass changes the palette, which must be picked up by the next blit */
+            for (pass = 0; pass < 2; pass++) {
+                int mismatches = 0;
+
+                FillTestPalette(palette, pass ? (k + 1) % 3 : k);
+                for (y = 0; y < src->h; y++) {
+                    Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+                    for (x = 0; x < src->w; x++) {
+                        /* Mostly opaque, with some translucent pixels */
+                        Uint32 alpha = (x % 4) ? 0xFF000000 : (Uint32)SDLTest_RandomUint8() << 24;
+                        row[x] = alpha | (SDLTest_RandomUint32() & 0x00FFFFFF);
+                    }
+                }
+                SDL_BlitSurface(src, NULL, dst, NULL);
+
+                for (y = 0; y < src->h; y++) {
+                    const Uint32 *srow = (const Uint32 *)((const Uint8 *)src->pixels + y * src->pitch);
+                    const Uint8 *drow = (const Uint8 *)dst->pixels + y * dst->pitch;
+                    for (x = 0; x < src->w; x++) {
+                        const Uint8 a = (Uint8)(srow[x] >> 24), r = (Uint8)(srow[x] >> 16), g = (Uint8)(srow[x] >> 8), b = (Uint8)srow[x];
+                        const Uint8 expected = FindClosestPaletteColor(palette, r, g, b, a);
+                        if (drow[x] != expected) {
+                            if (mismatches++ == 0) {
+                                SDLTest_LogError("Pixel (%d,%d) 0x%.8" SDL_PRIx32 ": expected index %u, got %u", x, y, srow[x], expected, drow[x]);
+                            }
+                        }
+                        if (x == y && SDL_MapRGBA(details, palette, r, g, b, a) != expected) {
+                            mismatches++;
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(mismatches == 0, "Map colors to %d color palette %d, pass %d, expected 0 mismatches, got %d", ncolors[c], k, pass, mismatches);
+            }
+
+            SDL_DestroyPalette(palette);
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+static void FillRawRect(Uint8 *pixels, int pitch, int bpp, const SDL_Rect *rect, Uint32 color)
+{
+    int x, y;
+
+    for (y = rect->y; y < rect->y + rect->h; ++y) {
+        Uint8 *p = pixels + y * pitch + rect->x * bpp;
+        for (x = 0; x < rect->w; ++x, p += bpp) {
+            switch (bpp) {
+            case 1:
+                *p = (Uint8)color;
+                break;
+            case 2:
+                *(Uint16 *)p = (Uint16)color;
+                break;
+            case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                p[0] = (Uint8)color;
+                p[1] = (Uint8)(color >> 8);
+                p[2] = (Uint8)(color >> 16);
+#else
+                p[0] = (Uint8)(color >> 16);
+                p[1] = (Uint8)(color >> 8);
+                p[2] = (Uint8)color;
+#endif
+                break;
+            default:
+                *(Uint32 *)p = color;
+                break;
+            }
+        }
+    }
+}
+
+static int SDLCALL surface_testFillRects(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_INDEX8,
+        SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_BGR24,
+        SDL_PIXELFORMAT_XRGB8888,
+    };
+    /* Large enough to be streamed and filled with blit threads */
+    const int w = 1201, h = 1200;
+    const SDL_Rect clip = { 2, 3, w - 4, h - 5 };
+    SDL_Rect rects[200];
+    int i, j, mode;
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        const char *name = SDL_GetPixelFormatName(formats[i]);
+        const int bpp = SDL_BYTESPERPIXEL(formats[i]);
+        /* Rows start at every alignment, with padding that must stay untouched */
+        const int pitch = (w + 3) * bpp;
+        const size_t size = (size_t)h * pitch + bpp;
+        Uint8 *buffer = (Uint8 *)SDL_malloc(size);
+        Uint8 *expected = (Uint8 *)SDL_malloc(size);
+        const Uint32 mask = (bpp == 4) ? 0xFFFFFFFF : ((1u << (bpp * 8)) - 1);
+
+        SDLTest_AssertCheck(buffer && expected, "Verify buffers are not NULL");
+        if (!buffer || !expected) {
+            SDL_free(buffer);
+            SDL_free(expected);
+            return TEST_ABORTED;
+        }
+
+        /* 0: filled on this thread, 1: filled with blit threads */
+        for (mode = 0; mode < 2; ++mode) {
+            SDL_Surface *surface = SDL_CreateSurfaceFrom(w, h, formats[i], buffer + bpp, pitch);
+            Uint8 *pixels = expected + bpp;
+            SDL_Rect big = { -7, -3, w + 20, h + 9 };
+            SDL_Rect clipped;
+            Uint32 color;
+            size_t k;
+            bool ret;
+
+            SDLTest_AssertCheck(surface != NULL, "Verify surface is not NULL");
+            if (!surface) {
+                break;
+            }
+            SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, (mode == 1) ? "3" : "0");
+            SDL_SetSurfaceClipRect(surface, &clip);
+            SDL_memset(buffer, 0x5a, size);
+            SDL_memset(expected, 0x5a, size);
+
+            /* One rectangle covering the whole surface */
+            color = (Uint32)SDLTest_RandomSint32() & mask;
+            ret = SDL_FillSurfaceRect(surface, &big, color);
+            SDLTest_AssertCheck(ret, "SDL_FillSurfaceRect(%s), expected: true, got: %i", name, ret);
+            SDL_GetRectIntersection(&big, &clip, &clipped);
+            FillRawRect(pixels, pitch, bpp, &clipped, color);
+
+            /* Lots of rectangles of every width and offset, some partly or completely clipped */
+            for (j = 0; j < SDL_arraysize(rects); ++j) {
+                rects[j].x = SDLTest_RandomIntegerInRange(-20, w);
+                rects[j].y = SDLTest_RandomIntegerInRange(-20, h);
+                rects[j].w = SDLTest_RandomIntegerInRange(0, 300);
+                rects[j].h = SDLTest_RandomIntegerInRange(0, 40);
+            }
+            color = (Uint32)SDLTest_RandomSint32() & mask;
+            ret = SDL_FillSurfaceRects(surface, rects, SDL_arraysize(rects), color);
+            SDLTest_AssertCheck(ret, "SDL_FillSurfaceRects(%s), expected: true, got: %i", name, ret);
+            for (j = 0; j < SDL_arraysize(rects); ++j) {
+                if (SDL_GetRectIntersection(&rects[j], &clip, &clipped)) {
+                    FillRawRect(pixels, pitch, bpp, &clipped, color);
+                }
+            }
+
+            for (k = 0; k < size; ++k) {
+                if (buffer[k] != expected[k]) {
+                    break;
+                }
+            }
+            SDLTest_AssertCheck(k == size, "Verify %s fill, mode %d, expected all bytes to match, first mismatch at row %d, byte %d",
+                                name, mode, (k < size) ? (int)((k - bpp) / pitch) : -1, (k < size) ? (int)((k - bpp) % pitch) : -1);
+            SDL_DestroySurface(surface);
+        }
+        SDL_free(buffer);
+        SDL_free(expected);
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testSurfacePool(void *arg)
+{
+    SDL_SurfacePool *pool;
+    SDL_SurfacePoolStats stats;
+    SDL_Surface *surface, *other, *large;
+    void *pixels;
+    Uint8 r, g, b, a;
+    bool ret;
+
+    pool = SDL_CreateSurfacePool(64 * 1024 * 1024, true);
+    SDLTest_AssertCheck(pool != NULL, "SDL_CreateSurfacePool(), expected: not NULL, got: %p", (void *)pool);
+    if (!pool) {
+        return TEST_ABORTED;
+    }
+
+    /* A new buffer is cleared, a recycled one keeps its pixels */
+    surface = SDL_CreatePooledSurface(pool, 97, 61, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreatePooledSurface(), expected: not NULL, got: %p", (void *)surface);
+    if (!surface) {
+        SDL_DestroySurfacePool(pool);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(((uintptr_t)surface->pixels % SDL_GetSIMDAlignment()) == 0, "Verify the pixels are SIMD aligned");
+    SDL_ReadSurfacePixel(surface, 96, 60, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 0 && g == 0 && b == 0, "Verify a new buffer is cleared, got %d,%d,%d", r, g, b);
+    SDL_WriteSurfacePixel(surface, 96, 60, 10, 20, 30, 255);
+    pixels = surface->pixels;
+    SDL_DestroySurface(surface);
+
+    ret = SDL_GetSurfacePoolStats(pool, &stats);
+    SDLTest_AssertCheck(ret, "SDL_GetSurfacePoolStats(), expected: true, got: %i", ret);
+    SDLTest_AssertCheck(stats.hits == 0 && stats.misses == 1, "Verify 0 hits and 1 miss, got %d and %d", (int)stats.hits, (int)stats.misses);
+    SDLTest_AssertCheck(stats.free_bytes == stats.resident_bytes && stats.free_bytes >= (size_t)61 * 97 * 4, "Verify the buffer is free, got %d of %d bytes", (int)stats.free_bytes, (int)stats.resident_bytes);
+
+    surface = SDL_CreatePooledSurface(pool, 97, 61, SDL_PIXELFORMAT_XRGB8888);
+    other = SDL_CreatePooledSurface(pool, 97, 61, SDL_PIXELFORMAT_RGB565);
+    SDLTest_AssertCheck(surface && other, "Verify surfaces are not NULL");
+    if (!surface || !other) {
+        SDL_DestroySurface(surface);
+        SDL_DestroySurface(other);
+        SDL_DestroySurfacePool(pool);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(surface->pixels == pixels, "Verify the buffer was reused");
+    SDLTest_AssertCheck(other->pixels != pixels, "Verify a different format gets its own buffer");
+    SDL_ReadSurfacePixel(surface, 96, 60, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 10 && g == 20 && b == 30, "Verify a reused buffer isn't cleared, got %d,%d,%d", r, g, b);
+    SDL_GetSurfacePoolStats(pool, &stats);
+    SDLTest_AssertCheck(stats.hits == 1 && stats.misses == 2, "Verify 1 hit and 2 misses, got %d and %d", (int)stats.hits, (int)stats.misses);
+    SDLTest_AssertCheck(stats.free_bytes == 0, "Verify no buffers are free, got %d bytes", (int)stats.free_bytes);
+    SDL_DestroySurface(other);
+
+    /* Large enough for huge pages, where they are supported */
+    large = SDL_CreatePooledSurface(pool, 1200, 1000, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(large != NULL, "SDL_CreatePooledSurface(1200x1000), expected: not NULL, got: %p", (void *)large);
+    if (large) {
+        SDL_ReadSurfacePixel(large, 1199, 999, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 0 && g == 0 && b == 0, "Verify a new large buffer is cleared, got %d,%d,%d", r, g, b);
+        ret = SDL_FillSurfaceRect(large, NULL, SDL_MapSurfaceRGB(large, 1, 2, 3));
+        SDLTest_AssertCheck(ret, "SDL_FillSurfaceRect(), expected: true, got: %i", ret);
+    }
+    SDL_GetSurfacePoolStats(pool, &stats);
+    SDLTest_AssertCheck(stats.resident_bytes >= (size_t)1200 * 1000 * 4 + 2 * 97 * 61 * 2, "Verify the resident bytes include every buffer, got %d", (int)stats.resident_bytes);
+
+    /* Zero sized surfaces don't need the pool */
+    other = SDL_CreatePooledSurface(pool, 0, 0, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(other != NULL, "SDL_CreatePooledSurface(0x0), expected: not NULL, got: %p", (void *)other);
+    SDL_DestroySurface(other);
+
+    /* RLE encoding gives the pixels back early */
+    other = SDL_CreatePooledSurface(pool, 33, 17, SDL_PIXELFORMAT_XRGB8888);
+    if (other) {
+        size_t free_bytes;
+
+        SDL_GetSurfacePoolStats(pool, &stats);
+        free_bytes = stats.free_bytes;
+        SDL_SetSurfaceColorKey(other, true, 0);
+        SDL_SetSurfaceRLE(other, true);
+        SDL_BlitSurface(other, NULL, surface, NULL);
+        SDL_GetSurfacePoolStats(pool, &stats);
+        SDLTest_AssertCheck(stats.free_bytes > free_bytes, "Verify RLE encoding released the pixels, got %d free bytes", (int)stats.free_bytes);
+        SDL_DestroySurface(other);
+    }
+
+    /* Surfaces outlive their pool */
+    SDL_DestroySurface(surface);
+    SDL_DestroySurfacePool(pool);
+    if (large) {
+        SDL_ReadSurfacePixel(large, 1199, 999, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 1 && g == 2 && b == 3, "Verify a surface still works after its pool is destroyed, got %d,%d,%d", r, g, b);
+        SDL_DestroySurface(large);
+    }
+
+    /* A pool that doesn't keep anything frees buffers right away */
+    pool = SDL_CreateSurfacePool(0, false);
+    surface = SDL_CreatePooledSurface(pool, 16, 16, SDL_PIXELFORMAT_INDEX8);
+    SDL_DestroySurface(surface);
+    SDL_GetSurfacePoolStats(pool, &stats);
+    SDLTest_AssertCheck(stats.resident_bytes == 0, "Verify nothing is resident, got %d bytes", (int)stats.resident_bytes);
+
+    /* Sizes that were used once don't leave anything behind */
+    {
+        const int allocations = SDL_GetNumAllocations();
+        int i;
+
+        for (i = 1; i <= 64; ++i) {
+            surface = SDL_CreatePooledSurface(pool, i, i, SDL_PIXELFORMAT_INDEX8);
+            SDL_DestroySurface(surface);
+        }
+        SDLTest_AssertCheck(SDL_GetNumAllocations() == allocations, "Verify the pool didn't keep any allocations, expected: %d, got: %d", allocations, SDL_GetNumAllocations());
+    }
+    SDL_DestroySurfacePool(pool);
+
+    surface = SDL_CreatePooledSurface(NULL, 16, 16, SDL_PIXELFORMAT_INDEX8);
+    SDLTest_AssertCheck(surface == NULL, "SDL_CreatePooledSurface(NULL), expected: NULL, got: %p", (void *)surface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that duplicated surfaces share their pixels until they are changed.
+ */
+static int SDLCALL surface_testCopyOnWrite(void *arg)
+{
+    SDL_SurfacePool *pool;
+    SDL_Surface *surface, *copy, *other;
+    void *pixels;
+    Uint8 r, g, b, a;
+    bool ret;
+
+    SDL_SetHint(SDL_HINT_SURFACE_COPY_ON_WRITE, "1");
+
+    surface = SDL_CreateSurface(64, 48, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface(), expected: not NULL, got: %p", (void *)surface);
+    if (!surface) {
+        SDL_ResetHint(SDL_HINT_SURFACE_COPY_ON_WRITE);
+        return TEST_ABORTED;
+    }
+    SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, 10, 20, 30, 40));
+    SDL_SetSurfaceAlphaMod(surface, 128);
+
+    /* A duplicate refers to the same pixels and keeps the surface settings */
+    copy = SDL_DuplicateSurface(surface);
+    SDLTest_AssertCheck(copy != NULL, "SDL_DuplicateSurface(), expected: not NULL, got: %p", (void *)copy);
+    if (!copy) {
+        SDL_DestroySurface(surface);
+        SDL_ResetHint(SDL_HINT_SURFACE_COPY_ON_WRITE);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(copy->pixels == surface->pixels, "Verify the duplicate shares the pixels");
+    SDLTest_AssertCheck(copy->pitch == surface->pitch, "Verify the duplicate has the same pitch, got %d", copy->pitch);
+    SDLTest_AssertCheck(!(copy->flags & SDL_SURFACE_PREALLOCATED), "Verify the duplicate isn't preallocated");
+    SDL_GetSurfaceAlphaMod(copy, &a);
+    SDLTest_AssertCheck(a == 128, "Verify the duplicate alpha mod, expected: 128, got: %d", a);
+
+    /* Writing to the duplicate gives it its own pixels */
+    pixels = surface->pixels;
+    ret = SDL_WriteSurfacePixel(copy, 5, 5, 200, 100, 50, 255);
+    SDLTest_AssertCheck(ret, "SDL_WriteSurfacePixel(), expected: true, got: %i", ret);
+    SDLTest_AssertCheck(copy->pixels != pixels && surface->pixels == pixels, "Verify only the written surface got new pixels");
+    SDLTest_AssertCheck(((uintptr_t)copy->pixels % SDL_GetSIMDAlignment()) == 0, "Verify the new pixels are SIMD aligned");
+    SDL_ReadSurfacePixel(surface, 5, 5, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 10 && g == 20 && b == 30 && a == 40, "Verify the original is unchanged, got %d,%d,%d,%d", r, g, b, a);
+    SDL_ReadSurfacePixel(copy, 6, 5, &r, &g, &b, &a);
+    SDLTest_AssertCheck(r == 10 && g == 20 && b == 30 && a == 40, "Verify the copy kept the other pixels, got %d,%d,%d,%d", r, g, b, a);
+    SDL_DestroySurface(copy);
+
+    /* Fills, blits and locks of the original leave duplicates alone */
+    copy = SDL_DuplicateSurface(surface);
+    other = SDL_DuplicateSurface(copy);
+    SDLTest_AssertCheck(copy && other && other->pixels == pixels, "Verify duplicates of duplicates share the pixels");
+    if (copy && other) {
+        ret = SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, 1, 2, 3, 4));
+        SDLTest_AssertCheck(ret, "SDL_FillSurfaceRect(), expected: true, got: %i", ret);
+        SDL_ReadSurfacePixel(copy, 0, 0, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 10 && g == 20 && b == 30 && a == 40, "Verify a fill didn't change the duplicate, got %d,%d,%d,%d", r, g, b, a);
+
+        ret = SDL_BlitSurface(surface, NULL, copy, NULL);
+        SDLTest_AssertCheck(ret, "SDL_BlitSurface(), expected: true, got: %i", ret);
+        SDL_ReadSurfacePixel(other, 0, 0, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 10 && g == 20 && b == 30 && a == 40, "Verify a blit didn't change the other duplicate, got %d,%d,%d,%d", r, g, b, a);
+
+        /* The last surface using the pixels takes them back */
+        SDLTest_AssertCheck(other->pixels == pixels, "Verify the last duplicate still has the original pixels");
+        ret = SDL_LockSurface(other);
+        SDLTest_AssertCheck(ret, "SDL_LockSurface(), expected: true, got: %i", ret);
+        SDLTest_AssertCheck(other->pixels == pixels, "Verify the pixels weren't copied for the last surface using them");
+        *(Uint32 *)other->pixels = 0;
+        SDL_UnlockSurface(other);
+    }
+    SDL_DestroySurface(copy);
+    SDL_DestroySurface(other);
+
+    /* The original can go away first */
+    copy = SDL_DuplicateSurface(surface);
+    pixels = surface->pixels;
+    SDL_DestroySurface(surface);
+    if (copy) {
+        SDLTest_AssertCheck(copy->pixels == pixels, "Verify the duplicate shared the pixels");
+        SDL_ReadSurfacePixel(copy, 63, 47, &r, &g, &b, &a);
+        SDLTest_AssertCheck(r == 1 && g == 2 && b == 3 && a == 4, "Verify the duplicate outlives the original, got %d,%d,%d,%d", r, g, b, a);
+        SDL_DestroySurface(copy);
+    }
+
+    /* Conversions that change the pixels still copy them */
+    surface = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_XRGB8888);
+    if (surface) {
+        copy = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_XRGB8888);
+        SDLTest_AssertCheck(copy && copy->pixels == surface->pixels, "Verify a conversion to the same format shares the pixels");
+        SDL_DestroySurface(copy);
+        copy = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGB565);
+        SDLTest_AssertCheck(copy && copy->pixels != surface->pixels, "Verify a conversion to another format copies the pixels");
+        SDL_DestroySurface(copy);
+        SDL_SetSurfaceColorKey(surface, true, 0);
+        copy = SDL_DuplicateSurface(surface);
+        SDLTest_AssertCheck(copy && copy->pixels != surface->pixels, "Verify a colorkeyed surface is copied");
+        SDL_DestroySurface(copy);
+
+        /* RLE encoding releases the shared pixels */
+        SDL_SetSurfaceColorKey(surface, false, 0);
+        copy = SDL_DuplicateSurface(surface);
+        other = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_XRGB8888);
+        SDLTest_AssertCheck(copy && copy->pixels == surface->pixels, "Verify the duplicate shares the pixels");
+        if (copy && other) {
+            SDL_SetSurfaceColorKey(copy, true, 0);
+            SDL_SetSurfaceRLE(copy, true);
+            ret = SDL_BlitSurface(copy, NULL, other, NULL);
+            SDLTest_AssertCheck(ret, "SDL_BlitSurface() with RLE, expected: true, got: %i", ret);
+        }
+        SDL_DestroySurface(copy);
+        SDL_DestroySurface(other);
+        SDL_DestroySurface(surface);
+    }
+
+    /* Pooled pixels go back to the pool once no surface uses them */
+    pool = SDL_CreateSurfacePool(1024 * 1024, false);
+    surface = SDL_CreatePooledSurface(pool, 32, 32, SDL_PIXELFORMAT_RGB565);
+    if (surface) {
+        SDL_SurfacePoolStats stats;
+
+        copy = SDL_DuplicateSurface(surface);
+        SDLTest_AssertCheck(copy && copy->pixels == surface->pixels, "Verify a pooled surface shares its pixels");
+        SDL_DestroySurface(surface);
+        SDL_GetSurfacePoolStats(pool, &stats);
+        SDLTest_AssertCheck(stats.free_bytes == 0, "Verify the pixels are still in use, got %d free bytes", (int)stats.free_bytes);
+        SDL_DestroySurface(copy);
+        SDL_GetSurfacePoolStats(pool, &stats);
+        SDLTest_AssertCheck(stats.free_bytes > 0, "Verify the pixels went back to the pool, got %d free bytes", (int)stats.free_bytes);
+    }
+    SDL_DestroySurfacePool(pool);
+
+    /* Without the hint duplicates get their own pixels */
+    SDL_ResetHint(SDL_HINT_SURFACE_COPY_ON_WRITE);
+    surface = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_XRGB8888);
+    copy = SDL_DuplicateSurface(surface);
+    SDLTest_AssertCheck(surface && copy && copy->pixels != surface->pixels, "Verify the pixels are copied by default");
+    SDL_DestroySurface(copy);
+    SDL_DestroySurface(surface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests horizontal flips and quarter turns of every pixel size against a simple reference.
+ */
+static int SDLCALL surface_testRotate90(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_INDEX8,
+        SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_RGB24,
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_RGB48,
+        SDL_PIXELFORMAT_RGBA64,
+        SDL_PIXELFORMAT_RGBA128_FLOAT,
+    };
+    static const struct
+    {
+        int w;
+        int h;
+    } sizes[] = { { 1, 1 }, { 7, 3 }, { 37, 23 }, { 64, 64 }, { 131, 67 } };
+    int f, i, turns, threads;
+
+    for (threads = 0; threads < 2; threads++) {
+        SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, threads ? "3" : "0");
+
+        for (f = 0; f < SDL_arraysize(formats); f++) {
+            for (i = 0; i < SDL_arraysize(sizes); i++) {
+                const int w = sizes[i].w;
+                const int h = sizes[i].h;
+                SDL_Surface *surface = SDL_CreateSurface(w, h, formats[f]);
+                SDL_Surface *flipped;
+                int bpp, x, y, errors = 0;
+
+                if (!surface) {
+                    SDLTest_AssertCheck(false, "SDL_CreateSurface(%s), got: %s", SDL_GetPixelFormatName(formats[f]), SDL_GetError());
+                    continue;
+                }
+                bpp = SDL_BYTESPERPIXEL(formats[f]);
+                for (y = 0; y < h; y++) {
+                    for (x = 0; x < w * bpp; x++) {
+                        ((Uint8 *)surface->pixels)[y * surface->pitch + x] = (Uint8)SDL_rand(256);
+                    }
+                }
+
+                for (turns = -1; turns <= 4; turns++) {
+                    SDL_Surface *rotated = SDL_RotateSurface90(surface, turns);
+                    const int t = (turns + 4) % 4;
+
+                    if (!rotated) {
+                        SDLTest_AssertCheck(false, "SDL_RotateSurface90(%d), got: %s", turns, SDL_GetError());
+                        continue;
+                    }
+                    errors = 0;
+                    if (rotated->w != ((t & 1) ? h : w) || rotated->h != ((t & 1) ? w : h)) {
+                        errors = 1;
+                    } else {
+                        for (y = 0; y < rotated->h; y++) {
+                            for (x = 0; x < rotated->w; x++) {
+                                int sx, sy;
+
+                                switch (t) {
+                                case 0:
+                                    sx = x;
+                                    sy = y;
+                                    break;
+                                case 1:
+                                    sx = y;
+                                    sy = h - 1 - x;
+                                    break;
+                                case 2:
+                                    sx = w - 1 - x;
+                                    sy = h - 1 - y;
+                                    break;
+                                default:
+                                    sx = w - 1 - y;
+                                    sy = x;
+                                    break;
+                                }
+                                if (SDL_memcmp((Uint8 *)rotated->pixels + y * rotated->pitch + x * bpp,
+                                               (Uint8 *)surface->pixels + sy * surface->pitch + sx * bpp, bpp) != 0) {
+                                    ++errors;
+                                }
+                            }
+                        }
+                    }
+                    SDLTest_AssertCheck(errors == 0, "Verify %s %dx%d rotated %d quarter turns, expected: 0 errors, got: %d",
+                                        SDL_GetPixelFormatName(formats[f]), w, h, turns, errors);
+                    SDL_DestroySurface(rotated);
+                }
+
+                /* Copied by hand, converting isn't lossless for every format */
+                flipped = SDL_CreateSurface(w, h, formats[f]);
+                if (flipped) {
+                    for (y = 0; y < h; y++) {
+                        SDL_memcpy((Uint8 *)flipped->pixels + y * flipped->pitch, (Uint8 *)surface->pixels + y * surface->pitch, (size_t)w * bpp);
+                    }
+                    SDL_FlipSurface(flipped, SDL_FLIP_HORIZONTAL);
+                    errors = 0;
+                    for (y = 0; y < h; y++) {
+                        for (x = 0; x < w; x++) {
+                            if (SDL_memcmp((Uint8 *)flipped->pixels + y * flipped->pitch + x * bpp,
+                                           (Uint8 *)surface->pixels + y * surface->pitch + (w - 1 - x) * bpp, bpp) != 0) {
+                                ++errors;
+                            }
+                        }
+                    }
+                    SDLTest_AssertCheck(errors == 0, "Verify %s %dx%d flipped horizontally, expected: 0 errors, got: %d",
+                                        SDL_GetPixelFormatName(formats[f]), w, h, errors);
+                    SDL_DestroySurface(flipped);
+                }
+                SDL_DestroySurface(surface);
+            }
+        }
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+
+    return TEST_COMPLETED;
+}
+
+static Uint32 GetRawPixel(const Uint8 *p, int bpp)
+{
+    switch (bpp) {
+    case 2:
+        return *(const Uint16 *)p;
+    case 3:
+        if (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+            return p[0] | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16);
+        } else {
+            return ((Uint32)p[0] << 16) | ((Uint32)p[1] << 8) | p[2];
+        }
+    default:
+        return *(const Uint32 *)p;
+    }
+}
+
+/**
+ * Tests SDL_ConvertPixels() between the 16, 24 and 32-bit RGB formats, which doesn't go through a blit,
+ * against SDL_ConvertSurface(), which does
+ */
+static int SDLCALL surface_testConvertPixelsDirect(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_XRGB4444, SDL_PIXELFORMAT_XBGR4444, SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_RGBA4444,
+        SDL_PIXELFORMAT_ABGR4444, SDL_PIXELFORMAT_BGRA4444, SDL_PIXELFORMAT_XRGB1555, SDL_PIXELFORMAT_XBGR1555,
+        SDL_PIXELFORMAT_ARGB1555, SDL_PIXELFORMAT_RGBA5551, SDL_PIXELFORMAT_ABGR1555, SDL_PIXELFORMAT_BGRA5551,
+        SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_BGR565, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_BGR24,
+        SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGBX8888, SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_BGRX8888,
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_XRGB2101010, SDL_PIXELFORMAT_XBGR2101010, SDL_PIXELFORMAT_ARGB2101010, SDL_PIXELFORMAT_ABGR2101010,
+    };
+    /* Odd widths leave pixels for the scalar code and wide rows go through the 24-bit buffer in chunks.
+       The last size covers every 16-bit pixel value, and is big enough to be split across threads. */
+    static const struct
+    {
+        int w;
+        int h;
+    } sizes[] = { { 1, 1 }, { 13, 3 }, { 67, 5 }, { 611, 2 }, { 256, 256 } };
+    /* Rows are padded, but the blitters used for reference need pitches that are a multiple of 4 */
+    const int padding = 13;
+    int i, j, k;
+
+    SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, "3");
+    for (i = 0; i < SDL_arraysize(formats); i++) {
+        const int src_bpp = SDL_BYTESPERPIXEL(formats[i]);
+
+        for (k = 0; k < SDL_arraysize(sizes); k++) {
+            const int w = sizes[k].w;
+            const int h = sizes[k].h;
+            const int src_pitch = (w * src_bpp + padding + 3) & ~3;
+            SDL_PixelFormat first_format = SDL_PIXELFORMAT_UNKNOWN;
+            Uint32 first_in = 0, first_expected = 0, first_got = 0;
+            SDL_Surface *source;
+            Uint8 *src, *dst;
+            int x, y, mismatched = 0;
+
+            if (w * h == 65536 && src_bpp != 2) {
+                continue;
+            }
+            src = (Uint8 *)SDL_malloc((size_t)src_pitch * h);
+            dst = (Uint8 *)SDL_malloc((size_t)((w * 4 + padding + 3) & ~3) * h);
+
+            if (!src || !dst) {
+                SDLTest_AssertCheck(false, "Allocate %dx%d pixels", w, h);
+                SDL_free(src);
+                SDL_free(dst);
+                continue;
+            }
+            if (w * h == 65536) {
+                /* Every 16-bit pixel value */
+                for (y = 0; y < h; y++) {
+                    for (x = 0; x < w; x++) {
+                        const Uint16 value = (Uint16)(y * w + x);
+                        SDL_memcpy(src + y * src_pitch + x * 2, &value, sizeof(value));
+                    }
+                }
+            } else {
+                for (x = 0; x < src_pitch * h; x++) {
+                    src[x] = (Uint8)SDL_rand(256);
+                }
+            }
+
+            source = SDL_CreateSurfaceFrom(w, h, formats[i], src, src_pitch);
+            SDLTest_AssertCheck(source != NULL, "SDL_CreateSurfaceFrom(%s), expected: not NULL", SDL_GetPixelFormatName(formats[i]));
+            if (!source) {
+                SDL_free(src);
+                SDL_free(dst);
+                continue;
+            }
+            SDL_SetSurfaceColorspace(source, SDL_COLORSPACE_SRGB);
+
+            for (j = 0; j < SDL_arraysize(formats); j++) {
+                const int dst_bpp = SDL_BYTESPERPIXEL(formats[j]);
+                const int dst_pitch = (w * dst_bpp + padding + 3) & ~3;
+                SDL_Surface *reference;
+                int errors = 0;
+                bool result;
+
+                if (i == j) {
+                    continue;
+                }
+                reference = SDL_ConvertSurfaceAndColorspace(source, formats[j], NULL, SDL_COLORSPACE_SRGB, 0);
+                if (!reference) {
+                    SDLTest_AssertCheck(false, "SDL_ConvertSurface(%s to %s), got: %s", SDL_GetPixelFormatName(formats[i]),
+                                        SDL_GetPixelFormatName(formats[j]), SDL_GetError());
+                    continue;
+                }
+
+                /* Some blitters leave the padding byte alone, so start from the cleared pixels of a new surface */
+                SDL_memset(dst, 0x5A, (size_t)dst_pitch * h);
+                for (y = 0; y < h; y++) {
+                    SDL_memset(dst + y * dst_pitch, 0, (size_t)w * dst_bpp);
+                }
+                result = SDL_ConvertPixelsAndColorspace(w, h, formats[i], SDL_COLORSPACE_SRGB, 0, src, src_pitch,
+                                                        formats[j], SDL_COLORSPACE_SRGB, 0, dst, dst_pitch);
+                if (!result) {
+                    SDLTest_AssertCheck(false, "SDL_ConvertPixels(%s to %s), got: %s", SDL_GetPixelFormatName(formats[i]),
+                                        SDL_GetPixelFormatName(formats[j]), SDL_GetError());
+                    SDL_DestroySurface(reference);
+                    continue;
+                }
+                for (y = 0; y < h; y++) {
+                    for (x = 0; x < w; x++) {
+                        const Uint32 in = GetRawPixel(src + y * src_pitch + x * src_bpp, src_bpp);
+                        const Uint32 got = GetRawPixel(dst + y * dst_pitch + x * dst_bpp, dst_bpp);
+                        const Uint32 expected = GetRawPixel((const Uint8 *)reference->pixels + y * reference->pitch + x * dst_bpp, dst_bpp);
+
+                        if (got != expected) {
+                            if (errors++ == 0 && mismatched == 0) {
+                                first_format = formats[j];
+                                first_in = in;
+                                first_expected = expected;
+                                first_got = got;
+                            }
+                        }
+                    }
+                    /* The bytes past the end of each row are left alone */
+                    for (x = w * dst_bpp; x < dst_pitch; x++) {
+                        if (dst[y * dst_pitch + x] != 0x5A && errors++ == 0 && mismatched == 0) {
+                            first_format = formats[j];
+                            first_in = first_expected = 0x5A;
+                            first_got = dst[y * dst_pitch + x];
+                        }
+                    }
+                }
+                if (errors) {
+                    ++mismatched;
+                }
+                SDL_DestroySurface(reference);
+            }
+            SDL_DestroySurface(source);
+            SDLTest_AssertCheck(mismatched == 0,
+                                "Verify %s %dx%d converted to every other format, expected: 0 mismatched formats, got: %d (first %s, 0x%.8" SDL_PRIx32 " became 0x%.8" SDL_PRIx32 " instead of 0x%.8" SDL_PRIx32 ")",
+                                SDL_GetPixelFormatName(formats[i]), w, h, mismatched,
+                                SDL_GetPixelFormatName(first_format), first_in, first_got, first_expected);
+            SDL_free(src);
+            SDL_free(dst);
+        }
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_BLIT_THREADS);
+    return TEST_COMPLETED;
+}
 
 /* ================= Test References ================== */
 
@@ -1550,6 +3357,22 @@ static const SDLTest_TestCaseReference surfaceTestBlitBlendMul = {
     surface_testBlitBlendMul, "surface_testBlitBlendMul", "Tests blitting routines with mul blending mode.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestBlitModulatedRows = {
+    surface_testBlitModulatedRows, "surface_testBlitModulatedRows", "Tests modulated blits of whole rows in every blend mode.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitBatch = {
+    surface_testBlitBatch, "surface_testBlitBatch", "Tests blitting a batch of surfaces with a blit plan.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitScaledNearest = {
+    surface_testBlitScaledNearest, "surface_testBlitScaledNearest", "Tests nearest scaling of 1 to 4 byte pixels.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestScaleFiltered = {
+    surface_testScaleFiltered, "surface_testScaleFiltered", "Tests area averaging and Lanczos scaling.", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference surfaceTestOverflow = {
     surface_testOverflow, "surface_testOverflow", "Test overflow detection.", TEST_ENABLED
 };
@@ -1574,6 +3397,42 @@ static const SDLTest_TestCaseReference surfaceTestPremultiplyAlpha = {
     surface_testPremultiplyAlpha, "surface_testPremultiplyAlpha", "Test alpha premultiply operations.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestPremultiplyAlphaRows = {
+    surface_testPremultiplyAlphaRows, "surface_testPremultiplyAlphaRows", "Tests alpha premultiply and unpremultiply against their definitions.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestConvertColorspaceRows = {
+    surface_testConvertColorspaceRows, "surface_testConvertColorspaceRows", "Tests that colorspace conversions match the per-pixel conversion.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitRLE = {
+    surface_testBlitRLE, "surface_testBlitRLE", "Tests RLE accelerated blits, encoded on one or more threads or ahead of time.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestPaletteBlits = {
+    surface_testPaletteBlits, "surface_testPaletteBlits", "Tests blits that expand palette indices or map colors to a palette.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestFillRects = {
+    surface_testFillRects, "surface_testFillRects", "Tests filling rectangles of every pixel size, alignment and area.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestSurfacePool = {
+    surface_testSurfacePool, "surface_testSurfacePool", "Tests that pooled surfaces recycle their pixels.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestCopyOnWrite = {
+    surface_testCopyOnWrite, "surface_testCopyOnWrite", "Tests that duplicated surfaces share their pixels until they are changed.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestRotate90 = {
+    surface_testRotate90, "surface_testRotate90", "Tests horizontal flips and quarter turns of every pixel size.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestConvertPixelsDirect = {
+    surface_testConvertPixelsDirect, "surface_testConvertPixelsDirect", "Tests SDL_ConvertPixels() between every pair of packed RGB formats.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestSaveLoadBitmap,
@@ -1593,12 +3452,25 @@ static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestBlitBlendAddPremultiplied,
     &surfaceTestBlitBlendMod,
     &surfaceTestBlitBlendMul,
+    &surfaceTestBlitModulatedRows,
+    &surfaceTestBlitBatch,
+    &surfaceTestBlitScaledNearest,
+    &surfaceTestScaleFiltered,
     &surfaceTestOverflow,
     &surfaceTestFlip,
     &surfaceTestPalette,
     &surfaceTestPalettization,
     &surfaceTestClearSurface,
     &surfaceTestPremultiplyAlpha,
+    &surfaceTestPremultiplyAlphaRows,
+    &surfaceTestConvertColorspaceRows,
+    &surfaceTestBlitRLE,
+    &surfaceTestPaletteBlits,
+    &surfaceTestFillRects,
+    &surfaceTestSurfacePool,
+    &surfaceTestCopyOnWrite,
+    &surfaceTestRotate90,
+    &surfaceTestConvertPixelsDirect,
     NULL
 };
 
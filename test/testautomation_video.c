@@ -2404,6 +2404,176 @@ static int SDLCALL video_getWindowSurface(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Returns true if the rectangle is inside one of the damage rectangles */
+static bool isRectDamaged(const SDL_Rect *rect, const SDL_Rect *damage, int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        SDL_Rect u;
+        SDL_GetRectUnion(&damage[i], rect, &u);
+        if (SDL_RectsEqual(&u, &damage[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Tests that window surfaces track the areas that are changed
+ */
+/* Counts the frames the dummy driver saved for a window with SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES, and removes them if asked */
+static int countSavedFrames(SDL_Window *window, bool remove)
+{
+    char pattern[64];
+    char **files;
+    int count = 0, i;
+
+    (void)SDL_snprintf(pattern, sizeof(pattern), "SDL_window%" SDL_PRIu32 "-*.bmp", SDL_GetWindowID(window));
+    files = SDL_GlobDirectory(".", pattern, 0, &count);
+    if (files && remove) {
+        for (i = 0; i < count; i++) {
+            SDL_RemovePath(files[i]);
+        }
+    }
+    SDL_free(files);
+    return count;
+}
+
+static int SDLCALL video_getWindowSurfaceDamage(void *arg)
+{
+    const SDL_Rect full = { 0, 0, 320, 240 };
+    const SDL_Rect fill1 = { 10, 10, 20, 20 };
+    const SDL_Rect fill2 = { 30, 10, 20, 20 };
+    const SDL_Rect merged = { 10, 10, 40, 20 };
+    const SDL_Rect blit = { 200, 150, 16, 16 };
+    const SDL_Rect pixel = { 5, 200, 1, 1 };
+    const SDL_Rect outside = { 310, 230, 50, 50 };
+    const SDL_Rect clipped = { 310, 230, 10, 10 };
+    SDL_Window *window;
+    SDL_Surface *surface, *sprite;
+    SDL_Rect *damage;
+    SDL_Rect rect;
+    int count, i, x, y;
+    bool covered;
+
+    SDL_SetHint(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING, "1");
+
+    window = SDL_CreateWindow("video_getWindowSurfaceDamage Test Window", full.w, full.h, 0);
+    SDLTest_AssertCheck(window != NULL, "Validate that returned window is not NULL");
+    surface = SDL_GetWindowSurface(window);
+    SDLTest_AssertCheck(surface != NULL, "Validate that returned surface is not NULL");
+    sprite = SDL_CreateSurface(blit.w, blit.h, SDL_PIXELFORMAT_ARGB8888);
+    if (!window || !surface || !sprite) {
+        SDL_DestroySurface(sprite);
+        SDL_DestroyWindow(window);
+        SDL_ResetHint(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING);
+        return TEST_ABORTED;
+    }
+
+    /* A new surface hasn't been shown yet */
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertPass("Call to SDL_GetWindowSurfaceDamage(window)");
+    SDLTest_AssertCheck(damage && count == 1 && SDL_RectsEqual(&damage[0], &full), "Verify the whole surface is damaged, got %d rectangles", count);
+    SDL_free(damage);
+
+    SDL_UpdateWindowSurface(window);
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertCheck(damage != NULL && count == 0, "Verify there is no damage after an update, got %d rectangles", count);
+    SDL_free(damage);
+
+    /* An update without damage doesn't reach the framebuffer */
+    if (SDL_strcmp(SDL_GetCurrentVideoDriver(), "dummy") == 0) {
+        bool result;
+
+        countSavedFrames(window, true);
+        SDL_SetHint(SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES, "1");
+        result = SDL_UpdateWindowSurface(window);
+        SDLTest_AssertCheck(result, "Verify SDL_UpdateWindowSurface() without damage succeeds, got: %i", result);
+        count = countSavedFrames(window, false);
+        SDLTest_AssertCheck(count == 0, "Verify an update without damage isn't presented, got %d frames", count);
+        SDL_FillSurfaceRect(surface, &fill1, 0);
+        SDL_UpdateWindowSurface(window);
+        count = countSavedFrames(window, true);
+        SDLTest_AssertCheck(count == 1, "Verify an update with damage is presented, got %d frames", count);
+        SDL_ResetHint(SDL_HINT_VIDEO_DUMMY_SAVE_FRAMES);
+    }
+
+    /* Neighboring fills are merged, blits and pixel writes are tracked, and damage is clipped */
+    SDL_FillSurfaceRect(surface, &fill1, 0);
+    SDL_FillSurfaceRect(surface, &fill2, 0);
+    rect = blit;
+    SDL_BlitSurface(sprite, NULL, surface, &rect);
+    SDL_WriteSurfacePixel(surface, pixel.x, pixel.y, 255, 255, 255, 255);
+    SDL_FillSurfaceRect(surface, &outside, 0);
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertCheck(damage != NULL && count == 4, "Verify the damage has 4 rectangles, got %d", count);
+    if (damage) {
+        SDLTest_AssertCheck(isRectDamaged(&merged, damage, count), "Verify the fills are damaged");
+        SDLTest_AssertCheck(isRectDamaged(&blit, damage, count), "Verify the blit is damaged");
+        SDLTest_AssertCheck(isRectDamaged(&pixel, damage, count), "Verify the pixel is damaged");
+        SDLTest_AssertCheck(isRectDamaged(&clipped, damage, count), "Verify the clipped fill is damaged");
+        for (i = 0; i < count; i++) {
+            SDLTest_AssertCheck(SDL_RectsEqual(&damage[i], &merged) || SDL_RectsEqual(&damage[i], &blit) ||
+                                SDL_RectsEqual(&damage[i], &pixel) || SDL_RectsEqual(&damage[i], &clipped),
+                                "Verify rectangle %d is no larger than needed", i);
+        }
+        SDL_free(damage);
+    }
+    SDL_UpdateWindowSurface(window);
+
+    /* Scattered changes are limited to a few rectangles that still cover them all */
+    for (y = 0; y < 10; y++) {
+        for (x = 0; x < 10; x++) {
+            rect.x = 7 + x * 31;
+            rect.y = 5 + y * 23;
+            rect.w = 4;
+            rect.h = 4;
+            SDL_FillSurfaceRect(surface, &rect, 0);
+        }
+    }
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertCheck(damage != NULL && count > 0 && count <= 16, "Verify the damage is limited to 16 rectangles, got %d", count);
+    covered = true;
+    for (y = 0; y < 10 && damage; y++) {
+        for (x = 0; x < 10; x++) {
+            rect.x = 7 + x * 31;
+            rect.y = 5 + y * 23;
+            rect.w = 4;
+            rect.h = 4;
+            covered = covered && isRectDamaged(&rect, damage, count);
+        }
+    }
+    SDLTest_AssertCheck(covered, "Verify every fill is damaged");
+    SDL_free(damage);
+    SDL_UpdateWindowSurface(window);
+
+    /* Locking the surface could change anything */
+    SDL_LockSurface(surface);
+    SDL_UnlockSurface(surface);
+    damage = SDL_GetWindowSurfaceDamage(window, &count);
+    SDLTest_AssertCheck(damage && count == 1 && SDL_RectsEqual(&damage[0], &full), "Verify locking damages the whole surface, got %d rectangles", count);
+    SDL_free(damage);
+
+    SDL_DestroySurface(sprite);
+    SDL_DestroyWindow(window);
+
+    /* Without tracking the whole surface is always updated */
+    SDL_SetHint(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING, "0");
+    window = SDL_CreateWindow("video_getWindowSurfaceDamage Test Window", full.w, full.h, 0);
+    SDLTest_AssertCheck(window != NULL, "Validate that returned window is not NULL");
+    if (window && SDL_GetWindowSurface(window)) {
+        SDL_UpdateWindowSurface(window);
+        damage = SDL_GetWindowSurfaceDamage(window, &count);
+        SDLTest_AssertCheck(damage && count == 1 && SDL_RectsEqual(&damage[0], &full), "Verify the whole surface is updated without tracking, got %d rectangles", count);
+        SDL_free(damage);
+    }
+    SDL_DestroyWindow(window);
+    SDL_ResetHint(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Video test cases */
@@ -2495,6 +2665,10 @@ static const SDLTest_TestCaseReference videoTestGetWindowSurface = {
     video_getWindowSurface, "video_getWindowSurface", "Checks window surface functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference videoTestGetWindowSurfaceDamage = {
+    video_getWindowSurfaceDamage, "video_getWindowSurfaceDamage", "Checks that window surfaces track the areas that are changed", TEST_ENABLED
+};
+
 /* Sequence of Video test cases */
 static const SDLTest_TestCaseReference *videoTests[] = {
     &videoTestEnableDisableScreensaver,
@@ -2519,6 +2693,7 @@ static const SDLTest_TestCaseReference *videoTests[] = {
     &videoTestCreateMinimized,
     &videoTestCreateMaximized,
     &videoTestGetWindowSurface,
+    &videoTestGetWindowSurfaceDamage,
     NULL
 };
 
@@ -0,0 +1,240 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure drawing sprites from one atlas that alternate between a few
+   blend modes and modulations: setting the state on the atlas before each
+   SDL_BlitSurface(), compared to blitting with one SDL_BlitPlan per state, one
+   sprite at a time or in a batch per state. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define NUM_SPRITES 2000
+#define NUM_STATES  4
+
+typedef struct
+{
+    SDL_BlendMode blend;
+    Uint8 r, g, b, a;
+} BlitState;
+
+static const BlitState states[NUM_STATES] = {
+    { SDL_BLENDMODE_BLEND, 255, 255, 255, 255 },
+    { SDL_BLENDMODE_BLEND, 255, 128, 128, 255 },
+    { SDL_BLENDMODE_ADD, 255, 255, 255, 128 },
+    { SDL_BLENDMODE_BLEND, 255, 255, 255, 96 },
+};
+
+typedef struct
+{
+    int state;
+    SDL_BlitBatchItem item;
+} Sprite;
+
+static Sprite sprites[NUM_SPRITES];
+static SDL_BlitBatchItem grouped[NUM_SPRITES];
+static int group_start[NUM_STATES + 1];
+
+static void apply_state(SDL_Surface *surface, const BlitState *state)
+{
+    SDL_SetSurfaceBlendMode(surface, state->blend);
+    SDL_SetSurfaceColorMod(surface, state->r, state->g, state->b);
+    SDL_SetSurfaceAlphaMod(surface, state->a);
+}
+
+static SDL_Surface *create_atlas(SDL_PixelFormat format)
+{
+    SDL_Surface *atlas = SDL_CreateSurface(256, 256, format);
+    int x, y;
+
+    if (!atlas) {
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_Palette *palette = SDL_CreateSurfacePalette(atlas);
+        for (x = 0; palette && x < palette->ncolors; x++) {
+            palette->colors[x].r = (Uint8)SDL_rand(256);
+            palette->colors[x].g = (Uint8)SDL_rand(256);
+            palette->colors[x].b = (Uint8)SDL_rand(256);
+            palette->colors[x].a = (Uint8)SDL_rand(256);
+        }
+        SDL_SetSurfaceColorKey(atlas, true, 0);
+    }
+    for (y = 0; y < atlas->h; y++) {
+        Uint8 *row = (Uint8 *)atlas->pixels + y * atlas->pitch;
+        for (x = 0; x < atlas->w * SDL_BYTESPERPIXEL(format); x++) {
+            row[x] = (Uint8)SDL_rand(256);
+        }
+    }
+    return atlas;
+}
+
+static void setup_sprites(SDL_Surface *atlas, SDL_Surface *dst, int size)
+{
+    int i, state, n = 0;
+
+    for (i = 0; i < NUM_SPRITES; i++) {
+        Sprite *sprite = &sprites[i];
+        sprite->state = i % NUM_STATES;
+        sprite->item.src = atlas;
+        sprite->item.srcrect.x = SDL_rand(atlas->w - size);
+        sprite->item.srcrect.y = SDL_rand(atlas->h - size);
+        sprite->item.srcrect.w = size;
+        sprite->item.srcrect.h = size;
+        sprite->item.dstrect.x = SDL_rand(dst->w - size);
+        sprite->item.dstrect.y = SDL_rand(dst->h - size);
+        sprite->item.dstrect.w = size;
+        sprite->item.dstrect.h = size;
+    }
+
+    for (state = 0; state < NUM_STATES; state++) {
+        group_start[state] = n;
+        for (i = 0; i < NUM_SPRITES; i++) {
+            if (sprites[i].state == state) {
+                grouped[n++] = sprites[i].item;
+            }
+        }
+    }
+    group_start[NUM_STATES] = n;
+}
+
+static void draw_with_state_changes(SDL_Surface *atlas, SDL_Surface *dst)
+{
+    int i;
+    for (i = 0; i < NUM_SPRITES; i++) {
+        apply_state(atlas, &states[sprites[i].state]);
+        SDL_BlitSurface(atlas, &sprites[i].item.srcrect, dst, &sprites[i].item.dstrect);
+    }
+}
+
+static void draw_with_plans(SDL_BlitPlan **plans, SDL_Surface *dst)
+{
+    int i;
+    for (i = 0; i < NUM_SPRITES; i++) {
+        SDL_BlitSurfaceBatch(plans[sprites[i].state], &sprites[i].item, 1, dst);
+    }
+}
+
+static void draw_grouped(SDL_BlitPlan **plans, SDL_Surface *dst)
+{
+    int state;
+    for (state = 0; state < NUM_STATES; state++) {
+        SDL_BlitSurfaceBatch(plans[state], &grouped[group_start[state]], group_start[state + 1] - group_start[state], dst);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const SDL_PixelFormat formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_INDEX8 };
+    static const int sizes[] = { 8, 32 };
+    SDLTest_CommonState *state;
+    int iterations = 50;
+    int ret = 0;
+    int i, f, s, k;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+            iterations = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-24s %6s %16s %16s %16s", "atlas", "size", "state ns/sprite", "plan ns/sprite", "batch ns/sprite");
+    for (f = 0; f < SDL_arraysize(formats) && ret == 0; f++) {
+        for (s = 0; s < SDL_arraysize(sizes) && ret == 0; s++) {
+            SDL_Surface *atlas = create_atlas(formats[f]);
+            SDL_Surface *dst = SDL_CreateSurface(1280, 720, SDL_PIXELFORMAT_XRGB8888);
+            SDL_Surface *reference = SDL_CreateSurface(1280, 720, SDL_PIXELFORMAT_XRGB8888);
+            SDL_BlitPlan *plans[NUM_STATES] = { NULL };
+            double ns[3];
+            Uint64 start;
+
+            if (!atlas || !dst || !reference) {
+                SDL_Log("Couldn't create surfaces: %s", SDL_GetError());
+                ret = 2;
+            } else {
+                setup_sprites(atlas, dst, sizes[s]);
+                for (k = 0; k < NUM_STATES; k++) {
+                    apply_state(atlas, &states[k]);
+                    plans[k] = SDL_CreateBlitPlan(atlas, dst);
+                    if (!plans[k]) {
+                        SDL_Log("Couldn't create a blit plan: %s", SDL_GetError());
+                        ret = 3;
+                    }
+                }
+            }
+
+            if (ret == 0) {
+                /* the plans have to draw exactly what setting the state on the atlas does */
+                draw_with_state_changes(atlas, reference);
+                draw_with_plans(plans, dst);
+                if (SDLTest_CompareSurfaces(dst, reference, 0) != 0) {
+                    SDL_Log("%s: blit plans don't match SDL_BlitSurface()", SDL_GetPixelFormatName(formats[f]));
+                    ret = 4;
+                }
+            }
+
+            if (ret == 0) {
+                start = SDL_GetTicksNS();
+                for (i = 0; i < iterations; i++) {
+                    draw_with_state_changes(atlas, dst);
+                }
+                ns[0] = (double)(SDL_GetTicksNS() - start) / iterations / NUM_SPRITES;
+
+                start = SDL_GetTicksNS();
+                for (i = 0; i < iterations; i++) {
+                    draw_with_plans(plans, dst);
+                }
+                ns[1] = (double)(SDL_GetTicksNS() - start) / iterations / NUM_SPRITES;
+
+                start = SDL_GetTicksNS();
+                for (i = 0; i < iterations; i++) {
+                    draw_grouped(plans, dst);
+                }
+                ns[2] = (double)(SDL_GetTicksNS() - start) / iterations / NUM_SPRITES;
+
+                SDL_Log("%-24s %6d %16.1f %16.1f %16.1f", SDL_GetPixelFormatName(formats[f]), sizes[s], ns[0], ns[1], ns[2]);
+            }
+
+            for (k = 0; k < NUM_STATES; k++) {
+                SDL_DestroyBlitPlan(plans[k]);
+            }
+            SDL_DestroySurface(atlas);
+            SDL_DestroySurface(dst);
+            SDL_DestroySurface(reference);
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
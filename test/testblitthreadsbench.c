@@ -0,0 +1,186 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how large surface blits scale with SDL_HINT_SURFACE_BLIT_THREADS.
+   Every blit is also checked against the single threaded result, which has to match exactly. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct
+{
+    const char *name;
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    SDL_BlendMode blend;
+    int src_w, src_h;
+    int dst_w, dst_h;
+    SDL_ScaleMode scale;
+} BenchCase;
+
+static const BenchCase cases[] = {
+    { "copy ARGB8888 -> XRGB8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_NONE, 3840, 2160, 3840, 2160, SDL_SCALEMODE_NEAREST },
+    { "blend ARGB8888 -> XRGB8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_BLEND, 3840, 2160, 3840, 2160, SDL_SCALEMODE_NEAREST },
+    { "blend ABGR8888 -> RGB565", SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565, SDL_BLENDMODE_BLEND, 3840, 2160, 3840, 2160, SDL_SCALEMODE_NEAREST },
+    { "convert RGB24 -> ARGB8888", SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, 3840, 2160, 3840, 2160, SDL_SCALEMODE_NEAREST },
+    { "stretch nearest 1080p -> 4K", SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_NONE, 1920, 1080, 3840, 2160, SDL_SCALEMODE_NEAREST },
+    { "stretch linear 1080p -> 4K", SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_NONE, 1920, 1080, 3840, 2160, SDL_SCALEMODE_LINEAR },
+    { "stretch linear 4K -> 1080p", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, 3840, 2160, 1920, 1080, SDL_SCALEMODE_LINEAR },
+};
+
+static void fill_random(SDL_Surface *surface)
+{
+    int y, x;
+    for (y = 0; y < surface->h; y++) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->w * SDL_BYTESPERPIXEL(surface->format); x++) {
+            row[x] = (Uint8)SDL_rand(256);
+        }
+    }
+}
+
+static void set_threads(int threads)
+{
+    char value[16];
+    (void)SDL_snprintf(value, sizeof(value), "%d", threads);
+    SDL_SetHint(SDL_HINT_SURFACE_BLIT_THREADS, value);
+}
+
+static bool do_blit(const BenchCase *c, SDL_Surface *src, SDL_Surface *dst)
+{
+    if (c->src_w == c->dst_w && c->src_h == c->dst_h) {
+        return SDL_BlitSurface(src, NULL, dst, NULL);
+    }
+    return SDL_BlitSurfaceScaled(src, NULL, dst, NULL, c->scale);
+}
+
+static void copy_surface(SDL_Surface *src, SDL_Surface *dst)
+{
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(src, NULL, dst, NULL);
+}
+
+/* Returns the average time per blit in milliseconds, or a negative value if it failed or
+   didn't come out the same as `reference`. */
+static double bench(const BenchCase *c, SDL_Surface *src, SDL_Surface *dst, SDL_Surface *background, SDL_Surface *reference, int threads, int iterations)
+{
+    const size_t row_len = (size_t)dst->w * SDL_BYTESPERPIXEL(dst->format);
+    Uint64 start, elapsed;
+    int i, y;
+
+    set_threads(threads);
+
+    copy_surface(background, dst);
+    if (!do_blit(c, src, dst)) {
+        SDL_Log("%s: blit failed: %s", c->name, SDL_GetError());
+        return -1.0;
+    }
+    for (y = 0; y < dst->h; y++) {
+        if (SDL_memcmp((Uint8 *)dst->pixels + y * dst->pitch, (Uint8 *)reference->pixels + y * reference->pitch, row_len) != 0) {
+            SDL_Log("%s: %d threads doesn't match the single threaded result at row %d", c->name, threads, y);
+            return -1.0;
+        }
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; i++) {
+        do_blit(c, src, dst);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    return (double)elapsed / iterations / SDL_NS_PER_MS;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int max_threads = SDL_GetNumLogicalCPUCores();
+    int iterations = 20;
+    int ret = 0;
+    int i, threads;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc) {
+            if (SDL_strcmp(argv[i], "--iterations") == 0) {
+                iterations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--max-threads") == 0) {
+                max_threads = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0 || iterations <= 0 || max_threads < 0) {
+            static const char *options[] = { "[--iterations N]", "[--max-threads N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-32s %8s %10s %8s", "blit", "threads", "ms/blit", "speedup");
+    for (i = 0; i < SDL_arraysize(cases) && ret == 0; i++) {
+        const BenchCase *c = &cases[i];
+        SDL_Surface *src = SDL_CreateSurface(c->src_w, c->src_h, c->src_format);
+        SDL_Surface *dst = SDL_CreateSurface(c->dst_w, c->dst_h, c->dst_format);
+        SDL_Surface *background = SDL_CreateSurface(c->dst_w, c->dst_h, c->dst_format);
+        SDL_Surface *reference = SDL_CreateSurface(c->dst_w, c->dst_h, c->dst_format);
+        double serial_ms = 0.0;
+
+        if (!src || !dst || !background || !reference) {
+            SDL_Log("%s: couldn't create surfaces: %s", c->name, SDL_GetError());
+            ret = 2;
+        } else {
+            fill_random(src);
+            fill_random(background);
+
+            set_threads(0);
+            copy_surface(background, reference);
+            SDL_SetSurfaceBlendMode(src, c->blend);
+            do_blit(c, src, reference);
+
+            for (threads = 0; threads <= max_threads; threads = threads ? threads * 2 : 1) {
+                const double ms = bench(c, src, dst, background, reference, threads, iterations);
+                if (ms < 0.0) {
+                    ret = 3;
+                    break;
+                }
+                if (threads == 0) {
+                    serial_ms = ms;
+                }
+                SDL_Log("%-32s %8d %10.2f %7.2fx", c->name, threads, ms, serial_ms / ms);
+            }
+        }
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+        SDL_DestroySurface(background);
+        SDL_DestroySurface(reference);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,228 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure SDL_ConvertPixels() between the packed RGB formats on
+   camera sized frames, printed as a matrix of MPix/s with a row per source
+   format and a column per destination format. Pass --blit to time
+   SDL_BlitSurface() with SDL_BLENDMODE_NONE for the same pairs, and set
+   SDL_CPU_FEATURE_MASK (for example to "-sse4.1,-avx2") to compare against the
+   other kernels. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define FRAME_WIDTH 1920
+#define FRAME_HEIGHT 1080
+
+static const SDL_PixelFormat common_formats[] = {
+    SDL_PIXELFORMAT_XRGB8888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_XRGB1555,
+    SDL_PIXELFORMAT_ARGB4444,
+    SDL_PIXELFORMAT_ARGB2101010,
+};
+
+static const SDL_PixelFormat all_formats[] = {
+    SDL_PIXELFORMAT_XRGB4444,
+    SDL_PIXELFORMAT_XBGR4444,
+    SDL_PIXELFORMAT_ARGB4444,
+    SDL_PIXELFORMAT_RGBA4444,
+    SDL_PIXELFORMAT_ABGR4444,
+    SDL_PIXELFORMAT_BGRA4444,
+    SDL_PIXELFORMAT_XRGB1555,
+    SDL_PIXELFORMAT_XBGR1555,
+    SDL_PIXELFORMAT_ARGB1555,
+    SDL_PIXELFORMAT_RGBA5551,
+    SDL_PIXELFORMAT_ABGR1555,
+    SDL_PIXELFORMAT_BGRA5551,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_BGR565,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_BGR24,
+    SDL_PIXELFORMAT_XRGB8888,
+    SDL_PIXELFORMAT_RGBX8888,
+    SDL_PIXELFORMAT_XBGR8888,
+    SDL_PIXELFORMAT_BGRX8888,
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_BGRA8888,
+    SDL_PIXELFORMAT_XRGB2101010,
+    SDL_PIXELFORMAT_XBGR2101010,
+    SDL_PIXELFORMAT_ARGB2101010,
+    SDL_PIXELFORMAT_ABGR2101010,
+};
+
+static const char *ShortFormatName(SDL_PixelFormat format)
+{
+    const char *name = SDL_GetPixelFormatName(format);
+    const char *prefix = "SDL_PIXELFORMAT_";
+
+    if (SDL_strncmp(name, prefix, SDL_strlen(prefix)) == 0) {
+        name += SDL_strlen(prefix);
+    }
+    return name;
+}
+
+/* Returns false if it failed */
+static bool bench(SDL_Surface *src, SDL_Surface *dst, bool blit, int iterations, double *mpix)
+{
+    Uint64 start, elapsed;
+    int i;
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; i++) {
+        if (blit) {
+            if (!SDL_BlitSurface(src, NULL, dst, NULL)) {
+                SDL_Log("Couldn't blit surface: %s", SDL_GetError());
+                return false;
+            }
+        } else if (!SDL_ConvertPixelsAndColorspace(src->w, src->h,
+                                                   src->format, SDL_COLORSPACE_SRGB, 0, src->pixels, src->pitch,
+                                                   dst->format, SDL_COLORSPACE_SRGB, 0, dst->pixels, dst->pitch)) {
+            SDL_Log("Couldn't convert pixels: %s", SDL_GetError());
+            return false;
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    *mpix = (double)FRAME_WIDTH * FRAME_HEIGHT * iterations / ((double)elapsed / 1000.0);
+    return true;
+}
+
+static SDL_Surface *CreateFrame(SDL_PixelFormat format)
+{
+    SDL_Surface *frame = SDL_CreateSurface(FRAME_WIDTH, FRAME_HEIGHT, format);
+    Uint32 seed = 0x12345678;
+    int x, y;
+
+    if (!frame) {
+        SDL_Log("Couldn't create surface: %s", SDL_GetError());
+        return NULL;
+    }
+    /* Compare like with like, the blitter would convert between colorspaces otherwise */
+    SDL_SetSurfaceColorspace(frame, SDL_COLORSPACE_SRGB);
+    SDL_SetSurfaceBlendMode(frame, SDL_BLENDMODE_NONE);
+
+    for (y = 0; y < frame->h; y++) {
+        Uint8 *row = (Uint8 *)frame->pixels + y * frame->pitch;
+        for (x = 0; x < frame->pitch; x++) {
+            seed = seed * 1103515245 + 12345;
+            row[x] = (Uint8)(seed >> 16);
+        }
+    }
+    return frame;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    const SDL_PixelFormat *formats = common_formats;
+    int num_formats = SDL_arraysize(common_formats);
+    SDL_Surface **frames;
+    bool blit = false;
+    int iterations = 20;
+    int ret = 0;
+    int i, j;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--all") == 0) {
+                formats = all_formats;
+                num_formats = SDL_arraysize(all_formats);
+                consumed = 1;
+            } else if (SDL_strcmp(argv[i], "--blit") == 0) {
+                blit = true;
+                consumed = 1;
+            } else if ((i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+                iterations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--all]", "[--blit]", "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    frames = (SDL_Surface **)SDL_calloc(num_formats, sizeof(*frames));
+    if (!frames) {
+        ret = 2;
+        goto done;
+    }
+    for (i = 0; i < num_formats; i++) {
+        frames[i] = CreateFrame(formats[i]);
+        if (!frames[i]) {
+            ret = 2;
+            goto done;
+        }
+    }
+
+    SDL_Log("%s MPix/s, source formats down, destination formats across", blit ? "SDL_BlitSurface()" : "SDL_ConvertPixels()");
+    {
+        char line[1024];
+
+        SDL_snprintf(line, sizeof(line), "%-12s", "");
+        for (j = 0; j < num_formats; j++) {
+            SDL_snprintf(line + SDL_strlen(line), sizeof(line) - SDL_strlen(line), " %11.11s", ShortFormatName(formats[j]));
+        }
+        SDL_Log("%s", line);
+
+        for (i = 0; i < num_formats && ret == 0; i++) {
+            SDL_snprintf(line, sizeof(line), "%-12.12s", ShortFormatName(formats[i]));
+            for (j = 0; j < num_formats; j++) {
+                double mpix;
+
+                if (i == j) {
+                    SDL_strlcat(line, "           -", sizeof(line));
+                    continue;
+                }
+                if (!bench(frames[i], frames[j], blit, iterations, &mpix)) {
+                    ret = 2;
+                    break;
+                }
+                SDL_snprintf(line + SDL_strlen(line), sizeof(line) - SDL_strlen(line), " %11.1f", mpix);
+            }
+            SDL_Log("%s", line);
+        }
+    }
+
+done:
+    if (frames) {
+        for (i = 0; i < num_formats; i++) {
+            SDL_DestroySurface(frames[i]);
+        }
+        SDL_free(frames);
+    }
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,191 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how much of a window surface is copied to the screen
+   each frame for workloads that only change part of it, with and without
+   SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING. Run it with the dummy or the
+   offscreen video driver to leave out the cost of the window system. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define WINDOW_W 1280
+#define WINDOW_H 720
+#define NUM_SPRITES 8
+#define SPRITE_SIZE 32
+
+typedef enum
+{
+    WORKLOAD_SPRITES,
+    WORKLOAD_CURSOR,
+    WORKLOAD_PROGRESS,
+    WORKLOAD_COUNT
+} Workload;
+
+static const char *workload_names[] = {
+    "moving sprites",
+    "blinking cursor",
+    "progress bar"
+};
+
+static void draw_frame(SDL_Surface *surface, SDL_Surface *sprite, Workload workload, int frame)
+{
+    const Uint32 background = SDL_MapSurfaceRGB(surface, 32, 32, 64);
+    const Uint32 foreground = SDL_MapSurfaceRGB(surface, 224, 224, 224);
+    SDL_Rect rect;
+    int i;
+
+    switch (workload) {
+    case WORKLOAD_SPRITES:
+        for (i = 0; i < NUM_SPRITES; i++) {
+            /* Erase the sprite where it was and draw it one step further */
+            rect.x = (i * 151 + (frame - 1) * 3) % (WINDOW_W - SPRITE_SIZE);
+            rect.y = (i * 83 + (frame - 1) * 2) % (WINDOW_H - SPRITE_SIZE);
+            rect.w = SPRITE_SIZE;
+            rect.h = SPRITE_SIZE;
+            SDL_FillSurfaceRect(surface, &rect, background);
+            rect.x = (i * 151 + frame * 3) % (WINDOW_W - SPRITE_SIZE);
+            rect.y = (i * 83 + frame * 2) % (WINDOW_H - SPRITE_SIZE);
+            SDL_BlitSurface(sprite, NULL, surface, &rect);
+        }
+        break;
+    case WORKLOAD_CURSOR:
+        rect.x = 100;
+        rect.y = 100;
+        rect.w = 2;
+        rect.h = 16;
+        SDL_FillSurfaceRect(surface, &rect, (frame / 8) % 2 ? foreground : background);
+        break;
+    case WORKLOAD_PROGRESS:
+        rect.x = 40 + (frame % (WINDOW_W - 80));
+        rect.y = WINDOW_H - 40;
+        rect.w = 1;
+        rect.h = 12;
+        SDL_FillSurfaceRect(surface, &rect, foreground);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Returns false if it failed */
+static bool bench(Workload workload, bool tracking, int frames, double *bytes_per_frame, double *rects_per_frame, double *us_per_frame)
+{
+    SDL_Window *window;
+    SDL_Surface *surface, *sprite = NULL;
+    Uint64 bytes = 0, rects = 0, start;
+    bool result = false;
+    int frame;
+
+    SDL_SetHint(SDL_HINT_WINDOW_SURFACE_DAMAGE_TRACKING, tracking ? "1" : "0");
+    window = SDL_CreateWindow("testdamagebench", WINDOW_W, WINDOW_H, 0);
+    if (!window) {
+        SDL_Log("Couldn't create window: %s", SDL_GetError());
+        return false;
+    }
+    surface = SDL_GetWindowSurface(window);
+    if (!surface) {
+        SDL_Log("Couldn't get window surface: %s", SDL_GetError());
+        goto done;
+    }
+    sprite = SDL_CreateSurface(SPRITE_SIZE, SPRITE_SIZE, surface->format);
+    if (!sprite) {
+        SDL_Log("Couldn't create sprite: %s", SDL_GetError());
+        goto done;
+    }
+    SDL_FillSurfaceRect(sprite, NULL, SDL_MapSurfaceRGB(sprite, 255, 128, 0));
+    SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGB(surface, 32, 32, 64));
+    SDL_UpdateWindowSurface(window);
+
+    start = SDL_GetTicksNS();
+    for (frame = 1; frame <= frames; frame++) {
+        int i, count = 0;
+        SDL_Rect *damage;
+
+        draw_frame(surface, sprite, workload, frame);
+
+        damage = SDL_GetWindowSurfaceDamage(window, &count);
+        if (!damage) {
+            SDL_Log("Couldn't get damage: %s", SDL_GetError());
+            goto done;
+        }
+        for (i = 0; i < count; i++) {
+            bytes += (Uint64)damage[i].w * damage[i].h * SDL_BYTESPERPIXEL(surface->format);
+        }
+        rects += count;
+        SDL_free(damage);
+
+        SDL_UpdateWindowSurface(window);
+    }
+    *us_per_frame = (double)(SDL_GetTicksNS() - start) / frames / 1000.0;
+    *bytes_per_frame = (double)bytes / frames;
+    *rects_per_frame = (double)rects / frames;
+    result = true;
+
+done:
+    SDL_DestroySurface(sprite);
+    SDL_DestroyWindow(window);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int frames = 500;
+    int ret = 0;
+    int i, j;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--frames") == 0) {
+            frames = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || frames <= 0) {
+            static const char *options[] = { "[--frames N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("Video driver: %s, %dx%d window", SDL_GetCurrentVideoDriver(), WINDOW_W, WINDOW_H);
+    SDL_Log("%-16s %-8s %14s %12s %12s", "workload", "damage", "bytes/frame", "rects/frame", "us/frame");
+    for (i = 0; i < WORKLOAD_COUNT && !ret; i++) {
+        for (j = 0; j < 2; j++) {
+            double bytes_per_frame, rects_per_frame, us_per_frame;
+            if (!bench((Workload)i, j == 1, frames, &bytes_per_frame, &rects_per_frame, &us_per_frame)) {
+                ret = 2;
+                break;
+            }
+            SDL_Log("%-16s %-8s %14.0f %12.1f %12.1f", workload_names[i], j ? "tracked" : "full",
+                    bytes_per_frame, rects_per_frame, us_per_frame);
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,140 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure SDL_FillSurfaceRects() on a 1920x1080 surface, from
+   clearing the whole surface down to lots of small rectangles. Set
+   SDL_SURFACE_BLIT_THREADS to fill on several threads, and
+   SDL_CPU_FEATURE_MASK (for example to "-sse2,-avx2") to compare against the
+   scalar paths. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define SURFACE_W 1920
+#define SURFACE_H 1080
+
+static const SDL_PixelFormat formats[] = {
+    SDL_PIXELFORMAT_INDEX8,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_XRGB8888,
+};
+
+typedef struct
+{
+    const char *name;
+    int size; /* 0 for the whole surface */
+    int count;
+} Scene;
+
+static const Scene scenes[] = {
+    { "clear", 0, 1 },
+    { "256x256", 256, 16 },
+    { "32x32", 32, 256 },
+    { "8x8", 8, 1024 },
+};
+
+/* Returns false if it failed */
+static bool bench(SDL_PixelFormat format, const Scene *scene, int iterations, double *mpps)
+{
+    SDL_Surface *dst = SDL_CreateSurface(SURFACE_W, SURFACE_H, format);
+    SDL_Rect *rects = (SDL_Rect *)SDL_malloc(scene->count * sizeof(*rects));
+    Uint64 start, elapsed;
+    Sint64 area = 0;
+    bool result = false;
+    int i;
+
+    if (!dst || !rects) {
+        SDL_Log("Couldn't create surface: %s", SDL_GetError());
+        goto done;
+    }
+
+    for (i = 0; i < scene->count; i++) {
+        if (scene->size) {
+            rects[i].x = SDL_rand(SURFACE_W - scene->size);
+            rects[i].y = SDL_rand(SURFACE_H - scene->size);
+            rects[i].w = scene->size;
+            rects[i].h = scene->size;
+        } else {
+            rects[i].x = 0;
+            rects[i].y = 0;
+            rects[i].w = SURFACE_W;
+            rects[i].h = SURFACE_H;
+        }
+        area += (Sint64)rects[i].w * rects[i].h;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; i++) {
+        SDL_FillSurfaceRects(dst, rects, scene->count, (Uint32)i);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    *mpps = ((double)area * iterations) / ((double)elapsed / 1000.0);
+    result = true;
+
+done:
+    SDL_free(rects);
+    SDL_DestroySurface(dst);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int iterations = 200;
+    int ret = 0;
+    int i, j;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+            iterations = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-26s %-10s %10s", "format", "rects", "MPix/s");
+    for (i = 0; i < SDL_arraysize(formats); i++) {
+        for (j = 0; j < SDL_arraysize(scenes); j++) {
+            double mpps;
+            if (!bench(formats[i], &scenes[j], iterations, &mpps)) {
+                ret = 2;
+                break;
+            }
+            SDL_Log("%-26s %-10s %10.1f", SDL_GetPixelFormatName(formats[i]), scenes[j].name, mpps);
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
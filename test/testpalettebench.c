@@ -0,0 +1,161 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure blits from paletted surfaces to 16 and 32-bit surfaces,
+   and from 32-bit surfaces to paletted surfaces. Set SDL_CPU_FEATURE_MASK
+   (for example to "-sse2,-sse41,-avx2") to compare against the scalar paths. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define SURFACE_SIZE 1024
+
+typedef struct
+{
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    int ncolors;
+    bool colorkey;
+} Mode;
+
+static const Mode modes[] = {
+    { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_XRGB8888, 16, false },
+    { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_XRGB8888, 16, true },
+    { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_XRGB8888, 256, false },
+    { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_XRGB8888, 256, true },
+    { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_RGB565, 16, false },
+    { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_RGB565, 256, false },
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_INDEX8, 16, false },
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_INDEX8, 256, false },
+};
+
+static SDL_Palette *create_palette(int ncolors)
+{
+    SDL_Palette *palette = SDL_CreatePalette(ncolors);
+    int i;
+
+    if (palette) {
+        for (i = 0; i < ncolors; i++) {
+            palette->colors[i].r = (Uint8)SDL_rand(256);
+            palette->colors[i].g = (Uint8)SDL_rand(256);
+            palette->colors[i].b = (Uint8)SDL_rand(256);
+            palette->colors[i].a = SDL_ALPHA_OPAQUE;
+        }
+    }
+    return palette;
+}
+
+/* Returns false if it failed */
+static bool bench(const Mode *m, int iterations, double *mpps)
+{
+    SDL_Palette *palette = create_palette(m->ncolors);
+    SDL_Surface *src = SDL_CreateSurface(SURFACE_SIZE, SURFACE_SIZE, m->src_format);
+    SDL_Surface *dst = SDL_CreateSurface(SURFACE_SIZE, SURFACE_SIZE, m->dst_format);
+    Uint64 start, elapsed;
+    bool result = false;
+    int x, y, i;
+
+    if (!palette || !src || !dst) {
+        SDL_Log("Couldn't create surfaces: %s", SDL_GetError());
+        goto done;
+    }
+
+    if (SDL_ISPIXELFORMAT_INDEXED(m->src_format)) {
+        SDL_SetSurfacePalette(src, palette);
+        for (y = 0; y < SURFACE_SIZE; y++) {
+            Uint8 *row = (Uint8 *)src->pixels + y * src->pitch;
+            for (x = 0; x < SURFACE_SIZE; x++) {
+                row[x] = (Uint8)SDL_rand(m->ncolors);
+            }
+        }
+        if (m->colorkey) {
+            SDL_SetSurfaceColorKey(src, true, 0);
+        }
+    } else {
+        /* A photo-like gradient with some noise */
+        SDL_SetSurfacePalette(dst, palette);
+        for (y = 0; y < SURFACE_SIZE; y++) {
+            for (x = 0; x < SURFACE_SIZE; x++) {
+                SDL_WriteSurfacePixel(src, x, y, (Uint8)(x / 4 + SDL_rand(8)), (Uint8)(y / 4 + SDL_rand(8)), (Uint8)((x + y) / 8), 255);
+            }
+        }
+    }
+
+    /* Warm up, and build any lookup tables */
+    SDL_BlitSurface(src, NULL, dst, NULL);
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; i++) {
+        SDL_BlitSurface(src, NULL, dst, NULL);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    *mpps = ((double)SURFACE_SIZE * SURFACE_SIZE * iterations) / ((double)elapsed / 1000.0);
+    result = true;
+
+done:
+    SDL_DestroyPalette(palette);
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int iterations = 20;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+            iterations = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-26s %-26s %7s %-9s %10s", "source", "destination", "colors", "key", "MPix/s");
+    for (i = 0; i < SDL_arraysize(modes); i++) {
+        double mpps;
+        if (!bench(&modes[i], iterations, &mpps)) {
+            ret = 2;
+            break;
+        }
+        SDL_Log("%-26s %-26s %7d %-9s %10.1f", SDL_GetPixelFormatName(modes[i].src_format),
+                SDL_GetPixelFormatName(modes[i].dst_format), modes[i].ncolors,
+                modes[i].colorkey ? "colorkey" : "none", mpps);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
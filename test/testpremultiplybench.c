@@ -0,0 +1,154 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure the throughput of SDL_PremultiplyAlpha() and
+   SDL_UnpremultiplyAlpha() on 1920x1080 images. Set
+   SDL_CPU_FEATURE_MASK (for example to "-avx2" or "-sse2,-avx2") to compare
+   against the older paths. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define BENCH_WIDTH 1920
+#define BENCH_HEIGHT 1080
+
+typedef struct
+{
+    SDL_PixelFormat format;
+    bool linear;
+    bool unpremultiply;
+} Mode;
+
+static const Mode modes[] = {
+    { SDL_PIXELFORMAT_ARGB8888, false, false },
+    { SDL_PIXELFORMAT_ARGB8888, false, true },
+    { SDL_PIXELFORMAT_ARGB8888, true, false },
+    { SDL_PIXELFORMAT_ARGB8888, true, true },
+    { SDL_PIXELFORMAT_RGBA8888, false, false },
+    { SDL_PIXELFORMAT_RGBA8888, false, true },
+    { SDL_PIXELFORMAT_ARGB128_FLOAT, false, false },
+    { SDL_PIXELFORMAT_ARGB128_FLOAT, false, true },
+    { SDL_PIXELFORMAT_ARGB128_FLOAT, true, false },
+    { SDL_PIXELFORMAT_ARGB128_FLOAT, true, true },
+};
+
+static void fill_random(SDL_Surface *surface)
+{
+    int y, x;
+    for (y = 0; y < surface->h; y++) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        if (SDL_ISPIXELFORMAT_FLOAT(surface->format)) {
+            float *frow = (float *)row;
+            for (x = 0; x < surface->w * 4; x++) {
+                frow[x] = SDL_randf();
+            }
+        } else {
+            for (x = 0; x < surface->w * SDL_BYTESPERPIXEL(surface->format); x++) {
+                row[x] = (Uint8)SDL_rand(256);
+            }
+        }
+    }
+}
+
+/* Returns the throughput in megapixels per second, or a negative value if it failed. */
+static double bench(const Mode *m, int iterations)
+{
+    SDL_Surface *src = SDL_CreateSurface(BENCH_WIDTH, BENCH_HEIGHT, m->format);
+    SDL_Surface *dst = SDL_CreateSurface(BENCH_WIDTH, BENCH_HEIGHT, m->format);
+    Uint64 start, elapsed;
+    double mpps = -1.0;
+    bool result = true;
+    int i;
+
+    if (!src || !dst) {
+        SDL_Log("Couldn't create surfaces: %s", SDL_GetError());
+        goto done;
+    }
+    fill_random(src);
+
+    /* Unpremultiplying is only meaningful for colors that don't exceed alpha */
+    if (m->unpremultiply && !SDL_PremultiplySurfaceAlpha(src, m->linear)) {
+        SDL_Log("Premultiply failed: %s", SDL_GetError());
+        goto done;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations && result; i++) {
+        if (m->unpremultiply) {
+            result = SDL_UnpremultiplyAlpha(src->w, src->h, src->format, src->pixels, src->pitch, dst->format, dst->pixels, dst->pitch, m->linear);
+        } else {
+            result = SDL_PremultiplyAlpha(src->w, src->h, src->format, src->pixels, src->pitch, dst->format, dst->pixels, dst->pitch, m->linear);
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    if (!result) {
+        SDL_Log("Premultiply failed: %s", SDL_GetError());
+        goto done;
+    }
+    mpps = ((double)BENCH_WIDTH * BENCH_HEIGHT * iterations) / ((double)elapsed / 1000.0);
+
+done:
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+    return mpps;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int iterations = 20;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+            iterations = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-30s %-8s %-14s %10s", "format", "space", "operation", "MPix/s");
+    for (i = 0; i < SDL_arraysize(modes); i++) {
+        const double mpps = bench(&modes[i], iterations);
+        if (mpps < 0.0) {
+            ret = 2;
+            break;
+        }
+        SDL_Log("%-30s %-8s %-14s %10.1f", SDL_GetPixelFormatName(modes[i].format),
+                modes[i].linear ? "linear" : "sRGB",
+                modes[i].unpremultiply ? "unpremultiply" : "premultiply", mpps);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
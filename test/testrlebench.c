@@ -0,0 +1,183 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure RLE encoding and RLE accelerated blits of a 2048x2048
+   sprite sheet. The encoding time is that of the first blit, minus a normal
+   blit. Set SDL_SURFACE_BLIT_THREADS to encode on several threads, and
+   SDL_CPU_FEATURE_MASK (for example to "-sse2,-avx2") to compare against the
+   scalar paths. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define SHEET_SIZE 2048
+#define SPRITE_SIZE 64
+
+typedef struct
+{
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    bool colorkey;
+    Uint8 alpha;
+} Mode;
+
+static const Mode modes[] = {
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, false, 255 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, false, 255 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, false, 255 },
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, true, 255 },
+    { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, true, 100 },
+    { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565, true, 255 },
+    { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_RGB24, true, 255 },
+};
+
+/* Round sprites with a solid middle, a wide translucent edge and transparent corners */
+static SDL_Surface *create_sheet(const Mode *m)
+{
+    SDL_Surface *sheet = SDL_CreateSurface(SHEET_SIZE, SHEET_SIZE, m->src_format);
+    int x, y;
+
+    if (!sheet) {
+        return NULL;
+    }
+    for (y = 0; y < SHEET_SIZE; y++) {
+        for (x = 0; x < SHEET_SIZE; x++) {
+            const float dx = (float)(x % SPRITE_SIZE) - SPRITE_SIZE / 2 + 0.5f;
+            const float dy = (float)(y % SPRITE_SIZE) - SPRITE_SIZE / 2 + 0.5f;
+            const float r = SDL_sqrtf(dx * dx + dy * dy);
+            Uint8 alpha;
+
+            if (r < 16.0f) {
+                alpha = 255;
+            } else if (r < 28.0f) {
+                alpha = (Uint8)(255.0f * (28.0f - r) / 12.0f);
+            } else {
+                alpha = 0;
+            }
+            if (m->colorkey) {
+                if (alpha < 128) {
+                    SDL_WriteSurfacePixel(sheet, x, y, 255, 0, 255, 255);
+                } else {
+                    SDL_WriteSurfacePixel(sheet, x, y, (Uint8)SDL_rand(256), (Uint8)(8 + SDL_rand(248)), (Uint8)SDL_rand(256), 255);
+                }
+            } else {
+                SDL_WriteSurfacePixel(sheet, x, y, (Uint8)SDL_rand(256), (Uint8)SDL_rand(256), (Uint8)SDL_rand(256), alpha);
+            }
+        }
+    }
+    if (m->colorkey) {
+        SDL_SetSurfaceColorKey(sheet, true, SDL_MapSurfaceRGB(sheet, 255, 0, 255));
+    } else {
+        SDL_SetSurfaceBlendMode(sheet, SDL_BLENDMODE_BLEND);
+    }
+    SDL_SetSurfaceAlphaMod(sheet, m->alpha);
+    return sheet;
+}
+
+/* Returns false if it failed */
+static bool bench(const Mode *m, int iterations, double *encode_ms, double *mpps)
+{
+    SDL_Surface *sheet = create_sheet(m);
+    SDL_Surface *dst = SDL_CreateSurface(SHEET_SIZE, SHEET_SIZE, m->dst_format);
+    Uint64 encode_time = 0, blit_time = 0;
+    bool result = false;
+    int i, j;
+
+    if (!sheet || !dst) {
+        SDL_Log("Couldn't create surfaces: %s", SDL_GetError());
+        goto done;
+    }
+
+    for (i = 0; i < iterations; i++) {
+        SDL_Surface *rle = SDL_DuplicateSurface(sheet);
+        Uint64 start, first, blits;
+
+        if (!rle) {
+            SDL_Log("Couldn't duplicate surface: %s", SDL_GetError());
+            goto done;
+        }
+        SDL_SetSurfaceRLE(rle, true);
+
+        start = SDL_GetTicksNS();
+        SDL_BlitSurface(rle, NULL, dst, NULL);
+        first = SDL_GetTicksNS() - start;
+
+        start = SDL_GetTicksNS();
+        for (j = 0; j < 4; j++) {
+            SDL_BlitSurface(rle, NULL, dst, NULL);
+        }
+        blits = SDL_GetTicksNS() - start;
+
+        encode_time += first - SDL_min(first, blits / 4);
+        blit_time += blits;
+        SDL_DestroySurface(rle);
+    }
+    *encode_ms = (double)encode_time / iterations / 1000000.0;
+    *mpps = ((double)SHEET_SIZE * SHEET_SIZE * iterations * 4) / ((double)blit_time / 1000.0);
+    result = true;
+
+done:
+    SDL_DestroySurface(sheet);
+    SDL_DestroySurface(dst);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int iterations = 10;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+            iterations = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-26s %-26s %-9s %5s %10s %10s", "source", "destination", "key", "alpha", "encode ms", "MPix/s");
+    for (i = 0; i < SDL_arraysize(modes); i++) {
+        double encode_ms, mpps;
+        if (!bench(&modes[i], iterations, &encode_ms, &mpps)) {
+            ret = 2;
+            break;
+        }
+        SDL_Log("%-26s %-26s %-9s %5d %10.1f %10.1f", SDL_GetPixelFormatName(modes[i].src_format),
+                SDL_GetPixelFormatName(modes[i].dst_format), modes[i].colorkey ? "colorkey" : "alpha",
+                modes[i].alpha, encode_ms, mpps);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,123 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure SDL_FlipSurface() and SDL_RotateSurface90() on camera
+   sized frames. Set SDL_SURFACE_BLIT_THREADS to rotate on several threads, and
+   SDL_CPU_FEATURE_MASK (for example to "-sse2,-avx2") to compare against the
+   scalar paths. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define FRAME_WIDTH 1920
+#define FRAME_HEIGHT 1080
+
+static const SDL_PixelFormat formats[] = {
+    SDL_PIXELFORMAT_INDEX8,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_XRGB8888,
+};
+
+/* 0: flip horizontally, 1: flip vertically, 2-4: one to three quarter turns */
+static const char *operations[] = { "flip h", "flip v", "rotate 90", "rotate 180", "rotate 270" };
+
+/* Returns false if it failed */
+static bool bench(SDL_Surface *frame, int operation, int iterations, double *ms)
+{
+    Uint64 start, elapsed;
+    int i;
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; i++) {
+        if (operation < 2) {
+            if (!SDL_FlipSurface(frame, operation == 0 ? SDL_FLIP_HORIZONTAL : SDL_FLIP_VERTICAL)) {
+                SDL_Log("Couldn't flip surface: %s", SDL_GetError());
+                return false;
+            }
+        } else {
+            SDL_Surface *rotated = SDL_RotateSurface90(frame, operation - 1);
+            if (!rotated) {
+                SDL_Log("Couldn't rotate surface: %s", SDL_GetError());
+                return false;
+            }
+            SDL_DestroySurface(rotated);
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    *ms = (double)elapsed / iterations / 1000000.0;
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int iterations = 60;
+    int ret = 0;
+    int i, operation;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+            iterations = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-26s %-10s %10s %10s", "format", "operation", "ms", "MPix/s");
+    for (i = 0; i < SDL_arraysize(formats) && ret == 0; i++) {
+        SDL_Surface *frame = SDL_CreateSurface(FRAME_WIDTH, FRAME_HEIGHT, formats[i]);
+
+        if (!frame) {
+            SDL_Log("Couldn't create surface: %s", SDL_GetError());
+            ret = 2;
+            break;
+        }
+        SDL_FillSurfaceRect(frame, NULL, 0x12345678);
+
+        for (operation = 0; operation < SDL_arraysize(operations); operation++) {
+            double ms;
+
+            if (!bench(frame, operation, iterations, &ms)) {
+                ret = 2;
+                break;
+            }
+            SDL_Log("%-26s %-10s %10.2f %10.1f", SDL_GetPixelFormatName(formats[i]), operations[operation],
+                    ms, (double)FRAME_WIDTH * FRAME_HEIGHT / (ms * 1000.0));
+        }
+        SDL_DestroySurface(frame);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
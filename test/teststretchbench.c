@@ -0,0 +1,164 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure SDL_BlitSurfaceScaled() without conversion or blending, which
+   goes straight to the stretchers, for common upscale and downscale ratios. Set
+   SDL_CPU_FEATURE_MASK (for example to "-avx2" or "-sse41,-avx2") to compare
+   against the older paths. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct
+{
+    const char *name;
+    int src_w, src_h;
+    int dst_w, dst_h;
+} Ratio;
+
+static const Ratio ratios[] = {
+    { "320x180 -> 1280x720 (4x)", 320, 180, 1280, 720 },
+    { "640x360 -> 1920x1080 (3x)", 640, 360, 1920, 1080 },
+    { "1280x720 -> 1920x1080 (1.5x)", 1280, 720, 1920, 1080 },
+    { "1920x1080 -> 1280x720 (1/1.5x)", 1920, 1080, 1280, 720 },
+    { "1920x1080 -> 960x540 (1/2x)", 1920, 1080, 960, 540 },
+    { "3840x2160 -> 960x540 (1/4x)", 3840, 2160, 960, 540 },
+};
+
+typedef struct
+{
+    SDL_PixelFormat format;
+    SDL_ScaleMode scale;
+} Mode;
+
+static const Mode modes[] = {
+    { SDL_PIXELFORMAT_RGB332, SDL_SCALEMODE_NEAREST },
+    { SDL_PIXELFORMAT_RGB565, SDL_SCALEMODE_NEAREST },
+    { SDL_PIXELFORMAT_RGB24, SDL_SCALEMODE_NEAREST },
+    { SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_NEAREST },
+    { SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_LINEAR },
+    { SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_AREA },
+    { SDL_PIXELFORMAT_XRGB8888, SDL_SCALEMODE_LANCZOS },
+};
+
+static const char *scale_mode_name(SDL_ScaleMode scale)
+{
+    switch (scale) {
+    case SDL_SCALEMODE_NEAREST:
+        return "nearest";
+    case SDL_SCALEMODE_LINEAR:
+        return "linear";
+    case SDL_SCALEMODE_AREA:
+        return "area";
+    case SDL_SCALEMODE_LANCZOS:
+        return "lanczos";
+    default:
+        return "unknown";
+    }
+}
+
+static void fill_random(SDL_Surface *surface)
+{
+    int y, x;
+    for (y = 0; y < surface->h; y++) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->w * SDL_BYTESPERPIXEL(surface->format); x++) {
+            row[x] = (Uint8)SDL_rand(256);
+        }
+    }
+}
+
+/* Returns the average time per destination pixel in nanoseconds, or a negative value if it failed. */
+static double bench(const Ratio *r, const Mode *m, int iterations)
+{
+    SDL_Surface *src = SDL_CreateSurface(r->src_w, r->src_h, m->format);
+    SDL_Surface *dst = SDL_CreateSurface(r->dst_w, r->dst_h, m->format);
+    Uint64 start, elapsed;
+    double ns = -1.0;
+    int i;
+
+    if (!src || !dst) {
+        SDL_Log("Couldn't create surfaces: %s", SDL_GetError());
+        goto done;
+    }
+    fill_random(src);
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+    if (!SDL_BlitSurfaceScaled(src, NULL, dst, NULL, m->scale)) {
+        SDL_Log("Blit failed: %s", SDL_GetError());
+        goto done;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; i++) {
+        SDL_BlitSurfaceScaled(src, NULL, dst, NULL, m->scale);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    ns = (double)elapsed / iterations / ((double)r->dst_w * r->dst_h);
+
+done:
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(dst);
+    return ns;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int iterations = 20;
+    int ret = 0;
+    int i, j;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+            iterations = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-32s %-24s %8s %10s", "ratio", "format", "scale", "ns/pixel");
+    for (i = 0; i < SDL_arraysize(ratios) && ret == 0; i++) {
+        for (j = 0; j < SDL_arraysize(modes); j++) {
+            const double ns = bench(&ratios[i], &modes[j], iterations);
+            if (ns < 0.0) {
+                ret = 2;
+                break;
+            }
+            SDL_Log("%-32s %-24s %8s %10.3f", ratios[i].name, SDL_GetPixelFormatName(modes[j].format),
+                    scale_mode_name(modes[j].scale), ns);
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
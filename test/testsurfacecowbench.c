@@ -0,0 +1,127 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure duplicating a large image with and without
+   SDL_HINT_SURFACE_COPY_ON_WRITE, and the cost of the first write to a
+   duplicate that shares its pixels. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct
+{
+    int w;
+    int h;
+} Size;
+
+static const Size sizes[] = {
+    { 640, 360 },
+    { 1920, 1080 },
+    { 3840, 2160 },
+};
+
+/* Returns false if it failed */
+static bool bench(const Size *size, bool cow, int iterations, double *duplicate_us, double *write_us)
+{
+    SDL_Surface *image = SDL_CreateSurface(size->w, size->h, SDL_PIXELFORMAT_ARGB8888);
+    Uint64 duplicate_time = 0, write_time = 0;
+    bool result = false;
+    int i;
+
+    if (!image) {
+        SDL_Log("Couldn't create surface: %s", SDL_GetError());
+        return false;
+    }
+    SDL_FillSurfaceRect(image, NULL, SDL_MapSurfaceRGBA(image, 10, 20, 30, 255));
+
+    SDL_SetHint(SDL_HINT_SURFACE_COPY_ON_WRITE, cow ? "1" : "0");
+    for (i = 0; i < iterations; i++) {
+        SDL_Surface *copy;
+        Uint64 start;
+
+        start = SDL_GetTicksNS();
+        copy = SDL_DuplicateSurface(image);
+        duplicate_time += SDL_GetTicksNS() - start;
+        if (!copy) {
+            SDL_Log("Couldn't duplicate surface: %s", SDL_GetError());
+            goto done;
+        }
+
+        start = SDL_GetTicksNS();
+        SDL_WriteSurfacePixel(copy, i % size->w, 0, 255, 255, 255, 255);
+        write_time += SDL_GetTicksNS() - start;
+
+        SDL_DestroySurface(copy);
+    }
+    *duplicate_us = (double)duplicate_time / iterations / 1000.0;
+    *write_us = (double)write_time / iterations / 1000.0;
+    result = true;
+
+done:
+    SDL_ResetHint(SDL_HINT_SURFACE_COPY_ON_WRITE);
+    SDL_DestroySurface(image);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int iterations = 200;
+    int ret = 0;
+    int i, cow;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+            iterations = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-10s %-6s %14s %14s", "size", "mode", "duplicate us", "first write us");
+    for (i = 0; i < SDL_arraysize(sizes); i++) {
+        for (cow = 0; cow <= 1; cow++) {
+            char name[32];
+            double duplicate_us, write_us;
+
+            if (!bench(&sizes[i], cow != 0, iterations, &duplicate_us, &write_us)) {
+                ret = 2;
+                break;
+            }
+            (void)SDL_snprintf(name, sizeof(name), "%dx%d", sizes[i].w, sizes[i].h);
+            SDL_Log("%-10s %-6s %14.1f %14.1f", name, cow ? "cow" : "copy", duplicate_us, write_us);
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,132 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure creating, writing and destroying a surface per video
+   frame, with SDL_CreateSurface() and with a surface pool, with and without
+   huge pages. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct
+{
+    int w;
+    int h;
+} Size;
+
+static const Size sizes[] = {
+    { 640, 360 },
+    { 1920, 1080 },
+    { 3840, 2160 },
+};
+
+/* 0: SDL_CreateSurface(), 1: pool, 2: pool with huge pages */
+static const char *modes[] = { "create", "pool", "pool+huge" };
+
+/* Returns false if it failed */
+static bool bench(const Size *size, int mode, int frames, double *fps, SDL_SurfacePoolStats *stats)
+{
+    SDL_SurfacePool *pool = NULL;
+    Uint64 start, elapsed;
+    int i;
+
+    SDL_zerop(stats);
+    if (mode > 0) {
+        pool = SDL_CreateSurfacePool(256 * 1024 * 1024, mode == 2);
+        if (!pool) {
+            SDL_Log("Couldn't create surface pool: %s", SDL_GetError());
+            return false;
+        }
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < frames; i++) {
+        SDL_Surface *frame;
+
+        if (pool) {
+            frame = SDL_CreatePooledSurface(pool, size->w, size->h, SDL_PIXELFORMAT_XRGB8888);
+        } else {
+            frame = SDL_CreateSurface(size->w, size->h, SDL_PIXELFORMAT_XRGB8888);
+        }
+        if (!frame) {
+            SDL_Log("Couldn't create surface: %s", SDL_GetError());
+            SDL_DestroySurfacePool(pool);
+            return false;
+        }
+        /* Stand in for the decoder writing the frame */
+        SDL_memset(frame->pixels, i, (size_t)frame->h * frame->pitch);
+        SDL_DestroySurface(frame);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    *fps = (double)frames / ((double)elapsed / 1000000000.0);
+    if (pool) {
+        SDL_GetSurfacePoolStats(pool, stats);
+        SDL_DestroySurfacePool(pool);
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    int frames = 500;
+    int ret = 0;
+    int i, mode;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed && (i + 1) < argc && SDL_strcmp(argv[i], "--frames") == 0) {
+            frames = SDL_atoi(argv[i + 1]);
+            consumed = 2;
+        }
+        if (consumed <= 0 || frames <= 0) {
+            static const char *options[] = { "[--frames N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-10s %-10s %10s %8s %12s", "size", "mode", "frames/s", "hits", "resident MB");
+    for (i = 0; i < SDL_arraysize(sizes); i++) {
+        for (mode = 0; mode < SDL_arraysize(modes); mode++) {
+            SDL_SurfacePoolStats stats;
+            char name[32];
+            double fps;
+
+            if (!bench(&sizes[i], mode, frames, &fps, &stats)) {
+                ret = 2;
+                break;
+            }
+            (void)SDL_snprintf(name, sizeof(name), "%dx%d", sizes[i].w, sizes[i].h);
+            SDL_Log("%-10s %-10s %10.1f %8d %12.1f", name, modes[mode], fps, (int)stats.hits, (double)stats.resident_bytes / (1024.0 * 1024.0));
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,207 @@
+/*
+  Copyright (C) 1997-2024 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how fast SDL_LoadWAV_IO decodes each WAVE encoding, using
+   sample.wav (or a file given on the command line) and synthetic ADPCM and
+   companded files. Set SDL_CPU_FEATURE_MASK (for example to "-sse2" or
+   "-neon") to compare against the scalar decoders. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+#include "testutils.h"
+
+#define SYNTHETIC_SECONDS 30
+
+typedef struct
+{
+    const char *name;
+    Uint16 formattag;
+    Uint16 channels;
+    Uint16 blockalign;
+    Uint16 samplesperblock;
+} SyntheticWave;
+
+static const SyntheticWave synthetic[] = {
+    { "MS ADPCM mono", 0x0002, 1, 1024, 2036 },
+    { "MS ADPCM stereo", 0x0002, 2, 2048, 2036 },
+    { "IMA ADPCM mono", 0x0011, 1, 1024, 2041 },
+    { "IMA ADPCM stereo", 0x0011, 2, 2048, 2041 },
+    { "A-law stereo", 0x0006, 2, 2, 1 },
+    { "mu-law stereo", 0x0007, 2, 2, 1 },
+};
+
+static void write_le(Uint8 **p, Uint32 value, int bytes)
+{
+    int i;
+    for (i = 0; i < bytes; i++) {
+        *(*p)++ = (Uint8)(value >> (i * 8));
+    }
+}
+
+/* Random data decodes just as fast as real audio, as long as the block headers are valid. */
+static Uint8 *build_wave(const SyntheticWave *w, size_t *len)
+{
+    static const Sint16 coeffs[14] = { 256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232 };
+    const Uint32 fmt_len = w->formattag == 0x0002 ? 50 : (w->formattag == 0x0011 ? 20 : 16);
+    const Uint32 frames = 44100 * SYNTHETIC_SECONDS;
+    const Uint32 blocks = frames / w->samplesperblock;
+    const Uint32 data_len = blocks * w->blockalign;
+    Uint8 *wave, *p, *data;
+    Uint32 i, c;
+
+    *len = 12 + 8 + fmt_len + 8 + data_len;
+    wave = (Uint8 *)SDL_malloc(*len);
+    if (!wave) {
+        return NULL;
+    }
+
+    p = wave;
+    SDL_memcpy(p, "RIFF", 4);
+    p += 4;
+    write_le(&p, (Uint32)(*len - 8), 4);
+    SDL_memcpy(p, "WAVEfmt ", 8);
+    p += 8;
+    write_le(&p, fmt_len, 4);
+    write_le(&p, w->formattag, 2);
+    write_le(&p, w->channels, 2);
+    write_le(&p, 44100, 4);
+    write_le(&p, 44100 * w->blockalign / w->samplesperblock, 4);
+    write_le(&p, w->blockalign, 2);
+    write_le(&p, w->formattag == 0x0002 || w->formattag == 0x0011 ? 4 : 8, 2);
+    if (w->formattag == 0x0002) {
+        write_le(&p, 32, 2);
+        write_le(&p, w->samplesperblock, 2);
+        write_le(&p, 7, 2);
+        for (i = 0; i < 14; i++) {
+            write_le(&p, (Uint16)coeffs[i], 2);
+        }
+    } else if (w->formattag == 0x0011) {
+        write_le(&p, 2, 2);
+        write_le(&p, w->samplesperblock, 2);
+    }
+    SDL_memcpy(p, "data", 4);
+    p += 4;
+    write_le(&p, data_len, 4);
+
+    data = p;
+    for (i = 0; i < data_len; i++) {
+        data[i] = (Uint8)SDL_rand(256);
+    }
+
+    for (i = 0; w->samplesperblock > 1 && i < blocks; i++) {
+        Uint8 *block = data + i * w->blockalign;
+        for (c = 0; c < w->channels; c++) {
+            if (w->formattag == 0x0002) {
+                block[c] = (Uint8)SDL_rand(7);            /* coefficient index */
+                block[w->channels + c * 2 + 1] = 0;       /* keep the initial delta small */
+            } else {
+                block[c * 4 + 2] = (Uint8)SDL_rand(89);   /* step index */
+                block[c * 4 + 3] = 0;
+            }
+        }
+    }
+
+    return wave;
+}
+
+static void bench(const char *name, const void *wave, size_t len, int iterations)
+{
+    SDL_AudioSpec spec;
+    Uint8 *buf = NULL;
+    Uint32 buflen = 0;
+    Uint64 start, elapsed = 0;
+    int frames = 0;
+    int i;
+
+    for (i = 0; i < iterations; i++) {
+        start = SDL_GetTicksNS();
+        if (!SDL_LoadWAV_IO(SDL_IOFromConstMem(wave, len), true, &spec, &buf, &buflen)) {
+            SDL_Log("%-20s failed to load: %s", name, SDL_GetError());
+            return;
+        }
+        elapsed += SDL_GetTicksNS() - start;
+        frames = (int)(buflen / SDL_AUDIO_FRAMESIZE(spec));
+        SDL_free(buf);
+    }
+
+    SDL_Log("%-20s %10d %12.2f %12.1f", name, frames, (double)elapsed / iterations / frames,
+            ((double)len * iterations / (1024.0 * 1024.0)) / ((double)elapsed / SDL_NS_PER_SECOND));
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    char *filename = NULL;
+    void *sample = NULL;
+    size_t sample_len = 0;
+    int iterations = 20;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if ((i + 1) < argc && SDL_strcmp(argv[i], "--iterations") == 0) {
+                iterations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (!filename) {
+                filename = argv[i];
+                consumed = 1;
+            }
+        }
+        if (consumed <= 0 || iterations <= 0) {
+            static const char *options[] = { "[--iterations N]", "[sample.wav]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%-20s %10s %12s %12s", "encoding", "frames", "ns/frame", "input MB/s");
+
+    filename = GetResourceFilename(filename, "sample.wav");
+    if (filename) {
+        sample = SDL_LoadFile(filename, &sample_len);
+    }
+    if (sample) {
+        bench(filename, sample, sample_len, iterations);
+    } else {
+        SDL_Log("Couldn't load sample.wav: %s", SDL_GetError());
+    }
+
+    for (i = 0; i < SDL_arraysize(synthetic); i++) {
+        size_t len;
+        Uint8 *wave = build_wave(&synthetic[i], &len);
+        if (wave) {
+            bench(synthetic[i].name, wave, len, iterations);
+            SDL_free(wave);
+        }
+    }
+
+    SDL_free(sample);
+    SDL_free(filename);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}